@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    AnalysisGovernor.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the CPU-adaptive analysis governor.
+
+  ==============================================================================
+*/
+
+#include "AnalysisGovernor.h"
+#include "../Core/Constants.h"
+
+namespace AIplayer {
+
+namespace {
+    /// Tier presets, lowest first; Standard is the analysis the plugin always had
+    constexpr AnalysisGovernor::TierSettings TIERS[AnalysisGovernor::NUM_TIERS] = {
+        { "minimal",   9, 0.0f,  2, 0 },
+        { "reduced",  10, 0.0f,  5, AnalysisGovernor::Loudness },
+        { "standard", 10, 0.0f, 10, AnalysisGovernor::Spectrum | AnalysisGovernor::KeyAnalysis | AnalysisGovernor::Loudness | AnalysisGovernor::Pitch },
+        { "high",     12, 0.5f, 25, AnalysisGovernor::Spectrum | AnalysisGovernor::KeyAnalysis | AnalysisGovernor::Loudness | AnalysisGovernor::Pitch }
+    };
+
+    /// Priority presets, lowest first; lower priorities give way first, leaving
+    /// the budget (and the OSC link) to focused tracks
+    constexpr AnalysisGovernor::PriorityPreset PRIORITIES[] = {
+        { "background", AnalysisGovernor::Tier::Reduced,  0.6f,  8 },
+        { "normal",     AnalysisGovernor::Tier::Standard, 0.8f, Constants::TELEMETRY_RATE_HZ },
+        { "focused",    AnalysisGovernor::Tier::High,     1.0f, 60 }
+    };
+
+    /// Loads of every instance in the process, in parts per million
+    std::atomic<juce::int64> processCallbackPpm{0};
+    std::atomic<juce::int64> processAnalysisPpm{0};
+
+    constexpr double PPM = 1.0e6;
+}
+
+//==============================================================================
+AnalysisGovernor::AnalysisGovernor(FrequencyAnalyzer& mainAnalyzer, FrequencyAnalyzer& sidechainAnalyzer,
+                                   AudioMetrics& audioMetrics, Logger& log)
+    : analyzer(mainAnalyzer)
+    , keyAnalyzer(sidechainAnalyzer)
+    , metrics(audioMetrics)
+    , logger(log)
+{
+    applyTier(Tier::Standard);
+    changeCount = 0;
+
+    lastEvaluationMs = juce::Time::getMillisecondCounterHiRes();
+    lastComputeMs = analyzer.getTotalComputeTime() + keyAnalyzer.getTotalComputeTime();
+}
+
+AnalysisGovernor::~AnalysisGovernor()
+{
+    stopTimer();
+
+    // Leave the process sums as if this instance never existed
+    processCallbackPpm.fetch_sub(sharedCallbackPpm);
+    processAnalysisPpm.fetch_sub(sharedAnalysisPpm);
+}
+
+void AnalysisGovernor::prepare(double rate)
+{
+    sampleRate = rate > 0.0 ? rate : 44100.0;
+}
+
+//==============================================================================
+const AnalysisGovernor::TierSettings& AnalysisGovernor::getSettings(Tier tier)
+{
+    return TIERS[juce::jlimit(0, NUM_TIERS - 1, static_cast<int>(tier))];
+}
+
+const AnalysisGovernor::PriorityPreset& AnalysisGovernor::getPreset(Priority priority)
+{
+    return PRIORITIES[juce::jlimit(0, 2, static_cast<int>(priority))];
+}
+
+juce::String AnalysisGovernor::priorityToString(Priority priority)
+{
+    return getPreset(priority).name;
+}
+
+AnalysisGovernor::Priority AnalysisGovernor::priorityFromString(const juce::String& text)
+{
+    const auto value = text.trim();
+
+    if (value.equalsIgnoreCase("focused") || value.equalsIgnoreCase("solo") || value == "2")
+        return Priority::Focused;
+
+    if (value.equalsIgnoreCase("background") || value == "0")
+        return Priority::Background;
+
+    return Priority::Normal;
+}
+
+//==============================================================================
+void AnalysisGovernor::setPriority(Priority newPriority)
+{
+    if (newPriority == priority)
+        return;
+
+    const bool raised = static_cast<int>(newPriority) > static_cast<int>(priority);
+    priority = newPriority;
+    ++changeCount;
+
+    // A promoted track may climb at the next calm evaluation rather than after a full hold
+    if (raised)
+        calmSeconds = UPGRADE_HOLD_SECONDS;
+
+    logger.log(Logger::Level::Info, "Analysis priority: " + priorityToString(priority));
+}
+
+AnalysisGovernor::Status AnalysisGovernor::getStatus() const
+{
+    Status status;
+    status.tier = tier;
+    status.priority = priority;
+    status.fftSize = analyzer.getFFTSize();
+    status.overlap = analyzer.getOverlap();
+    status.updateRateHz = analyzer.getUpdateRate();
+    status.features = features.load();
+    status.callbackLoad = callbackLoad;
+    status.analysisLoad = analysisLoad;
+    status.pressure = lastPressure;
+    return status;
+}
+
+//==============================================================================
+void AnalysisGovernor::update(float pressure, double elapsedSeconds)
+{
+    lastPressure = pressure;
+    secondsSinceChange += elapsedSeconds;
+
+    const int current = static_cast<int>(tier);
+    const int ceiling = static_cast<int>(getMaxTier(priority));
+    const float threshold = getThreshold(priority);
+    int target = current;
+
+    if (current > ceiling)
+    {
+        target = ceiling;
+    }
+    else if (pressure > threshold)
+    {
+        calmSeconds = 0.0;
+
+        if (secondsSinceChange >= DOWNGRADE_HOLD_SECONDS && current > 0)
+            target = current - 1;
+    }
+    else if (pressure < threshold * RECOVERY_RATIO)
+    {
+        calmSeconds += elapsedSeconds;
+
+        if (calmSeconds >= UPGRADE_HOLD_SECONDS && current < ceiling)
+            target = current + 1;
+    }
+    else
+    {
+        calmSeconds = 0.0;
+    }
+
+    if (target != current)
+    {
+        applyTier(static_cast<Tier>(target));
+        secondsSinceChange = 0.0;
+        calmSeconds = 0.0;
+    }
+}
+
+void AnalysisGovernor::applyTier(Tier newTier)
+{
+    const auto& settings = getSettings(newTier);
+
+    analyzer.setFFTOrder(settings.fftOrder);
+    analyzer.setOverlap(settings.overlap);
+    analyzer.setUpdateRate(settings.updateRateHz);
+    analyzer.setSpectrumEnabled((settings.features & Spectrum) != 0);
+    analyzer.setPitchAllowed((settings.features & Pitch) != 0);
+    metrics.setLoudnessEnabled((settings.features & Loudness) != 0);
+    features.store(settings.features);
+
+    tier = newTier;
+    ++changeCount;
+
+    logger.log(Logger::Level::Info,
+               juce::String("Analysis quality: ") + settings.name
+               + " (FFT " + juce::String(1 << settings.fftOrder)
+               + ", " + juce::String(settings.updateRateHz) + " Hz, pressure "
+               + juce::String(lastPressure, 2) + ")");
+}
+
+//==============================================================================
+float AnalysisGovernor::measurePressure(double elapsedSeconds)
+{
+    // Audio callback: busy time per second of audio processed
+    const auto ticks = callbackTicks.exchange(0);
+    const auto samples = callbackSamples.exchange(0);
+
+    callbackLoad = samples > 0
+        ? static_cast<float>(juce::Time::highResolutionTicksToSeconds(ticks) * sampleRate / static_cast<double>(samples))
+        : 0.0f;
+
+    // Analysis: frame computation time per second of wall time
+    const double computeMs = analyzer.getTotalComputeTime() + keyAnalyzer.getTotalComputeTime();
+    analysisLoad = elapsedSeconds > 0.0
+        ? static_cast<float>((computeMs - lastComputeMs) / (1000.0 * elapsedSeconds))
+        : 0.0f;
+    lastComputeMs = computeMs;
+
+    // Replace this instance's share of the process sums
+    const auto callbackPpm = static_cast<juce::int64>(callbackLoad * PPM);
+    const auto analysisPpm = static_cast<juce::int64>(analysisLoad * PPM);
+
+    const double processCallback = static_cast<double>(processCallbackPpm.fetch_add(callbackPpm - sharedCallbackPpm)
+                                                       + callbackPpm - sharedCallbackPpm) / PPM;
+    const double processAnalysis = static_cast<double>(processAnalysisPpm.fetch_add(analysisPpm - sharedAnalysisPpm)
+                                                       + analysisPpm - sharedAnalysisPpm) / PPM;
+
+    sharedCallbackPpm = callbackPpm;
+    sharedAnalysisPpm = analysisPpm;
+
+    // Hosts spread tracks over cores; the message thread is one
+    const double cores = juce::jmax(1, juce::SystemStats::getNumPhysicalCpus());
+
+    return static_cast<float>(juce::jmax(processCallback / (cores * CALLBACK_BUDGET),
+                                         processAnalysis / ANALYSIS_BUDGET));
+}
+
+void AnalysisGovernor::timerCallback()
+{
+    const double now = juce::Time::getMillisecondCounterHiRes();
+    const double elapsedSeconds = (now - lastEvaluationMs) / 1000.0;
+    lastEvaluationMs = now;
+
+    update(measurePressure(elapsedSeconds), elapsedSeconds);
+}
+
+} // namespace AIplayer
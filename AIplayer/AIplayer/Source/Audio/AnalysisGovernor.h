@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+    AnalysisGovernor.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    CPU-adaptive analysis quality: trades FFT size, overlap, update rate and
+    optional features against measured load.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include "../Core/Logger.h"
+#include "AudioMetrics.h"
+#include "FrequencyAnalyzer.h"
+#include <atomic>
+
+namespace AIplayer {
+
+/**
+ * @class AnalysisGovernor
+ * @brief Degrades analysis before the host has to drop audio
+ *
+ * Every few hundred milliseconds (message thread) the governor measures two
+ * loads and combines them with the other instances in the process:
+ * - audio callback load: time spent in processBlock() per second of audio,
+ *   reported by the processor with addCallbackTime() (lock-free)
+ * - analysis load: time the frequency analyzers spent computing frames per
+ *   second of wall time, all on the one message thread
+ *
+ * The process-wide sums, relative to their budgets, give a pressure where
+ * 1.0 means "at budget". Each instance reacts according to its priority,
+ * set by the controller: background instances step down first, focused
+ * (soloed) ones last, and only focused ones may climb to the High tier.
+ * Steps are one tier at a time, at most once per second down and after
+ * five calm seconds up.
+ *
+ * Priorities are presets too (PriorityPreset): besides the ceiling and
+ * threshold they carry the telemetry rate, so the controller's focus
+ * (/aiplayer/focus) moves an instance between precomputed configurations.
+ *
+ * A tier sets the FFT order, overlap and update rate of the main analyzer
+ * and which optional features run (display spectrum, sidechain key
+ * analysis, loudness, pitch). FFT processors for all orders are allocated up
+ * front, so a switch never allocates. The status, including the measured
+ * loads, goes out with the telemetry whenever it changes.
+ */
+class AnalysisGovernor : private juce::Timer
+{
+public:
+    /// Quality tiers, lowest first
+    enum class Tier
+    {
+        Minimal = 0,    ///< Bands only, small FFT, slow updates
+        Reduced,        ///< Bands and loudness
+        Standard,       ///< Default analysis
+        High            ///< Large overlapped FFT at a high rate (focused tracks)
+    };
+
+    static constexpr int NUM_TIERS = 4;
+
+    /// How much this instance matters to the controller
+    enum class Priority
+    {
+        Background = 0,
+        Normal,
+        Focused
+    };
+
+    /// Optional analysis features (bit flags)
+    enum Feature
+    {
+        Spectrum = 1 << 0,      ///< Log-binned display spectrum
+        KeyAnalysis = 1 << 1,   ///< FFT analysis of the sidechain key
+        Loudness = 1 << 2,      ///< Momentary/short-term loudness
+        Pitch = 1 << 3          ///< Fundamental-frequency tracking (when requested)
+    };
+
+    /// Analysis settings of one tier
+    struct TierSettings
+    {
+        const char* name;
+        int fftOrder;
+        float overlap;          ///< Fraction of each frame shared with the previous one
+        int updateRateHz;
+        int features;           ///< Feature flags
+    };
+
+    /// Settings that follow from a priority
+    struct PriorityPreset
+    {
+        const char* name;
+        Tier maxTier;           ///< Highest tier the instance may climb to
+        float threshold;        ///< Pressure above which it steps down
+        int telemetryRateHz;    ///< Rate of its telemetry stream
+    };
+
+    /// FFT orders the main analyzer has to be configured for
+    static constexpr int MIN_FFT_ORDER = 9;
+    static constexpr int MAX_FFT_ORDER = 12;
+
+    /// Evaluation rate
+    static constexpr int EVALUATION_RATE_HZ = 4;
+
+    /// Callback budget: fraction of real time summed over instances, per core
+    static constexpr double CALLBACK_BUDGET = 0.6;
+
+    /// Analysis budget: fraction of the message thread summed over instances
+    static constexpr double ANALYSIS_BUDGET = 0.2;
+
+    /// Minimum time between downward steps
+    static constexpr double DOWNGRADE_HOLD_SECONDS = 1.0;
+
+    /// Calm time needed before an upward step
+    static constexpr double UPGRADE_HOLD_SECONDS = 5.0;
+
+    /// Pressure below threshold * RECOVERY_RATIO counts as calm
+    static constexpr float RECOVERY_RATIO = 0.6f;
+
+    /// Snapshot reported through telemetry
+    struct Status
+    {
+        Tier tier{Tier::Standard};
+        Priority priority{Priority::Normal};
+        int fftSize{0};
+        float overlap{0.0f};
+        int updateRateHz{0};
+        int features{0};
+        float callbackLoad{0.0f};   ///< This instance, fraction of real time
+        float analysisLoad{0.0f};   ///< This instance, fraction of the message thread
+        float pressure{0.0f};       ///< Process-wide, 1.0 = at budget
+    };
+
+    /**
+     * @brief Constructor; applies the Standard tier
+     *
+     * @param analyzer Main analyzer (configured for MIN_FFT_ORDER..MAX_FFT_ORDER)
+     * @param keyAnalyzer Sidechain key analyzer (its load is counted)
+     * @param metrics Metering whose loudness is switched
+     * @param logger Logger for tier changes
+     */
+    AnalysisGovernor(FrequencyAnalyzer& analyzer, FrequencyAnalyzer& keyAnalyzer,
+                     AudioMetrics& metrics, Logger& logger);
+
+    ~AnalysisGovernor() override;
+
+    /**
+     * @brief Sets the sample rate used to turn callback sample counts into time
+     *
+     * @param sampleRate Processing sample rate
+     */
+    void prepare(double sampleRate);
+
+    /// Starts periodic evaluation (message thread)
+    void start() { startTimerHz(EVALUATION_RATE_HZ); }
+
+    /// Stops periodic evaluation
+    void stop() { stopTimer(); }
+
+    /**
+     * @brief Records the duration of one audio callback (audio thread)
+     *
+     * @param ticks Duration in juce::Time high-resolution ticks
+     * @param numSamples Samples processed in the callback
+     */
+    void addCallbackTime(juce::int64 ticks, int numSamples) noexcept
+    {
+        callbackTicks.fetch_add(ticks, std::memory_order_relaxed);
+        callbackSamples.fetch_add(numSamples, std::memory_order_relaxed);
+    }
+
+    /// Whether an optional feature runs at the current tier (any thread)
+    bool isEnabled(Feature feature) const { return (features.load(std::memory_order_relaxed) & feature) != 0; }
+
+    /**
+     * @brief Sets the instance priority (message thread)
+     *
+     * Above the new priority's ceiling the tier drops at the next
+     * evaluation; a raised priority may climb at the next calm one.
+     *
+     * @param newPriority The priority chosen by the controller
+     */
+    void setPriority(Priority newPriority);
+
+    /// Current priority
+    Priority getPriority() const { return priority; }
+
+    /// Current tier
+    Tier getTier() const { return tier; }
+
+    /// Status snapshot (message thread)
+    Status getStatus() const;
+
+    /// Incremented on every tier or priority change, so reporters can tell what is new
+    int getChangeCount() const { return changeCount; }
+
+    /**
+     * @brief One decision step
+     *
+     * Called by the timer with the measured pressure; public so tests can
+     * drive the policy directly.
+     *
+     * @param pressure Process-wide load relative to budget (1.0 = at budget)
+     * @param elapsedSeconds Time since the previous step
+     */
+    void update(float pressure, double elapsedSeconds);
+
+    /// Settings of a tier
+    static const TierSettings& getSettings(Tier tier);
+
+    /// Preset of a priority
+    static const PriorityPreset& getPreset(Priority priority);
+
+    /// Highest tier an instance of this priority may use
+    static Tier getMaxTier(Priority priority) { return getPreset(priority).maxTier; }
+
+    /// Pressure above which an instance of this priority steps down
+    static float getThreshold(Priority priority) { return getPreset(priority).threshold; }
+
+    /// Telemetry rate for an instance of this priority
+    static int getTelemetryRate(Priority priority) { return getPreset(priority).telemetryRateHz; }
+
+    /// Converts a priority to its OSC name ("background", "normal", "focused")
+    static juce::String priorityToString(Priority priority);
+
+    /// Parses an OSC priority name or number (0-2); unknown text is Normal
+    static Priority priorityFromString(const juce::String& text);
+
+private:
+    void timerCallback() override;
+
+    /// Measures this instance's loads, updates its share of the process sums and returns the pressure
+    float measurePressure(double elapsedSeconds);
+
+    void applyTier(Tier newTier);
+
+    FrequencyAnalyzer& analyzer;
+    FrequencyAnalyzer& keyAnalyzer;
+    AudioMetrics& metrics;
+    Logger& logger;
+
+    std::atomic<juce::int64> callbackTicks{0};
+    std::atomic<juce::int64> callbackSamples{0};
+    std::atomic<int> features{0};
+
+    double sampleRate{44100.0};
+    Tier tier{Tier::Standard};
+    Priority priority{Priority::Normal};
+    int changeCount{0};
+
+    double secondsSinceChange{0.0};
+    double calmSeconds{0.0};
+    double lastEvaluationMs{0.0};
+    double lastComputeMs{0.0};
+
+    float callbackLoad{0.0f};
+    float analysisLoad{0.0f};
+    float lastPressure{0.0f};
+
+    /// This instance's contribution to the process-wide sums (parts per million)
+    juce::int64 sharedCallbackPpm{0};
+    juce::int64 sharedAnalysisPpm{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisGovernor)
+};
+
+} // namespace AIplayer
@@ -16,9 +16,28 @@ namespace AIplayer {
 
 AudioMetrics::AudioMetrics()
 {
-    // Initialize metrics buffer with a reasonable size
-    // This will be resized as needed in updateMetrics
-    metricsBuffer.setSize(2, 512, false, true, false);
+}
+
+void AudioMetrics::prepare(double sampleRate, int maxBlockSize, const juce::AudioChannelSet& layout)
+{
+    const int layoutChannels = juce::jlimit(1, ChannelLayout::MAX_CHANNELS, layout.size());
+    
+    std::array<float, ChannelLayout::MAX_CHANNELS> weights;
+    ChannelLayout::loudnessWeights(layout, weights.data());
+    
+    loudnessMeter.prepare(sampleRate, maxBlockSize, layoutChannels);
+    loudnessMeter.setChannelWeights(weights.data(), layoutChannels);
+    loudnessBlockSize = juce::jmax(1, maxBlockSize);
+    
+    scheduler.prepare(sampleRate);
+    hopSamples = scheduler.getHopSamples();
+    hopSums.fill(0.0f);
+    hopPeaks.fill(0.0f);
+    hopCount.store(0);
+    dynamics.reset();
+    
+    momentaryLufs.store(LoudnessMeter::SILENCE_DB);
+    shortTermLufs.store(LoudnessMeter::SILENCE_DB);
 }
 
 float AudioMetrics::calculateRMS(const juce::AudioBuffer<float>& buffer) const
@@ -74,51 +93,123 @@ float AudioMetrics::calculateRMS(const juce::AudioBuffer<float>& buffer) const
 
 void AudioMetrics::updateMetrics(const juce::AudioBuffer<float>& buffer)
 {
-    // Calculate current RMS
-    const float rms = calculateRMS(buffer);
-    currentRMS.store(rms);
+    const int channels = juce::jmin(buffer.getNumChannels(), ChannelLayout::MAX_CHANNELS);
+    const int numSamples = buffer.getNumSamples();
     
-    // Calculate peak level
-    float peak = 0.0f;
+    if (channels == 0 || numSamples == 0)
+        return;
     
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    if (hopSamples > 0)
     {
-        const float channelPeak = buffer.getMagnitude(channel, 0, buffer.getNumSamples());
-        if (channelPeak > peak)
-            peak = channelPeak;
+        // Accumulate along the hop grid (one contiguous pass per channel and
+        // segment for the energy and one for the peak); publish per hop
+        scheduler.process(numSamples, [&](int start, int count)
+        {
+            for (int channel = 0; channel < channels; ++channel)
+            {
+                const auto index = static_cast<size_t>(channel);
+                hopSums[index] += ChannelLayout::sumOfSquares(buffer.getReadPointer(channel, start), count);
+                hopPeaks[index] = juce::jmax(hopPeaks[index], buffer.getMagnitude(channel, start, count));
+            }
+        },
+        [&](juce::int64 hop)
+        {
+            publishLevels(hopSums.data(), hopPeaks.data(), channels, hopSamples);
+            hopCount.store(hop + 1, std::memory_order_release);
+            dynamics.addLevels(currentRMS.load(), peakLevel.load());
+            
+            hopSums.fill(0.0f);
+            hopPeaks.fill(0.0f);
+        });
     }
-    
-    peakLevel.store(peak);
-    
-    // Optionally store a copy of the buffer for later analysis
-    // This is only needed if we want to calculate metrics outside the audio thread
+    else
     {
-        const juce::ScopedLock sl(bufferLock);
+        std::array<float, ChannelLayout::MAX_CHANNELS> sums, peaks;
         
-        // Resize if needed
-        if (metricsBuffer.getNumChannels() != buffer.getNumChannels() ||
-            metricsBuffer.getNumSamples() != buffer.getNumSamples())
+        for (int channel = 0; channel < channels; ++channel)
         {
-            metricsBuffer.setSize(buffer.getNumChannels(), 
-                                 buffer.getNumSamples(), 
-                                 false, false, true);
+            sums[static_cast<size_t>(channel)] = ChannelLayout::sumOfSquares(buffer.getReadPointer(channel), numSamples);
+            peaks[static_cast<size_t>(channel)] = buffer.getMagnitude(channel, 0, numSamples);
         }
         
-        // Copy the buffer
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        publishLevels(sums.data(), peaks.data(), channels, numSamples);
+    }
+    
+    // Channel-weighted loudness (in chunks if the host exceeds the prepared block size)
+    if (loudnessBlockSize > 0)
+    {
+        const bool enabled = loudnessEnabled.load();
+        if (enabled != loudnessRunning)
         {
-            metricsBuffer.copyFrom(channel, 0, buffer, channel, 0, buffer.getNumSamples());
+            loudnessRunning = enabled;
+            loudnessMeter.reset();
+            dynamics.resetLoudness();
+            momentaryLufs.store(LoudnessMeter::SILENCE_DB);
+            shortTermLufs.store(LoudnessMeter::SILENCE_DB);
+        }
+        
+        if (!enabled)
+            return;
+        
+        // Runs end on loudness hop boundaries so every hop reaches the dynamics histograms
+        for (int start = 0; start < numSamples;)
+        {
+            const int count = juce::jmin(loudnessBlockSize, numSamples - start, loudnessMeter.getSamplesUntilHop());
+            
+            if (loudnessMeter.process(buffer, start, count) > 0)
+            {
+                momentaryLufs.store(loudnessMeter.getMomentaryLufs());
+                shortTermLufs.store(loudnessMeter.getShortTermLufs());
+                dynamics.addLoudness(loudnessMeter.getMomentaryLufs(), loudnessMeter.getShortTermLufs());
+            }
+            
+            start += count;
         }
     }
 }
 
+void AudioMetrics::publishLevels(const float* sums, const float* peaks, int channels, int numSamples)
+{
+    float totalSum = 0.0f;
+    float peak = 0.0f;
+    
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        channelRMS[static_cast<size_t>(channel)].store(std::sqrt(sums[channel] / static_cast<float>(numSamples) + 1.0e-10f));
+        channelPeak[static_cast<size_t>(channel)].store(peaks[channel]);
+        
+        totalSum += sums[channel];
+        peak = juce::jmax(peak, peaks[channel]);
+    }
+    
+    numChannels.store(channels);
+    currentRMS.store(std::sqrt(totalSum / static_cast<float>(channels * numSamples) + 1.0e-10f));
+    peakLevel.store(peak);
+}
+
+float AudioMetrics::getChannelRMS(int channel) const
+{
+    if (channel < 0 || channel >= numChannels.load())
+        return 0.0f;
+    
+    return channelRMS[static_cast<size_t>(channel)].load();
+}
+
+float AudioMetrics::getChannelPeak(int channel) const
+{
+    if (channel < 0 || channel >= numChannels.load())
+        return 0.0f;
+    
+    return channelPeak[static_cast<size_t>(channel)].load();
+}
+
 void AudioMetrics::reset()
 {
     currentRMS.store(0.0f);
     peakLevel.store(0.0f);
-    
-    const juce::ScopedLock sl(bufferLock);
-    metricsBuffer.clear();
+    numChannels.store(0);
+    momentaryLufs.store(LoudnessMeter::SILENCE_DB);
+    shortTermLufs.store(LoudnessMeter::SILENCE_DB);
 }
 
 } // namespace AIplayer
@@ -13,7 +13,12 @@
 
 #pragma once
 
-#include "../../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
+#include "ChannelLayout.h"
+#include "DynamicsAnalyzer.h"
+#include "HopScheduler.h"
+#include "LoudnessMeter.h"
+#include <array>
 #include <atomic>
 
 namespace AIplayer {
@@ -24,6 +29,19 @@ namespace AIplayer {
  * 
  * Thread-safe audio analysis component that can be called from both
  * audio thread (for updating) and other threads (for reading).
+ * 
+ * Buses of up to ChannelLayout::MAX_CHANNELS channels are metered per
+ * channel. Once prepared with the bus layout, momentary and short-term
+ * loudness are measured with BS.1770 surround channel weights.
+ * 
+ * Once prepared, RMS and peak levels are measured over fixed 10 ms hops
+ * (HopScheduler) rather than over host blocks, so they read the same for
+ * any buffer size: the getters return the last completed hop, on the same
+ * grid as the loudness values, and getHopCount() says which hop that is.
+ * Unprepared, levels fall back to one measurement per updateMetrics() call.
+ * 
+ * Each hop's levels, and each loudness hop, also feed the DynamicsAnalyzer
+ * (level distribution, crest factor, PLR/PSR over rolling windows).
  */
 class AudioMetrics
 {
@@ -38,10 +56,23 @@ public:
      */
     ~AudioMetrics() = default;
     
+    /**
+     * @brief Prepares loudness metering for a bus layout
+     * 
+     * Without this call only RMS and peak levels are measured.
+     * 
+     * @param sampleRate Processing sample rate
+     * @param maxBlockSize Largest block passed to updateMetrics()
+     * @param layout Channel layout of the metered bus
+     */
+    void prepare(double sampleRate, int maxBlockSize, const juce::AudioChannelSet& layout);
+    
     /**
      * @brief Calculates the RMS value from an audio buffer
      * 
      * Can be called from any thread. Does not modify internal state.
+     * The result depends on how the audio is split into buffers; the
+     * hop-aligned level is getCurrentRMS().
      * 
      * @param buffer The audio buffer to calculate RMS from
      * @return The calculated RMS value (linear, not dB)
@@ -52,12 +83,30 @@ public:
      * @brief Updates internal metrics based on the provided audio buffer
      * 
      * Should be called from the audio thread during processBlock.
-     * Updates currentRMS and peakLevel atomically.
+     * Updates currentRMS and peakLevel atomically for every hop completed
+     * within the buffer; does not allocate or lock.
      * 
      * @param buffer The audio buffer to analyze
      */
     void updateMetrics(const juce::AudioBuffer<float>& buffer);
     
+    /**
+     * @brief Gets the number of hops measured since prepare()
+     * 
+     * Levels read after this returns n describe hop n - 1, i.e. the samples
+     * [(n - 1) * hop, n * hop) since prepare(). Stays 0 when unprepared.
+     * 
+     * @return Completed hop count
+     */
+    juce::int64 getHopCount() const { return hopCount.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Gets the hop length
+     * 
+     * @return Hop length in samples (0 when unprepared)
+     */
+    int getHopSamples() const { return hopSamples; }
+    
     /**
      * @brief Gets the current RMS level
      * 
@@ -76,6 +125,71 @@ public:
      */
     float getPeakLevel() const { return peakLevel.load(); }
     
+    /**
+     * @brief Gets the number of channels in the last metered block
+     * 
+     * @return Channel count (at most ChannelLayout::MAX_CHANNELS)
+     */
+    int getNumChannels() const { return numChannels.load(); }
+    
+    /**
+     * @brief Gets the RMS level of one channel
+     * 
+     * @param channel Channel index
+     * @return RMS level (linear), 0 for channels out of range
+     */
+    float getChannelRMS(int channel) const;
+    
+    /**
+     * @brief Gets the peak level of one channel
+     * 
+     * @param channel Channel index
+     * @return Peak level (linear), 0 for channels out of range
+     */
+    float getChannelPeak(int channel) const;
+    
+    /**
+     * @brief Gets the momentary (400 ms) channel-weighted loudness
+     * 
+     * @return Loudness in LUFS (LoudnessMeter::SILENCE_DB before prepare())
+     */
+    float getMomentaryLufs() const { return momentaryLufs.load(); }
+    
+    /**
+     * @brief Gets the short-term (3 s) channel-weighted loudness
+     * 
+     * @return Loudness in LUFS (LoudnessMeter::SILENCE_DB before prepare())
+     */
+    float getShortTermLufs() const { return shortTermLufs.load(); }
+    
+    /**
+     * @brief Enables or disables the loudness measurement
+     * 
+     * Disabling saves the K-weighting filters; the loudness getters then
+     * read LoudnessMeter::SILENCE_DB. Re-enabling restarts the windows, so
+     * momentary loudness is valid again after 400 ms. Any thread.
+     * 
+     * @param enable true to measure loudness (the default)
+     */
+    void setLoudnessEnabled(bool enable) { loudnessEnabled.store(enable); }
+    
+    /**
+     * @brief Checks whether loudness is measured
+     * 
+     * @return true if enabled
+     */
+    bool isLoudnessEnabled() const { return loudnessEnabled.load(); }
+    
+    /**
+     * @brief Gets the dynamics statistics
+     * 
+     * Fed on the hop grid once prepared; read its reports from any thread.
+     * Without loudness the loudness-based values (PLR, PSR) read 0.
+     * 
+     * @return The dynamics analyzer
+     */
+    const DynamicsAnalyzer& getDynamics() const { return dynamics; }
+    
     /**
      * @brief Resets all metrics to zero
      * 
@@ -90,11 +204,31 @@ private:
     /// Current peak level (atomic for thread safety)
     std::atomic<float> peakLevel{0.0f};
     
-    /// Buffer for thread-safe metric calculations
-    juce::AudioBuffer<float> metricsBuffer;
+    /// Per-channel levels (linear)
+    std::array<std::atomic<float>, ChannelLayout::MAX_CHANNELS> channelRMS{};
+    std::array<std::atomic<float>, ChannelLayout::MAX_CHANNELS> channelPeak{};
+    std::atomic<int> numChannels{0};
+    
+    /// Hop grid and the sums of the hop in progress (audio thread only)
+    HopScheduler scheduler;
+    int hopSamples{0};
+    std::array<float, ChannelLayout::MAX_CHANNELS> hopSums{};
+    std::array<float, ChannelLayout::MAX_CHANNELS> hopPeaks{};
+    std::atomic<juce::int64> hopCount{0};
+    
+    /// Publishes levels from per-channel sums of squares and peaks
+    void publishLevels(const float* sums, const float* peaks, int channels, int numSamples);
+    
+    /// Channel-weighted loudness, measured once prepared
+    LoudnessMeter loudnessMeter;
+    int loudnessBlockSize{0};
+    std::atomic<bool> loudnessEnabled{true};
+    bool loudnessRunning{true};
+    std::atomic<float> momentaryLufs{LoudnessMeter::SILENCE_DB};
+    std::atomic<float> shortTermLufs{LoudnessMeter::SILENCE_DB};
     
-    /// Lock for protecting metricsBuffer access
-    mutable juce::CriticalSection bufferLock;
+    /// Level and loudness histograms over rolling windows (audio thread)
+    DynamicsAnalyzer dynamics;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioMetrics)
 };
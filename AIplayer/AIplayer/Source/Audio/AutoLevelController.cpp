@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+    AutoLevelController.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of in-plugin gain matching.
+
+  ==============================================================================
+*/
+
+#include "AutoLevelController.h"
+#include <cmath>
+
+namespace AIplayer {
+
+void AutoLevelController::prepare(double newSampleRate, int maxBlockSize, int numChannels)
+{
+    sampleRate = newSampleRate;
+    meter.prepare(sampleRate, maxBlockSize, numChannels);
+
+    // Force the current target to be re-applied with the new hop length
+    appliedSerial = requestSerial.load(std::memory_order_acquire) - 1;
+    reset();
+}
+
+void AutoLevelController::reset()
+{
+    meter.reset();
+    currentGain = 1.0f;
+    gainStep = 1.0f;
+    hopTargetGainDb = 0.0f;
+    tracking = false;
+
+    statusMeasuredDb.store(LoudnessMeter::SILENCE_DB, std::memory_order_relaxed);
+    statusGainDb.store(0.0f, std::memory_order_relaxed);
+    statusConverged.store(false, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void AutoLevelController::setTarget(const Target& target)
+{
+    requestedMode.store(static_cast<int>(target.mode), std::memory_order_relaxed);
+    requestedLevelDb.store(target.levelDb, std::memory_order_relaxed);
+    requestedToleranceDb.store(juce::jmax(0.05f, target.toleranceDb), std::memory_order_relaxed);
+    requestedTimeConstantMs.store(juce::jmax(MIN_TIME_CONSTANT_MS, target.timeConstantMs), std::memory_order_relaxed);
+    requestSerial.fetch_add(1, std::memory_order_release);
+}
+
+void AutoLevelController::applyPendingTarget()
+{
+    const auto serial = requestSerial.load(std::memory_order_acquire);
+    if (serial == appliedSerial)
+        return;
+
+    appliedSerial = serial;
+
+    const auto previousMode = active.mode;
+    active.mode = static_cast<Mode>(requestedMode.load(std::memory_order_relaxed));
+    active.levelDb = requestedLevelDb.load(std::memory_order_relaxed);
+    active.toleranceDb = requestedToleranceDb.load(std::memory_order_relaxed);
+    active.timeConstantMs = requestedTimeConstantMs.load(std::memory_order_relaxed);
+
+    const double hopMs = 1000.0 * meter.getHopSamples() / sampleRate;
+    hopCoeff = static_cast<float>(1.0 - std::exp(-hopMs / active.timeConstantMs));
+
+    // The meter does not run while off; start from a clean window
+    if (previousMode == Mode::Off && active.mode != Mode::Off)
+        meter.reset();
+
+    tracking = active.mode != Mode::Off;
+
+    statusMode.store(static_cast<int>(active.mode), std::memory_order_relaxed);
+    statusTargetDb.store(active.levelDb, std::memory_order_relaxed);
+    statusConverged.store(false, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void AutoLevelController::process(juce::AudioBuffer<float>& buffer)
+{
+    applyPendingTarget();
+
+    // Fully released: nothing to measure or apply
+    if (active.mode == Mode::Off && currentGain == 1.0f && gainStep == 1.0f)
+        return;
+
+    const int numSamples = buffer.getNumSamples();
+    int start = 0;
+
+    // Split the block at hop boundaries so each control step takes effect
+    // on the exact sample where its measurement window ended
+    while (start < numSamples)
+    {
+        const int count = juce::jmin(numSamples - start, meter.getSamplesUntilHop());
+
+        // Measure this stage's input, before the gain it controls
+        const int hops = meter.process(buffer, start, count);
+
+        applyGain(buffer, start, count);
+
+        if (hops > 0)
+            updateGainTarget();
+
+        start += count;
+    }
+}
+
+void AutoLevelController::applyGain(juce::AudioBuffer<float>& buffer, int start, int numSamples)
+{
+    if (gainStep == 1.0f)
+    {
+        if (currentGain != 1.0f)
+            buffer.applyGain(start, numSamples, currentGain);
+        return;
+    }
+
+    const int numChannels = buffer.getNumChannels();
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    float gain = currentGain;
+
+    for (int i = start; i < start + numSamples; ++i)
+    {
+        gain *= gainStep;
+        for (int channel = 0; channel < numChannels; ++channel)
+            channels[channel][i] *= gain;
+    }
+
+    currentGain = gain;
+}
+
+/**
+ * @brief One control step, run at the end of every hop
+ *
+ * @details The controller is feed-forward on the measured input: output
+ * level = input level + applied gain, so the required gain is known exactly
+ * and the first-order approach toward it cannot overshoot or oscillate,
+ * whatever the window length. Once outside the tolerance band the controller
+ * keeps tracking until the error is a quarter of the tolerance, then holds.
+ */
+void AutoLevelController::updateGainTarget()
+{
+    // Land exactly on the previous hop's target to stop rounding drift
+    const float gainDb = hopTargetGainDb;
+    currentGain = juce::Decibels::decibelsToGain(gainDb, -1000.0f);
+
+    float desiredDb = gainDb;
+    float inputDb = LoudnessMeter::SILENCE_DB;
+    bool converged = false;
+
+    if (active.mode == Mode::Off)
+    {
+        desiredDb = 0.0f;
+    }
+    else
+    {
+        inputDb = active.mode == Mode::Lufs ? meter.getMomentaryLufs() : meter.getMomentaryRmsDb();
+
+        if (meter.hasMomentaryWindow() && inputDb > SILENCE_GATE_DB)
+        {
+            const float errorDb = active.levelDb - (inputDb + gainDb);
+
+            if (std::abs(errorDb) > active.toleranceDb)
+                tracking = true;
+            else if (std::abs(errorDb) < active.toleranceDb * 0.25f)
+                tracking = false;
+
+            if (tracking)
+                desiredDb = juce::jlimit(-MAX_GAIN_DB, MAX_GAIN_DB, active.levelDb - inputDb);
+
+            converged = std::abs(errorDb) <= active.toleranceDb;
+        }
+    }
+
+    float nextDb = gainDb + (desiredDb - gainDb) * hopCoeff;
+    if (std::abs(desiredDb - nextDb) < 0.001f)
+        nextDb = desiredDb;
+
+    const float nextGain = juce::Decibels::decibelsToGain(nextDb, -1000.0f);
+    gainStep = nextDb == gainDb ? 1.0f
+                                : std::pow(nextGain / currentGain, 1.0f / static_cast<float>(meter.getHopSamples()));
+    hopTargetGainDb = nextDb;
+
+    // Back at unity with nothing to do: stop ramping so process() can bypass
+    if (active.mode == Mode::Off && nextDb == 0.0f)
+    {
+        currentGain = 1.0f;
+        gainStep = 1.0f;
+    }
+
+    statusMeasuredDb.store(inputDb <= LoudnessMeter::SILENCE_DB ? LoudnessMeter::SILENCE_DB : inputDb + gainDb,
+                           std::memory_order_relaxed);
+    statusGainDb.store(gainDb, std::memory_order_relaxed);
+    statusConverged.store(converged, std::memory_order_relaxed);
+}
+
+//==============================================================================
+AutoLevelController::Status AutoLevelController::getStatus() const
+{
+    Status status;
+    status.mode = static_cast<Mode>(statusMode.load(std::memory_order_relaxed));
+    status.targetDb = statusTargetDb.load(std::memory_order_relaxed);
+    status.measuredDb = statusMeasuredDb.load(std::memory_order_relaxed);
+    status.gainDb = statusGainDb.load(std::memory_order_relaxed);
+    status.errorDb = status.mode == Mode::Off ? 0.0f : status.targetDb - status.measuredDb;
+    status.converged = statusConverged.load(std::memory_order_relaxed);
+    return status;
+}
+
+AutoLevelController::Mode AutoLevelController::modeFromString(const juce::String& text)
+{
+    if (text.equalsIgnoreCase("lufs"))
+        return Mode::Lufs;
+
+    if (text.equalsIgnoreCase("rms"))
+        return Mode::Rms;
+
+    return Mode::Off;
+}
+
+juce::String AutoLevelController::modeToString(Mode mode)
+{
+    switch (mode)
+    {
+        case Mode::Lufs: return "lufs";
+        case Mode::Rms:  return "rms";
+        case Mode::Off:  break;
+    }
+
+    return "off";
+}
+
+} // namespace AIplayer
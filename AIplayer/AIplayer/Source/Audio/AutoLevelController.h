@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    AutoLevelController.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    In-plugin gain matching to a target loudness or RMS level.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include "LoudnessMeter.h"
+#include <atomic>
+
+namespace AIplayer {
+
+/**
+ * @class AutoLevelController
+ * @brief Levels a track to a target on the audio thread
+ *
+ * Replaces the remote loop where ChattyChannels polled /aiplayer/query_rms
+ * and sent GAIN corrections over UDP. The agent now sends one target and the
+ * loop runs entirely in the plugin:
+ *
+ * - The input to this stage is measured by a LoudnessMeter (momentary window,
+ *   K-weighted for LUFS or unweighted for RMS)
+ * - Every 10 ms hop the required gain (target - measured input) is computed
+ *   and the applied gain moves toward it with the requested time constant
+ * - Between hops the gain is ramped geometrically per sample, so the change
+ *   is sample-accurate and free of steps
+ * - Inside the tolerance band the gain is held, which avoids pumping on
+ *   program material; below the absolute silence gate it is also held, so
+ *   pauses are never boosted
+ *
+ * setTarget() may be called from any thread; process() runs on the audio
+ * thread and never allocates. getStatus() is lock-free for telemetry.
+ */
+class AutoLevelController
+{
+public:
+    /**
+     * @brief What the target level refers to
+     */
+    enum class Mode
+    {
+        Off = 0,    ///< Stage is bypassed (unity gain)
+        Lufs,       ///< Momentary K-weighted loudness
+        Rms         ///< Momentary unweighted RMS
+    };
+
+    /**
+     * @struct Target
+     * @brief Leveling request from the agent
+     */
+    struct Target
+    {
+        Mode mode{Mode::Off};
+        float levelDb{-18.0f};          ///< Target in LUFS or dBFS RMS
+        float toleranceDb{0.5f};        ///< Converged when within this distance
+        float timeConstantMs{500.0f};   ///< Time to close ~63% of the error
+    };
+
+    /**
+     * @struct Status
+     * @brief Snapshot reported through telemetry
+     */
+    struct Status
+    {
+        Mode mode{Mode::Off};
+        float targetDb{0.0f};
+        float measuredDb{LoudnessMeter::SILENCE_DB};   ///< Estimated output level
+        float gainDb{0.0f};                            ///< Gain currently applied
+        float errorDb{0.0f};                           ///< target - measured
+        bool converged{false};
+    };
+
+    /// Range of gain the controller may apply
+    static constexpr float MAX_GAIN_DB = 24.0f;
+
+    /// Inputs below this level do not move the gain
+    static constexpr float SILENCE_GATE_DB = -70.0f;
+
+    /// Shortest accepted time constant
+    static constexpr float MIN_TIME_CONSTANT_MS = 50.0f;
+
+    /**
+     * @brief Constructor
+     */
+    AutoLevelController() = default;
+
+    /**
+     * @brief Allocates measurement state
+     *
+     * @param sampleRate Processing sample rate
+     * @param maxBlockSize Largest block passed to process()
+     * @param numChannels Number of channels
+     */
+    void prepare(double sampleRate, int maxBlockSize, int numChannels);
+
+    /**
+     * @brief Clears measurement state and returns to unity gain
+     */
+    void reset();
+
+    /**
+     * @brief Sets BS.1770 channel weights for LUFS mode (call while not processing)
+     *
+     * @param weights One weight per channel (see ChannelLayout::loudnessWeights)
+     * @param numChannels Number of weights
+     */
+    void setChannelWeights(const float* weights, int numChannels) { meter.setChannelWeights(weights, numChannels); }
+
+    /**
+     * @brief Sets a new target (any thread)
+     *
+     * @param target The leveling request; Mode::Off releases the gain to unity
+     */
+    void setTarget(const Target& target);
+
+    /**
+     * @brief Measures and levels a block in place (audio thread)
+     *
+     * @param buffer Audio to process
+     */
+    void process(juce::AudioBuffer<float>& buffer);
+
+    /**
+     * @brief Current state for telemetry (any thread)
+     */
+    Status getStatus() const;
+
+    /// Whether a target is active
+    bool isActive() const { return static_cast<Mode>(requestedMode.load(std::memory_order_relaxed)) != Mode::Off; }
+
+    /// Parses "lufs", "rms" or "off" (case-insensitive); anything else is Off
+    static Mode modeFromString(const juce::String& text);
+
+    /// Lower-case name of a mode
+    static juce::String modeToString(Mode mode);
+
+private:
+    /// Pulls a new target into the audio thread if one was published
+    void applyPendingTarget();
+
+    /// Per-hop control step
+    void updateGainTarget();
+
+    /// Applies the geometric ramp to a run of samples
+    void applyGain(juce::AudioBuffer<float>& buffer, int start, int numSamples);
+
+    LoudnessMeter meter;
+    double sampleRate{44100.0};
+
+    // Target published by setTarget()
+    std::atomic<int> requestedMode{0};
+    std::atomic<float> requestedLevelDb{-18.0f};
+    std::atomic<float> requestedToleranceDb{0.5f};
+    std::atomic<float> requestedTimeConstantMs{500.0f};
+    std::atomic<juce::uint32> requestSerial{0};
+
+    // Audio thread state
+    juce::uint32 appliedSerial{0};
+    Target active;
+    float hopCoeff{0.0f};              ///< Fraction of error closed per hop
+    float currentGain{1.0f};           ///< Linear gain at the current sample
+    float gainStep{1.0f};              ///< Per-sample multiplier for this hop
+    float hopTargetGainDb{0.0f};
+    bool tracking{false};              ///< Moving toward the target (hysteresis)
+
+    // Published status
+    std::atomic<int> statusMode{0};
+    std::atomic<float> statusTargetDb{0.0f};
+    std::atomic<float> statusMeasuredDb{LoudnessMeter::SILENCE_DB};
+    std::atomic<float> statusGainDb{0.0f};
+    std::atomic<bool> statusConverged{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AutoLevelController)
+};
+
+} // namespace AIplayer
@@ -46,9 +46,11 @@ BandEnergyAnalyzer::BandEnergyAnalyzer(const float* customBandLimits)
  * 
  * @details This method implements frequency band energy analysis:
  * 1. Maps frequency bands to FFT bin ranges using binWidth
- * 2. Accumulates energy within each band (magnitude squared)
+ * 2. Accumulates energy within each band (magnitude squared), weighting the
+ *    bins at the edges by the fraction of their width inside the band
  * 3. Applies optional A-weighting for perceptual accuracy
- * 4. Averages energy across bins to prevent bias toward wider bands
+ * 4. Divides by the window's noise bandwidth, turning summed bin energies
+ *    into the power of the signal in the band
  * 5. Stores both linear and dB values for different use cases
  * 
  * The analysis uses 4 mixing-relevant frequency bands:
@@ -61,9 +63,11 @@ BandEnergyAnalyzer::BandEnergyAnalyzer(const float* customBandLimits)
  * @param numBins Number of frequency bins in the spectrum
  * @param binWidth Frequency resolution per bin (Hz/bin)
  * @param sampleRate Current sample rate (used for validation)
+ * @param noiseBandwidth Equivalent noise bandwidth of the window (bins)
  * 
  * @note Energy calculation uses magnitude squared (power), not magnitude directly.
- *       Bin averaging prevents bands with more frequency bins from appearing louder.
+ *       Bands are totals, so broadband signals read higher in wider bands;
+ *       a sine reads the same in any band that contains it.
  *       A-weighting follows ISO 226:2003 perceptual loudness curves when enabled.
  * 
  * @warning Input validation ensures magnitudeSpectrum is non-null and parameters are valid.
@@ -75,32 +79,36 @@ BandEnergyAnalyzer::BandEnergyAnalyzer(const float* customBandLimits)
 void BandEnergyAnalyzer::analyzeBands(const float* magnitudeSpectrum, 
                                      int numBins, 
                                      float binWidth,
-                                     double sampleRate)
+                                     double sampleRate,
+                                     float noiseBandwidth)
 {
     // Validate input parameters
-    if (magnitudeSpectrum == nullptr || numBins <= 0 || binWidth <= 0.0f)
+    if (magnitudeSpectrum == nullptr || numBins <= 0 || binWidth <= 0.0f || noiseBandwidth <= 0.0f)
         return;
     
     // Analyze energy for each of the 4 frequency bands
     for (int band = 0; band < NUM_BANDS; ++band)
     {
-        const float lowFreq = bandLimits[band];
-        const float highFreq = bandLimits[band + 1];
+        // Band edges in bins; bin k covers k - 0.5 to k + 0.5
+        const float lowEdge = bandLimits[band] / binWidth;
+        const float highEdge = bandLimits[band + 1] / binWidth;
         
-        // Map frequency range to FFT bin indices
-        int startBin = static_cast<int>(lowFreq / binWidth);
-        int endBin = static_cast<int>(highFreq / binWidth);
-        
-        // Clamp bin indices to valid spectrum range
-        startBin = juce::jlimit(0, numBins - 1, startBin);
-        endBin = juce::jlimit(0, numBins - 1, endBin);
+        // Map frequency range to the FFT bins it touches
+        const int startBin = juce::jlimit(0, numBins - 1, static_cast<int>(std::floor(lowEdge + 0.5f)));
+        const int endBin = juce::jlimit(0, numBins - 1, static_cast<int>(std::floor(highEdge + 0.5f)));
         
         // Accumulate energy across all bins in this frequency band
         float bandEnergy = 0.0f;
-        int binCount = 0;
         
         for (int bin = startBin; bin <= endBin; ++bin)
         {
+            // Share of the bin inside the band (1 except at the edges)
+            const float binCentre = static_cast<float>(bin);
+            const float weight = juce::jmin(binCentre + 0.5f, highEdge) - juce::jmax(binCentre - 0.5f, lowEdge);
+            
+            if (weight <= 0.0f)
+                continue;
+            
             float magnitude = magnitudeSpectrum[bin];
             
             // Apply A-weighting for perceptual accuracy if enabled
@@ -111,16 +119,11 @@ void BandEnergyAnalyzer::analyzeBands(const float* magnitudeSpectrum,
             }
             
             // Accumulate power (energy = magnitude²) not magnitude
-            bandEnergy += magnitude * magnitude;
-            binCount++;
+            bandEnergy += juce::jmin(weight, 1.0f) * magnitude * magnitude;
         }
         
-        // Average energy across bins to prevent bias toward bands with more bins
-        // (High frequency bands naturally have more bins due to linear spacing)
-        if (binCount > 0)
-        {
-            bandEnergy /= static_cast<float>(binCount);
-        }
+        // Each bin holds the energy of ENBW bins' worth of spectrum
+        bandEnergy /= noiseBandwidth;
         
         // Store linear energy value (for mathematical operations)
         bandEnergiesLinear[band].store(bandEnergy);
@@ -27,6 +27,13 @@ namespace AIplayer {
  * - Band 2 (Low-Mid):  250 Hz - 2 kHz    (vocals, snare, keys)
  * - Band 3 (High-Mid): 2 kHz - 8 kHz     (presence, clarity)
  * - Band 4 (High):     8 kHz - 20 kHz    (air, cymbals)
+ * 
+ * Each FFT bin stands for the frequencies within half a bin of its
+ * centre; a bin straddling a band edge counts in both bands in proportion,
+ * so adjacent bands share it rather than both taking all of it. Band
+ * energies are the power in the band, sine-referenced: with the magnitudes
+ * and noise bandwidth of FFTProcessor, a sine in the band reads its level
+ * in dBFS wherever it falls between bins.
  */
 class BandEnergyAnalyzer
 {
@@ -55,11 +62,16 @@ public:
      * @param numBins Number of frequency bins
      * @param binWidth Frequency width per bin (Hz)
      * @param sampleRate Current sample rate
+     * @param noiseBandwidth Equivalent noise bandwidth of the analysis
+     *                       window in bins (FFTProcessor::getNoiseBandwidth();
+     *                       1 for a rectangular window). No default, so no
+     *                       caller can leave the window uncorrected.
      */
     void analyzeBands(const float* magnitudeSpectrum, 
                      int numBins, 
                      float binWidth,
-                     double sampleRate);
+                     double sampleRate,
+                     float noiseBandwidth);
     
     /**
      * @brief Get energy level for a specific band
@@ -0,0 +1,258 @@
+/*
+  ==============================================================================
+
+    BeatTracker.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the streaming beat tracker.
+
+  ==============================================================================
+*/
+
+#include "BeatTracker.h"
+
+namespace AIplayer {
+
+namespace {
+    /// Log compression of the band energies: log(1 + C * meanSquare)
+    constexpr double ENERGY_COMPRESSION = 1000.0;
+
+    /// Time constant of the envelope mean that is removed
+    constexpr double MEAN_TIME_CONSTANT = 1.0;
+
+    static_assert((BeatTracker::HISTORY_SIZE & (BeatTracker::HISTORY_SIZE - 1)) == 0,
+                  "the onset ring is indexed with a mask");
+}
+
+//==============================================================================
+void BeatTracker::prepare(double sampleRate)
+{
+    scheduler.prepare(sampleRate);
+    hopSeconds = scheduler.getHopSamples() / sampleRate;
+
+    lowCoefficient = static_cast<float>(1.0 - std::exp(-juce::MathConstants<double>::twoPi * SPLIT_FREQUENCY / sampleRate));
+    meanCoefficient = static_cast<float>(1.0 - std::exp(-hopSeconds / MEAN_TIME_CONSTANT));
+    acfDecay = static_cast<float>(std::exp(-hopSeconds / TEMPO_TIME_CONSTANT));
+    resonatorDecay = std::exp(-hopSeconds / PHASE_TIME_CONSTANT);
+
+    // Lags scored, with room for the double lag (and its neighbour) in the autocorrelation
+    minLag = juce::jmax(2, static_cast<int>(std::floor(60.0 / (MAX_BPM * hopSeconds))));
+    maxLag = juce::jmin(ACF_SIZE / 2 - 2, static_cast<int>(std::ceil(60.0 / (MIN_BPM * hopSeconds))));
+
+    for (int lag = 1; lag < ACF_SIZE; ++lag)
+    {
+        const double octaves = std::log2(60.0 / (lag * hopSeconds) / PRIOR_BPM) / PRIOR_OCTAVES;
+        prior[static_cast<size_t>(lag)] = static_cast<float>(std::exp(-0.5 * octaves * octaves));
+    }
+
+    prepared = true;
+    reset();
+}
+
+void BeatTracker::reset()
+{
+    scheduler.reset();
+
+    lowState = 0.0f;
+    lowSum = 0.0;
+    highSum = 0.0;
+    previousLow = 0.0f;
+    previousHigh = 0.0f;
+    onsetMean = 0.0f;
+
+    onsets.fill(0.0f);
+    onsetIndex = 0;
+    acf.fill(0.0f);
+    hopsSinceTempo = 0;
+    hopsAnalysed = 0;
+
+    period = 60.0 / (PRIOR_BPM * hopSeconds);
+    oscillatorPhase = 0.0;
+    resonatorRe = 0.0;
+    resonatorIm = 0.0;
+    estimateConfidence = 0.0f;
+    estimateReady = false;
+
+    publishedSource.store(static_cast<int>(Source::None));
+    publishedBpm.store(0.0f);
+    publishedPhase.store(0.0f);
+    publishedConfidence.store(0.0f);
+    lastOnset.store(0.0f);
+}
+
+juce::String BeatTracker::sourceToString(Source source)
+{
+    switch (source)
+    {
+        case Source::Audio: return "audio";
+        case Source::Host:  return "host";
+        case Source::None:  break;
+    }
+
+    return "none";
+}
+
+//==============================================================================
+void BeatTracker::setHostTransport(double bpm, double ppqPosition, bool isPlaying)
+{
+    hostBpm = bpm;
+    hostPpq = ppqPosition;
+    hostPlaying = isPlaying;
+}
+
+void BeatTracker::process(const juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    if (!prepared || numChannels == 0)
+        return;
+
+    const auto* const* channels = buffer.getArrayOfReadPointers();
+    const float channelGain = 1.0f / static_cast<float>(numChannels);
+
+    scheduler.process(buffer.getNumSamples(),
+        [&](int start, int count)
+        {
+            for (int i = start; i < start + count; ++i)
+            {
+                float sample = 0.0f;
+                for (int channel = 0; channel < numChannels; ++channel)
+                    sample += channels[channel][i];
+                sample *= channelGain;
+
+                lowState += lowCoefficient * (sample - lowState);
+                const float high = sample - lowState;
+
+                lowSum += static_cast<double>(lowState) * lowState;
+                highSum += static_cast<double>(high) * high;
+            }
+        },
+        [this](juce::int64)
+        {
+            processHop();
+        });
+
+    if (hostPlaying && hostBpm > 0.0)
+    {
+        publishedSource.store(static_cast<int>(Source::Host));
+        publishedBpm.store(static_cast<float>(hostBpm));
+        publishedPhase.store(static_cast<float>(hostPpq - std::floor(hostPpq)));
+        publishedConfidence.store(1.0f);
+    }
+}
+
+void BeatTracker::processHop()
+{
+    // Band-wise energy flux, log-compressed, with its running mean removed
+    const int hopSamples = scheduler.getHopSamples();
+    const auto low = static_cast<float>(std::log1p(ENERGY_COMPRESSION * lowSum / hopSamples));
+    const auto high = static_cast<float>(std::log1p(ENERGY_COMPRESSION * highSum / hopSamples));
+    lowSum = 0.0;
+    highSum = 0.0;
+
+    const float flux = juce::jmax(0.0f, low - previousLow) + juce::jmax(0.0f, high - previousHigh);
+    previousLow = low;
+    previousHigh = high;
+
+    onsetMean += meanCoefficient * (flux - onsetMean);
+    const float onset = flux - onsetMean;
+    lastOnset.store(onset, std::memory_order_relaxed);
+
+    // Leaky autocorrelation: one multiply-add per lag
+    onsetIndex = (onsetIndex + 1) & (HISTORY_SIZE - 1);
+    onsets[static_cast<size_t>(onsetIndex)] = onset;
+
+    for (int lag = 0; lag < ACF_SIZE; ++lag)
+    {
+        auto& value = acf[static_cast<size_t>(lag)];
+        value = acfDecay * value + onset * onsets[static_cast<size_t>((onsetIndex - lag) & (HISTORY_SIZE - 1))];
+    }
+
+    ++hopsAnalysed;
+
+    if (++hopsSinceTempo >= TEMPO_UPDATE_HOPS)
+    {
+        hopsSinceTempo = 0;
+        updateTempo();
+    }
+
+    // Resonator at the beat rate: its angle is where the onsets fall in the cycle
+    oscillatorPhase += juce::MathConstants<double>::twoPi / period;
+    if (oscillatorPhase >= juce::MathConstants<double>::twoPi)
+        oscillatorPhase -= juce::MathConstants<double>::twoPi;
+
+    resonatorRe = resonatorDecay * resonatorRe + onset * std::cos(oscillatorPhase);
+    resonatorIm = resonatorDecay * resonatorIm - onset * std::sin(oscillatorPhase);
+
+    if (!estimateReady || (hostPlaying && hostBpm > 0.0))
+        return;
+
+    // An onset is registered at the end of its hop, on average half a hop late
+    const double cycles = (oscillatorPhase + std::atan2(resonatorIm, resonatorRe)) / juce::MathConstants<double>::twoPi
+                        + 0.5 / period;
+
+    publishedSource.store(static_cast<int>(Source::Audio));
+    publishedBpm.store(static_cast<float>(60.0 / (period * hopSeconds)));
+    publishedPhase.store(static_cast<float>(cycles - std::floor(cycles)));
+    publishedConfidence.store(estimateConfidence);
+}
+
+void BeatTracker::updateTempo()
+{
+    const float energy = acf[0];
+    if (energy <= 0.0f)
+        return;
+
+    // The lag plus half its double (metrical support), weighted by the prior
+    auto score = [this](int lag)
+    {
+        return (acf[static_cast<size_t>(lag)] + 0.5f * acf[static_cast<size_t>(2 * lag)]) * prior[static_cast<size_t>(lag)];
+    };
+
+    int best = -1;
+    float bestScore = 0.0f;
+
+    for (int lag = minLag; lag <= maxLag; ++lag)
+    {
+        const float value = score(lag);
+        if (value > bestScore)
+        {
+            best = lag;
+            bestScore = value;
+        }
+    }
+
+    if (best < 0)
+    {
+        estimateConfidence = 0.0f;
+        return;
+    }
+
+    double shift = 0.0;
+    if (best > minLag && best < maxLag)
+    {
+        const float a = score(best - 1);
+        const float c = score(best + 1);
+        const float denominator = a - 2.0f * bestScore + c;
+
+        if (denominator < 0.0f)
+            shift = juce::jlimit(-0.5, 0.5, 0.5 * (a - c) / denominator);
+    }
+
+    period = best + shift;
+    estimateConfidence = juce::jlimit(0.0f, 1.0f, acf[static_cast<size_t>(best)] / energy);
+    estimateReady = hopsAnalysed * hopSeconds >= WARMUP_SECONDS;
+}
+
+//==============================================================================
+BeatTracker::Status BeatTracker::getStatus() const
+{
+    Status status;
+    status.source = static_cast<Source>(publishedSource.load());
+    status.bpm = publishedBpm.load();
+    status.phase = publishedPhase.load();
+    status.confidence = publishedConfidence.load();
+    return status;
+}
+
+} // namespace AIplayer
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    BeatTracker.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Streaming tempo and beat-phase estimation from an onset envelope.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "HopScheduler.h"
+#include <array>
+#include <atomic>
+
+namespace AIplayer {
+
+/**
+ * @class BeatTracker
+ * @brief Tempo and beat phase of the analysed signal, for when no host transport is running
+ *
+ * Runs on the audio thread on the 10 ms hop grid (HopScheduler):
+ * - Onset envelope: per hop, the mean-square energy below and above
+ *   SPLIT_FREQUENCY is log-compressed and the positive changes of both
+ *   bands are summed (band-wise energy flux), then its running mean is
+ *   removed
+ * - Tempo: a leaky autocorrelation of the envelope, updated with one
+ *   multiply-add per lag every hop (TEMPO_TIME_CONSTANT memory, fixed ring
+ *   of HISTORY_SIZE hops). Every TEMPO_UPDATE_HOPS hops the lag range
+ *   MIN_BPM-MAX_BPM is scored (lag plus half its double, weighted by a
+ *   log-Gaussian prior around PRIOR_BPM to settle octave ambiguity) and the
+ *   best lag is refined by parabolic interpolation
+ * - Phase: a resonator at the tracked beat rate (PHASE_TIME_CONSTANT
+ *   memory) gives where the onsets fall in the beat cycle
+ *
+ * The cost per hop is constant (a fixed number of lags), so per second of
+ * audio it does not depend on the block size or the history length. All
+ * state is fixed-size; nothing allocates after construction.
+ *
+ * While the host transport is playing its tempo and position take over,
+ * so the controller gets one tempo stream whichever source is available.
+ * Results are published lock-free for the telemetry thread.
+ */
+class BeatTracker
+{
+public:
+    BeatTracker() = default;
+
+    /// Tempo range searched
+    static constexpr float MIN_BPM = 60.0f;
+    static constexpr float MAX_BPM = 200.0f;
+
+    /// Centre and width (octaves) of the tempo prior
+    static constexpr float PRIOR_BPM = 120.0f;
+    static constexpr float PRIOR_OCTAVES = 1.0f;
+
+    /// Memory of the autocorrelation and of the phase resonator
+    static constexpr double TEMPO_TIME_CONSTANT = 8.0;
+    static constexpr double PHASE_TIME_CONSTANT = 3.0;
+
+    /// Onset envelope kept for the autocorrelation (hops)
+    static constexpr int HISTORY_SIZE = 256;
+
+    /// Hops between tempo decisions
+    static constexpr int TEMPO_UPDATE_HOPS = 10;
+
+    /// Audio needed before a tempo is reported
+    static constexpr double WARMUP_SECONDS = 3.0;
+
+    /// Low/high band split of the onset envelope
+    static constexpr float SPLIT_FREQUENCY = 150.0f;
+
+    /// Where the reported tempo comes from
+    enum class Source
+    {
+        None,       ///< Not enough audio yet
+        Audio,      ///< Estimated from the signal
+        Host        ///< Host transport (playing)
+    };
+
+    /// Snapshot for telemetry
+    struct Status
+    {
+        Source source{Source::None};
+        float bpm{0.0f};
+        float phase{0.0f};          ///< Position within the beat, 0 at the beat to 1
+        float confidence{0.0f};     ///< Normalised autocorrelation at the beat period, 0-1
+    };
+
+    /**
+     * @brief Prepares for playback and clears the history
+     * @param sampleRate Processing sample rate
+     */
+    void prepare(double sampleRate);
+
+    /// Clears the history (audio thread, or while stopped)
+    void reset();
+
+    /**
+     * @brief Analyses a block (audio thread)
+     * @param buffer Audio to analyse; channels are averaged
+     */
+    void process(const juce::AudioBuffer<float>& buffer);
+
+    /**
+     * @brief Passes the host transport (audio thread, once per block)
+     *
+     * @param bpm Host tempo (0 if unknown)
+     * @param ppqPosition Position in quarter notes at the start of the block
+     * @param isPlaying Whether the transport is running; a stopped
+     *                  transport leaves the estimate in charge
+     */
+    void setHostTransport(double bpm, double ppqPosition, bool isPlaying);
+
+    /// Latest tempo and phase (any thread)
+    Status getStatus() const;
+
+    /// Onset envelope value of the latest hop, mean removed (any thread)
+    float getLastOnset() const { return lastOnset.load(std::memory_order_relaxed); }
+
+    /// Converts a source to its OSC name ("none", "audio", "host")
+    static juce::String sourceToString(Source source);
+
+private:
+    static constexpr int ACF_SIZE = HISTORY_SIZE;
+
+    void processHop();
+    void updateTempo();
+
+    bool prepared{false};
+    double hopSeconds{HopScheduler::DEFAULT_HOP_SECONDS};
+    HopScheduler scheduler;
+
+    // Onset envelope (audio thread)
+    float lowCoefficient{0.0f};
+    float lowState{0.0f};
+    double lowSum{0.0};
+    double highSum{0.0};
+    float previousLow{0.0f};
+    float previousHigh{0.0f};
+    float onsetMean{0.0f};
+    float meanCoefficient{0.0f};
+
+    // Autocorrelation over the envelope ring (audio thread)
+    std::array<float, HISTORY_SIZE> onsets{};
+    int onsetIndex{0};
+    std::array<float, ACF_SIZE> acf{};
+    std::array<float, ACF_SIZE> prior{};    // Tempo prior per lag
+    float acfDecay{1.0f};
+    int minLag{30};
+    int maxLag{100};
+    int hopsSinceTempo{0};
+    juce::int64 hopsAnalysed{0};
+
+    // Beat-rate resonator (audio thread)
+    double period{50.0};            // Hops per beat
+    double oscillatorPhase{0.0};
+    double resonatorRe{0.0};
+    double resonatorIm{0.0};
+    double resonatorDecay{1.0};
+    float estimateConfidence{0.0f};
+    bool estimateReady{false};
+
+    // Host transport (audio thread)
+    double hostBpm{0.0};
+    double hostPpq{0.0};
+    bool hostPlaying{false};
+
+    // Published results
+    std::atomic<int> publishedSource{0};
+    std::atomic<float> publishedBpm{0.0f};
+    std::atomic<float> publishedPhase{0.0f};
+    std::atomic<float> publishedConfidence{0.0f};
+    std::atomic<float> lastOnset{0.0f};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BeatTracker)
+};
+
+} // namespace AIplayer
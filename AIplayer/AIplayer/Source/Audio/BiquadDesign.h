@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    BiquadDesign.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Biquad coefficient design (RBJ Audio EQ Cookbook).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <cmath>
+
+namespace AIplayer {
+
+/**
+ * @struct BiquadCoefficients
+ * @brief Normalised second-order section coefficients (a0 == 1)
+ *
+ * Transfer function: H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+ */
+struct BiquadCoefficients
+{
+    float b0{1.0f}, b1{0.0f}, b2{0.0f};
+    float a1{0.0f}, a2{0.0f};
+
+    bool operator==(const BiquadCoefficients& other) const
+    {
+        return b0 == other.b0 && b1 == other.b1 && b2 == other.b2 && a1 == other.a1 && a2 == other.a2;
+    }
+
+    bool operator!=(const BiquadCoefficients& other) const { return !(*this == other); }
+};
+
+/**
+ * @namespace BiquadDesign
+ * @brief Coefficient calculators for the filter shapes used by the plugin
+ *
+ * Computed in double precision and rounded to float once. Frequencies are
+ * clamped below Nyquist so agent-supplied values can never produce an
+ * unstable section.
+ */
+namespace BiquadDesign {
+
+    /// Butterworth Q for a single second-order section
+    constexpr double BUTTERWORTH_Q = 0.7071067811865476;
+
+    namespace detail {
+        inline double clampFrequency(double sampleRate, double frequency)
+        {
+            return juce::jlimit(1.0, sampleRate * 0.49, frequency);
+        }
+
+        inline BiquadCoefficients normalise(double b0, double b1, double b2, double a0, double a1, double a2)
+        {
+            const double inv = 1.0 / a0;
+            return { static_cast<float>(b0 * inv), static_cast<float>(b1 * inv), static_cast<float>(b2 * inv),
+                     static_cast<float>(a1 * inv), static_cast<float>(a2 * inv) };
+        }
+    }
+
+    /// Pass-through section
+    inline BiquadCoefficients identity() { return {}; }
+
+    /// 12 dB/octave high-pass
+    inline BiquadCoefficients highPass(double sampleRate, double frequency, double q = BUTTERWORTH_Q)
+    {
+        const double w0 = juce::MathConstants<double>::twoPi * detail::clampFrequency(sampleRate, frequency) / sampleRate;
+        const double cosW0 = std::cos(w0);
+        const double alpha = std::sin(w0) / (2.0 * q);
+
+        return detail::normalise((1.0 + cosW0) * 0.5, -(1.0 + cosW0), (1.0 + cosW0) * 0.5,
+                                 1.0 + alpha, -2.0 * cosW0, 1.0 - alpha);
+    }
+
+    /// 12 dB/octave low-pass
+    inline BiquadCoefficients lowPass(double sampleRate, double frequency, double q = BUTTERWORTH_Q)
+    {
+        const double w0 = juce::MathConstants<double>::twoPi * detail::clampFrequency(sampleRate, frequency) / sampleRate;
+        const double cosW0 = std::cos(w0);
+        const double alpha = std::sin(w0) / (2.0 * q);
+
+        return detail::normalise((1.0 - cosW0) * 0.5, 1.0 - cosW0, (1.0 - cosW0) * 0.5,
+                                 1.0 + alpha, -2.0 * cosW0, 1.0 - alpha);
+    }
+
+    /// Peaking (bell) EQ
+    inline BiquadCoefficients peak(double sampleRate, double frequency, double q, double gainDb)
+    {
+        const double a = std::pow(10.0, gainDb / 40.0);
+        const double w0 = juce::MathConstants<double>::twoPi * detail::clampFrequency(sampleRate, frequency) / sampleRate;
+        const double cosW0 = std::cos(w0);
+        const double alpha = std::sin(w0) / (2.0 * juce::jmax(0.01, q));
+
+        return detail::normalise(1.0 + alpha * a, -2.0 * cosW0, 1.0 - alpha * a,
+                                 1.0 + alpha / a, -2.0 * cosW0, 1.0 - alpha / a);
+    }
+
+    /// Low shelf (q = BUTTERWORTH_Q gives the cookbook's shelf slope S = 1)
+    inline BiquadCoefficients lowShelf(double sampleRate, double frequency, double gainDb, double q = BUTTERWORTH_Q)
+    {
+        const double a = std::pow(10.0, gainDb / 40.0);
+        const double w0 = juce::MathConstants<double>::twoPi * detail::clampFrequency(sampleRate, frequency) / sampleRate;
+        const double cosW0 = std::cos(w0);
+        const double alpha = std::sin(w0) / (2.0 * q);
+        const double sqrtA2alpha = 2.0 * std::sqrt(a) * alpha;
+
+        return detail::normalise(a * ((a + 1.0) - (a - 1.0) * cosW0 + sqrtA2alpha),
+                                 2.0 * a * ((a - 1.0) - (a + 1.0) * cosW0),
+                                 a * ((a + 1.0) - (a - 1.0) * cosW0 - sqrtA2alpha),
+                                 (a + 1.0) + (a - 1.0) * cosW0 + sqrtA2alpha,
+                                 -2.0 * ((a - 1.0) + (a + 1.0) * cosW0),
+                                 (a + 1.0) + (a - 1.0) * cosW0 - sqrtA2alpha);
+    }
+
+    /// High shelf (q = BUTTERWORTH_Q gives the cookbook's shelf slope S = 1)
+    inline BiquadCoefficients highShelf(double sampleRate, double frequency, double gainDb, double q = BUTTERWORTH_Q)
+    {
+        const double a = std::pow(10.0, gainDb / 40.0);
+        const double w0 = juce::MathConstants<double>::twoPi * detail::clampFrequency(sampleRate, frequency) / sampleRate;
+        const double cosW0 = std::cos(w0);
+        const double alpha = std::sin(w0) / (2.0 * q);
+        const double sqrtA2alpha = 2.0 * std::sqrt(a) * alpha;
+
+        return detail::normalise(a * ((a + 1.0) + (a - 1.0) * cosW0 + sqrtA2alpha),
+                                 -2.0 * a * ((a - 1.0) + (a + 1.0) * cosW0),
+                                 a * ((a + 1.0) + (a - 1.0) * cosW0 - sqrtA2alpha),
+                                 (a + 1.0) - (a - 1.0) * cosW0 + sqrtA2alpha,
+                                 2.0 * ((a - 1.0) - (a + 1.0) * cosW0),
+                                 (a + 1.0) - (a - 1.0) * cosW0 - sqrtA2alpha);
+    }
+
+} // namespace BiquadDesign
+} // namespace AIplayer
@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+    BiquadEngine.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the shared biquad cascade.
+
+  ==============================================================================
+*/
+
+#include "BiquadEngine.h"
+#include <cmath>
+
+namespace AIplayer {
+
+namespace {
+    constexpr float DENORMAL_THRESHOLD = 1.0e-15f;
+
+    void snapToZero(BiquadEngine::Vec& v)
+    {
+        for (size_t lane = 0; lane < BiquadEngine::Vec::size(); ++lane)
+            if (std::abs(v.get(lane)) < DENORMAL_THRESHOLD)
+                v.set(lane, 0.0f);
+    }
+}
+
+//==============================================================================
+void BiquadEngine::prepare(int newNumChannels, int newMaxSections, int newMaxBlockSize)
+{
+    numChannels = juce::jmax(0, newNumChannels);
+    numGroups = (numChannels + LANES - 1) / LANES;
+    maxSections = juce::jmax(0, newMaxSections);
+    maxBlockSize = juce::jmax(1, newMaxBlockSize);
+    numActiveSections = juce::jmin(numActiveSections, maxSections);
+
+    sections.assign(static_cast<size_t>(maxSections), {});
+    for (auto& section : sections)
+        setCurrent(section, BiquadDesign::identity());
+
+    states.assign(static_cast<size_t>(numGroups * maxSections), {});
+    scratch.assign(static_cast<size_t>(maxBlockSize), Vec::expand(0.0f));
+
+    reset();
+}
+
+void BiquadEngine::reset()
+{
+    for (auto& state : states)
+        state.s1 = state.s2 = Vec::expand(0.0f);
+}
+
+void BiquadEngine::setNumSections(int numSections)
+{
+    numSections = juce::jlimit(0, maxSections, numSections);
+
+    for (int group = 0; group < numGroups; ++group)
+        for (int section = numActiveSections; section < numSections; ++section)
+        {
+            auto& state = states[static_cast<size_t>(group * maxSections + section)];
+            state.s1 = state.s2 = Vec::expand(0.0f);
+        }
+
+    numActiveSections = numSections;
+}
+
+void BiquadEngine::setCurrent(Section& section, const BiquadCoefficients& c)
+{
+    section.b0 = Vec::expand(c.b0);
+    section.b1 = Vec::expand(c.b1);
+    section.b2 = Vec::expand(c.b2);
+    section.a1 = Vec::expand(c.a1);
+    section.a2 = Vec::expand(c.a2);
+    section.target = c;
+    section.rampRemaining = 0;
+}
+
+void BiquadEngine::setCoefficients(int sectionIndex, const BiquadCoefficients& c, int rampSamples)
+{
+    if (sectionIndex < 0 || sectionIndex >= maxSections)
+    {
+        jassertfalse;
+        return;
+    }
+
+    auto& section = sections[static_cast<size_t>(sectionIndex)];
+
+    if (rampSamples <= 0)
+    {
+        setCurrent(section, c);
+        return;
+    }
+
+    // Ramp from wherever the section currently is (possibly mid-ramp)
+    const float inv = 1.0f / static_cast<float>(rampSamples);
+    section.db0 = (Vec::expand(c.b0) - section.b0) * inv;
+    section.db1 = (Vec::expand(c.b1) - section.b1) * inv;
+    section.db2 = (Vec::expand(c.b2) - section.b2) * inv;
+    section.da1 = (Vec::expand(c.a1) - section.a1) * inv;
+    section.da2 = (Vec::expand(c.a2) - section.a2) * inv;
+    section.target = c;
+    section.rampRemaining = rampSamples;
+}
+
+//==============================================================================
+void BiquadEngine::process(juce::AudioBuffer<float>& buffer)
+{
+    process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples());
+}
+
+void BiquadEngine::process(float* const* channels, int channelsToProcess, int numSamples)
+{
+    channelsToProcess = juce::jmin(channelsToProcess, numChannels);
+
+    if (numActiveSections == 0 || channelsToProcess <= 0 || numSamples <= 0)
+        return;
+
+    jassert(numSamples <= maxBlockSize);
+    numSamples = juce::jmin(numSamples, maxBlockSize);
+
+    juce::ScopedNoDenormals noDenormals;
+
+    for (int group = 0; group * LANES < channelsToProcess; ++group)
+    {
+        const int firstChannel = group * LANES;
+        processGroup(group, channels + firstChannel,
+                     juce::jmin(LANES, channelsToProcess - firstChannel), numSamples);
+    }
+
+    for (int section = 0; section < numActiveSections; ++section)
+        advanceRamp(sections[static_cast<size_t>(section)], numSamples);
+}
+
+/**
+ * @brief Transposes one group into lanes, runs the cascade, transposes back
+ */
+void BiquadEngine::processGroup(int group, float* const* channels, int numChannelsInGroup, int numSamples)
+{
+    auto* interleaved = reinterpret_cast<float*>(scratch.data());
+
+    for (int lane = 0; lane < numChannelsInGroup; ++lane)
+    {
+        const float* source = channels[lane];
+        for (int i = 0; i < numSamples; ++i)
+            interleaved[i * LANES + lane] = source[i];
+    }
+
+    // Unused lanes carry silence so their state stays at zero
+    for (int lane = numChannelsInGroup; lane < LANES; ++lane)
+        for (int i = 0; i < numSamples; ++i)
+            interleaved[i * LANES + lane] = 0.0f;
+
+    auto* groupStates = states.data() + group * maxSections;
+    for (int section = 0; section < numActiveSections; ++section)
+        runSection(sections[static_cast<size_t>(section)], groupStates[section], scratch.data(), numSamples);
+
+    for (int lane = 0; lane < numChannelsInGroup; ++lane)
+    {
+        float* dest = channels[lane];
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = interleaved[i * LANES + lane];
+    }
+}
+
+void BiquadEngine::runSection(const Section& section, State& state, Vec* data, int numSamples)
+{
+    Vec b0 = section.b0, b1 = section.b1, b2 = section.b2, a1 = section.a1, a2 = section.a2;
+    Vec s1 = state.s1, s2 = state.s2;
+
+    int i = 0;
+
+    // Interpolating part
+    const int rampSamples = juce::jmin(numSamples, section.rampRemaining);
+    for (; i < rampSamples; ++i)
+    {
+        b0 += section.db0; b1 += section.db1; b2 += section.db2;
+        a1 += section.da1; a2 += section.da2;
+
+        const Vec x = data[i];
+        const Vec y = b0 * x + s1;
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+        data[i] = y;
+    }
+
+    if (rampSamples > 0 && rampSamples == section.rampRemaining)
+    {
+        const auto& t = section.target;
+        b0 = Vec::expand(t.b0); b1 = Vec::expand(t.b1); b2 = Vec::expand(t.b2);
+        a1 = Vec::expand(t.a1); a2 = Vec::expand(t.a2);
+    }
+
+    // Steady-state part
+    for (; i < numSamples; ++i)
+    {
+        const Vec x = data[i];
+        const Vec y = b0 * x + s1;
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+        data[i] = y;
+    }
+
+    snapToZero(s1);
+    snapToZero(s2);
+    state.s1 = s1;
+    state.s2 = s2;
+}
+
+void BiquadEngine::advanceRamp(Section& section, int numSamples)
+{
+    if (section.rampRemaining <= 0)
+        return;
+
+    if (numSamples >= section.rampRemaining)
+    {
+        setCurrent(section, section.target);
+        return;
+    }
+
+    const float steps = static_cast<float>(numSamples);
+    section.b0 += section.db0 * steps;
+    section.b1 += section.db1 * steps;
+    section.b2 += section.db2 * steps;
+    section.a1 += section.da1 * steps;
+    section.a2 += section.da2 * steps;
+    section.rampRemaining -= numSamples;
+}
+
+} // namespace AIplayer
@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    BiquadEngine.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Shared multi-channel biquad cascade with SIMD channel lanes.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadDesign.h"
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @class BiquadEngine
+ * @brief Cascade of transposed direct form II biquads for 1..N channels
+ *
+ * The single filter implementation used by every IIR stage in the plugin
+ * (channel strip filters, loudness weighting, analysis pre-filters).
+ *
+ * - Channels are interleaved into juce::dsp::SIMDRegister lanes, so one
+ *   instruction advances up to SIMDRegister::size() channels at once. Channels
+ *   are processed in groups of that width.
+ * - Each group's block is transposed once into an interleaved scratch buffer,
+ *   and the cascade then runs section by section over it. Every pass keeps one
+ *   section's coefficients and state in registers while the block stays in L1.
+ * - setCoefficients() with a ramp interpolates coefficients linearly per
+ *   sample. Filters swept by an agent then move without zipper noise. Ramps
+ *   shorter than a few milliseconds keep every intermediate set stable for
+ *   the shapes in BiquadDesign.
+ * - State is flushed to zero below 1e-15 after every block, and processing
+ *   runs under ScopedNoDenormals, so decaying tails never hit denormal
+ *   slow paths.
+ *
+ * All memory is allocated in prepare(). setCoefficients() and process() are
+ * allocation- and lock-free and must be called from the same (audio) thread.
+ */
+class BiquadEngine
+{
+public:
+    using Vec = juce::dsp::SIMDRegister<float>;
+
+    /// Channels processed per SIMD register
+    static constexpr int LANES = static_cast<int>(Vec::SIMDNumElements);
+
+    /**
+     * @brief Constructor
+     */
+    BiquadEngine() = default;
+
+    /**
+     * @brief Allocates state and scratch memory
+     *
+     * All sections start as pass-through with cleared state.
+     *
+     * @param numChannels Number of channels to filter
+     * @param maxSections Maximum number of cascaded sections
+     * @param maxBlockSize Largest block passed to process()
+     */
+    void prepare(int numChannels, int maxSections, int maxBlockSize);
+
+    /**
+     * @brief Clears the filter state of every section
+     */
+    void reset();
+
+    /**
+     * @brief Sets how many sections of the cascade are run
+     *
+     * Sections that become active have their state cleared.
+     *
+     * @param numSections Active section count (clamped to the prepared maximum)
+     */
+    void setNumSections(int numSections);
+
+    /**
+     * @brief Sets a section's coefficients for all channels
+     *
+     * @param section Section index
+     * @param coefficients New coefficients
+     * @param rampSamples Samples over which to interpolate (0 = immediate)
+     */
+    void setCoefficients(int section, const BiquadCoefficients& coefficients, int rampSamples = 0);
+
+    /**
+     * @brief Filters a block in place
+     *
+     * @param channels Channel pointers
+     * @param numChannels Number of channels (at most the prepared count)
+     * @param numSamples Number of samples (at most the prepared block size)
+     */
+    void process(float* const* channels, int numChannels, int numSamples);
+
+    /**
+     * @brief Filters a buffer in place
+     *
+     * @param buffer Audio buffer; channels beyond the prepared count are ignored
+     */
+    void process(juce::AudioBuffer<float>& buffer);
+
+    int getNumSections() const { return numActiveSections; }
+    int getMaxSections() const { return maxSections; }
+    int getNumChannels() const { return numChannels; }
+
+private:
+    /// Coefficients of one section, broadcast to every lane
+    struct Section
+    {
+        Vec b0, b1, b2, a1, a2;             ///< Current values
+        Vec db0, db1, db2, da1, da2;        ///< Per-sample increments while ramping
+        BiquadCoefficients target;
+        int rampRemaining{0};
+    };
+
+    /// TDF-II state for one section of one channel group
+    struct State
+    {
+        Vec s1, s2;
+    };
+
+    void processGroup(int group, float* const* channels, int numChannelsInGroup, int numSamples);
+
+    /// Runs one section over an interleaved block (does not modify the section)
+    static void runSection(const Section& section, State& state, Vec* data, int numSamples);
+
+    /// Advances a section's ramp once all groups have processed the block
+    static void advanceRamp(Section& section, int numSamples);
+
+    static void setCurrent(Section& section, const BiquadCoefficients& coefficients);
+
+    int numChannels{0};
+    int numGroups{0};
+    int maxSections{0};
+    int maxBlockSize{0};
+    int numActiveSections{0};
+
+    std::vector<Section> sections;          ///< [section]
+    std::vector<State> states;              ///< [group * maxSections + section]
+    std::vector<Vec> scratch;               ///< Interleaved block for one group
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BiquadEngine)
+};
+
+} // namespace AIplayer
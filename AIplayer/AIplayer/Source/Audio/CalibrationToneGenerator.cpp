@@ -25,12 +25,14 @@ void CalibrationToneGenerator::prepare(double sampleRate, int samplesPerBlock)
     // Store the process specification
     processSpec.sampleRate = sampleRate;
     processSpec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    processSpec.numChannels = 2; // Default to stereo
+    processSpec.numChannels = 1; // Rendered once, added to every channel
     
     // Prepare the oscillator
     oscillator.prepare(processSpec);
     oscillator.setFrequency(frequency.load());
     
+    toneBuffer.setSize(1, juce::jmax(1, samplesPerBlock));
+    
     isPrepared = true;
 }
 
@@ -82,22 +84,25 @@ void CalibrationToneGenerator::processBlock(juce::AudioBuffer<float>& buffer)
     // Update oscillator frequency in case it changed
     oscillator.setFrequency(frequency.load());
     
-    // Create a temporary buffer for the tone
-    juce::AudioBuffer<float> toneBuffer(buffer.getNumChannels(), buffer.getNumSamples());
-    toneBuffer.clear();
-    
-    // Create audio block and process context for the tone buffer
-    juce::dsp::AudioBlock<float> toneBlock(toneBuffer);
-    juce::dsp::ProcessContextReplacing<float> context(toneBlock);
-    
-    // Generate the tone
-    oscillator.process(context);
+    // Render in scratch-sized pieces, in case the host exceeds the prepared block size
+    const int numSamples = buffer.getNumSamples();
+    const int maxChunk = toneBuffer.getNumSamples();
     
-    // Mix the tone with the existing audio
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    for (int start = 0; start < numSamples; start += maxChunk)
     {
-        buffer.addFrom(channel, 0, toneBuffer, channel, 0, 
-                      buffer.getNumSamples(), currentAmplitude);
+        const int chunk = juce::jmin(maxChunk, numSamples - start);
+        toneBuffer.clear(0, 0, chunk);
+        
+        // Generate the tone
+        auto toneBlock = juce::dsp::AudioBlock<float>(toneBuffer).getSubBlock(0, static_cast<size_t>(chunk));
+        juce::dsp::ProcessContextReplacing<float> context(toneBlock);
+        oscillator.process(context);
+        
+        // Mix the tone with the existing audio
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            buffer.addFrom(channel, start, toneBuffer, 0, 0, chunk, currentAmplitude);
+        }
     }
 }
 
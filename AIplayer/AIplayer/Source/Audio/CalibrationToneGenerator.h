@@ -23,7 +23,9 @@ namespace AIplayer {
  * @brief Generates calibration tones for track identification
  * 
  * Thread-safe tone generator that can be controlled from any thread
- * and processes audio in the audio thread.
+ * and processes audio in the audio thread. The tone is rendered once in
+ * mono into a buffer sized in prepare() and added to every channel, so
+ * processBlock() does not allocate.
  */
 class CalibrationToneGenerator
 {
@@ -124,6 +126,9 @@ private:
     /// Process specification for DSP
     juce::dsp::ProcessSpec processSpec;
     
+    /// Mono tone scratch, sized in prepare()
+    juce::AudioBuffer<float> toneBuffer;
+    
     /// Whether tone generation is enabled
     std::atomic<bool> toneEnabled{false};
     
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    ChannelLayout.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Channel limits, BS.1770 loudness weights, analysis downmix gains and
+    the shared per-channel energy kernel.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+
+namespace AIplayer {
+
+/**
+ * @namespace ChannelLayout
+ * @brief Per-channel weights for multichannel buses (up to 16 channels)
+ *
+ * Stems can be anything from mono to 7.1.4 or discrete layouts. Everything
+ * that combines channels takes its per-channel gains from here, so loudness,
+ * metering and the analysis downmix agree on what each channel is.
+ * All functions fill caller-provided arrays and never allocate.
+ *
+ * Per-channel work is done channel-major: each channel is one contiguous,
+ * vectorisable pass (sumOfSquares(), FloatVectorOperations), rather than
+ * an inner loop over channels for every sample.
+ */
+namespace ChannelLayout
+{
+    /// Largest supported bus width
+    constexpr int MAX_CHANNELS = 16;
+
+    /// BS.1770 weight of a surround channel (+1.5 dB)
+    constexpr float SURROUND_WEIGHT = 1.41f;
+
+    /**
+     * @brief How the analysis path folds a bus down to mono
+     */
+    enum class Downmix
+    {
+        All = 0,        ///< Average of every channel
+        NoLfe,          ///< Average of every channel except LFE
+        Front,          ///< Average of left, right and centre (first two if discrete)
+        Loudness        ///< BS.1770 channel weights (surrounds +1.5 dB, no LFE)
+    };
+
+    /**
+     * @brief Sum of squared samples of one channel
+     *
+     * @details Four independent accumulators break the dependency chain so
+     * the loop vectorises without relaxed floating-point flags.
+     */
+    inline float sumOfSquares(const float* samples, int numSamples)
+    {
+        float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+        const int numQuads = numSamples / 4;
+
+        for (int quad = 0; quad < numQuads; ++quad)
+        {
+            const float* q = samples + quad * 4;
+            s0 += q[0] * q[0];
+            s1 += q[1] * q[1];
+            s2 += q[2] * q[2];
+            s3 += q[3] * q[3];
+        }
+
+        for (int i = numQuads * 4; i < numSamples; ++i)
+            s0 += samples[i] * samples[i];
+
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    /// Number of Downmix modes (for the choice parameter)
+    constexpr int NUM_DOWNMIX_MODES = 4;
+
+    /// Display names of the Downmix modes, in enum order
+    inline const char* getDownmixName(int mode)
+    {
+        static const char* names[NUM_DOWNMIX_MODES] = { "All", "No LFE", "Front", "Loudness" };
+        return names[juce::jlimit(0, NUM_DOWNMIX_MODES - 1, mode)];
+    }
+
+    /**
+     * @brief BS.1770 weight of a channel
+     *
+     * @details LFE is excluded. Surrounds at roughly 60-120 degrees azimuth
+     * (5.1 surrounds, 7.1 side surrounds) are weighted by 1.41; every other
+     * channel, including rears, heights and unknown discrete channels, by 1.0.
+     */
+    inline float loudnessWeight(juce::AudioChannelSet::ChannelType type)
+    {
+        using CT = juce::AudioChannelSet::ChannelType;
+
+        switch (type)
+        {
+            case CT::LFE:
+            case CT::LFE2:
+                return 0.0f;
+
+            case CT::leftSurround:
+            case CT::rightSurround:
+            case CT::leftSurroundSide:
+            case CT::rightSurroundSide:
+                return SURROUND_WEIGHT;
+
+            default:
+                return 1.0f;
+        }
+    }
+
+    /**
+     * @brief Fills BS.1770 weights for every channel of a layout
+     *
+     * @param layout Bus layout
+     * @param weights Output, MAX_CHANNELS entries; unused entries are zeroed
+     */
+    inline void loudnessWeights(const juce::AudioChannelSet& layout, float* weights)
+    {
+        const int numChannels = juce::jmin(layout.size(), MAX_CHANNELS);
+
+        for (int channel = 0; channel < MAX_CHANNELS; ++channel)
+            weights[channel] = channel < numChannels ? loudnessWeight(layout.getTypeOfChannel(channel)) : 0.0f;
+
+        // Mono and unlabelled layouts: every channel counts
+        if (numChannels > 0 && std::all_of(weights, weights + numChannels, [](float w) { return w == 0.0f; }))
+            std::fill(weights, weights + numChannels, 1.0f);
+    }
+
+    /**
+     * @brief Fills downmix gains for a layout; the gains sum to one
+     *
+     * @param mode Downmix mode
+     * @param layout Bus layout
+     * @param gains Output, MAX_CHANNELS entries; unused entries are zeroed
+     */
+    inline void downmixGains(Downmix mode, const juce::AudioChannelSet& layout, float* gains)
+    {
+        using CT = juce::AudioChannelSet::ChannelType;
+        const int numChannels = juce::jmin(layout.size(), MAX_CHANNELS);
+
+        for (int channel = 0; channel < MAX_CHANNELS; ++channel)
+        {
+            float gain = channel < numChannels ? 1.0f : 0.0f;
+
+            if (channel < numChannels && mode != Downmix::All)
+            {
+                const auto type = layout.getTypeOfChannel(channel);
+
+                if (mode == Downmix::NoLfe)
+                    gain = (type == CT::LFE || type == CT::LFE2) ? 0.0f : 1.0f;
+                else if (mode == Downmix::Front)
+                    gain = (type == CT::left || type == CT::right || type == CT::centre) ? 1.0f : 0.0f;
+                else
+                    gain = loudnessWeight(type);
+            }
+
+            gains[channel] = gain;
+        }
+
+        // Front of a discrete layout: the first two channels
+        if (mode == Downmix::Front && layout.isDiscreteLayout())
+            for (int channel = 0; channel < numChannels; ++channel)
+                gains[channel] = channel < 2 ? 1.0f : 0.0f;
+
+        float total = 0.0f;
+        for (int channel = 0; channel < numChannels; ++channel)
+            total += gains[channel];
+
+        // Nothing selected (e.g. Front of an LFE-only bus): fall back to all
+        if (total <= 0.0f)
+        {
+            std::fill(gains, gains + numChannels, 1.0f);
+            total = static_cast<float>(numChannels);
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            gains[channel] /= total;
+    }
+}
+
+} // namespace AIplayer
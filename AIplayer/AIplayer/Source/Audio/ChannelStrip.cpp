@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+    ChannelStrip.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the channel strip processing chain.
+
+  ==============================================================================
+*/
+
+#include "ChannelStrip.h"
+#include <array>
+#include <cmath>
+
+namespace AIplayer {
+
+namespace {
+    /// Bell gains closer to 0 dB than this are treated as flat
+    constexpr float FLAT_EQ_GAIN_DB = 0.01f;
+
+    float timeConstantToCoeff(float milliseconds, double sampleRate)
+    {
+        const double samples = juce::jmax(1.0, static_cast<double>(milliseconds) * 0.001 * sampleRate);
+        return static_cast<float>(std::exp(-1.0 / samples));
+    }
+}
+
+//==============================================================================
+void ChannelStrip::prepare(double newSampleRate, int maxBlockSize, int numChannels)
+{
+    sampleRate = newSampleRate;
+    preparedChannels = numChannels;
+
+    filters.prepare(numChannels, MAX_SECTIONS, maxBlockSize);
+    filters.setNumSections(0);
+    filterLayout = -1;
+    rampSamples = juce::roundToInt(COEFFICIENT_RAMP_MS * 0.001 * sampleRate);
+
+    const int maxLookahead = static_cast<int>(std::ceil(MAX_LOOKAHEAD_MS * 0.001 * sampleRate));
+    delayBuffer.setSize(numChannels, maxLookahead + 1);
+
+    settingsValid = false;
+    setSettings(settings);
+    reset();
+}
+
+void ChannelStrip::reset()
+{
+    filters.reset();
+
+    delayBuffer.clear();
+    delayWritePosition = 0;
+    envelopeDb = 0.0f;
+    gainReductionDb.store(0.0f, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void ChannelStrip::setSettings(const Settings& newSettings)
+{
+    const bool filtersChanged = !settingsValid
+        || newSettings.hpfEnabled != settings.hpfEnabled
+        || newSettings.hpfFrequency != settings.hpfFrequency
+        || newSettings.lpfEnabled != settings.lpfEnabled
+        || newSettings.lpfFrequency != settings.lpfFrequency
+        || newSettings.eqFrequency != settings.eqFrequency
+        || newSettings.eqGainDb != settings.eqGainDb
+        || newSettings.eqQ != settings.eqQ;
+
+    const bool compressorChanged = !settingsValid
+        || newSettings.compThresholdDb != settings.compThresholdDb
+        || newSettings.compRatio != settings.compRatio
+        || newSettings.compAttackMs != settings.compAttackMs
+        || newSettings.compReleaseMs != settings.compReleaseMs
+        || newSettings.compMakeupDb != settings.compMakeupDb
+        || newSettings.compLookaheadMs != settings.compLookaheadMs;
+
+    settings = newSettings;
+    settingsValid = true;
+
+    if (filtersChanged)
+        updateFilters();
+
+    if (compressorChanged)
+        updateCompressor();
+}
+
+void ChannelStrip::updateFilters()
+{
+    std::array<BiquadCoefficients, MAX_SECTIONS> coefficients;
+    int count = 0;
+    int layout = 0;
+
+    if (settings.hpfEnabled)
+    {
+        coefficients[static_cast<size_t>(count++)] = BiquadDesign::highPass(sampleRate, settings.hpfFrequency);
+        layout |= 1;
+    }
+
+    if (std::abs(settings.eqGainDb) >= FLAT_EQ_GAIN_DB)
+    {
+        coefficients[static_cast<size_t>(count++)] = BiquadDesign::peak(sampleRate, settings.eqFrequency,
+                                                                         settings.eqQ, settings.eqGainDb);
+        layout |= 2;
+    }
+
+    if (settings.lpfEnabled)
+    {
+        coefficients[static_cast<size_t>(count++)] = BiquadDesign::lowPass(sampleRate, settings.lpfFrequency);
+        layout |= 4;
+    }
+
+    // Sections shift position when a stage is toggled, so jump and restart
+    // from clean state; plain parameter moves glide to the new response
+    const bool layoutChanged = layout != filterLayout;
+    if (layoutChanged)
+    {
+        filterLayout = layout;
+        filters.setNumSections(0);
+        filters.setNumSections(count);
+    }
+
+    for (int i = 0; i < count; ++i)
+        filters.setCoefficients(i, coefficients[static_cast<size_t>(i)], layoutChanged ? 0 : rampSamples);
+}
+
+void ChannelStrip::updateCompressor()
+{
+    const float ratio = juce::jmax(1.0f, settings.compRatio);
+
+    compressorActive = ratio > 1.0f || std::abs(settings.compMakeupDb) > 0.0f;
+    slope = 1.0f / ratio - 1.0f;
+    attackCoeff = timeConstantToCoeff(settings.compAttackMs, sampleRate);
+    releaseCoeff = timeConstantToCoeff(settings.compReleaseMs, sampleRate);
+    makeupGain = juce::Decibels::decibelsToGain(settings.compMakeupDb);
+
+    const int maxLookahead = juce::jmax(0, delayBuffer.getNumSamples() - 1);
+    const int newLookahead = juce::jlimit(0, maxLookahead,
+        juce::roundToInt(juce::jlimit(0.0f, MAX_LOOKAHEAD_MS, settings.compLookaheadMs) * 0.001 * sampleRate));
+
+    if (newLookahead != lookaheadSamples)
+    {
+        lookaheadSamples = newLookahead;
+        delayBuffer.clear();
+        delayWritePosition = 0;
+    }
+
+    if (!compressorActive)
+    {
+        envelopeDb = 0.0f;
+        gainReductionDb.store(0.0f, std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+void ChannelStrip::process(juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), preparedChannels);
+    const int numSamples = buffer.getNumSamples();
+
+    if (numChannels == 0 || numSamples == 0)
+        return;
+
+    if (filters.getNumSections() > 0)
+        filters.process(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+    if (compressorActive || lookaheadSamples > 0)
+        processCompressor(buffer, numChannels, numSamples);
+}
+
+float ChannelStrip::computeGainReductionDb(float levelDb) const
+{
+    const float overshoot = levelDb - settings.compThresholdDb;
+
+    if (2.0f * overshoot < -KNEE_WIDTH_DB)
+        return 0.0f;
+
+    if (2.0f * overshoot > KNEE_WIDTH_DB)
+        return slope * overshoot;
+
+    const float x = overshoot + KNEE_WIDTH_DB * 0.5f;
+    return slope * x * x / (2.0f * KNEE_WIDTH_DB);
+}
+
+/**
+ * @brief Feed-forward compressor with optional lookahead
+ *
+ * @details The detector is a stereo-linked peak taken from the undelayed
+ * input; the smoothed gain is applied to the delayed signal. With lookahead
+ * at zero the delay line is bypassed and gain is applied in place.
+ */
+void ChannelStrip::processCompressor(juce::AudioBuffer<float>& buffer, int numChannels, int numSamples)
+{
+    const int delaySize = delayBuffer.getNumSamples();
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    auto* const* delayLines = delayBuffer.getArrayOfWritePointers();
+
+    float envelope = envelopeDb;
+    int writePosition = delayWritePosition;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float gain = 1.0f;
+
+        if (compressorActive)
+        {
+            float peak = 0.0f;
+            for (int channel = 0; channel < numChannels; ++channel)
+                peak = juce::jmax(peak, std::abs(channels[channel][i]));
+
+            const float target = computeGainReductionDb(juce::Decibels::gainToDecibels(peak, -120.0f));
+            const float coeff = target < envelope ? attackCoeff : releaseCoeff;
+            envelope = target + coeff * (envelope - target);
+
+            gain = juce::Decibels::decibelsToGain(envelope, -120.0f) * makeupGain;
+        }
+
+        if (lookaheadSamples > 0)
+        {
+            int readPosition = writePosition - lookaheadSamples;
+            if (readPosition < 0)
+                readPosition += delaySize;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                delayLines[channel][writePosition] = channels[channel][i];
+                channels[channel][i] = delayLines[channel][readPosition] * gain;
+            }
+
+            if (++writePosition == delaySize)
+                writePosition = 0;
+        }
+        else
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                channels[channel][i] *= gain;
+        }
+    }
+
+    envelopeDb = envelope;
+    delayWritePosition = writePosition;
+    gainReductionDb.store(envelope, std::memory_order_relaxed);
+}
+
+} // namespace AIplayer
@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    ChannelStrip.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Real-time channel strip: HPF, bell EQ, LPF and feed-forward compressor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include "BiquadEngine.h"
+#include <atomic>
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @class ChannelStrip
+ * @brief The processing chain the mixing agents drive
+ *
+ * Signal flow: HPF -> bell EQ -> LPF -> compressor (optional lookahead).
+ *
+ * - The three filters run as one BiquadEngine cascade containing only the
+ *   active sections; when none is active the filter stage is skipped entirely
+ * - Filter moves are interpolated per sample over COEFFICIENT_RAMP_MS
+ * - The compressor is skipped when its ratio is 1:1 and it has no makeup gain
+ * - Coefficients are recalculated only when a setting actually changes
+ * - All buffers are sized in prepare(); process() never allocates or locks
+ *
+ * Lookahead delays the audio (not the detector) by a fixed amount so gain
+ * reduction can start before a transient arrives. The delay is applied
+ * whenever lookahead is non-zero, even with the compressor bypassed, so the
+ * latency reported to the host does not change when the agent toggles stages.
+ */
+class ChannelStrip
+{
+public:
+    /// Maximum number of cascaded filter sections (HPF, bell, LPF)
+    static constexpr int MAX_SECTIONS = 3;
+
+    /// Longest supported compressor lookahead
+    static constexpr float MAX_LOOKAHEAD_MS = 10.0f;
+
+    /// Time over which filter coefficient changes are interpolated
+    static constexpr float COEFFICIENT_RAMP_MS = 5.0f;
+
+    /**
+     * @struct Settings
+     * @brief Complete parameter snapshot for one block
+     */
+    struct Settings
+    {
+        bool hpfEnabled{false};
+        float hpfFrequency{80.0f};
+        bool lpfEnabled{false};
+        float lpfFrequency{18000.0f};
+
+        float eqFrequency{250.0f};
+        float eqGainDb{0.0f};
+        float eqQ{2.0f};
+
+        float compThresholdDb{0.0f};
+        float compRatio{1.0f};
+        float compAttackMs{10.0f};
+        float compReleaseMs{100.0f};
+        float compMakeupDb{0.0f};
+        float compLookaheadMs{0.0f};
+    };
+
+    /**
+     * @brief Constructor
+     */
+    ChannelStrip() = default;
+
+    /**
+     * @brief Allocates state for the given configuration
+     *
+     * @param sampleRate Processing sample rate
+     * @param maxBlockSize Largest block passed to process()
+     * @param numChannels Number of channels to process
+     */
+    void prepare(double sampleRate, int maxBlockSize, int numChannels);
+
+    /**
+     * @brief Clears filter, detector and delay state
+     */
+    void reset();
+
+    /**
+     * @brief Applies a parameter snapshot
+     *
+     * Cheap when nothing changed; call once per block from the audio thread.
+     *
+     * @param newSettings The settings to use for the next process() call
+     */
+    void setSettings(const Settings& newSettings);
+
+    /**
+     * @brief Processes a block in place
+     *
+     * @param buffer Audio to process (channels beyond the prepared count are ignored)
+     */
+    void process(juce::AudioBuffer<float>& buffer);
+
+    /**
+     * @brief Latency introduced by the current settings
+     *
+     * @return Lookahead delay in samples
+     */
+    int getLatencySamples() const { return lookaheadSamples; }
+
+    /**
+     * @brief Current compressor gain reduction
+     *
+     * Safe to call from any thread.
+     *
+     * @return Gain reduction in dB (0 or negative)
+     */
+    float getGainReductionDb() const { return gainReductionDb.load(std::memory_order_relaxed); }
+
+    /// Whether any filter section is active
+    bool isFilterStageActive() const { return filters.getNumSections() > 0; }
+
+    /// Whether the compressor is doing any work
+    bool isCompressorActive() const { return compressorActive; }
+
+private:
+    void updateFilters();
+    void updateCompressor();
+
+    void processCompressor(juce::AudioBuffer<float>& buffer, int numChannels, int numSamples);
+
+    /// Static curve: gain reduction (dB, <= 0) for a detector level in dB
+    float computeGainReductionDb(float levelDb) const;
+
+    double sampleRate{44100.0};
+    int preparedChannels{0};
+    Settings settings;
+    bool settingsValid{false};
+
+    // Filters
+    BiquadEngine filters;
+    int filterLayout{-1};              ///< Bitmask of active filter stages
+    int rampSamples{0};
+
+    // Compressor
+    static constexpr float KNEE_WIDTH_DB = 6.0f;
+    bool compressorActive{false};
+    float slope{0.0f};                 ///< 1/ratio - 1
+    float attackCoeff{0.0f};
+    float releaseCoeff{0.0f};
+    float makeupGain{1.0f};
+    float envelopeDb{0.0f};
+    std::atomic<float> gainReductionDb{0.0f};
+
+    // Lookahead
+    juce::AudioBuffer<float> delayBuffer;
+    int delayWritePosition{0};
+    int lookaheadSamples{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelStrip)
+};
+
+} // namespace AIplayer
@@ -0,0 +1,375 @@
+/*
+  ==============================================================================
+
+    DrumHitAnalyzer.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the drum hit analysis.
+
+  ==============================================================================
+*/
+
+#include "DrumHitAnalyzer.h"
+
+namespace AIplayer {
+
+namespace {
+    /// Attack limits as fractions of the peak
+    constexpr float ATTACK_START = 0.1f;
+    constexpr float ATTACK_END = 0.9f;
+
+    /// Points on the integrated energy decay used for the T60-like figure (dB)
+    constexpr float DECAY_START_DB = -5.0f;
+    constexpr float DECAY_END_DB = -25.0f;
+    constexpr float DECAY_SHORT_END_DB = -15.0f;
+
+    /// A hit whose last frame is louder than this (dB re its peak) was cut short
+    constexpr float CUT_SHORT_DB = -35.0f;
+
+    /// Fractional frame at which a series first crosses a value (from above or below)
+    template <typename Compare>
+    float findCrossing(const float* values, int start, int end, float target, Compare crossed)
+    {
+        for (int i = start; i < end; ++i)
+        {
+            if (!crossed(values[i], target))
+                continue;
+
+            if (i == start)
+                return static_cast<float>(i);
+
+            const float previous = values[i - 1];
+            const float step = values[i] - previous;
+            return static_cast<float>(i - 1) + (step != 0.0f ? (target - previous) / step : 1.0f);
+        }
+
+        return -1.0f;
+    }
+}
+
+//==============================================================================
+void DrumHitAnalyzer::prepare(double sampleRate)
+{
+    frameSamples = juce::jmax(1, juce::roundToInt(sampleRate * FRAME_SECONDS));
+    frameSeconds = frameSamples / sampleRate;
+
+    lowCoefficient = static_cast<float>(1.0 - std::exp(-juce::MathConstants<double>::twoPi * SPLIT_FREQUENCY / sampleRate));
+    heldRelease = static_cast<float>(std::exp(-frameSeconds / ONSET_RELEASE_SECONDS));
+    backgroundCoefficient = static_cast<float>(1.0 - std::exp(-frameSeconds / BACKGROUND_SECONDS));
+    minIntervalFrames = static_cast<int>(std::ceil(MIN_INTERVAL_SECONDS / frameSeconds));
+
+    prepared = true;
+    reset();
+}
+
+void DrumHitAnalyzer::reset()
+{
+    lowState = 0.0f;
+    currentFrame = Frame();
+    framePosition = 0;
+
+    heldEnergy = 0.0f;
+    background = 0.0f;
+    armed = true;
+    frameCount = 0;
+    lastOnsetFrame = -1;
+    hitIntervalMs = 0.0f;
+
+    preRoll.fill(Frame());
+    preRollPosition = 0;
+    slotFrames = 0;
+    capturing = false;
+
+    counts.fill(0);
+    means.fill(0.0);
+    variances.fill(0.0);
+    lastHit.fill(0.0f);
+    hits = 0;
+
+    publish();
+}
+
+void DrumHitAnalyzer::setEnabled(bool enable)
+{
+    enabled.store(enable);
+}
+
+juce::String DrumHitAnalyzer::measureToString(Measure measure)
+{
+    switch (measure)
+    {
+        case PeakDb:        return "peak_db";
+        case AttackMs:      return "attack_ms";
+        case DecayMs:       return "decay_ms";
+        case BalanceDb:     return "balance_db";
+        case IntervalMs:    return "interval_ms";
+        case NUM_MEASURES:  break;
+    }
+
+    return {};
+}
+
+//==============================================================================
+void DrumHitAnalyzer::process(const juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = buffer.getNumChannels();
+    if (!prepared || numChannels == 0)
+        return;
+
+    // Switching on starts from a clean slate; the reset runs here so the
+    // audio thread stays the only writer
+    const bool enable = enabled.load();
+    if (enable != running)
+    {
+        running = enable;
+        reset();
+    }
+
+    if (!running)
+        return;
+
+    const auto* const* channels = buffer.getArrayOfReadPointers();
+    const float channelGain = 1.0f / static_cast<float>(numChannels);
+    const float frameGain = 1.0f / static_cast<float>(frameSamples);
+
+    for (int i = 0; i < buffer.getNumSamples(); ++i)
+    {
+        float sample = 0.0f;
+        for (int channel = 0; channel < numChannels; ++channel)
+            sample += channels[channel][i];
+        sample *= channelGain;
+
+        lowState += lowCoefficient * (sample - lowState);
+        const float high = sample - lowState;
+
+        currentFrame.peak = juce::jmax(currentFrame.peak, std::abs(sample));
+        currentFrame.energy += sample * sample;
+        currentFrame.lowEnergy += lowState * lowState;
+        currentFrame.highEnergy += high * high;
+
+        if (++framePosition == frameSamples)
+        {
+            currentFrame.energy *= frameGain;
+            currentFrame.lowEnergy *= frameGain;
+            currentFrame.highEnergy *= frameGain;
+
+            processFrame(currentFrame);
+
+            currentFrame = Frame();
+            framePosition = 0;
+        }
+    }
+}
+
+void DrumHitAnalyzer::processFrame(const Frame& frame)
+{
+    const juce::int64 frameIndex = frameCount++;
+
+    // Onset: the held energy jumps well above the background
+    heldEnergy = juce::jmax(frame.energy, heldEnergy * heldRelease);
+
+    const float ratio = std::pow(10.0f, ONSET_RATIO_DB / 10.0f);
+    const float thresholdEnergy = std::pow(10.0f, threshold.load() / 10.0f);
+    const bool rising = heldEnergy > background * ratio;
+
+    const bool onset = armed && rising && heldEnergy > thresholdEnergy
+                    && (lastOnsetFrame < 0 || frameIndex - lastOnsetFrame >= minIntervalFrames);
+
+    armed = onset ? false : (armed || !rising);
+    background += backgroundCoefficient * (heldEnergy - background);
+
+    if (onset)
+    {
+        if (capturing)
+            finishHit();
+
+        const double interval = lastOnsetFrame < 0 ? 0.0 : static_cast<double>(frameIndex - lastOnsetFrame) * frameSeconds;
+        hitIntervalMs = interval > 0.0 && interval <= MAX_INTERVAL_SECONDS ? static_cast<float>(interval * 1000.0) : 0.0f;
+        lastOnsetFrame = frameIndex;
+
+        startHit(frame);
+    }
+    else if (capturing)
+    {
+        slot[static_cast<size_t>(slotFrames++)] = frame;
+
+        if (slotFrames == SLOT_FRAMES)
+            finishHit();
+    }
+
+    preRoll[static_cast<size_t>(preRollPosition)] = frame;
+    preRollPosition = (preRollPosition + 1) % PRE_ROLL_FRAMES;
+}
+
+void DrumHitAnalyzer::startHit(const Frame& onsetFrame)
+{
+    // The frames before the onset, oldest first, then the onset frame
+    for (int i = 0; i < PRE_ROLL_FRAMES; ++i)
+        slot[static_cast<size_t>(i)] = preRoll[static_cast<size_t>((preRollPosition + i) % PRE_ROLL_FRAMES)];
+
+    slot[static_cast<size_t>(PRE_ROLL_FRAMES)] = onsetFrame;
+    slotFrames = PRE_ROLL_FRAMES + 1;
+    capturing = true;
+}
+
+void DrumHitAnalyzer::finishHit()
+{
+    // The trailing frames may already hold the next hit's rise
+    capturing = false;
+    slotFrames -= PRE_ROLL_FRAMES;
+
+    Measures measures{};
+    Validity valid{};
+
+    // Peak and band balance of the hit itself (the pre-roll is only for the attack)
+    int peakFrame = PRE_ROLL_FRAMES;
+    double low = 0.0, high = 0.0;
+
+    for (int i = PRE_ROLL_FRAMES; i < slotFrames; ++i)
+    {
+        const auto& frame = slot[static_cast<size_t>(i)];
+        if (frame.peak > slot[static_cast<size_t>(peakFrame)].peak)
+            peakFrame = i;
+
+        low += frame.lowEnergy;
+        high += frame.highEnergy;
+    }
+
+    measures[PeakDb] = juce::Decibels::gainToDecibels(slot[static_cast<size_t>(peakFrame)].peak);
+    valid[PeakDb] = true;
+
+    measures[AttackMs] = measureAttack();
+    valid[AttackMs] = measures[AttackMs] >= 0.0f;
+
+    measures[DecayMs] = measureDecay(peakFrame);
+    valid[DecayMs] = measures[DecayMs] > 0.0f;
+
+    measures[BalanceDb] = static_cast<float>(10.0 * std::log10((low + 1.0e-20) / (high + 1.0e-20)));
+    valid[BalanceDb] = low + high > 0.0;
+
+    measures[IntervalMs] = hitIntervalMs;
+    valid[IntervalMs] = hitIntervalMs > 0.0f;
+
+    for (int measure = 0; measure < NUM_MEASURES; ++measure)
+        if (!valid[static_cast<size_t>(measure)])
+            measures[static_cast<size_t>(measure)] = 0.0f;
+
+    addToStatistics(measures, valid);
+}
+
+float DrumHitAnalyzer::measureAttack()
+{
+    // Held peak envelope (rises with the signal, falls with the onset release)
+    // so that the cycles of a low kick do not read as separate rises
+    float peak = 0.0f;
+    for (int i = 0; i < slotFrames; ++i)
+    {
+        const float previous = i > 0 ? scratch[static_cast<size_t>(i - 1)] * heldRelease : 0.0f;
+        scratch[static_cast<size_t>(i)] = juce::jmax(slot[static_cast<size_t>(i)].peak, previous);
+        peak = juce::jmax(peak, scratch[static_cast<size_t>(i)]);
+    }
+
+    if (peak <= 0.0f)
+        return -1.0f;
+
+    auto rises = [](float value, float target) { return value >= target; };
+    const float end = findCrossing(scratch.data(), 0, slotFrames, ATTACK_END * peak, rises);
+
+    // The rise starts after the last frame below ATTACK_START before the end
+    int start = static_cast<int>(end);
+    while (start > 0 && scratch[static_cast<size_t>(start)] > ATTACK_START * peak)
+        --start;
+
+    const float begin = findCrossing(scratch.data(), start, slotFrames, ATTACK_START * peak, rises);
+    return static_cast<float>((end - begin) * frameSeconds * 1000.0);
+}
+
+float DrumHitAnalyzer::measureDecay(int peakFrame)
+{
+    // Schroeder integration: energy remaining from each frame to the end, in dB re the total
+    double remaining = 0.0;
+    for (int i = slotFrames - 1; i >= peakFrame; --i)
+    {
+        remaining += slot[static_cast<size_t>(i)].energy;
+        scratch[static_cast<size_t>(i)] = static_cast<float>(remaining);
+    }
+
+    if (remaining <= 0.0)
+        return 0.0f;
+
+    for (int i = peakFrame; i < slotFrames; ++i)
+        scratch[static_cast<size_t>(i)] = static_cast<float>(10.0 * std::log10(scratch[static_cast<size_t>(i)] / remaining + 1.0e-30));
+
+    // A hit stopped early by the next one (or by the slot) has a truncated
+    // tail that bends the curve down; only its upper part is used. The tail
+    // level is averaged over the pre-roll length to smooth out low cycles.
+    const int tailFrames = juce::jmin(PRE_ROLL_FRAMES, slotFrames - peakFrame);
+    double tail = 0.0, loudest = 0.0;
+
+    for (int i = peakFrame; i < slotFrames; ++i)
+    {
+        loudest = juce::jmax(loudest, static_cast<double>(slot[static_cast<size_t>(i)].energy));
+        if (i >= slotFrames - tailFrames)
+            tail += slot[static_cast<size_t>(i)].energy;
+    }
+
+    const bool cutShort = 10.0 * std::log10(tail / tailFrames / loudest + 1.0e-30) > CUT_SHORT_DB;
+    const float endDb = cutShort ? DECAY_SHORT_END_DB : DECAY_END_DB;
+
+    auto falls = [](float value, float target) { return value <= target; };
+    const float start = findCrossing(scratch.data(), peakFrame, slotFrames, DECAY_START_DB, falls);
+    const float end = findCrossing(scratch.data(), peakFrame, slotFrames, endDb, falls);
+
+    if (start < 0.0f || end <= start)
+        return 0.0f;
+
+    return static_cast<float>((end - start) * frameSeconds * 1000.0 * (-60.0 / (endDb - DECAY_START_DB)));
+}
+
+//==============================================================================
+void DrumHitAnalyzer::addToStatistics(const Measures& measures, const Validity& valid)
+{
+    // Welford's update; capping the count turns it into an exponential
+    // average so the spread follows the performance rather than the session
+    for (size_t measure = 0; measure < static_cast<size_t>(NUM_MEASURES); ++measure)
+    {
+        if (!valid[measure])
+            continue;
+
+        const int count = juce::jmin(++counts[measure], STATISTICS_HITS);
+        const double weight = 1.0 / count;
+        const double delta = measures[measure] - means[measure];
+        means[measure] += weight * delta;
+        variances[measure] = (1.0 - weight) * (variances[measure] + weight * delta * delta);
+    }
+
+    lastHit = measures;
+    ++hits;
+    publish();
+}
+
+void DrumHitAnalyzer::publish()
+{
+    Report report;
+    report.hits = hits;
+    report.lastHit = lastHit;
+    report.counts = counts;
+
+    for (size_t measure = 0; measure < static_cast<size_t>(NUM_MEASURES); ++measure)
+    {
+        report.statistics[measure].mean = static_cast<float>(means[measure]);
+        report.statistics[measure].standardDeviation = static_cast<float>(std::sqrt(variances[measure]));
+    }
+
+    reportSnapshot.publish(report);
+    hitCount.store(hits);
+}
+
+void DrumHitAnalyzer::getReport(Report& report) const
+{
+    if (reportSnapshot.read(report) == 0)
+        report = Report();
+}
+
+} // namespace AIplayer
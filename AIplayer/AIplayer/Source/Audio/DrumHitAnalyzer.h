@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+    DrumHitAnalyzer.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Onset-triggered analysis of drum hits: attack, peak, decay, spectral
+    balance and hit-to-hit consistency.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Core/SnapshotBuffer.h"
+#include <array>
+#include <atomic>
+
+namespace AIplayer {
+
+/**
+ * @class DrumHitAnalyzer
+ * @brief Envelope and consistency statistics for kick and snare instances
+ *
+ * Runs on the audio thread. The channels are averaged, split at
+ * SPLIT_FREQUENCY by a one-pole filter and reduced to frames of
+ * FRAME_SECONDS holding the peak, the total energy and the energy of
+ * each band. The frames feed:
+ * - an onset detector: a frame's energy (held with ONSET_RELEASE_SECONDS
+ *   release) rising ONSET_RATIO_DB above the running background
+ *   (BACKGROUND_SECONDS) and above the threshold; it re-arms once the
+ *   energy falls back, and fires at most once per MIN_INTERVAL_SECONDS
+ * - a capture slot preallocated for CAPTURE_FRAMES frames. A hit
+ *   starts with the PRE_ROLL_FRAMES before its onset and ends when the
+ *   slot is full or the next hit begins; its last PRE_ROLL_FRAMES are
+ *   left to the next hit, whose rise starts before it is detected
+ *
+ * A completed hit is measured in one pass over its frames, bounded by
+ * the slot size:
+ * - peak: the highest sample
+ * - attack: 10% to 90% of the peak on the held peak envelope
+ * - decay: a T60-like figure from the Schroeder-integrated energy,
+ *   extrapolated from the -5 to -25 dB slope (or -5 to -15 dB when the
+ *   hit is cut short)
+ * - balance: energy below versus above SPLIT_FREQUENCY
+ * - interval: time since the previous onset
+ *
+ * Each measure feeds a running mean and standard deviation (Welford's
+ * update, weighted as an exponential average once STATISTICS_HITS hits
+ * have been seen), so the spread is the hit-to-hit consistency. The
+ * statistics are published lock-free for telemetry. Nothing allocates
+ * after construction.
+ */
+class DrumHitAnalyzer
+{
+public:
+    DrumHitAnalyzer() = default;
+
+    /// Analysis frame length
+    static constexpr double FRAME_SECONDS = 0.00025;
+
+    /// Longest hit measured from its onset; later frames belong to no hit
+    static constexpr int CAPTURE_FRAMES = 2000;           // 0.5 s
+
+    /// Frames before the onset kept with each hit
+    static constexpr int PRE_ROLL_FRAMES = 40;            // 10 ms
+
+    /// Low/high band split
+    static constexpr float SPLIT_FREQUENCY = 150.0f;
+
+    /// Onset detection
+    static constexpr float ONSET_RATIO_DB = 10.0f;
+    static constexpr double ONSET_RELEASE_SECONDS = 0.02;
+    static constexpr double BACKGROUND_SECONDS = 0.05;
+    static constexpr double MIN_INTERVAL_SECONDS = 0.03;
+    static constexpr float DEFAULT_THRESHOLD_DB = -50.0f;
+
+    /// Hits after which the statistics become an exponential average
+    static constexpr int STATISTICS_HITS = 64;
+
+    /// Longer gaps between onsets are pauses, not part of the pattern
+    static constexpr double MAX_INTERVAL_SECONDS = 2.0;
+
+    /// Measures kept per hit
+    enum Measure
+    {
+        PeakDb,             ///< dBFS
+        AttackMs,           ///< 10-90% rise time
+        DecayMs,            ///< T60-like decay time
+        BalanceDb,          ///< Low band minus high band energy
+        IntervalMs,         ///< Time since the previous onset
+        NUM_MEASURES
+    };
+
+    /// Running mean and standard deviation of one measure
+    struct Statistic
+    {
+        float mean{0.0f};
+        float standardDeviation{0.0f};
+    };
+
+    /// Snapshot for telemetry
+    struct Report
+    {
+        int hits{0};                                        ///< Hits measured since the last reset
+        std::array<float, NUM_MEASURES> lastHit{};          ///< Measures of the latest hit (0 if not measured)
+        std::array<Statistic, NUM_MEASURES> statistics{};
+        std::array<int, NUM_MEASURES> counts{};             ///< Hits behind each statistic
+    };
+
+    /**
+     * @brief Prepares for playback and clears the statistics
+     * @param sampleRate Processing sample rate
+     */
+    void prepare(double sampleRate);
+
+    /// Clears the capture and the statistics (audio thread, or while stopped)
+    void reset();
+
+    /**
+     * @brief Switches the analysis on or off (any thread)
+     *
+     * Switching on starts new statistics.
+     *
+     * @param enable true to analyse
+     */
+    void setEnabled(bool enable);
+
+    /// Whether hits are analysed
+    bool isEnabled() const { return enabled.load(); }
+
+    /**
+     * @brief Sets the level below which onsets are ignored (any thread)
+     * @param thresholdDb Frame energy threshold (dBFS)
+     */
+    void setThreshold(float thresholdDb) { threshold.store(thresholdDb); }
+
+    /// Gets the onset threshold (dBFS)
+    float getThreshold() const { return threshold.load(); }
+
+    /**
+     * @brief Analyses a block (audio thread)
+     * @param buffer Audio to analyse; channels are averaged
+     */
+    void process(const juce::AudioBuffer<float>& buffer);
+
+    /**
+     * @brief Copies the latest statistics (any thread)
+     * @param report Receives the statistics
+     */
+    void getReport(Report& report) const;
+
+    /// Number of hits measured since the last reset (any thread)
+    int getHitCount() const { return hitCount.load(); }
+
+    /// Converts a measure to its name ("peak_db", "attack_ms", ...)
+    static juce::String measureToString(Measure measure);
+
+private:
+    static constexpr int SLOT_FRAMES = PRE_ROLL_FRAMES + CAPTURE_FRAMES + PRE_ROLL_FRAMES;
+
+    /// One frame of the reduced signal
+    struct Frame
+    {
+        float peak{0.0f};
+        float energy{0.0f};
+        float lowEnergy{0.0f};
+        float highEnergy{0.0f};
+    };
+
+    using Measures = std::array<float, NUM_MEASURES>;
+    using Validity = std::array<bool, NUM_MEASURES>;
+
+    void processFrame(const Frame& frame);
+    void startHit(const Frame& onsetFrame);
+    void finishHit();
+    float measureAttack();
+    float measureDecay(int peakFrame);
+    void addToStatistics(const Measures& measures, const Validity& valid);
+    void publish();
+
+    std::atomic<bool> enabled{false};
+    std::atomic<float> threshold{DEFAULT_THRESHOLD_DB};
+    bool running{false};
+    bool prepared{false};
+
+    // Frame reduction (audio thread)
+    int frameSamples{12};
+    double frameSeconds{FRAME_SECONDS};
+    float lowCoefficient{0.0f};
+    float lowState{0.0f};
+    Frame currentFrame;
+    int framePosition{0};
+
+    // Onset detection (audio thread)
+    float heldEnergy{0.0f};
+    float background{0.0f};
+    bool armed{true};
+    float heldRelease{0.0f};
+    float backgroundCoefficient{0.0f};
+    int minIntervalFrames{120};
+    juce::int64 frameCount{0};
+    juce::int64 lastOnsetFrame{-1};
+    float hitIntervalMs{0.0f};          // 0 for the first hit or after a pause
+
+    // Pre-roll ring and the capture slot (audio thread)
+    std::array<Frame, PRE_ROLL_FRAMES> preRoll{};
+    int preRollPosition{0};
+    std::array<Frame, SLOT_FRAMES> slot{};
+    std::array<float, SLOT_FRAMES> scratch{};
+    int slotFrames{0};
+    bool capturing{false};
+
+    // Running statistics (audio thread)
+    std::array<int, NUM_MEASURES> counts{};
+    std::array<double, NUM_MEASURES> means{};
+    std::array<double, NUM_MEASURES> variances{};
+    Measures lastHit{};
+    int hits{0};
+
+    // Published results
+    SnapshotBuffer<Report> reportSnapshot;
+    std::atomic<int> hitCount{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DrumHitAnalyzer)
+};
+
+} // namespace AIplayer
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    DynamicsAnalyzer.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the rolling dynamics statistics.
+
+  ==============================================================================
+*/
+
+#include "DynamicsAnalyzer.h"
+
+namespace AIplayer {
+
+DynamicsAnalyzer::DynamicsAnalyzer()
+{
+    for (int bin = 0; bin < NUM_BINS; ++bin)
+        binPower[static_cast<size_t>(bin)] = std::pow(10.0, (binLowerEdge(bin) + 0.5 * BIN_DB) / 10.0);
+
+    gateBin = binForDb(GATE_DB);
+    reset();
+}
+
+//==============================================================================
+void DynamicsAnalyzer::RollingHistogram::clear()
+{
+    for (auto& histogram : counts)
+        histogram.fill(0);
+
+    position = 0;
+    filled = 0;
+}
+
+void DynamicsAnalyzer::RollingHistogram::add(int bin)
+{
+    // Hops leaving each window; the long window's is the slot being overwritten
+    for (int window = 0; window < NUM_WINDOWS; ++window)
+    {
+        const int length = windowHops(window);
+        if (filled >= length)
+        {
+            const int oldest = (position - length + LONG_WINDOW_HOPS) % LONG_WINDOW_HOPS;
+            --counts[static_cast<size_t>(window)][ring[static_cast<size_t>(oldest)]];
+        }
+
+        ++counts[static_cast<size_t>(window)][static_cast<size_t>(bin)];
+    }
+
+    ring[static_cast<size_t>(position)] = static_cast<uint8_t>(bin);
+    position = (position + 1) % LONG_WINDOW_HOPS;
+    filled = juce::jmin(filled + 1, LONG_WINDOW_HOPS);
+}
+
+//==============================================================================
+void DynamicsAnalyzer::reset()
+{
+    rmsLevels.clear();
+    peakLevels.clear();
+    hopsSinceStatistics = 0;
+    resetLoudness();
+
+    published.store(false);
+}
+
+void DynamicsAnalyzer::resetLoudness()
+{
+    loudnessLevels.clear();
+    shortTermLufs = FLOOR_DB;
+    hasLoudness = false;
+}
+
+int DynamicsAnalyzer::binForDb(float levelDb)
+{
+    return juce::jlimit(0, NUM_BINS - 1, static_cast<int>(std::floor((levelDb - MIN_DB) / BIN_DB)));
+}
+
+juce::String DynamicsAnalyzer::windowToString(Window window)
+{
+    return window == Window::Short ? "short" : "long";
+}
+
+void DynamicsAnalyzer::addLevels(float rms, float peak)
+{
+    rmsLevels.add(binForDb(juce::Decibels::gainToDecibels(rms, FLOOR_DB)));
+    peakLevels.add(binForDb(juce::Decibels::gainToDecibels(peak, FLOOR_DB)));
+
+    if (++hopsSinceStatistics >= STATISTICS_HOPS)
+    {
+        hopsSinceStatistics = 0;
+        computeStatistics();
+    }
+}
+
+void DynamicsAnalyzer::addLoudness(float momentaryLufs, float shortTermLufsValue)
+{
+    loudnessLevels.add(binForDb(momentaryLufs));
+    shortTermLufs = shortTermLufsValue;
+    hasLoudness = true;
+}
+
+bool DynamicsAnalyzer::getReport(Report& report) const
+{
+    if (!published.load())
+        return false;
+
+    return reportSnapshot.read(report) != 0;
+}
+
+//==============================================================================
+float DynamicsAnalyzer::percentile(const Histogram& histogram, int total, float fraction) const
+{
+    // Level below which `fraction` of the gated hops fall, interpolated within the bin
+    const float target = fraction * static_cast<float>(total);
+    float below = 0.0f;
+
+    for (int bin = gateBin; bin < NUM_BINS; ++bin)
+    {
+        const auto count = static_cast<float>(histogram[static_cast<size_t>(bin)]);
+        if (count > 0.0f && below + count >= target)
+            return binLowerEdge(bin) + BIN_DB * (target - below) / count;
+
+        below += count;
+    }
+
+    return binLowerEdge(NUM_BINS);
+}
+
+float DynamicsAnalyzer::energyMeanDb(const Histogram& histogram, int firstBin, int& count) const
+{
+    double energy = 0.0;
+    count = 0;
+
+    for (int bin = firstBin; bin < NUM_BINS; ++bin)
+    {
+        const int hops = histogram[static_cast<size_t>(bin)];
+        energy += hops * binPower[static_cast<size_t>(bin)];
+        count += hops;
+    }
+
+    return count > 0 ? static_cast<float>(10.0 * std::log10(energy / count)) : FLOOR_DB;
+}
+
+void DynamicsAnalyzer::computeStatistics()
+{
+    Report report;
+
+    for (int window = 0; window < NUM_WINDOWS; ++window)
+    {
+        const auto& rms = rmsLevels.counts[static_cast<size_t>(window)];
+        const auto& peaks = peakLevels.counts[static_cast<size_t>(window)];
+        auto& statistics = report.windows[static_cast<size_t>(window)];
+
+        statistics.rmsDb = energyMeanDb(rms, gateBin, statistics.activeHops);
+        if (statistics.activeHops == 0)
+            continue;
+
+        for (int bin = NUM_BINS - 1; bin >= 0; --bin)
+        {
+            if (peaks[static_cast<size_t>(bin)] > 0)
+            {
+                statistics.peakDb = binLowerEdge(bin) + 0.5f * BIN_DB;
+                break;
+            }
+        }
+
+        statistics.crestDb = statistics.peakDb - statistics.rmsDb;
+        statistics.lowDb = percentile(rms, statistics.activeHops, LOW_PERCENTILE);
+        statistics.highDb = percentile(rms, statistics.activeHops, HIGH_PERCENTILE);
+        statistics.rangeDb = statistics.highDb - statistics.lowDb;
+
+        if (hasLoudness)
+        {
+            // Absolute gate, then the relative gate below that loudness
+            const auto& loudness = loudnessLevels.counts[static_cast<size_t>(window)];
+            int gated = 0;
+            const float absolute = energyMeanDb(loudness, gateBin, gated);
+
+            if (gated > 0)
+            {
+                statistics.loudnessLufs = energyMeanDb(loudness, juce::jmax(gateBin, binForDb(absolute + RELATIVE_GATE_LU)), gated);
+                statistics.plrDb = statistics.peakDb - statistics.loudnessLufs;
+            }
+        }
+    }
+
+    const auto& shortWindow = report.windows[static_cast<size_t>(Window::Short)];
+    if (hasLoudness && shortWindow.activeHops > 0 && shortTermLufs > GATE_DB)
+        report.psrDb = shortWindow.peakDb - shortTermLufs;
+
+    reportSnapshot.publish(report);
+    published.store(true);
+}
+
+} // namespace AIplayer
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+    DynamicsAnalyzer.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Level distribution, crest factor and peak-to-loudness statistics over
+    rolling windows, from fixed-bin dB histograms.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Core/SnapshotBuffer.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace AIplayer {
+
+/**
+ * @class DynamicsAnalyzer
+ * @brief Streaming dynamics statistics for compression decisions
+ *
+ * Fed once per 10 ms hop on the audio thread (AudioMetrics drives it from
+ * its hop grid and from the loudness meter):
+ * - hop RMS and hop peak levels, and the momentary loudness, are quantised
+ *   to BIN_DB bins and counted in one histogram per quantity and window
+ * - each window is a ring of bin indices; the hop leaving the window is
+ *   subtracted from the histogram as the new one is added, so a window
+ *   update is O(1) and the memory is fixed whatever the session length
+ *
+ * Every STATISTICS_HOPS hops the statistics are derived from the
+ * histograms in O(bins) and published lock-free (SnapshotBuffer):
+ * - percentile levels (LOW_PERCENTILE, HIGH_PERCENTILE) of the hop RMS and
+ *   their spread, over hops above GATE_DB so that silence does not count
+ * - the maximum peak, the energy mean of the hop RMS and their ratio
+ *   (crest factor)
+ * - the window loudness (BS.1770-style gating of the momentary values:
+ *   absolute at GATE_DB, relative at RELATIVE_GATE_LU) and the
+ *   peak-to-loudness ratio (PLR)
+ * - the peak-to-short-term loudness ratio (PSR): the short window's peak
+ *   against the current short-term loudness
+ *
+ * Levels are resolved to BIN_DB; peaks are sample peaks.
+ */
+class DynamicsAnalyzer
+{
+public:
+    DynamicsAnalyzer();
+
+    /// Histogram bin width and range (levels outside are clamped to the end bins)
+    static constexpr float BIN_DB = 0.5f;
+    static constexpr float MIN_DB = -100.0f;
+    static constexpr float MAX_DB = 12.0f;
+    static constexpr int NUM_BINS = 224;
+
+    /// Hops below this level (dBFS, or LUFS for loudness) are ignored
+    static constexpr float GATE_DB = -70.0f;
+
+    /// Relative loudness gate below the absolute-gated loudness (LU)
+    static constexpr float RELATIVE_GATE_LU = -10.0f;
+
+    /// Percentiles reported for the hop RMS distribution
+    static constexpr float LOW_PERCENTILE = 0.10f;
+    static constexpr float HIGH_PERCENTILE = 0.95f;
+
+    /// Window lengths in 10 ms hops (3 s, the short-term loudness window, and 30 s)
+    static constexpr int SHORT_WINDOW_HOPS = 300;
+    static constexpr int LONG_WINDOW_HOPS = 3000;
+
+    /// Hops between published statistics (100 ms)
+    static constexpr int STATISTICS_HOPS = 10;
+
+    /// Value reported when a window holds nothing above the gate
+    static constexpr float FLOOR_DB = -120.0f;
+
+    static_assert(static_cast<int>((MAX_DB - MIN_DB) / BIN_DB) == NUM_BINS, "bin range");
+    static_assert(NUM_BINS <= 256, "bins are stored as bytes");
+
+    /// Rolling windows
+    enum class Window
+    {
+        Short,      ///< SHORT_WINDOW_HOPS
+        Long        ///< LONG_WINDOW_HOPS
+    };
+
+    static constexpr int NUM_WINDOWS = 2;
+
+    /// Statistics of one window
+    struct Statistics
+    {
+        int activeHops{0};                  ///< Hops above the gate
+        float peakDb{FLOOR_DB};             ///< Highest sample peak (dBFS)
+        float rmsDb{FLOOR_DB};              ///< Energy mean of the gated hop RMS (dBFS)
+        float crestDb{0.0f};                ///< peakDb - rmsDb
+        float lowDb{FLOOR_DB};              ///< LOW_PERCENTILE of the hop RMS (dBFS)
+        float highDb{FLOOR_DB};             ///< HIGH_PERCENTILE of the hop RMS (dBFS)
+        float rangeDb{0.0f};                ///< highDb - lowDb
+        float loudnessLufs{FLOOR_DB};       ///< Gated loudness (LUFS)
+        float plrDb{0.0f};                  ///< peakDb - loudnessLufs (0 without loudness)
+    };
+
+    /// Published snapshot
+    struct Report
+    {
+        std::array<Statistics, NUM_WINDOWS> windows;
+        float psrDb{0.0f};                  ///< Short window peak - short-term loudness (0 without loudness)
+    };
+
+    /// Clears all windows (audio thread, or while stopped)
+    void reset();
+
+    /// Clears the loudness windows only, e.g. when loudness metering restarts (audio thread)
+    void resetLoudness();
+
+    /**
+     * @brief Adds one hop of levels (audio thread)
+     * @param rms RMS of the hop across channels (linear)
+     * @param peak Sample peak of the hop (linear)
+     */
+    void addLevels(float rms, float peak);
+
+    /**
+     * @brief Adds one hop of loudness (audio thread)
+     * @param momentaryLufs Momentary loudness at the end of the hop
+     * @param shortTermLufs Short-term loudness at the end of the hop
+     */
+    void addLoudness(float momentaryLufs, float shortTermLufs);
+
+    /**
+     * @brief Copies the latest statistics (any thread)
+     * @param report Receives the statistics
+     * @return true if anything has been published since the last reset
+     */
+    bool getReport(Report& report) const;
+
+    /// Converts a window to its OSC name ("short", "long")
+    static juce::String windowToString(Window window);
+
+    /// Bin of a level (clamped to the histogram range)
+    static int binForDb(float levelDb);
+
+    /// Lower edge of a bin
+    static float binLowerEdge(int bin) { return MIN_DB + static_cast<float>(bin) * BIN_DB; }
+
+private:
+    using Histogram = std::array<uint16_t, NUM_BINS>;
+
+    /// Histograms of one quantity over both windows, fed from one ring
+    struct RollingHistogram
+    {
+        std::array<uint8_t, LONG_WINDOW_HOPS> ring{};
+        std::array<Histogram, NUM_WINDOWS> counts{};
+        int position{0};
+        int filled{0};
+
+        void clear();
+        void add(int bin);
+    };
+
+    static constexpr int windowHops(int window) { return window == 0 ? SHORT_WINDOW_HOPS : LONG_WINDOW_HOPS; }
+
+    void computeStatistics();
+    float percentile(const Histogram& histogram, int total, float fraction) const;
+    float energyMeanDb(const Histogram& histogram, int firstBin, int& count) const;
+
+    RollingHistogram rmsLevels;
+    RollingHistogram peakLevels;
+    RollingHistogram loudnessLevels;
+    float shortTermLufs{FLOOR_DB};
+    bool hasLoudness{false};
+    int hopsSinceStatistics{0};
+
+    std::array<double, NUM_BINS> binPower{};    // Mean square at each bin centre
+    int gateBin{0};
+
+    SnapshotBuffer<Report> reportSnapshot;
+    std::atomic<bool> published{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DynamicsAnalyzer)
+};
+
+} // namespace AIplayer
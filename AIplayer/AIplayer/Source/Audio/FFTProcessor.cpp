@@ -18,19 +18,116 @@ FFTProcessor::FFTProcessor(int order)
     : fftOrder(order)
     , fftSize(1 << order)
     , fft(order)
-    , window(fftSize, juce::dsp::WindowingFunction<float>::hann)
 {
     // Initialize buffers
-    circularBuffer.setSize(1, fftSize * 2); // Double size for circular buffer
+    circularBuffer.setSize(1, std::max(fftSize, MIN_HISTORY_SAMPLES) * 2); // Readable half plus room for the writer
     circularBuffer.clear();
     
     // Resize FFT data arrays
     fftData.resize(fftSize * 2); // Complex FFT needs 2x size
     magnitudeData.resize(fftSize / 2);
+    monoScratch.resize(fftSize);
     
     // Clear arrays
     std::fill(fftData.begin(), fftData.end(), 0.0f);
     std::fill(magnitudeData.begin(), magnitudeData.end(), 0.0f);
+    
+    windowTable.resize(fftSize);
+    buildWindow(tableWindow);
+    
+    hopSize.store(fftSize);
+}
+
+/**
+ * @brief Fills the window table and derives its gain corrections
+ * 
+ * @details With S1 the sum of the window and S2 the sum of its squares:
+ * - a sine of amplitude A centred on bin k gives |X[k]| = A * S1 / 2, so
+ *   magnitudes are scaled by 2 / S1 (coherent gain correction)
+ * - the same sine anywhere spreads A^2 * N * S2 / S1^2 over the scaled
+ *   squared magnitudes, so N * S2 / S1^2 is the noise bandwidth in bins
+ * 
+ * The table keeps its size, so rebuilding it does not allocate.
+ */
+void FFTProcessor::buildWindow(Window type)
+{
+    using Windowing = juce::dsp::WindowingFunction<float>;
+    
+    Windowing::WindowingMethod method = Windowing::hann;
+    switch (type)
+    {
+        case Window::Rectangular:    method = Windowing::rectangular; break;
+        case Window::Hann:           method = Windowing::hann; break;
+        case Window::Hamming:        method = Windowing::hamming; break;
+        case Window::BlackmanHarris: method = Windowing::blackmanHarris; break;
+        case Window::FlatTop:        method = Windowing::flatTop; break;
+    }
+    
+    Windowing::fillWindowingTables(windowTable.data(), static_cast<size_t>(fftSize), method, false);
+    
+    double sum = 0.0, sumOfSquares = 0.0;
+    for (const float w : windowTable)
+    {
+        sum += w;
+        sumOfSquares += static_cast<double>(w) * w;
+    }
+    
+    magnitudeScale = static_cast<float>(2.0 / sum);
+    noiseBandwidth.store(static_cast<float>(fftSize * sumOfSquares / (sum * sum)));
+    tableWindow = type;
+}
+
+juce::String FFTProcessor::windowToString(Window type)
+{
+    switch (type)
+    {
+        case Window::Rectangular:    return "rectangular";
+        case Window::Hann:           return "hann";
+        case Window::Hamming:        return "hamming";
+        case Window::BlackmanHarris: return "blackman_harris";
+        case Window::FlatTop:        return "flat_top";
+    }
+    
+    return "hann";
+}
+
+FFTProcessor::Window FFTProcessor::windowFromString(const juce::String& text)
+{
+    for (const auto type : { Window::Rectangular, Window::Hann, Window::Hamming, Window::BlackmanHarris, Window::FlatTop })
+    {
+        if (text.trim().equalsIgnoreCase(windowToString(type)))
+            return type;
+    }
+    
+    return Window::Hann;
+}
+
+void FFTProcessor::resetInput()
+{
+    circularBuffer.clear();
+    writePosition.store(0);
+    validFrom.store(samplesWritten.load());
+}
+
+int FFTProcessor::copyRecentInput(float* destination, int maxSamples) const
+{
+    if (destination == nullptr || maxSamples <= 0)
+        return 0;
+    
+    // Only the newest half; the audio thread may be writing the other one
+    const int bufferSize = circularBuffer.getNumSamples();
+    const juce::int64 available = samplesWritten.load() - validFrom.load();
+    const int count = static_cast<int>(std::min<juce::int64>({ available, static_cast<juce::int64>(maxSamples),
+                                                               static_cast<juce::int64>(bufferSize / 2) }));
+    
+    auto* circularData = circularBuffer.getReadPointer(0);
+    const int start = (writePosition.load() - count + bufferSize) % bufferSize;
+    const int firstPart = std::min(count, bufferSize - start);
+    
+    juce::FloatVectorOperations::copy(destination, circularData + start, firstPart);
+    juce::FloatVectorOperations::copy(destination + firstPart, circularData, count - firstPart);
+    
+    return count;
 }
 
 void FFTProcessor::processAudioBlock(const juce::AudioBuffer<float>& buffer, double sampleRate)
@@ -44,34 +141,64 @@ void FFTProcessor::processAudioBlock(const juce::AudioBuffer<float>& buffer, dou
     if (numChannels == 0 || numSamples == 0)
         return;
     
-    // Mix to mono and write to circular buffer
+    // Per-channel downmix gains for this block
+    const int mixChannels = std::min(numChannels, ChannelLayout::MAX_CHANNELS);
+    std::array<float, ChannelLayout::MAX_CHANNELS> gains;
+    
+    if (useDownmixGains.load())
+    {
+        for (int channel = 0; channel < mixChannels; ++channel)
+            gains[channel] = downmixGains[channel].load(std::memory_order_relaxed);
+    }
+    else
+    {
+        gains.fill(1.0f / static_cast<float>(mixChannels));
+    }
+    
+    // Mix to mono channel by channel (one vectorised pass each) in chunks,
+    // then copy each chunk into the circular buffer
     auto* circularData = circularBuffer.getWritePointer(0);
     const int bufferSize = circularBuffer.getNumSamples();
+    const int chunkSize = static_cast<int>(monoScratch.size());
+    float* mono = monoScratch.data();
+    int writePos = writePosition.load();
     
-    for (int sample = 0; sample < numSamples; ++sample)
+    for (int start = 0; start < numSamples; start += chunkSize)
     {
-        float monoSample = 0.0f;
+        const int count = std::min(chunkSize, numSamples - start);
+        juce::FloatVectorOperations::clear(mono, count);
         
-        // Sum all channels
-        for (int channel = 0; channel < numChannels; ++channel)
+        for (int channel = 0; channel < mixChannels; ++channel)
         {
-            monoSample += buffer.getSample(channel, sample);
+            if (gains[channel] != 0.0f)
+                juce::FloatVectorOperations::addWithMultiply(mono, buffer.getReadPointer(channel, start),
+                                                             gains[channel], count);
         }
         
-        // Average for mono
-        monoSample /= static_cast<float>(numChannels);
-        
-        // Write to circular buffer
-        const int writePos = writePosition.load();
-        circularData[writePos] = monoSample;
-        
-        // Update write position (circular)
-        writePosition.store((writePos + 1) % bufferSize);
+        const int firstPart = std::min(count, bufferSize - writePos);
+        juce::FloatVectorOperations::copy(circularData + writePos, mono, firstPart);
+        juce::FloatVectorOperations::copy(circularData, mono + firstPart, count - firstPart);
+        writePos = (writePos + count) % bufferSize;
+    }
+    
+    writePosition.store(writePos);
+    
+    // Only this thread writes the count; the analysis thread compares against it
+    samplesWritten.store(samplesWritten.load() + numSamples);
+}
+
+void FFTProcessor::setDownmixGains(const float* gains, int numChannels)
+{
+    if (gains == nullptr)
+    {
+        useDownmixGains.store(false);
+        return;
     }
     
-    // Update samples available
-    int currentAvailable = samplesAvailable.load();
-    samplesAvailable.store(std::min(currentAvailable + numSamples, fftSize));
+    for (int channel = 0; channel < ChannelLayout::MAX_CHANNELS; ++channel)
+        downmixGains[channel].store(channel < numChannels ? gains[channel] : 0.0f, std::memory_order_relaxed);
+    
+    useDownmixGains.store(true);
 }
 
 /**
@@ -80,10 +207,10 @@ void FFTProcessor::processAudioBlock(const juce::AudioBuffer<float>& buffer, dou
  * @details This method implements the complete FFT processing pipeline:
  * 1. Validates sufficient samples are available (must have fftSize samples)
  * 2. Extracts oldest fftSize samples from circular buffer in correct order
- * 3. Applies Hann windowing to reduce spectral leakage
+ * 3. Applies the selected window (Hann by default) to reduce spectral leakage
  * 4. Performs forward FFT transform using JUCE's optimized FFT
- * 5. Converts complex FFT output to magnitude spectrum
- * 6. Normalizes magnitude values for consistent scaling
+ * 5. Keeps the magnitudes of the positive frequencies
+ * 6. Corrects them for the window's coherent gain (see buildWindow())
  * 
  * The circular buffer read algorithm ensures temporal continuity by calculating
  * the correct starting position based on current write position.
@@ -94,8 +221,8 @@ void FFTProcessor::processAudioBlock(const juce::AudioBuffer<float>& buffer, dou
  *       during FFT computation. The magnitude spectrum contains only positive
  *       frequencies (DC to Nyquist) as negative frequencies are redundant for real signals.
  * 
- * @warning The method resets samplesAvailable to 0 after computation, requiring
- *          new audio data before the next FFT can be performed.
+ * @warning A frame needs getHopSize() new samples after the previous one
+ *          (the whole FFT size by default, i.e. no overlap).
  * 
  * @see processAudioBlock() for sample accumulation
  * @see getMagnitudeSpectrum() for accessing results
@@ -103,47 +230,45 @@ void FFTProcessor::processAudioBlock(const juce::AudioBuffer<float>& buffer, dou
 bool FFTProcessor::computeFFT()
 {
     // Check if we have accumulated enough samples for FFT computation
-    if (samplesAvailable.load() < fftSize)
+    const juce::int64 written = samplesWritten.load();
+    if (written - validFrom.load() < fftSize || written - lastFrameEnd < hopSize.load())
         return false;
     
     const juce::ScopedLock sl(fftLock); // Ensure thread-safe access to FFT data
     
+    // A new window applies from this frame on
+    const Window requested = requestedWindow.load();
+    if (requested != tableWindow)
+        buildWindow(requested);
+    
     // Extract samples from circular buffer in correct chronological order
     auto* circularData = circularBuffer.getReadPointer(0);
     const int bufferSize = circularBuffer.getNumSamples();
-    int readPos = (writePosition.load() - fftSize + bufferSize) % bufferSize;
+    const int readPos = (writePosition.load() - fftSize + bufferSize) % bufferSize;
     
-    // Prepare FFT input data (interleaved real/imaginary format)
-    for (int i = 0; i < fftSize; ++i)
-    {
-        fftData[i] = circularData[readPos];      // Real part: audio sample
-        fftData[i + fftSize] = 0.0f;             // Imaginary part: zero for real input
-        readPos = (readPos + 1) % bufferSize;    // Advance with wrap-around
-    }
+    // Copy the oldest sample first; the second half is transform workspace
+    const int firstPart = std::min(fftSize, bufferSize - readPos);
+    juce::FloatVectorOperations::copy(fftData.data(), circularData + readPos, firstPart);
+    juce::FloatVectorOperations::copy(fftData.data() + firstPart, circularData, fftSize - firstPart);
+    juce::FloatVectorOperations::clear(fftData.data() + fftSize, fftSize);
     
-    // Apply Hann window to reduce spectral leakage and improve frequency resolution
-    window.multiplyWithWindowingTable(fftData.data(), fftSize);
+    // Apply the window to reduce spectral leakage
+    juce::FloatVectorOperations::multiply(fftData.data(), windowTable.data(), fftSize);
     
-    // Perform forward FFT transform (time domain → frequency domain)
-    fft.performFrequencyOnlyForwardTransform(fftData.data());
+    // Perform forward FFT transform (time domain → frequency domain); this
+    // leaves the magnitude of bin k in fftData[k]
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
     
-    // Convert complex FFT output to magnitude spectrum
-    // For real input signals, only positive frequencies (0 to Nyquist) are meaningful
-    for (int i = 0; i < fftSize / 2; ++i)
-    {
-        const float real = fftData[i];
-        const float imag = fftData[i + fftSize];
-        const float magnitude = std::sqrt(real * real + imag * imag);
-        
-        // Normalize magnitude by half FFT size for consistent scaling
-        magnitudeData[i] = magnitude / static_cast<float>(fftSize / 2);
-    }
+    // For real input signals, only positive frequencies (0 to Nyquist) are
+    // meaningful; their energy is doubled except at DC, which has no mirror
+    juce::FloatVectorOperations::multiply(magnitudeData.data(), fftData.data(), magnitudeScale, fftSize / 2);
+    magnitudeData[0] *= 0.5f;
     
     // Signal that new FFT data is available for consumption
     fftReady.store(true);
     
-    // Reset sample counter to accumulate samples for next FFT
-    samplesAvailable.store(0);
+    // The next frame waits for one hop of new samples
+    lastFrameEnd = written;
     
     return true;
 }
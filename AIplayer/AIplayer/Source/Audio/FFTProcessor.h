@@ -14,6 +14,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ChannelLayout.h"
 #include <array>
 #include <atomic>
 
@@ -28,11 +29,33 @@ namespace AIplayer {
  * - Windowing function application
  * - FFT computation
  * - Magnitude spectrum calculation
+ * 
+ * Magnitudes are corrected for the window's coherent gain, so a sine
+ * centred on a bin reads its amplitude there (a full-scale sine reads 1).
+ * Between bins the peak drops by the window's scalloping loss, but the
+ * energy summed over the bins around it and divided by
+ * getNoiseBandwidth() is the same anywhere; BandEnergyAnalyzer relies on
+ * this for calibrated band levels.
+ * 
+ * Input buses of any width (up to ChannelLayout::MAX_CHANNELS) are folded
+ * to mono with configurable per-channel gains; the default is a plain
+ * average of all channels.
  */
 class FFTProcessor
 {
 public:
     static constexpr int DEFAULT_FFT_ORDER = 10; // 2^10 = 1024 samples
+    static constexpr int MIN_HISTORY_SAMPLES = 4096; // Input readable for time-domain analysis
+    
+    /// Analysis windows
+    enum class Window
+    {
+        Rectangular,        ///< Best resolution, worst leakage (ENBW 1 bin)
+        Hann,               ///< General purpose (ENBW 1.5 bins)
+        Hamming,            ///< Lower first sidelobe than Hann (ENBW 1.36 bins)
+        BlackmanHarris,     ///< Low leakage for wide dynamic range (ENBW 2.0 bins)
+        FlatTop             ///< Negligible scalloping, for level readings (ENBW 3.8 bins)
+    };
     
     /**
      * @brief Construct FFT processor with specified order
@@ -48,12 +71,102 @@ public:
      */
     void processAudioBlock(const juce::AudioBuffer<float>& buffer, double sampleRate);
     
+    /**
+     * @brief Set the per-channel gains used to fold the input to mono
+     * @param gains One gain per channel (see ChannelLayout::downmixGains),
+     *              or nullptr to return to the default average
+     * @param numChannels Number of gains
+     */
+    void setDownmixGains(const float* gains, int numChannels);
+    
     /**
      * @brief Perform FFT computation if enough samples are available
+     * 
+     * A frame needs a full window since the last resetInput() and at least
+     * one hop of new samples since the previous frame.
+     * 
      * @return true if FFT was computed, false otherwise
      */
     bool computeFFT();
     
+    /**
+     * @brief Set the number of new samples between frames
+     * 
+     * The default is the FFT size (no overlap); half the size gives 50%
+     * overlap when the analysis is polled often enough.
+     * 
+     * @param samples Hop in samples (1 to FFT size)
+     */
+    void setHopSize(int samples) { hopSize.store(juce::jlimit(1, fftSize, samples)); }
+    
+    /**
+     * @brief Get the number of new samples between frames
+     * @return Hop in samples
+     */
+    int getHopSize() const { return hopSize.load(); }
+    
+    /**
+     * @brief Select the analysis window
+     * 
+     * Takes effect at the next computeFFT(); does not allocate.
+     * 
+     * @param type Window applied before the transform (Hann by default)
+     */
+    void setWindow(Window type) { requestedWindow.store(type); }
+    
+    /**
+     * @brief Get the selected analysis window
+     * @return Window type
+     */
+    Window getWindow() const { return requestedWindow.load(); }
+    
+    /**
+     * @brief Get the equivalent noise bandwidth of the window of the last frame
+     * 
+     * Summed squared magnitudes divided by this give the power of the
+     * signal they cover.
+     * 
+     * @return ENBW in bins (1 for the rectangular window)
+     */
+    float getNoiseBandwidth() const { return noiseBandwidth.load(); }
+    
+    /**
+     * @brief Convert a window to its name ("hann", "flat_top", ...)
+     * @param type Window type
+     * @return Window name
+     */
+    static juce::String windowToString(Window type);
+    
+    /**
+     * @brief Parse a window name
+     * @param text Name as returned by windowToString()
+     * @return The window (Hann if the name is unknown)
+     */
+    static Window windowFromString(const juce::String& text);
+    
+    /**
+     * @brief Discard buffered input, e.g. when analysis switches to this processor
+     * 
+     * Called from the thread that feeds processAudioBlock(); does not allocate.
+     */
+    void resetInput();
+    
+    /**
+     * @brief Copy the newest mono input samples, oldest first
+     * 
+     * At most half the circular buffer is readable: at least
+     * MIN_HISTORY_SAMPLES (and the FFT size), so time-domain analysis such
+     * as pitch tracking can share this input. The other half is where the
+     * audio thread writes while a copy runs, so a host block of up to that
+     * size never overwrites samples being copied. Called from the analysis
+     * thread; does not allocate.
+     * 
+     * @param destination Receives the samples
+     * @param maxSamples Capacity of destination
+     * @return Number of samples copied (fewer after resetInput())
+     */
+    int copyRecentInput(float* destination, int maxSamples) const;
+    
     /**
      * @brief Get the magnitude spectrum from last FFT computation
      * @return Read-only access to magnitude data
@@ -94,12 +207,27 @@ private:
     const int fftOrder;
     const int fftSize;
     juce::dsp::FFT fft;
-    juce::dsp::WindowingFunction<float> window;
+    
+    // Window table and its gain corrections (rebuilt by computeFFT() on change)
+    void buildWindow(Window type);
+    std::vector<float> windowTable;
+    std::atomic<Window> requestedWindow{Window::Hann};
+    Window tableWindow{Window::Hann};
+    float magnitudeScale{0.0f};                     // 2 / sum of the window
+    std::atomic<float> noiseBandwidth{1.5f};
     
     // Audio buffers
     juce::AudioBuffer<float> circularBuffer;
     std::atomic<int> writePosition{0};
-    std::atomic<int> samplesAvailable{0};
+    std::atomic<juce::int64> samplesWritten{0};     // Total fed (audio thread)
+    std::atomic<juce::int64> validFrom{0};          // samplesWritten at the last resetInput()
+    juce::int64 lastFrameEnd{0};                    // samplesWritten at the last frame (analysis thread)
+    std::atomic<int> hopSize{0};
+    
+    // Downmix
+    std::array<std::atomic<float>, ChannelLayout::MAX_CHANNELS> downmixGains{};
+    std::atomic<bool> useDownmixGains{false};
+    std::vector<float> monoScratch;
     
     // FFT data
     std::vector<float> fftData;
@@ -18,16 +18,30 @@ FrequencyAnalyzer::FrequencyAnalyzer(Logger& log, const Config& cfg)
     : logger(log)
     , config(cfg)
 {
-    // Create FFT processor
-    fftProcessor = std::make_unique<FFTProcessor>(config.fftOrder);
+    // Create an FFT processor for every selectable order
+    minFftOrder = config.minFftOrder > 0 ? juce::jmin(config.minFftOrder, config.fftOrder) : config.fftOrder;
+    const int maxFftOrder = config.maxFftOrder > 0 ? juce::jmax(config.maxFftOrder, config.fftOrder) : config.fftOrder;
+    
+    for (int order = minFftOrder; order <= maxFftOrder; ++order)
+    {
+        fftProcessors.push_back(std::make_unique<FFTProcessor>(order));
+        fftProcessors.back()->setWindow(config.window);
+    }
+    
+    requestedProcessor.store(config.fftOrder - minFftOrder);
+    activeProcessor.store(config.fftOrder - minFftOrder);
     
     // Create band analyzer
     bandAnalyzer = std::make_unique<BandEnergyAnalyzer>(config.customBandLimits);
     bandAnalyzer->setAWeighting(config.enableAWeighting);
     
+    static_assert(FFTProcessor::MIN_HISTORY_SAMPLES >= PitchTracker::MAX_WINDOW_SIZE,
+                  "the FFT input history must cover the pitch window");
+    pitchInput.resize(PitchTracker::MAX_WINDOW_SIZE);
+    
     logger.log(Logger::Level::Info, 
               "FrequencyAnalyzer initialized with FFT order " + juce::String(config.fftOrder) +
-              " (size: " + juce::String(fftProcessor->getFFTSize()) + ")");
+              " (size: " + juce::String(getFFTSize()) + ")");
     
     // Start analysis if configured
     if (config.autoStart)
@@ -44,8 +58,16 @@ FrequencyAnalyzer::~FrequencyAnalyzer()
 
 void FrequencyAnalyzer::processBlock(const juce::AudioBuffer<float>& buffer, double sampleRate)
 {
+    // Switch processors here, on the thread that feeds them
+    const int requested = requestedProcessor.load();
+    if (requested != activeProcessor.load())
+    {
+        fftProcessors[static_cast<size_t>(requested)]->resetInput();
+        activeProcessor.store(requested);
+    }
+    
     // Feed audio to FFT processor
-    fftProcessor->processAudioBlock(buffer, sampleRate);
+    getActiveProcessor().processAudioBlock(buffer, sampleRate);
     
     // Mark that we should compute on next timer callback
     shouldCompute.store(true);
@@ -89,8 +111,10 @@ bool FrequencyAnalyzer::computeNow()
     
     auto startTime = juce::Time::getMillisecondCounterHiRes();
     
+    auto& fftProcessor = getActiveProcessor();
+    
     // Compute FFT
-    if (!fftProcessor->computeFFT())
+    if (!fftProcessor.computeFFT())
     {
         return false;
     }
@@ -100,13 +124,31 @@ bool FrequencyAnalyzer::computeNow()
         const juce::ScopedLock sl(analysisLock);
         
         bandAnalyzer->analyzeBands(
-            fftProcessor->getMagnitudeSpectrum(),
-            fftProcessor->getMagnitudeSpectrumSize(),
-            fftProcessor->getBinWidth(),
-            44100.0 // This will be updated with actual sample rate
+            fftProcessor.getMagnitudeSpectrum(),
+            fftProcessor.getMagnitudeSpectrumSize(),
+            fftProcessor.getBinWidth(),
+            static_cast<double>(fftProcessor.getBinWidth()) * fftProcessor.getFFTSize(),
+            fftProcessor.getNoiseBandwidth()
         );
     }
     
+    // Make the new spectrum available to lock-free readers
+    publishFrame(fftProcessor);
+    lastFrameProcessor = &fftProcessor;
+    
+    // Each frame stands for one hop of audio, whatever the timer rate
+    const double frameSampleRate = static_cast<double>(fftProcessor.getBinWidth()) * fftProcessor.getFFTSize();
+    longTermSpectrum.addFrame(fftProcessor.getMagnitudeSpectrum(), fftProcessor.getMagnitudeSpectrumSize(),
+                              fftProcessor.getBinWidth(), fftProcessor.getNoiseBandwidth(),
+                              fftProcessor.getHopSize() / frameSampleRate);
+    
+    if (isPitchTracking())
+    {
+        const int numSamples = fftProcessor.copyRecentInput(pitchInput.data(), static_cast<int>(pitchInput.size()));
+        pitchTracker.process(pitchInput.data(), numSamples,
+                             fftProcessor.getBinWidth() * static_cast<float>(fftProcessor.getFFTSize()));
+    }
+    
     // Update performance metrics
     auto endTime = juce::Time::getMillisecondCounterHiRes();
     float computeTime = static_cast<float>(endTime - startTime);
@@ -118,7 +160,7 @@ bool FrequencyAnalyzer::computeNow()
     
     // Reset flags
     shouldCompute.store(false);
-    fftProcessor->resetFFTReady();
+    fftProcessor.resetFFTReady();
     bandAnalyzer->resetAnalysisReady();
     
     // Log performance periodically
@@ -131,6 +173,75 @@ bool FrequencyAnalyzer::computeNow()
     return true;
 }
 
+/**
+ * @brief Condenses the magnitude spectrum into a fixed-size display frame
+ *
+ * @details Maps the linear FFT bins onto AnalysisFrame::NUM_SPECTRUM_BINS
+ * logarithmically spaced bins between 20 Hz and 20 kHz. Each display bin takes
+ * the strongest FFT bin inside its range; at low frequencies where a display bin
+ * is narrower than one FFT bin, the magnitude is linearly interpolated at the
+ * bin centre instead. The result is published through frameSnapshot so the UI
+ * never has to touch analysisLock.
+ */
+void FrequencyAnalyzer::publishFrame(const FFTProcessor& fftProcessor)
+{
+    const float* magnitudes = fftProcessor.getMagnitudeSpectrum();
+    const int numBins = fftProcessor.getMagnitudeSpectrumSize();
+    const float binWidth = fftProcessor.getBinWidth();
+    
+    if (magnitudes == nullptr || numBins <= 1 || binWidth <= 0.0f)
+        return;
+    
+    // Bands only: keep the last spectrum, update the band energies
+    if (!spectrumEnabled.load())
+    {
+        const auto energies = bandAnalyzer->getAllBandEnergies();
+        std::copy(energies.begin(), energies.end(), scratchFrame.bandEnergiesDb.begin());
+        ++scratchFrame.frameIndex;
+        frameSnapshot.publish(scratchFrame);
+        return;
+    }
+    
+    constexpr int numDisplayBins = AnalysisFrame::NUM_SPECTRUM_BINS;
+    const float logMin = std::log(AnalysisFrame::MIN_FREQUENCY);
+    const float logRange = std::log(AnalysisFrame::MAX_FREQUENCY) - logMin;
+    
+    for (int i = 0; i < numDisplayBins; ++i)
+    {
+        const float lowFreq  = std::exp(logMin + logRange * static_cast<float>(i) / numDisplayBins);
+        const float highFreq = std::exp(logMin + logRange * static_cast<float>(i + 1) / numDisplayBins);
+        
+        const int startBin = juce::jlimit(0, numBins - 1, static_cast<int>(std::ceil(lowFreq / binWidth)));
+        const int endBin   = juce::jlimit(0, numBins - 1, static_cast<int>(std::floor(highFreq / binWidth)));
+        
+        float magnitude = 0.0f;
+        
+        if (endBin >= startBin)
+        {
+            for (int bin = startBin; bin <= endBin; ++bin)
+                magnitude = std::max(magnitude, magnitudes[bin]);
+        }
+        else
+        {
+            // Display bin falls between two FFT bins - interpolate at its centre
+            const float position = std::sqrt(lowFreq * highFreq) / binWidth;
+            const int lower = juce::jlimit(0, numBins - 2, static_cast<int>(position));
+            const float fraction = juce::jlimit(0.0f, 1.0f, position - static_cast<float>(lower));
+            magnitude = magnitudes[lower] + fraction * (magnitudes[lower + 1] - magnitudes[lower]);
+        }
+        
+        scratchFrame.spectrumDb[static_cast<size_t>(i)] = juce::Decibels::gainToDecibels(magnitude, -100.0f);
+    }
+    
+    const auto energies = bandAnalyzer->getAllBandEnergies();
+    std::copy(energies.begin(), energies.end(), scratchFrame.bandEnergiesDb.begin());
+    
+    scratchFrame.sampleRate = static_cast<double>(binWidth) * fftProcessor.getFFTSize();
+    ++scratchFrame.frameIndex;
+    
+    frameSnapshot.publish(scratchFrame);
+}
+
 void FrequencyAnalyzer::timerCallback()
 {
     // Lazy computation - only compute if new data is available
@@ -161,6 +272,51 @@ void FrequencyAnalyzer::setAWeighting(bool enable)
               juce::String("A-weighting ") + (enable ? "enabled" : "disabled"));
 }
 
+int FrequencyAnalyzer::getFullSpectrumDb(float* destination, int maxBins, float& binWidthHz) const
+{
+    if (lastFrameProcessor == nullptr || destination == nullptr)
+        return 0;
+    
+    const float* magnitudes = lastFrameProcessor->getMagnitudeSpectrum();
+    const int numBins = juce::jmin(maxBins, lastFrameProcessor->getMagnitudeSpectrumSize());
+    
+    for (int bin = 0; bin < numBins; ++bin)
+        destination[bin] = juce::Decibels::gainToDecibels(magnitudes[bin], -120.0f);
+    
+    binWidthHz = lastFrameProcessor->getBinWidth();
+    return numBins;
+}
+
+void FrequencyAnalyzer::setDownmixGains(const float* gains, int numChannels)
+{
+    for (auto& processor : fftProcessors)
+        processor->setDownmixGains(gains, numChannels);
+}
+
+void FrequencyAnalyzer::setFFTOrder(int order)
+{
+    const int index = juce::jlimit(0, static_cast<int>(fftProcessors.size()) - 1, order - minFftOrder);
+    requestedProcessor.store(index);
+}
+
+void FrequencyAnalyzer::setOverlap(float fraction)
+{
+    fraction = juce::jlimit(0.0f, 0.875f, fraction);
+    overlap.store(fraction);
+    
+    for (auto& processor : fftProcessors)
+        processor->setHopSize(juce::roundToInt(processor->getFFTSize() * (1.0f - fraction)));
+}
+
+void FrequencyAnalyzer::setWindow(FFTProcessor::Window type)
+{
+    for (auto& processor : fftProcessors)
+        processor->setWindow(type);
+    
+    config.window = type;
+    logger.log(Logger::Level::Info, "Analysis window set to " + FFTProcessor::windowToString(type));
+}
+
 void FrequencyAnalyzer::setUpdateRate(int hz)
 {
     hz = juce::jlimit(1, 100, hz);
@@ -17,8 +17,13 @@
 #include "FFTProcessor.h"
 #include "BandEnergyAnalyzer.h"
 #include "../Core/Logger.h"
+#include "../Core/SnapshotBuffer.h"
+#include "../Models/AnalysisFrame.h"
+#include "LongTermSpectrum.h"
+#include "PitchTracker.h"
 #include <memory>
 #include <atomic>
+#include <vector>
 
 namespace AIplayer {
 
@@ -31,6 +36,11 @@ namespace AIplayer {
  * - Implements lazy computation to minimize CPU usage
  * - Provides thread-safe access to analysis results
  * - Configurable update rates and FFT parameters
+ * 
+ * Every FFT order between Config::minFftOrder and Config::maxFftOrder gets
+ * its own FFTProcessor up front, so setFFTOrder() only switches which one the
+ * audio thread feeds; the switch happens at the next processBlock(), which
+ * clears the newly fed processor's input.
  */
 class FrequencyAnalyzer : public juce::Timer
 {
@@ -45,9 +55,13 @@ public:
         bool enableAWeighting;                // Apply A-weighting to bands
         bool autoStart;                       // Start analysis automatically
         const float* customBandLimits;        // Custom frequency bands
+        int minFftOrder;                      // Smallest selectable order (0 = fftOrder)
+        int maxFftOrder;                      // Largest selectable order (0 = fftOrder)
+        FFTProcessor::Window window;          // Analysis window
         
         Config() : fftOrder(10), updateRateHz(10), enableAWeighting(false), 
-                   autoStart(true), customBandLimits(nullptr) {}
+                   autoStart(true), customBandLimits(nullptr),
+                   minFftOrder(0), maxFftOrder(0), window(FFTProcessor::Window::Hann) {}
     };
     
     /**
@@ -65,6 +79,14 @@ public:
      */
     void processBlock(const juce::AudioBuffer<float>& buffer, double sampleRate);
     
+    /**
+     * @brief Set how multichannel input is folded to mono for analysis
+     * @param gains One gain per channel (see ChannelLayout::downmixGains),
+     *              or nullptr for a plain average
+     * @param numChannels Number of gains
+     */
+    void setDownmixGains(const float* gains, int numChannels);
+    
     /**
      * @brief Start frequency analysis
      */
@@ -110,7 +132,142 @@ public:
      * @brief Get FFT configuration
      * @return Current FFT order (size = 2^order)
      */
-    int getFFTOrder() const { return fftProcessor->getFFTSize(); }
+    int getFFTOrder() const { return getActiveProcessor().getFFTSize(); }
+    
+    /**
+     * @brief Select the FFT size
+     * 
+     * Takes effect at the next processBlock(); does not allocate.
+     * 
+     * @param order FFT order (size = 2^order), clamped to the configured range
+     */
+    void setFFTOrder(int order);
+    
+    /**
+     * @brief Get the FFT size currently analysed
+     * @return FFT size in samples
+     */
+    int getFFTSize() const { return getActiveProcessor().getFFTSize(); }
+    
+    /**
+     * @brief Set the overlap between successive frames
+     * @param fraction 0 (each frame needs a full window of new samples) to 0.875
+     */
+    void setOverlap(float fraction);
+    
+    /**
+     * @brief Get the overlap between successive frames
+     * @return Overlap fraction
+     */
+    float getOverlap() const { return overlap.load(); }
+    
+    /**
+     * @brief Select the analysis window for every FFT size
+     * 
+     * Takes effect at the next computed frame; band energies stay
+     * calibrated whichever window is used.
+     * 
+     * @param type Window type
+     */
+    void setWindow(FFTProcessor::Window type);
+    
+    /**
+     * @brief Get the analysis window
+     * @return Window type
+     */
+    FFTProcessor::Window getWindow() const { return getActiveProcessor().getWindow(); }
+    
+    /**
+     * @brief Enable/disable the log-binned display spectrum
+     * 
+     * Band energies are computed either way; without the spectrum the
+     * frame snapshot keeps its last spectrum and only the bands update.
+     * 
+     * @param enable true to publish the spectrum
+     */
+    void setSpectrumEnabled(bool enable) { spectrumEnabled.store(enable); }
+    
+    /**
+     * @brief Check whether the display spectrum is computed
+     * @return true if enabled
+     */
+    bool isSpectrumEnabled() const { return spectrumEnabled.load(); }
+    
+    /**
+     * @brief Get the analysis update rate
+     * @return Update rate in Hz
+     */
+    int getUpdateRate() const { return config.updateRateHz; }
+    
+    /**
+     * @brief Get the total time spent computing analysis frames
+     * 
+     * Read on the message thread (where frames are computed).
+     * 
+     * @return Milliseconds since construction
+     */
+    double getTotalComputeTime() const { return totalComputeTime; }
+    
+    /**
+     * @brief Get the lock-free snapshot of the latest analysis frame
+     *
+     * Readers (e.g. the editor's spectrum view) poll the sequence number and
+     * copy the frame only when it changed.
+     *
+     * @return Snapshot buffer holding the most recent AnalysisFrame
+     */
+    const SnapshotBuffer<AnalysisFrame>& getFrameSnapshot() const { return frameSnapshot; }
+    
+    /**
+     * @brief Copy the full-resolution spectrum of the latest frame in dB
+     * 
+     * One value per FFT bin (bin k at k * binWidthHz), from the processor
+     * that computed the latest frame. Message thread only, where frames
+     * are computed.
+     * 
+     * @param destination Receives up to maxBins levels (dB, floor -120)
+     * @param maxBins Capacity of destination
+     * @param binWidthHz Receives the bin spacing
+     * @return Number of bins written (0 before the first frame)
+     */
+    int getFullSpectrumDb(float* destination, int maxBins, float& binWidthHz) const;
+    
+    /**
+     * @brief Get the long-term average spectrum
+     * 
+     * Every computed frame is added, standing for one update interval of
+     * audio. Message thread only, where frames are computed.
+     * 
+     * @return The LTAS accumulator (mode, reset, references, comparison)
+     */
+    LongTermSpectrum& getLongTermSpectrum() { return longTermSpectrum; }
+    const LongTermSpectrum& getLongTermSpectrum() const { return longTermSpectrum; }
+    
+    /**
+     * @brief Get the pitch tracker
+     * 
+     * Enable it (and set its range) for tonal sources; it then analyses the
+     * newest input at every computed frame. Message thread only.
+     * 
+     * @return The f0 tracker
+     */
+    PitchTracker& getPitchTracker() { return pitchTracker; }
+    const PitchTracker& getPitchTracker() const { return pitchTracker; }
+    
+    /**
+     * @brief Allow/forbid pitch tracking (analysis governor)
+     * 
+     * Tracking runs only while it is both enabled on the tracker and allowed.
+     * 
+     * @param allow true to allow
+     */
+    void setPitchAllowed(bool allow) { pitchAllowed.store(allow); }
+    
+    /**
+     * @brief Check whether pitch tracking runs
+     * @return true if enabled and allowed
+     */
+    bool isPitchTracking() const { return pitchAllowed.load() && pitchTracker.isEnabled(); }
     
     /**
      * @brief Enable/disable A-weighting
@@ -128,8 +285,20 @@ private:
     // Timer callback for lazy computation
     void timerCallback() override;
     
-    // Components
-    std::unique_ptr<FFTProcessor> fftProcessor;
+    // Builds the log-binned display frame from the current magnitude spectrum
+    void publishFrame(const FFTProcessor& processor);
+    
+    // Processor the audio thread feeds
+    FFTProcessor& getActiveProcessor() const { return *fftProcessors[static_cast<size_t>(activeProcessor.load())]; }
+    
+    // Components (one FFT processor per selectable order)
+    std::vector<std::unique_ptr<FFTProcessor>> fftProcessors;
+    int minFftOrder{10};
+    std::atomic<int> requestedProcessor{0};
+    std::atomic<int> activeProcessor{0};
+    std::atomic<float> overlap{0.0f};
+    std::atomic<bool> spectrumEnabled{true};
+    const FFTProcessor* lastFrameProcessor{nullptr};
     std::unique_ptr<BandEnergyAnalyzer> bandAnalyzer;
     Logger& logger;
     
@@ -143,6 +312,18 @@ private:
     std::atomic<int> computeCount{0};
     double totalComputeTime{0.0};
     
+    // Latest result for lock-free readers
+    SnapshotBuffer<AnalysisFrame> frameSnapshot;
+    AnalysisFrame scratchFrame;
+    
+    // Long-term average of every frame
+    LongTermSpectrum longTermSpectrum;
+    
+    // Fundamental-frequency tracking over the newest input
+    PitchTracker pitchTracker;
+    std::vector<float> pitchInput;
+    std::atomic<bool> pitchAllowed{true};
+    
     // Thread safety
     mutable juce::CriticalSection analysisLock;
     
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    HopScheduler.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Slices host blocks of any size into fixed analysis hops.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace AIplayer {
+
+/**
+ * @class HopScheduler
+ * @brief Maps host blocks onto a fixed grid of analysis hops
+ *
+ * Hosts call processBlock() with whatever buffer size they like, and may
+ * change it between callbacks. Measurements that are finalised per host
+ * block (a block RMS, a block peak) therefore differ between a 64-sample
+ * and a 1024-sample setting. The scheduler keeps the position within the
+ * current hop across callbacks and splits every block into segments that
+ * never cross a hop boundary:
+ * - small blocks accumulate until a hop completes
+ * - large blocks are cut into several hops plus a partial one
+ *
+ * Meters accumulate in the segment callback and finalise in the hop
+ * callback, so their results depend only on the audio and the sample rate.
+ * Hops are counted from prepare(); the count is a sample-accurate time stamp
+ * (hop n ends at sample (n + 1) * getHopSamples()). The work per block is one
+ * callback per segment, i.e. constant per second of audio apart from the
+ * single partial segment at the end of a block.
+ */
+class HopScheduler
+{
+public:
+    /// Default hop: 10 ms, the LoudnessMeter and telemetry grid
+    static constexpr double DEFAULT_HOP_SECONDS = 0.010;
+
+    /**
+     * @brief Sets the hop length and restarts the grid
+     *
+     * @param sampleRate Processing sample rate
+     * @param hopSeconds Hop length (rounded to whole samples, at least one)
+     */
+    void prepare(double sampleRate, double hopSeconds = DEFAULT_HOP_SECONDS)
+    {
+        hopSamples = juce::jmax(1, juce::roundToInt(sampleRate * hopSeconds));
+        reset();
+    }
+
+    /// Restarts the grid at the next sample
+    void reset()
+    {
+        hopPosition = 0;
+        hopsCompleted = 0;
+    }
+
+    /**
+     * @brief Walks a block of samples along the hop grid
+     *
+     * @param numSamples Samples in the block
+     * @param segment Called as segment(startSample, count) for each run within one hop
+     * @param hopComplete Called as hopComplete(hopIndex) after the segment that completes a hop
+     * @return Number of hops completed within the block
+     */
+    template <typename SegmentCallback, typename HopCallback>
+    int process(int numSamples, SegmentCallback&& segment, HopCallback&& hopComplete)
+    {
+        int completed = 0;
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int count = juce::jmin(numSamples - start, hopSamples - hopPosition);
+            segment(start, count);
+
+            hopPosition += count;
+            start += count;
+
+            if (hopPosition == hopSamples)
+            {
+                hopPosition = 0;
+                hopComplete(hopsCompleted++);
+                ++completed;
+            }
+        }
+
+        return completed;
+    }
+
+    /// Hop length in samples
+    int getHopSamples() const { return hopSamples; }
+
+    /// Samples remaining until the current hop completes
+    int getSamplesUntilHop() const { return hopSamples - hopPosition; }
+
+    /// Samples already in the current (incomplete) hop
+    int getHopPosition() const { return hopPosition; }
+
+    /// Hops completed since prepare() or reset()
+    juce::int64 getHopsCompleted() const { return hopsCompleted; }
+
+private:
+    int hopSamples{441};
+    int hopPosition{0};
+    juce::int64 hopsCompleted{0};
+};
+
+} // namespace AIplayer
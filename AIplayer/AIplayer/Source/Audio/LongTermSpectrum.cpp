@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+    LongTermSpectrum.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the long-term average spectrum.
+
+  ==============================================================================
+*/
+
+#include "LongTermSpectrum.h"
+
+namespace AIplayer {
+
+namespace {
+    /// Bins above this level over the floor carry signal
+    constexpr float SIGNAL_MARGIN_DB = 1.0f;
+
+    float binEdge(float bin)
+    {
+        return LongTermSpectrum::MIN_FREQUENCY * std::pow(2.0f, bin / LongTermSpectrum::BINS_PER_OCTAVE);
+    }
+}
+
+//==============================================================================
+void LongTermSpectrum::setMode(Mode newMode, double timeConstantSeconds)
+{
+    mode = newMode;
+    timeConstant = juce::jmax(0.1, timeConstantSeconds);
+}
+
+void LongTermSpectrum::reset()
+{
+    power.fill(0.0);
+    integratedSeconds = 0.0;
+}
+
+float LongTermSpectrum::getBinFrequency(int bin)
+{
+    return binEdge(static_cast<float>(bin) + 0.5f);
+}
+
+float LongTermSpectrum::getLevelDb(int bin) const
+{
+    const auto value = power[static_cast<size_t>(juce::jlimit(0, NUM_BINS - 1, bin))];
+    return value > 0.0 ? juce::jmax(FLOOR_DB, static_cast<float>(10.0 * std::log10(value))) : FLOOR_DB;
+}
+
+juce::String LongTermSpectrum::modeToString(Mode mode)
+{
+    return mode == Mode::Infinite ? "infinite" : "exponential";
+}
+
+LongTermSpectrum::Mode LongTermSpectrum::modeFromString(const juce::String& text)
+{
+    return text.trim().equalsIgnoreCase("infinite") ? Mode::Infinite : Mode::Exponential;
+}
+
+//==============================================================================
+void LongTermSpectrum::updateMapping(int numBins, float binWidth)
+{
+    for (int i = 0; i < NUM_BINS; ++i)
+    {
+        auto& range = mapping[static_cast<size_t>(i)];
+        range.start = static_cast<int>(std::ceil(binEdge(static_cast<float>(i)) / binWidth));
+        range.end = juce::jmin(numBins - 1, static_cast<int>(std::floor(binEdge(static_cast<float>(i + 1)) / binWidth)));
+        range.position = getBinFrequency(i) / binWidth;
+    }
+
+    mappedBins = numBins;
+    mappedWidth = binWidth;
+}
+
+void LongTermSpectrum::addFrame(const float* magnitudes, int numBins, float binWidth, float noiseBandwidth,
+                                double frameSeconds)
+{
+    if (magnitudes == nullptr || numBins < 2 || binWidth <= 0.0f || noiseBandwidth <= 0.0f || frameSeconds <= 0.0)
+        return;
+
+    if (numBins != mappedBins || binWidth != mappedWidth)
+        updateMapping(numBins, binWidth);
+
+    // Until the average spans one time constant both modes are a plain mean,
+    // so the first frames do not dominate an exponential average
+    const double meanWeight = frameSeconds / (integratedSeconds + frameSeconds);
+    const double weight = mode == Mode::Infinite
+        ? meanWeight
+        : juce::jmax(meanWeight, 1.0 - std::exp(-frameSeconds / timeConstant));
+
+    // Power per FFT bin to power per Hz
+    const double density = 1.0 / (static_cast<double>(noiseBandwidth) * binWidth);
+
+    for (int i = 0; i < NUM_BINS; ++i)
+    {
+        const auto& range = mapping[static_cast<size_t>(i)];
+        double framePower = 0.0;
+
+        if (range.end >= range.start)
+        {
+            for (int bin = range.start; bin <= range.end; ++bin)
+                framePower += static_cast<double>(magnitudes[bin]) * magnitudes[bin];
+
+            framePower /= (range.end - range.start + 1);
+        }
+        else if (range.position < static_cast<float>(numBins - 1))
+        {
+            // Narrower than one FFT bin - interpolate at the centre
+            const int lower = static_cast<int>(range.position);
+            const double fraction = range.position - static_cast<float>(lower);
+            const double low = static_cast<double>(magnitudes[lower]) * magnitudes[lower];
+            const double high = static_cast<double>(magnitudes[lower + 1]) * magnitudes[lower + 1];
+            framePower = low + fraction * (high - low);
+        }
+
+        auto& average = power[static_cast<size_t>(i)];
+        average += weight * (framePower * density - average);
+    }
+
+    integratedSeconds += frameSeconds;
+}
+
+//==============================================================================
+bool LongTermSpectrum::setReference(const juce::String& name, const float* frequencies, const float* levelsDb, int numPoints)
+{
+    if (name.isEmpty() || frequencies == nullptr || levelsDb == nullptr || numPoints < 2)
+        return false;
+
+    for (int point = 0; point < numPoints; ++point)
+        if (frequencies[point] <= 0.0f || (point > 0 && frequencies[point] <= frequencies[point - 1]))
+            return false;
+
+    std::array<float, NUM_BINS> curve;
+
+    for (int i = 0; i < NUM_BINS; ++i)
+    {
+        const float logFrequency = std::log(getBinFrequency(i));
+        int upper = 1;
+        while (upper < numPoints - 1 && frequencies[upper] < getBinFrequency(i))
+            ++upper;
+
+        const float logLow = std::log(frequencies[upper - 1]);
+        const float logHigh = std::log(frequencies[upper]);
+        const float fraction = juce::jlimit(0.0f, 1.0f, (logFrequency - logLow) / (logHigh - logLow));
+
+        curve[static_cast<size_t>(i)] = levelsDb[upper - 1] + fraction * (levelsDb[upper] - levelsDb[upper - 1]);
+    }
+
+    references[name] = curve;
+    return true;
+}
+
+bool LongTermSpectrum::loadReference(const juce::String& name, const juce::File& file)
+{
+    if (!file.existsAsFile())
+        return false;
+
+    juce::StringArray lines;
+    file.readLines(lines);
+
+    std::vector<float> frequencies, levels;
+
+    for (const auto& line : lines)
+    {
+        const auto text = line.trim();
+        if (text.isEmpty() || text.startsWithChar('#'))
+            continue;
+
+        juce::StringArray tokens;
+        tokens.addTokens(text, " \t,;", "");
+        tokens.removeEmptyStrings();
+
+        if (tokens.size() < 2)
+            continue;
+
+        frequencies.push_back(tokens[0].getFloatValue());
+        levels.push_back(tokens[1].getFloatValue());
+    }
+
+    return setReference(name, frequencies.data(), levels.data(), static_cast<int>(frequencies.size()));
+}
+
+juce::StringArray LongTermSpectrum::getReferenceNames() const
+{
+    juce::StringArray names;
+    for (const auto& reference : references)
+        names.add(reference.first);
+    return names;
+}
+
+//==============================================================================
+LongTermSpectrum::Comparison LongTermSpectrum::compare(const juce::String& name) const
+{
+    Comparison result;
+
+    const auto found = references.find(name);
+    if (found == references.end() || integratedSeconds <= 0.0)
+        return result;
+
+    const auto& reference = found->second;
+
+    // Align the reference to the track's level over the bins with signal
+    std::array<bool, NUM_BINS> hasSignal;
+    std::array<float, NUM_BINS> levels;
+    double offset = 0.0;
+    int count = 0;
+
+    for (int i = 0; i < NUM_BINS; ++i)
+    {
+        const auto index = static_cast<size_t>(i);
+        levels[index] = getLevelDb(i);
+        hasSignal[index] = levels[index] > FLOOR_DB + SIGNAL_MARGIN_DB;
+
+        if (hasSignal[index])
+        {
+            offset += levels[index] - reference[index];
+            ++count;
+        }
+    }
+
+    if (count == 0)
+        return result;
+
+    result.valid = true;
+    result.offsetDb = static_cast<float>(offset / count);
+
+    double squares = 0.0;
+    std::array<double, BandEnergyAnalyzer::NUM_BANDS> bandSums{};
+    std::array<int, BandEnergyAnalyzer::NUM_BANDS> bandCounts{};
+
+    for (int i = 0; i < NUM_BINS; ++i)
+    {
+        const auto index = static_cast<size_t>(i);
+        if (!hasSignal[index])
+            continue;
+
+        const float deviation = levels[index] - (reference[index] + result.offsetDb);
+        result.deviationDb[index] = deviation;
+        squares += static_cast<double>(deviation) * deviation;
+
+        const float frequency = getBinFrequency(i);
+        for (int band = 0; band < BandEnergyAnalyzer::NUM_BANDS; ++band)
+        {
+            if (frequency >= BandEnergyAnalyzer::DEFAULT_BAND_LIMITS[band]
+                && frequency < BandEnergyAnalyzer::DEFAULT_BAND_LIMITS[band + 1])
+            {
+                bandSums[static_cast<size_t>(band)] += deviation;
+                ++bandCounts[static_cast<size_t>(band)];
+            }
+        }
+    }
+
+    result.rmsDeviationDb = static_cast<float>(std::sqrt(squares / count));
+
+    for (size_t band = 0; band < bandSums.size(); ++band)
+        result.bandDeviationDb[band] = bandCounts[band] > 0 ? static_cast<float>(bandSums[band] / bandCounts[band]) : 0.0f;
+
+    // Suggested EQ: undo the deviation, smoothed over half an octave
+    for (int i = 0; i < NUM_BINS; ++i)
+    {
+        if (!hasSignal[static_cast<size_t>(i)])
+            continue;
+
+        float sum = 0.0f;
+        int used = 0;
+        for (int neighbour = juce::jmax(0, i - 1); neighbour <= juce::jmin(NUM_BINS - 1, i + 1); ++neighbour)
+        {
+            if (hasSignal[static_cast<size_t>(neighbour)])
+            {
+                sum += result.deviationDb[static_cast<size_t>(neighbour)];
+                ++used;
+            }
+        }
+
+        result.eqDb[static_cast<size_t>(i)] = juce::jlimit(-MAX_EQ_DB, MAX_EQ_DB, -sum / static_cast<float>(used));
+    }
+
+    return result;
+}
+
+} // namespace AIplayer
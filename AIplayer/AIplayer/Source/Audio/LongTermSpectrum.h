@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+    LongTermSpectrum.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Long-term average spectrum (LTAS) with reference-curve matching.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BandEnergyAnalyzer.h"
+#include <array>
+#include <map>
+
+namespace AIplayer {
+
+/**
+ * @class LongTermSpectrum
+ * @brief Streaming long-term average spectrum of a track
+ *
+ * Mix engineers compare a track's long-term average spectrum with genre
+ * references. Every analysis frame adds its power spectrum, condensed into
+ * NUM_BINS sixth-octave bins from 20 Hz, to a running average:
+ * - Infinite: plain mean over everything since reset()
+ * - Exponential: recent material weighted with a time constant
+ *
+ * Averaging is done on power spectral density: the mean |X|^2 per FFT bin
+ * within each bin, divided by the window's noise bandwidth in Hz (ENBW times
+ * the bin width). The magnitudes are scaled for coherent gain, so without
+ * that division the level of noise would move with the FFT size and window,
+ * and the analysis governor changes the FFT size mid-run. Bins narrower
+ * than one FFT bin interpolate. The FFT-to-bin mapping is
+ * cached per FFT size, so a frame costs one pass over the magnitudes and
+ * never allocates.
+ *
+ * Reference curves (frequency/level pairs, from OSC or a text file) are
+ * resampled onto the same bins. A comparison aligns the reference to the
+ * track's overall level and reports the deviation per bin and per analysis
+ * band, plus a suggested EQ: the inverted deviation, smoothed over half an
+ * octave and limited to MAX_EQ_DB. Bins without signal (silence, or above
+ * Nyquist) are left out of the alignment and get no EQ.
+ *
+ * Not thread-safe: fed and queried on the message thread, where the
+ * analyzer computes its frames.
+ */
+class LongTermSpectrum
+{
+public:
+    LongTermSpectrum() = default;
+
+    /// Integration mode
+    enum class Mode
+    {
+        Exponential,
+        Infinite
+    };
+
+    /// Sixth-octave bins from MIN_FREQUENCY, ten octaves
+    static constexpr int BINS_PER_OCTAVE = 6;
+    static constexpr int NUM_BINS = 60;
+    static constexpr float MIN_FREQUENCY = 20.0f;
+
+    /// Comparison of the average with a reference curve
+    struct Comparison
+    {
+        bool valid{false};
+        std::array<float, NUM_BINS> deviationDb{};      ///< Track minus aligned reference, per bin
+        std::array<float, NUM_BINS> eqDb{};             ///< Suggested EQ gain per bin
+        std::array<float, BandEnergyAnalyzer::NUM_BANDS> bandDeviationDb{};   ///< Mean deviation per analysis band
+        float rmsDeviationDb{0.0f};                     ///< Overall RMS deviation
+        float offsetDb{0.0f};                           ///< Level added to the reference to align it
+    };
+
+    /// Default exponential time constant
+    static constexpr double DEFAULT_TIME_CONSTANT_SECONDS = 10.0;
+
+    /// Floor for empty bins and silent tracks
+    static constexpr float FLOOR_DB = -120.0f;
+
+    /// Suggested EQ gains are limited to +/- this
+    static constexpr float MAX_EQ_DB = 12.0f;
+
+    /**
+     * @brief Sets the integration mode
+     *
+     * @param newMode Exponential or Infinite
+     * @param timeConstantSeconds Exponential time constant (ignored for Infinite)
+     */
+    void setMode(Mode newMode, double timeConstantSeconds = DEFAULT_TIME_CONSTANT_SECONDS);
+
+    /// Current mode
+    Mode getMode() const { return mode; }
+
+    /// Exponential time constant
+    double getTimeConstant() const { return timeConstant; }
+
+    /// Clears the average
+    void reset();
+
+    /**
+     * @brief Adds one analysis frame
+     *
+     * @param magnitudes Linear magnitude per FFT bin
+     * @param numBins Number of FFT bins (FFT size / 2)
+     * @param binWidth FFT bin spacing in Hz
+     * @param noiseBandwidth Equivalent noise bandwidth of the analysis
+     *                       window in bins (FFTProcessor::getNoiseBandwidth())
+     * @param frameSeconds Audio time the frame stands for (the hop between frames)
+     */
+    void addFrame(const float* magnitudes, int numBins, float binWidth, float noiseBandwidth, double frameSeconds);
+
+    /// Audio time averaged so far
+    double getIntegratedSeconds() const { return integratedSeconds; }
+
+    /// Average level of a bin in dB (power spectral density, full scale squared per Hz)
+    float getLevelDb(int bin) const;
+
+    /// Centre frequency of a bin
+    static float getBinFrequency(int bin);
+
+    /**
+     * @brief Defines a reference curve
+     *
+     * Points are interpolated linearly in dB over log frequency; bins
+     * outside the curve take its end values.
+     *
+     * @param name Reference name
+     * @param frequencies Point frequencies in Hz (ascending)
+     * @param levelsDb Point levels in dB
+     * @param numPoints Number of points (at least 2)
+     * @return true if the curve was accepted
+     */
+    bool setReference(const juce::String& name, const float* frequencies, const float* levelsDb, int numPoints);
+
+    /**
+     * @brief Loads a reference curve from a text file
+     *
+     * One "frequency level" pair per line, separated by whitespace, comma
+     * or semicolon; lines starting with '#' are ignored.
+     *
+     * @param name Reference name
+     * @param file The curve file
+     * @return true if loaded
+     */
+    bool loadReference(const juce::String& name, const juce::File& file);
+
+    /// Whether a reference with this name is loaded
+    bool hasReference(const juce::String& name) const { return references.find(name) != references.end(); }
+
+    /// Names of the loaded references
+    juce::StringArray getReferenceNames() const;
+
+    /**
+     * @brief Compares the average with a reference
+     *
+     * @param name Reference name
+     * @return The comparison; not valid without data or for an unknown reference
+     */
+    Comparison compare(const juce::String& name) const;
+
+    /// Converts a mode to its OSC name ("exponential", "infinite")
+    static juce::String modeToString(Mode mode);
+
+    /// Parses an OSC mode name; anything but "infinite" is Exponential
+    static Mode modeFromString(const juce::String& text);
+
+private:
+    /// FFT bins feeding one LTAS bin
+    struct BinRange
+    {
+        int start{0};
+        int end{-1};            ///< end < start: no FFT bin inside, interpolate at position
+        float position{0.0f};
+    };
+
+    void updateMapping(int numBins, float binWidth);
+
+    Mode mode{Mode::Exponential};
+    double timeConstant{DEFAULT_TIME_CONSTANT_SECONDS};
+
+    std::array<double, NUM_BINS> power{};
+    double integratedSeconds{0.0};
+
+    std::array<BinRange, NUM_BINS> mapping;
+    int mappedBins{0};
+    float mappedWidth{0.0f};
+
+    std::map<juce::String, std::array<float, NUM_BINS>> references;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LongTermSpectrum)
+};
+
+} // namespace AIplayer
@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    LookaheadLimiter.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the true-peak lookahead limiter.
+
+  ==============================================================================
+*/
+
+#include "LookaheadLimiter.h"
+#include <cmath>
+
+namespace AIplayer {
+
+//==============================================================================
+void LookaheadLimiter::prepare(double newSampleRate, int maxBlockSize, int numChannels)
+{
+    juce::ignoreUnused(maxBlockSize);
+
+    sampleRate = newSampleRate;
+    preparedChannels = numChannels;
+
+    // Window W: the hold spans W samples and its average reaches the held
+    // gain W - 1 samples later; the detector lags its input by DELAY_SAMPLES
+    windowSamples = juce::jmax(1, juce::roundToInt(LOOKAHEAD_MS * 0.001 * sampleRate));
+    latencySamples = windowSamples - 1 + TruePeakDetector::DELAY_SAMPLES;
+
+    detector.prepare(numChannels);
+    dequeGains.assign(static_cast<size_t>(windowSamples), 1.0f);
+    dequeIndices.assign(static_cast<size_t>(windowSamples), 0);
+    averageHistory.assign(static_cast<size_t>(windowSamples), 1.0f);
+    delayBuffer.setSize(juce::jmax(1, numChannels), latencySamples);
+
+    setSettings(settings);
+    reset();
+}
+
+void LookaheadLimiter::reset()
+{
+    resetGainComputer();
+
+    delayBuffer.clear();
+    delayPosition = 0;
+}
+
+void LookaheadLimiter::resetGainComputer()
+{
+    detector.reset();
+
+    dequeFront = 0;
+    dequeSize = 0;
+    sampleIndex = 0;
+
+    heldGain = 1.0f;
+    std::fill(averageHistory.begin(), averageHistory.end(), 1.0f);
+    averageSum = static_cast<double>(windowSamples);
+    averagePosition = 0;
+
+    gainReductionDb.store(0.0f, std::memory_order_relaxed);
+}
+
+void LookaheadLimiter::setSettings(const Settings& newSettings)
+{
+    // Switching on or off restarts the gain computer; the delay line keeps
+    // running either way, so the audio does not drop out
+    const bool toggled = newSettings.enabled != settings.enabled;
+    settings = newSettings;
+
+    ceilingGain = juce::Decibels::decibelsToGain(juce::jlimit(MIN_CEILING_DB, MAX_CEILING_DB, settings.ceilingDb));
+
+    const double releaseSamples = juce::jmax(1.0, static_cast<double>(settings.releaseMs) * 0.001 * sampleRate);
+    releaseCoeff = static_cast<float>(std::exp(-1.0 / releaseSamples));
+
+    if (toggled)
+        resetGainComputer();
+}
+
+//==============================================================================
+float LookaheadLimiter::slidingMinimum(float requiredGain)
+{
+    const int capacity = windowSamples;
+
+    // Expire the front once it leaves the window
+    if (dequeSize > 0 && dequeIndices[static_cast<size_t>(dequeFront)] <= sampleIndex - windowSamples)
+    {
+        dequeFront = dequeFront + 1 == capacity ? 0 : dequeFront + 1;
+        --dequeSize;
+    }
+
+    // Entries at or above the new gain can never be the minimum again
+    while (dequeSize > 0)
+    {
+        int back = dequeFront + dequeSize - 1;
+        if (back >= capacity)
+            back -= capacity;
+
+        if (dequeGains[static_cast<size_t>(back)] < requiredGain)
+            break;
+
+        --dequeSize;
+    }
+
+    int slot = dequeFront + dequeSize;
+    if (slot >= capacity)
+        slot -= capacity;
+
+    dequeGains[static_cast<size_t>(slot)] = requiredGain;
+    dequeIndices[static_cast<size_t>(slot)] = sampleIndex;
+    ++dequeSize;
+    ++sampleIndex;
+
+    return dequeGains[static_cast<size_t>(dequeFront)];
+}
+
+void LookaheadLimiter::delay(juce::AudioBuffer<float>& buffer, int numChannels)
+{
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    auto* const* delayLines = delayBuffer.getArrayOfWritePointers();
+    const int delaySize = delayBuffer.getNumSamples();
+    const int numSamples = buffer.getNumSamples();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float delayed = delayLines[channel][delayPosition];
+            delayLines[channel][delayPosition] = channels[channel][i];
+            channels[channel][i] = delayed;
+        }
+
+        if (++delayPosition == delaySize)
+            delayPosition = 0;
+    }
+}
+
+void LookaheadLimiter::process(juce::AudioBuffer<float>& buffer)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), preparedChannels);
+    const int numSamples = buffer.getNumSamples();
+
+    if (numChannels == 0 || numSamples == 0)
+        return;
+
+    if (!settings.enabled)
+    {
+        delay(buffer, numChannels);
+        return;
+    }
+
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    auto* const* delayLines = delayBuffer.getArrayOfWritePointers();
+    const int delaySize = delayBuffer.getNumSamples();
+    const double averageScale = 1.0 / windowSamples;
+
+    float held = heldGain;
+    float lowestGain = 1.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float peak = detector.processFrame(channels, numChannels, i);
+        const float required = peak > ceilingGain ? ceilingGain / peak : 1.0f;
+        const float windowMinimum = slidingMinimum(required);
+
+        // Instant hold, exponential release (never above the window minimum)
+        held = windowMinimum < held ? windowMinimum : windowMinimum + releaseCoeff * (held - windowMinimum);
+
+        averageSum += held - averageHistory[static_cast<size_t>(averagePosition)];
+        averageHistory[static_cast<size_t>(averagePosition)] = held;
+
+        // Re-sum once per window so rounding in the running sum cannot drift
+        if (++averagePosition == windowSamples)
+        {
+            averagePosition = 0;
+            averageSum = 0.0;
+            for (const float gain : averageHistory)
+                averageSum += gain;
+        }
+
+        const float gain = static_cast<float>(averageSum * averageScale);
+        lowestGain = juce::jmin(lowestGain, gain);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float delayed = delayLines[channel][delayPosition];
+            delayLines[channel][delayPosition] = channels[channel][i];
+            channels[channel][i] = delayed * gain;
+        }
+
+        if (++delayPosition == delaySize)
+            delayPosition = 0;
+    }
+
+    heldGain = held;
+    gainReductionDb.store(juce::Decibels::gainToDecibels(lowestGain, -120.0f), std::memory_order_relaxed);
+}
+
+} // namespace AIplayer
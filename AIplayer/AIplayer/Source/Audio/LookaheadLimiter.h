@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+    LookaheadLimiter.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Brickwall lookahead limiter with a true-peak ceiling.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include "TruePeakDetector.h"
+#include <atomic>
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @class LookaheadLimiter
+ * @brief Holds the output below a true-peak ceiling (master-bus role)
+ *
+ * Gain computer, per sample:
+ * - The 4x TruePeakDetector gives the stereo-linked true peak; the gain
+ *   that brings it to the ceiling is pushed into a monotonic deque, whose
+ *   front is the minimum over the last LOOKAHEAD_MS (O(1) amortised)
+ * - Rising gain releases exponentially towards that minimum; falling gain
+ *   follows it at once
+ * - A moving average of the same length smooths the attack into a ramp
+ *
+ * The average of a window-length hold reaches the required gain exactly
+ * when the peak leaves the delay line, so the ceiling is met without
+ * clipping. Audio is delayed by the window plus the detector's delay,
+ * which getLatencySamples() reports.
+ *
+ * The delay line also runs while the limiter is disabled, so the latency
+ * reported to the host does not change when the agent toggles it. Toggling
+ * restarts the detector and gain computer but keeps the delay line, so the
+ * audio stays continuous; peaks already in the delay line when the limiter
+ * is switched on are not caught. All state is allocated in prepare().
+ */
+class LookaheadLimiter
+{
+public:
+    /// Lookahead (gain ramp) length
+    static constexpr float LOOKAHEAD_MS = 2.0f;
+
+    /// Ceiling range
+    static constexpr float MIN_CEILING_DB = -12.0f;
+    static constexpr float MAX_CEILING_DB = 0.0f;
+
+    /**
+     * @struct Settings
+     * @brief Limiter parameters, read from the plugin parameters every block
+     */
+    struct Settings
+    {
+        bool enabled{false};
+        float ceilingDb{-1.0f};         ///< True-peak ceiling (dBTP)
+        float releaseMs{50.0f};
+    };
+
+    /**
+     * @brief Constructor
+     */
+    LookaheadLimiter() = default;
+
+    /**
+     * @brief Allocates the detector, gain computer and delay line
+     *
+     * @param sampleRate Processing sample rate
+     * @param maxBlockSize Largest block passed to process()
+     * @param numChannels Number of channels
+     */
+    void prepare(double sampleRate, int maxBlockSize, int numChannels);
+
+    /**
+     * @brief Clears the detector, gain computer and delay line
+     */
+    void reset();
+
+    /**
+     * @brief Updates the settings (audio thread)
+     *
+     * @param newSettings Settings for the following blocks
+     */
+    void setSettings(const Settings& newSettings);
+
+    /**
+     * @brief Limits a block in place (only delays it while disabled)
+     *
+     * @param buffer Audio, delayed by getLatencySamples() and limited
+     */
+    void process(juce::AudioBuffer<float>& buffer);
+
+    /**
+     * @brief Delay added by the limiter
+     *
+     * @return Lookahead plus detector delay in samples, enabled or not
+     */
+    int getLatencySamples() const { return latencySamples; }
+
+    /**
+     * @brief Deepest gain reduction of the last block (any thread)
+     *
+     * @return Gain reduction in dB (<= 0)
+     */
+    float getGainReductionDb() const { return gainReductionDb.load(std::memory_order_relaxed); }
+
+private:
+    /// Clears the detector and gain computer, leaving the delay line alone
+    void resetGainComputer();
+
+    /// Passes a block through the delay line unchanged (disabled)
+    void delay(juce::AudioBuffer<float>& buffer, int numChannels);
+
+    /// Pushes a required gain and returns the minimum over the window
+    float slidingMinimum(float requiredGain);
+
+    double sampleRate{44100.0};
+    int preparedChannels{0};
+    Settings settings;
+
+    float ceilingGain{1.0f};
+    float releaseCoeff{0.0f};
+
+    TruePeakDetector detector;
+    int windowSamples{1};
+    int latencySamples{0};
+
+    // Monotonic deque (ring of windowSamples): gains increase from the front
+    std::vector<float> dequeGains;
+    std::vector<juce::int64> dequeIndices;
+    int dequeFront{0};
+    int dequeSize{0};
+    juce::int64 sampleIndex{0};
+
+    // Released hold and its moving average
+    float heldGain{1.0f};
+    std::vector<float> averageHistory;
+    double averageSum{0.0};
+    int averagePosition{0};
+
+    juce::AudioBuffer<float> delayBuffer;
+    int delayPosition{0};
+
+    std::atomic<float> gainReductionDb{0.0f};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LookaheadLimiter)
+};
+
+} // namespace AIplayer
@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the sliding-window loudness meter.
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+#include <cmath>
+
+namespace AIplayer {
+
+BiquadCoefficients LoudnessMeter::kWeighting(double sampleRate, int stage)
+{
+    // De Man's bilinear fit of the BS.1770 48 kHz coefficients, re-derived
+    // for any sample rate. The cookbook shelf and high-pass differ from the
+    // spec by up to 0.4 dB, so they are not used here.
+    if (stage == 0)
+    {
+        const double k = std::tan(juce::MathConstants<double>::pi * 1681.974450955533 / sampleRate);
+        const double q = 0.7071752369554196;
+        const double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+
+        return BiquadDesign::detail::normalise(vh + vb * k / q + k * k, 2.0 * (k * k - vh), vh - vb * k / q + k * k,
+                                               1.0 + k / q + k * k, 2.0 * (k * k - 1.0), 1.0 - k / q + k * k);
+    }
+
+    // The RLB high-pass keeps the spec's unnormalised numerator (1, -2, 1)
+    const double k = std::tan(juce::MathConstants<double>::pi * 38.13547087602444 / sampleRate);
+    const double q = 0.5003270373238773;
+    const double a0 = 1.0 + k / q + k * k;
+
+    return { 1.0f, -2.0f, 1.0f,
+             static_cast<float>(2.0 * (k * k - 1.0) / a0), static_cast<float>((1.0 - k / q + k * k) / a0) };
+}
+
+//==============================================================================
+void LoudnessMeter::prepare(double sampleRate, int maxBlockSize, int numChannels)
+{
+    scheduler.prepare(sampleRate, HOP_SECONDS);
+
+    weighting.prepare(numChannels, 2, maxBlockSize);
+    weighting.setNumSections(2);
+    weighting.setCoefficients(0, kWeighting(sampleRate, 0));
+    weighting.setCoefficients(1, kWeighting(sampleRate, 1));
+
+    scratch.setSize(numChannels, maxBlockSize);
+    hops.assign(static_cast<size_t>(SHORT_TERM_HOPS), {});
+
+    reset();
+}
+
+void LoudnessMeter::setChannelWeights(const float* weights, int numChannels)
+{
+    for (int channel = 0; channel < ChannelLayout::MAX_CHANNELS; ++channel)
+        channelWeights[static_cast<size_t>(channel)] = channel < numChannels ? weights[channel] : 1.0f;
+}
+
+void LoudnessMeter::reset()
+{
+    weighting.reset();
+    std::fill(hops.begin(), hops.end(), Hop{});
+
+    currentHop = lastHop = {};
+    scheduler.reset();
+    hopsMeasured = 0;
+    ringPosition = 0;
+    momentaryWeighted = momentaryUnweighted = shortTermWeighted = 0.0;
+}
+
+//==============================================================================
+int LoudnessMeter::process(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), scratch.getNumChannels());
+    numSamples = juce::jmin(numSamples, scratch.getNumSamples());
+
+    if (numChannels <= 0 || numSamples <= 0)
+        return 0;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        scratch.copyFrom(channel, 0, buffer, channel, startSample, numSamples);
+
+    weighting.process(scratch.getArrayOfWritePointers(), numChannels, numSamples);
+
+    const float channelScale = 1.0f / static_cast<float>(numChannels);
+
+    return scheduler.process(numSamples, [&](int start, int count)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float sumWeighted = ChannelLayout::sumOfSquares(scratch.getReadPointer(channel, start), count);
+            const float sumRaw = ChannelLayout::sumOfSquares(buffer.getReadPointer(channel, startSample + start), count);
+
+            const float weight = channel < ChannelLayout::MAX_CHANNELS ? channelWeights[static_cast<size_t>(channel)] : 1.0f;
+            currentHop.weighted += sumWeighted * weight;
+            currentHop.unweighted += sumRaw * channelScale;
+        }
+    },
+    [this](juce::int64) { completeHop(); });
+}
+
+void LoudnessMeter::completeHop()
+{
+    // Normalise to mean square per sample (weighted energies are summed over
+    // channels as in BS.1770, unweighted ones averaged like a plain RMS meter)
+    const double scale = 1.0 / static_cast<double>(scheduler.getHopSamples());
+    const Hop finished { currentHop.weighted * scale, currentHop.unweighted * scale };
+
+    const int momentaryExpired = (ringPosition - MOMENTARY_HOPS + SHORT_TERM_HOPS) % SHORT_TERM_HOPS;
+    const auto& leaving = hops[static_cast<size_t>(momentaryExpired)];
+    const auto& oldest = hops[static_cast<size_t>(ringPosition)];
+
+    momentaryWeighted += finished.weighted - leaving.weighted;
+    momentaryUnweighted += finished.unweighted - leaving.unweighted;
+    shortTermWeighted += finished.weighted - oldest.weighted;
+
+    hops[static_cast<size_t>(ringPosition)] = finished;
+    lastHop = finished;
+    ringPosition = (ringPosition + 1) % SHORT_TERM_HOPS;
+
+    ++hopsMeasured;
+    currentHop = {};
+
+    // Running sums drift with rounding; rebuild them once per ring cycle
+    if (ringPosition == 0)
+    {
+        momentaryWeighted = momentaryUnweighted = shortTermWeighted = 0.0;
+        for (int i = 0; i < SHORT_TERM_HOPS; ++i)
+        {
+            const auto& hop = hops[static_cast<size_t>(i)];
+            shortTermWeighted += hop.weighted;
+            if (i >= SHORT_TERM_HOPS - MOMENTARY_HOPS)
+            {
+                momentaryWeighted += hop.weighted;
+                momentaryUnweighted += hop.unweighted;
+            }
+        }
+    }
+}
+
+float LoudnessMeter::toDb(double windowSum, int windowHops, double offset) const
+{
+    const int available = juce::jlimit(1, windowHops, hopsMeasured);
+    const double meanSquare = juce::jmax(0.0, windowSum) / static_cast<double>(available);
+
+    if (meanSquare <= 1.0e-12)
+        return SILENCE_DB;
+
+    return static_cast<float>(juce::jmax(static_cast<double>(SILENCE_DB), offset + 10.0 * std::log10(meanSquare)));
+}
+
+} // namespace AIplayer
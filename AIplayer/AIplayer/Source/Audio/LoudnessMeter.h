@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    ITU-R BS.1770 K-weighted loudness and unweighted RMS over sliding windows.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadEngine.h"
+#include "ChannelLayout.h"
+#include "HopScheduler.h"
+#include <array>
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @class LoudnessMeter
+ * @brief Sliding-window loudness measurement on the audio thread
+ *
+ * The input is K-weighted with the two BS.1770 pre-filter stages (run through
+ * the shared BiquadEngine on a scratch copy; the caller's audio is not
+ * modified). Weighted and unweighted channel energies are summed into fixed
+ * 10 ms hops (HopScheduler, so the result does not depend on the host block
+ * size), and the hops are kept in a ring so that both windows update
+ * every hop in O(1):
+ * - momentary: 400 ms
+ * - short-term: 3 s
+ *
+ * Channel energies are combined with BS.1770 channel weights (set with
+ * setChannelWeights(); by default every channel counts 1.0), so 5.1 and
+ * 7.1.4 stems read correctly with LFE excluded and surrounds at +1.5 dB.
+ *
+ * No gating is applied; these are the ungated momentary/short-term values.
+ * All memory is allocated in prepare().
+ */
+class LoudnessMeter
+{
+public:
+    /// Hop between window updates
+    static constexpr double HOP_SECONDS = HopScheduler::DEFAULT_HOP_SECONDS;
+
+    /// Momentary window length in hops (400 ms)
+    static constexpr int MOMENTARY_HOPS = 40;
+
+    /// Short-term window length in hops (3 s)
+    static constexpr int SHORT_TERM_HOPS = 300;
+
+    /// Value reported for silence
+    static constexpr float SILENCE_DB = -120.0f;
+
+    /**
+     * @brief Constructor
+     */
+    LoudnessMeter() { channelWeights.fill(1.0f); }
+
+    /**
+     * @brief Allocates filter state and scratch memory
+     *
+     * @param sampleRate Processing sample rate
+     * @param maxBlockSize Largest block passed to process()
+     * @param numChannels Number of channels measured
+     */
+    void prepare(double sampleRate, int maxBlockSize, int numChannels);
+
+    /**
+     * @brief Clears filters and windows
+     */
+    void reset();
+
+    /**
+     * @brief Sets the per-channel weights for the K-weighted sum
+     *
+     * @param weights One weight per channel (see ChannelLayout::loudnessWeights)
+     * @param numChannels Number of weights; channels beyond it keep weight 1.0
+     */
+    void setChannelWeights(const float* weights, int numChannels);
+
+    /**
+     * @brief Measures a run of samples
+     *
+     * @param buffer Audio to measure (read only)
+     * @param startSample First sample of the run
+     * @param numSamples Number of samples (at most the prepared block size)
+     * @return Number of hops completed within these samples
+     */
+    int process(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    /// Samples remaining until the current hop completes
+    int getSamplesUntilHop() const { return scheduler.getSamplesUntilHop(); }
+
+    /// Hop length in samples
+    int getHopSamples() const { return scheduler.getHopSamples(); }
+
+    /// Momentary (400 ms) K-weighted loudness in LUFS
+    float getMomentaryLufs() const { return toDb(momentaryWeighted, MOMENTARY_HOPS, LUFS_OFFSET); }
+
+    /// Short-term (3 s) K-weighted loudness in LUFS
+    float getShortTermLufs() const { return toDb(shortTermWeighted, SHORT_TERM_HOPS, LUFS_OFFSET); }
+
+    /// Unweighted RMS over the momentary window in dBFS (averaged over channels)
+    float getMomentaryRmsDb() const { return toDb(momentaryUnweighted, MOMENTARY_HOPS, 0.0); }
+
+    /// Whether at least one full momentary window has been measured
+    bool hasMomentaryWindow() const { return hopsMeasured >= MOMENTARY_HOPS; }
+
+    /// K-weighted mean square of the last completed hop (channel-weighted sum)
+    double getLastHopWeightedEnergy() const { return lastHop.weighted; }
+
+    /// Unweighted mean square of the last completed hop (averaged over channels)
+    double getLastHopUnweightedEnergy() const { return lastHop.unweighted; }
+
+    /**
+     * @brief K-weighting pre-filter stages for a sample rate
+     *
+     * @param sampleRate The sample rate
+     * @param stage 0 = high shelf ("head" effect), 1 = RLB high-pass
+     */
+    static BiquadCoefficients kWeighting(double sampleRate, int stage);
+
+private:
+    /// -0.691 dB offset from BS.1770
+    static constexpr double LUFS_OFFSET = -0.691;
+
+    struct Hop
+    {
+        double weighted{0.0};
+        double unweighted{0.0};
+    };
+
+    float toDb(double windowSum, int windowHops, double offset) const;
+    void completeHop();
+
+    HopScheduler scheduler;
+    int hopsMeasured{0};
+
+    BiquadEngine weighting;
+    std::array<float, ChannelLayout::MAX_CHANNELS> channelWeights;
+    juce::AudioBuffer<float> scratch;
+
+    Hop currentHop;
+    Hop lastHop;
+    std::vector<Hop> hops;             ///< Ring of SHORT_TERM_HOPS completed hops
+    int ringPosition{0};
+
+    double momentaryWeighted{0.0}, momentaryUnweighted{0.0};
+    double shortTermWeighted{0.0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeter)
+};
+
+} // namespace AIplayer
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    Oversampler.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the selectable oversampler.
+
+  ==============================================================================
+*/
+
+#include "Oversampler.h"
+
+namespace AIplayer {
+
+void Oversampler::prepare(int numChannels, int maxBlockSize, FilterType filterType)
+{
+    const auto type = filterType == FilterType::PolyphaseIIR
+        ? juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR
+        : juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple;
+
+    oversamplers[None].reset();
+
+    for (int factor = Two; factor < NUM_FACTORS; ++factor)
+    {
+        // One half-band stage per doubling; max quality keeps the stopband
+        // well below the compressor's distortion products
+        auto oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
+            static_cast<size_t>(numChannels), static_cast<size_t>(factor), type, true, true);
+        oversampler->initProcessing(static_cast<size_t>(maxBlockSize));
+        oversamplers[static_cast<size_t>(factor)] = std::move(oversampler);
+    }
+
+    maxFilterLatency = 0;
+    for (int factor = 0; factor < NUM_FACTORS; ++factor)
+        maxFilterLatency = juce::jmax(maxFilterLatency, getFilterLatencySamples(factor));
+
+    for (int factor = 0; factor < NUM_FACTORS; ++factor)
+        padSamples[static_cast<size_t>(factor)] = maxFilterLatency - getFilterLatencySamples(factor);
+
+    padBuffer.setSize(juce::jmax(1, numChannels), juce::jmax(1, maxFilterLatency));
+    padBuffer.clear();
+    padPosition = 0;
+
+    activeFactor = None;
+}
+
+void Oversampler::reset()
+{
+    for (auto& oversampler : oversamplers)
+        if (oversampler != nullptr)
+            oversampler->reset();
+
+    padBuffer.clear();
+    padPosition = 0;
+}
+
+void Oversampler::pad(juce::AudioBuffer<float>& buffer, int factor)
+{
+    const int delay = padSamples[static_cast<size_t>(factor)];
+    if (delay == 0)
+        return;
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), padBuffer.getNumChannels());
+    const int numSamples = buffer.getNumSamples();
+    const int size = padBuffer.getNumSamples();
+    auto* const* channels = buffer.getArrayOfWritePointers();
+    auto* const* lines = padBuffer.getArrayOfWritePointers();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Read before writing: a delay of the full line reads the slot being replaced
+        int readPosition = padPosition - delay;
+        if (readPosition < 0)
+            readPosition += size;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float delayed = lines[channel][readPosition];
+            lines[channel][padPosition] = channels[channel][i];
+            channels[channel][i] = delayed;
+        }
+
+        if (++padPosition == size)
+            padPosition = 0;
+    }
+}
+
+int Oversampler::getFilterLatencySamples(int factor) const
+{
+    factor = juce::jlimit(0, NUM_FACTORS - 1, factor);
+
+    if (const auto* oversampler = oversamplers[static_cast<size_t>(factor)].get())
+        return juce::roundToInt(oversampler->getLatencyInSamples());
+
+    return 0;
+}
+
+const char* Oversampler::getFactorName(int factor)
+{
+    static const char* names[NUM_FACTORS] = { "Off", "2x", "4x" };
+    return names[juce::jlimit(0, NUM_FACTORS - 1, factor)];
+}
+
+} // namespace AIplayer
@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+    Oversampler.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Selectable 2x/4x oversampling around the nonlinear processing stages.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include "ChannelLayout.h"
+#include <array>
+#include <memory>
+
+namespace AIplayer {
+
+/**
+ * @class Oversampler
+ * @brief Runs part of the chain at 2x or 4x the host rate
+ *
+ * Wraps juce::dsp::Oversampling with half-band filters (polyphase IIR by
+ * default for low latency, or equiripple FIR for linear phase). One
+ * instance per factor is built in prepare(), so switching factor on the
+ * audio thread only resets filter state and never allocates.
+ *
+ * Lower factors are padded with a host-rate delay up to the filter latency
+ * of the highest factor, so getLatencySamples() is the same whichever
+ * factor runs and switching never changes the latency reported to the host.
+ *
+ * The factor's processing is passed in as a callable that receives the
+ * upsampled audio and the factor index; callers keep one set of stage
+ * state per factor, prepared at the matching rate, and reset it when the
+ * factor changes:
+ *
+ * @code
+ * oversampler.process(buffer, factor, [&](juce::AudioBuffer<float>& audio, int index)
+ * {
+ *     strips[index]->process(audio);
+ * });
+ * @endcode
+ */
+class Oversampler
+{
+public:
+    /// Factor index: rate multiplier is 1 << index
+    enum Factor
+    {
+        None = 0,
+        Two,
+        Four
+    };
+
+    /// Number of factors (including None)
+    static constexpr int NUM_FACTORS = 3;
+
+    /// Half-band filter design
+    enum class FilterType
+    {
+        PolyphaseIIR,       ///< Low latency, non-linear phase
+        FIREquiripple       ///< Linear phase, higher latency
+    };
+
+    /**
+     * @brief Constructor
+     */
+    Oversampler() = default;
+
+    /**
+     * @brief Builds the 2x and 4x oversamplers
+     *
+     * @param numChannels Number of channels
+     * @param maxBlockSize Largest host block
+     * @param filterType Half-band filter design
+     */
+    void prepare(int numChannels, int maxBlockSize, FilterType filterType = FilterType::PolyphaseIIR);
+
+    /**
+     * @brief Clears the filter state of every factor
+     */
+    void reset();
+
+    /**
+     * @brief Processes a block, oversampled by the given factor
+     *
+     * @param buffer Audio processed in place at the host rate
+     * @param factor Factor index (None runs the callable on the buffer directly)
+     * @param stage Callable (juce::AudioBuffer<float>&, int factorIndex)
+     */
+    template <typename Callable>
+    void process(juce::AudioBuffer<float>& buffer, int factor, Callable&& stage)
+    {
+        factor = juce::jlimit(0, NUM_FACTORS - 1, factor);
+
+        // Factor changed: the new path starts from clean filter and padding state
+        if (factor != activeFactor)
+        {
+            if (auto* oversampler = oversamplers[static_cast<size_t>(factor)].get())
+                oversampler->reset();
+            padBuffer.clear();
+            padPosition = 0;
+            activeFactor = factor;
+        }
+
+        if (auto* oversampler = oversamplers[static_cast<size_t>(factor)].get())
+        {
+            juce::dsp::AudioBlock<float> block(buffer);
+            auto upsampled = oversampler->processSamplesUp(block);
+
+            // Wrap the oversampler's own storage; no copy, no allocation
+            const int numChannels = juce::jmin(static_cast<int>(upsampled.getNumChannels()), ChannelLayout::MAX_CHANNELS);
+            std::array<float*, ChannelLayout::MAX_CHANNELS> channels{};
+            for (int channel = 0; channel < numChannels; ++channel)
+                channels[static_cast<size_t>(channel)] = upsampled.getChannelPointer(static_cast<size_t>(channel));
+
+            juce::AudioBuffer<float> audio(channels.data(), numChannels, static_cast<int>(upsampled.getNumSamples()));
+            stage(audio, factor);
+
+            oversampler->processSamplesDown(block);
+        }
+        else
+        {
+            stage(buffer, static_cast<int>(None));
+        }
+
+        pad(buffer, factor);
+    }
+
+    /**
+     * @brief Latency of the oversampled section, in host-rate samples
+     *
+     * @return Filter latency of the highest factor; lower factors are padded to it
+     */
+    int getLatencySamples() const { return maxFilterLatency; }
+
+    /**
+     * @brief Latency added by a factor's filters alone, in host-rate samples
+     *
+     * @param factor Factor index
+     * @return Whole samples (the oversamplers use integer latency)
+     */
+    int getFilterLatencySamples(int factor) const;
+
+    /// Rate multiplier of a factor index
+    static int getMultiplier(int factor) { return 1 << juce::jlimit(0, NUM_FACTORS - 1, factor); }
+
+    /// Display names of the factors, in index order
+    static const char* getFactorName(int factor);
+
+private:
+    /// Delays a block by the padding of its factor
+    void pad(juce::AudioBuffer<float>& buffer, int factor);
+
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, NUM_FACTORS> oversamplers;
+    int activeFactor{None};
+
+    // Padding delay line (host rate), as long as the largest filter latency
+    std::array<int, NUM_FACTORS> padSamples{};
+    int maxFilterLatency{0};
+    juce::AudioBuffer<float> padBuffer;
+    int padPosition{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Oversampler)
+};
+
+} // namespace AIplayer
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+    PitchTracker.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the McLeod pitch tracker.
+
+  ==============================================================================
+*/
+
+#include "PitchTracker.h"
+
+namespace AIplayer {
+
+PitchTracker::PitchTracker()
+    : fft(FFT_ORDER)
+{
+    // Everything a frame needs, so process() never allocates
+    input.resize(MAX_WINDOW_SIZE);
+    spectrum.resize(FFT_SIZE + 2);
+    workspace.resize(FFT_SIZE * 2);
+    nsdf.resize(MAX_WINDOW_SIZE / 2 + 1);
+
+    reset();
+}
+
+//==============================================================================
+void PitchTracker::setEnabled(bool enable)
+{
+    enabled = enable;
+
+    if (!enabled)
+        reset();
+}
+
+void PitchTracker::setRange(float minHz, float maxHz)
+{
+    minFrequency = juce::jlimit(10.0f, 4000.0f, minHz);
+    maxFrequency = juce::jmax(minFrequency * 1.5f, juce::jmin(maxHz, 10000.0f));
+}
+
+void PitchTracker::reset()
+{
+    result = Result();
+    result.harmonicDb.fill(FLOOR_DB);
+}
+
+juce::String PitchTracker::getNoteName(float midiNote)
+{
+    if (midiNote <= 0.0f)
+        return {};
+
+    return juce::MidiMessage::getMidiNoteName(juce::roundToInt(midiNote), true, true, 4);
+}
+
+//==============================================================================
+bool PitchTracker::process(const float* samples, int numSamples, double sampleRate)
+{
+    if (!enabled || samples == nullptr || sampleRate <= 0.0)
+        return false;
+
+    // Two periods of the lowest frequency, as far as the input and the cap allow
+    const int wanted = juce::nextPowerOfTwo(static_cast<int>(std::ceil(2.0 * sampleRate / minFrequency)));
+    int size = juce::jmin(MAX_WINDOW_SIZE, wanted);
+    while (size > numSamples)
+        size /= 2;
+
+    if (size < MIN_WINDOW_SIZE)
+        return false;
+
+    windowSize = size;
+    std::copy(samples + numSamples - size, samples + numSamples, input.begin());
+
+    double energy = 0.0;
+    for (int i = 0; i < size; ++i)
+        energy += static_cast<double>(input[static_cast<size_t>(i)]) * input[static_cast<size_t>(i)];
+
+    if (10.0 * std::log10(energy / size + 1.0e-20) < SILENCE_DB)
+    {
+        reset();
+        return true;
+    }
+
+    // Spectrum of the zero-padded window (kept for the harmonics)
+    std::fill(workspace.begin(), workspace.end(), 0.0f);
+    std::copy(input.begin(), input.begin() + size, workspace.begin());
+    fft.performRealOnlyForwardTransform(workspace.data());
+    std::copy(workspace.begin(), workspace.begin() + static_cast<int>(spectrum.size()), spectrum.begin());
+
+    // Autocorrelation = inverse transform of the power spectrum; the padding
+    // makes it linear rather than circular
+    for (int bin = 0; bin < FFT_SIZE; ++bin)
+    {
+        const float re = workspace[static_cast<size_t>(2 * bin)];
+        const float im = workspace[static_cast<size_t>(2 * bin + 1)];
+        workspace[static_cast<size_t>(2 * bin)] = re * re + im * im;
+        workspace[static_cast<size_t>(2 * bin + 1)] = 0.0f;
+    }
+
+    fft.performRealOnlyInverseTransform(workspace.data());
+
+    // r(0) is the window energy; this removes the transform's scaling
+    const double scale = workspace[0] > 0.0f ? energy / workspace[0] : 0.0;
+    const int maxLag = juce::jmin(size / 2, static_cast<int>(sampleRate / minFrequency));
+
+    // NSDF: n(tau) = 2 r(tau) / m(tau), with m(tau) = sum of x[j]^2 + x[j + tau]^2
+    // over the overlap, updated incrementally
+    double m = 2.0 * energy;
+    for (int tau = 0; tau <= maxLag; ++tau)
+    {
+        if (tau > 0)
+        {
+            const double first = input[static_cast<size_t>(tau - 1)];
+            const double last = input[static_cast<size_t>(size - tau)];
+            m -= first * first + last * last;
+        }
+
+        nsdf[static_cast<size_t>(tau)] = m > 0.0 ? static_cast<float>(2.0 * workspace[static_cast<size_t>(tau)] * scale / m) : 0.0f;
+    }
+
+    findPeriod(sampleRate);
+
+    if (result.frequencyHz > 0.0f)
+        measureHarmonics(sampleRate);
+    else
+        result.harmonicDb.fill(FLOOR_DB);
+
+    return true;
+}
+
+void PitchTracker::findPeriod(double sampleRate)
+{
+    const int maxLag = juce::jmin(windowSize / 2, static_cast<int>(sampleRate / minFrequency));
+    const int minLag = juce::jmax(2, static_cast<int>(sampleRate / maxFrequency));
+
+    // Key maxima: the highest point of each positive lobe after the first
+    // negative-going zero crossing. visit() returns true to stop.
+    auto forEachKeyMaximum = [&](auto&& visit)
+    {
+        int tau = 1;
+        while (tau <= maxLag && nsdf[static_cast<size_t>(tau)] > 0.0f)
+            ++tau;
+
+        while (tau <= maxLag)
+        {
+            while (tau <= maxLag && nsdf[static_cast<size_t>(tau)] <= 0.0f)
+                ++tau;
+
+            int peak = -1;
+            while (tau <= maxLag && nsdf[static_cast<size_t>(tau)] > 0.0f)
+            {
+                if (tau >= minLag && (peak < 0 || nsdf[static_cast<size_t>(tau)] > nsdf[static_cast<size_t>(peak)]))
+                    peak = tau;
+                ++tau;
+            }
+
+            if (peak >= 0 && visit(peak))
+                return;
+        }
+    };
+
+    float highest = 0.0f;
+    forEachKeyMaximum([&](int tau) { highest = juce::jmax(highest, nsdf[static_cast<size_t>(tau)]); return false; });
+
+    int period = -1;
+    if (highest > 0.0f)
+    {
+        forEachKeyMaximum([&](int tau)
+        {
+            if (nsdf[static_cast<size_t>(tau)] < CLARITY_THRESHOLD * highest)
+                return false;
+
+            period = tau;
+            return true;
+        });
+    }
+
+    if (period < 0)
+    {
+        reset();
+        return;
+    }
+
+    // Parabolic interpolation of the period and its clarity
+    float shift = 0.0f;
+    float clarity = nsdf[static_cast<size_t>(period)];
+
+    if (period < maxLag)
+    {
+        const float a = nsdf[static_cast<size_t>(period - 1)];
+        const float b = nsdf[static_cast<size_t>(period)];
+        const float c = nsdf[static_cast<size_t>(period + 1)];
+        const float denominator = a - 2.0f * b + c;
+
+        if (denominator < 0.0f)
+        {
+            shift = juce::jlimit(-0.5f, 0.5f, 0.5f * (a - c) / denominator);
+            clarity = b - 0.25f * (a - c) * shift;
+        }
+    }
+
+    result.frequencyHz = static_cast<float>(sampleRate / (static_cast<double>(period) + shift));
+    result.confidence = juce::jlimit(0.0f, 1.0f, clarity);
+    result.voiced = result.confidence >= VOICED_CLARITY;
+    result.midiNote = 69.0f + 12.0f * std::log2(result.frequencyHz / 440.0f);
+}
+
+void PitchTracker::measureHarmonics(double sampleRate)
+{
+    // A Hann window over the first windowSize samples is a three-tap kernel
+    // in the padded spectrum, FFT_SIZE / windowSize bins apart
+    const int kernel = FFT_SIZE / windowSize;
+    const double binHz = sampleRate / FFT_SIZE;
+
+    // Coherent gain 0.5: a full-scale sine peaks at windowSize / 4
+    const float calibration = 4.0f / static_cast<float>(windowSize);
+
+    for (int harmonic = 0; harmonic < NUM_HARMONICS; ++harmonic)
+    {
+        const double frequency = result.frequencyHz * (harmonic + 1.0);
+        auto& level = result.harmonicDb[static_cast<size_t>(harmonic)];
+
+        if (frequency >= sampleRate * 0.5 - kernel * binHz)
+        {
+            level = FLOOR_DB;
+            continue;
+        }
+
+        // Peak of the main lobe around the expected bin
+        const int centre = static_cast<int>(std::lround(frequency / binHz));
+        float peak = 0.0f;
+
+        for (int bin = centre - kernel; bin <= centre + kernel; ++bin)
+        {
+            const auto windowed = 0.5f * getBin(bin) - 0.25f * (getBin(bin - kernel) + getBin(bin + kernel));
+            peak = juce::jmax(peak, std::abs(windowed));
+        }
+
+        level = juce::Decibels::gainToDecibels(peak * calibration, FLOOR_DB);
+    }
+}
+
+std::complex<float> PitchTracker::getBin(int index) const
+{
+    index = ((index % FFT_SIZE) + FFT_SIZE) % FFT_SIZE;
+
+    if (index > FFT_SIZE / 2)
+        return std::conj(getBin(FFT_SIZE - index));
+
+    return { spectrum[static_cast<size_t>(2 * index)], spectrum[static_cast<size_t>(2 * index + 1)] };
+}
+
+} // namespace AIplayer
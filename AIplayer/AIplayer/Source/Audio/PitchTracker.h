@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    PitchTracker.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Fundamental-frequency tracker (McLeod pitch method) with harmonic levels.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <complex>
+
+namespace AIplayer {
+
+/**
+ * @class PitchTracker
+ * @brief Real-time f0 tracker for tonal sources (bass, vocals, guitar)
+ *
+ * Implements the McLeod pitch method: the normalised square difference
+ * function (NSDF) is derived from an autocorrelation computed with one
+ * forward and one inverse FFT, the first key maximum within
+ * CLARITY_THRESHOLD of the highest one gives the period, and parabolic
+ * interpolation refines it. The NSDF value at the period ("clarity", 0-1)
+ * is the confidence.
+ *
+ * The window is the shortest power of two holding two periods of the lowest
+ * frequency searched, capped at MAX_WINDOW_SIZE, and the FFT is always
+ * FFT_SIZE, so every frame costs the same bounded amount and never
+ * allocates. The same transform, Hann-windowed in the frequency domain,
+ * gives the levels of the first NUM_HARMONICS harmonics.
+ *
+ * Not thread-safe: configured and run on the analysis (message) thread.
+ */
+class PitchTracker
+{
+public:
+    PitchTracker();
+
+    /// Longest analysis window in samples
+    static constexpr int MAX_WINDOW_SIZE = 4096;
+
+    /// Shortest analysis window in samples
+    static constexpr int MIN_WINDOW_SIZE = 256;
+
+    /// Harmonics reported, the fundamental included
+    static constexpr int NUM_HARMONICS = 8;
+
+    /// Default search range
+    static constexpr float DEFAULT_MIN_FREQUENCY = 40.0f;
+    static constexpr float DEFAULT_MAX_FREQUENCY = 2000.0f;
+
+    /// Key maxima within this fraction of the highest one are period candidates
+    static constexpr float CLARITY_THRESHOLD = 0.9f;
+
+    /// Frames with at least this clarity are voiced
+    static constexpr float VOICED_CLARITY = 0.6f;
+
+    /// Frames quieter than this (RMS, dBFS) are not analysed
+    static constexpr float SILENCE_DB = -60.0f;
+
+    /// Level reported for missing harmonics
+    static constexpr float FLOOR_DB = -120.0f;
+
+    /// Result of the latest frame
+    struct Result
+    {
+        bool voiced{false};
+        float frequencyHz{0.0f};        ///< Fundamental (0 if no period was found)
+        float confidence{0.0f};         ///< NSDF clarity at the period, 0-1
+        float midiNote{0.0f};           ///< Fractional MIDI note (69 = A4 = 440 Hz)
+        std::array<float, NUM_HARMONICS> harmonicDb{};  ///< Sine-calibrated level of each harmonic (dBFS)
+    };
+
+    /**
+     * @brief Enables or disables tracking
+     * @param enable true to track
+     */
+    void setEnabled(bool enable);
+
+    /// Whether tracking is enabled
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * @brief Sets the frequency range searched
+     *
+     * The lowest frequency is also bounded by the window: two periods must
+     * fit in MAX_WINDOW_SIZE samples.
+     *
+     * @param minHz Lowest fundamental
+     * @param maxHz Highest fundamental
+     */
+    void setRange(float minHz, float maxHz);
+
+    /// Lowest fundamental searched
+    float getMinFrequency() const { return minFrequency; }
+
+    /// Highest fundamental searched
+    float getMaxFrequency() const { return maxFrequency; }
+
+    /**
+     * @brief Analyses the newest samples
+     *
+     * @param samples Mono input, oldest first
+     * @param numSamples Number of samples available
+     * @param sampleRate Sample rate of the input
+     * @return true if a frame was analysed (enough samples, tracking enabled)
+     */
+    bool process(const float* samples, int numSamples, double sampleRate);
+
+    /// Result of the latest frame
+    const Result& getResult() const { return result; }
+
+    /// Window length used for the latest frame
+    int getWindowSize() const { return windowSize; }
+
+    /// Clears the result
+    void reset();
+
+    /// Note name of a MIDI note, e.g. "A4"
+    static juce::String getNoteName(float midiNote);
+
+private:
+    static constexpr int FFT_ORDER = 13;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;     // 2 x MAX_WINDOW_SIZE, so the autocorrelation is linear
+
+    void findPeriod(double sampleRate);
+    void measureHarmonics(double sampleRate);
+
+    /// Complex FFT bin of the input, any index (conjugate symmetry)
+    std::complex<float> getBin(int index) const;
+
+    bool enabled{false};
+    float minFrequency{DEFAULT_MIN_FREQUENCY};
+    float maxFrequency{DEFAULT_MAX_FREQUENCY};
+
+    juce::dsp::FFT fft;
+    std::vector<float> input;               // Current window
+    std::vector<float> spectrum;            // Interleaved complex spectrum of the window
+    std::vector<float> workspace;           // Power spectrum, then autocorrelation
+    std::vector<float> nsdf;
+    int windowSize{0};
+
+    Result result;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PitchTracker)
+};
+
+} // namespace AIplayer
@@ -0,0 +1,268 @@
+/*
+  ==============================================================================
+
+    SidechainProcessor.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of sidechain masking analysis and ducking.
+
+  ==============================================================================
+*/
+
+#include "SidechainProcessor.h"
+#include <cmath>
+
+namespace AIplayer {
+
+BiquadCoefficients SidechainProcessor::bandSplit(double sampleRate, int band, int stage)
+{
+    const auto* limits = BandEnergyAnalyzer::DEFAULT_BAND_LIMITS;
+    band = juce::jlimit(0, NUM_BANDS - 1, band);
+
+    if (stage == 0)
+        return BiquadDesign::highPass(sampleRate, limits[band]);
+
+    return BiquadDesign::lowPass(sampleRate, limits[band + 1]);
+}
+
+BiquadCoefficients SidechainProcessor::duckBell(double sampleRate, int band, float gainDb)
+{
+    const auto* limits = BandEnergyAnalyzer::DEFAULT_BAND_LIMITS;
+    band = juce::jlimit(0, NUM_BANDS - 1, band);
+
+    // Geometric centre, bandwidth equal to the band's width
+    const double low = limits[band], high = limits[band + 1];
+    const double centre = std::sqrt(low * high);
+
+    return BiquadDesign::peak(sampleRate, centre, centre / (high - low), gainDb);
+}
+
+//==============================================================================
+void SidechainProcessor::prepare(double newSampleRate, int newMaxBlockSize, int numChannels)
+{
+    sampleRate = newSampleRate;
+    maxBlockSize = juce::jmax(1, newMaxBlockSize);
+
+    for (int band = 0; band < NUM_BANDS; ++band)
+    {
+        auto& filter = bandFilters[static_cast<size_t>(band)];
+        filter.prepare(2, 2, maxBlockSize);
+        filter.setNumSections(2);
+        filter.setCoefficients(0, bandSplit(sampleRate, band, 0));
+        filter.setCoefficients(1, bandSplit(sampleRate, band, 1));
+    }
+
+    duckFilter.prepare(numChannels, 1, maxBlockSize);
+
+    mono.setSize(2, maxBlockSize);
+    bandScratch.setSize(2, maxBlockSize);
+
+    reset();
+}
+
+void SidechainProcessor::reset()
+{
+    for (auto& filter : bandFilters)
+        filter.reset();
+
+    trackEnergy.fill(0.0);
+    keyEnergy.fill(0.0);
+    analysing = false;
+
+    duckFilter.setNumSections(0);
+    duckFilterBand = -1;
+    duckGainDb = appliedGainDb = 0.0f;
+
+    publish(false);
+}
+
+void SidechainProcessor::setSettings(const Settings& newSettings)
+{
+    settings = newSettings;
+    settings.duckBand = juce::jlimit(0, NUM_BANDS - 1, settings.duckBand);
+    settings.depthDb = juce::jlimit(0.0f, MAX_DEPTH_DB, settings.depthDb);
+}
+
+//==============================================================================
+void SidechainProcessor::process(juce::AudioBuffer<float>& track, const juce::AudioBuffer<float>* key)
+{
+    jassert(track.getNumSamples() <= maxBlockSize);
+    const int numSamples = juce::jmin(track.getNumSamples(), maxBlockSize);
+    const bool keyPresent = key != nullptr && key->getNumChannels() > 0 && track.getNumChannels() > 0;
+
+    if (numSamples <= 0)
+        return;
+
+    if (keyPresent)
+    {
+        // Measure this stage's input, before the cut it controls
+        downmix(track, mono.getWritePointer(0), numSamples);
+        downmix(*key, mono.getWritePointer(1), juce::jmin(numSamples, key->getNumSamples()));
+        analyse(numSamples);
+        publish(true);
+    }
+    else if (analysing)
+    {
+        // Key disconnected: forget it so a reconnect starts from silence
+        for (auto& filter : bandFilters)
+            filter.reset();
+
+        trackEnergy.fill(0.0);
+        keyEnergy.fill(0.0);
+        analysing = false;
+        publish(false);
+    }
+
+    // Nothing ducked and nothing to duck
+    if (!analysing && duckGainDb == 0.0f && duckFilterBand < 0)
+        return;
+
+    updateDucking(numSamples);
+
+    if (duckFilterBand >= 0)
+        duckFilter.process(track.getArrayOfWritePointers(), track.getNumChannels(), numSamples);
+}
+
+void SidechainProcessor::downmix(const juce::AudioBuffer<float>& source, float* destination, int numSamples)
+{
+    const int numChannels = source.getNumChannels();
+    juce::FloatVectorOperations::copy(destination, source.getReadPointer(0), numSamples);
+
+    for (int channel = 1; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::add(destination, source.getReadPointer(channel), numSamples);
+
+    if (numChannels > 1)
+        juce::FloatVectorOperations::multiply(destination, 1.0f / static_cast<float>(numChannels), numSamples);
+}
+
+void SidechainProcessor::analyse(int numSamples)
+{
+    // Block-rate one-pole smoothing of the band energies; the first block
+    // after (re)connecting seeds the detectors directly
+    const double coeff = analysing
+        ? 1.0 - std::exp(-static_cast<double>(numSamples) / (ENERGY_SMOOTHING_MS * 0.001 * sampleRate))
+        : 1.0;
+
+    for (int band = 0; band < NUM_BANDS; ++band)
+    {
+        bandScratch.copyFrom(0, 0, mono, 0, 0, numSamples);
+        bandScratch.copyFrom(1, 0, mono, 1, 0, numSamples);
+        bandFilters[static_cast<size_t>(band)].process(bandScratch.getArrayOfWritePointers(), 2, numSamples);
+
+        double sums[2] = { 0.0, 0.0 };
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            const float* samples = bandScratch.getReadPointer(channel);
+            float sum = 0.0f;
+            for (int i = 0; i < numSamples; ++i)
+                sum += samples[i] * samples[i];
+            sums[channel] = static_cast<double>(sum) / numSamples;
+        }
+
+        auto& trackBand = trackEnergy[static_cast<size_t>(band)];
+        auto& keyBand = keyEnergy[static_cast<size_t>(band)];
+        trackBand += (sums[0] - trackBand) * coeff;
+        keyBand += (sums[1] - keyBand) * coeff;
+    }
+
+    analysing = true;
+}
+
+/**
+ * @brief Block-rate ducking control
+ *
+ * @details The cut follows the key band level 1:1 above the threshold up to
+ * the depth, moving with the attack time while deepening and the release
+ * time while recovering. The bell's coefficients ramp across the block to
+ * the new gain, so the cut is smooth within the block as well. Once back at
+ * 0 dB with the ramp finished, the bell is removed and the stage bypassed.
+ */
+void SidechainProcessor::updateDucking(int numSamples)
+{
+    float targetDb = 0.0f;
+
+    if (settings.duckEnabled && analysing)
+    {
+        const float keyDb = toDb(keyEnergy[static_cast<size_t>(settings.duckBand)]);
+        targetDb = -juce::jlimit(0.0f, settings.depthDb, keyDb - settings.thresholdDb);
+    }
+
+    const float timeMs = juce::jmax(0.1f, targetDb < duckGainDb ? settings.attackMs : settings.releaseMs);
+    const float coeff = 1.0f - std::exp(-1000.0f * static_cast<float>(numSamples)
+                                        / (timeMs * static_cast<float>(sampleRate)));
+
+    duckGainDb += (targetDb - duckGainDb) * coeff;
+    if (std::abs(targetDb - duckGainDb) < 0.01f)
+        duckGainDb = targetDb;
+
+    if (duckGainDb == 0.0f && appliedGainDb == 0.0f)
+    {
+        if (duckFilterBand >= 0)
+        {
+            duckFilter.setNumSections(0);
+            duckFilterBand = -1;
+        }
+    }
+    else
+    {
+        if (duckFilterBand < 0)
+        {
+            // Newly active: start flat so the first ramp has no step
+            duckFilter.setNumSections(1);
+            duckFilter.setCoefficients(0, duckBell(sampleRate, settings.duckBand, 0.0f));
+        }
+
+        duckFilterBand = settings.duckBand;
+        duckFilter.setCoefficients(0, duckBell(sampleRate, duckFilterBand, duckGainDb), numSamples);
+        appliedGainDb = duckGainDb;
+    }
+
+    reportDuckGainDb.store(duckGainDb, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void SidechainProcessor::publish(bool keyPresent)
+{
+    for (int band = 0; band < NUM_BANDS; ++band)
+    {
+        const auto index = static_cast<size_t>(band);
+        reportTrackDb[index].store(toDb(trackEnergy[index]), std::memory_order_relaxed);
+        reportKeyDb[index].store(toDb(keyEnergy[index]), std::memory_order_relaxed);
+    }
+
+    reportDuckGainDb.store(duckGainDb, std::memory_order_relaxed);
+    reportKeyPresent.store(keyPresent, std::memory_order_relaxed);
+}
+
+SidechainProcessor::Report SidechainProcessor::getReport() const
+{
+    Report report;
+    report.keyPresent = reportKeyPresent.load(std::memory_order_relaxed);
+    report.duckGainDb = reportDuckGainDb.load(std::memory_order_relaxed);
+
+    for (int band = 0; band < NUM_BANDS; ++band)
+    {
+        const auto index = static_cast<size_t>(band);
+        const float trackDb = reportTrackDb[index].load(std::memory_order_relaxed);
+        const float keyDb = reportKeyDb[index].load(std::memory_order_relaxed);
+
+        report.trackDb[index] = trackDb;
+        report.keyDb[index] = keyDb;
+        report.maskingDb[index] = (trackDb > MASKING_FLOOR_DB && keyDb > MASKING_FLOOR_DB)
+                                      ? juce::jlimit(NO_MASKING_DB, -NO_MASKING_DB, keyDb - trackDb)
+                                      : NO_MASKING_DB;
+    }
+
+    return report;
+}
+
+float SidechainProcessor::toDb(double meanSquare)
+{
+    if (meanSquare <= 1.0e-12)
+        return SILENCE_DB;
+
+    return juce::jmax(SILENCE_DB, static_cast<float>(10.0 * std::log10(meanSquare)));
+}
+
+} // namespace AIplayer
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    SidechainProcessor.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Block-rate masking analysis against a sidechain key and dynamic-EQ ducking.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include "BandEnergyAnalyzer.h"
+#include "BiquadEngine.h"
+#include <array>
+#include <atomic>
+
+namespace AIplayer {
+
+/**
+ * @class SidechainProcessor
+ * @brief Compares the track with a sidechain key and optionally ducks it
+ *
+ * Both signals are split at the BandEnergyAnalyzer edges (20/250/2k/8k/20k)
+ * with a Butterworth high-pass and low-pass per band, run through the shared
+ * BiquadEngine. This approximates the FFT bands rather than matching them:
+ * the 12 dB/octave skirts let neighbouring bands overlap, and band levels
+ * can differ from the FFT analysis by a few dB near the edges. In exchange
+ * the energies are available every block on the audio thread:
+ * - Per-band energies of the track and the key are smoothed over
+ *   ENERGY_SMOOTHING_MS and published lock-free
+ * - Masking per band is the key-to-track ratio in dB (positive: the key is
+ *   louder than the track in that band, e.g. kick over bass)
+ * - When ducking is enabled, a bell covering the selected band cuts the
+ *   track by the amount the key exceeds the threshold (1:1, limited to the
+ *   depth), with attack/release smoothing and per-block coefficient ramps
+ *
+ * Without a key, or with ducking off and fully released, process() returns
+ * without touching the audio. All memory is allocated in prepare().
+ */
+class SidechainProcessor
+{
+public:
+    static constexpr int NUM_BANDS = BandEnergyAnalyzer::NUM_BANDS;
+
+    /**
+     * @struct Settings
+     * @brief Ducking parameters, read from the plugin parameters every block
+     */
+    struct Settings
+    {
+        bool duckEnabled{false};
+        int duckBand{0};                ///< Band of the track to cut (0-3)
+        float thresholdDb{-30.0f};      ///< Key band level where ducking starts
+        float depthDb{6.0f};            ///< Largest cut
+        float attackMs{10.0f};
+        float releaseMs{150.0f};
+    };
+
+    /**
+     * @struct Report
+     * @brief Snapshot of the analysis for telemetry and UI
+     */
+    struct Report
+    {
+        bool keyPresent{false};
+        std::array<float, NUM_BANDS> trackDb{};
+        std::array<float, NUM_BANDS> keyDb{};
+        std::array<float, NUM_BANDS> maskingDb{};
+        float duckGainDb{0.0f};         ///< Cut currently applied (<= 0)
+    };
+
+    /// Largest ducking depth
+    static constexpr float MAX_DEPTH_DB = 24.0f;
+
+    /// Smoothing of the per-band energies
+    static constexpr float ENERGY_SMOOTHING_MS = 20.0f;
+
+    /// Level reported for an empty band
+    static constexpr float SILENCE_DB = -120.0f;
+
+    /// Bands quieter than this in either signal report no masking
+    static constexpr float MASKING_FLOOR_DB = -70.0f;
+
+    /// Masking value for bands below the floor (also the lower clamp)
+    static constexpr float NO_MASKING_DB = -60.0f;
+
+    /**
+     * @brief Constructor
+     */
+    SidechainProcessor() = default;
+
+    /**
+     * @brief Allocates filter state and scratch memory
+     *
+     * @param sampleRate Processing sample rate
+     * @param maxBlockSize Largest block passed to process()
+     * @param numChannels Number of track channels
+     */
+    void prepare(double sampleRate, int maxBlockSize, int numChannels);
+
+    /**
+     * @brief Clears filters, detectors and the ducking gain
+     */
+    void reset();
+
+    /**
+     * @brief Updates the ducking settings (audio thread)
+     *
+     * @param newSettings Settings for the following blocks
+     */
+    void setSettings(const Settings& newSettings);
+
+    /**
+     * @brief Analyses a block and applies ducking to the track in place
+     *
+     * @param track Track audio, ducked in place
+     * @param key Sidechain audio (read only), or nullptr when no key is connected
+     */
+    void process(juce::AudioBuffer<float>& track, const juce::AudioBuffer<float>* key);
+
+    /**
+     * @brief Latest analysis (any thread)
+     */
+    Report getReport() const;
+
+    /**
+     * @brief Band-pass section for a band
+     *
+     * @param sampleRate The sample rate
+     * @param band Band index (0-3)
+     * @param stage 0 = high-pass at the lower edge, 1 = low-pass at the upper edge
+     */
+    static BiquadCoefficients bandSplit(double sampleRate, int band, int stage);
+
+    /**
+     * @brief Bell covering a band, used for ducking
+     *
+     * @param sampleRate The sample rate
+     * @param band Band index (0-3)
+     * @param gainDb Bell gain
+     */
+    static BiquadCoefficients duckBell(double sampleRate, int band, float gainDb);
+
+private:
+    /// Averages the channels of source into destination
+    static void downmix(const juce::AudioBuffer<float>& source, float* destination, int numSamples);
+
+    /// Band energies of both signals for this block
+    void analyse(int numSamples);
+
+    /// Moves the ducking gain and updates the bell
+    void updateDucking(int numSamples);
+
+    /// Stores the current detector values for getReport()
+    void publish(bool keyPresent);
+
+    static float toDb(double meanSquare);
+
+    double sampleRate{44100.0};
+    int maxBlockSize{0};
+    Settings settings;
+
+    std::array<BiquadEngine, NUM_BANDS> bandFilters;   ///< 2 channels: track sum, key sum
+    juce::AudioBuffer<float> mono;                     ///< Track and key sums
+    juce::AudioBuffer<float> bandScratch;
+
+    std::array<double, NUM_BANDS> trackEnergy{};
+    std::array<double, NUM_BANDS> keyEnergy{};
+    bool analysing{false};
+
+    BiquadEngine duckFilter;
+    int duckFilterBand{-1};
+    float duckGainDb{0.0f};
+    float appliedGainDb{0.0f};          ///< Gain of the bell's last coefficients
+
+    // Published report
+    std::atomic<bool> reportKeyPresent{false};
+    std::array<std::atomic<float>, NUM_BANDS> reportTrackDb{};
+    std::array<std::atomic<float>, NUM_BANDS> reportKeyDb{};
+    std::atomic<float> reportDuckGainDb{0.0f};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SidechainProcessor)
+};
+
+} // namespace AIplayer
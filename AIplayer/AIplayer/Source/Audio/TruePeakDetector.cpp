@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the streaming true-peak detector.
+
+  ==============================================================================
+*/
+
+#include "TruePeakDetector.h"
+
+namespace AIplayer {
+
+void TruePeakDetector::prepare(int numChannels)
+{
+    history.setSize(juce::jmax(1, numChannels), 2 * TAPS_PER_PHASE);
+    reset();
+}
+
+void TruePeakDetector::reset()
+{
+    history.clear();
+    position = 0;
+}
+
+float TruePeakDetector::processBlock(const juce::AudioBuffer<float>& buffer)
+{
+    const auto* const* channels = buffer.getArrayOfReadPointers();
+    const int numChannels = buffer.getNumChannels();
+
+    float peak = 0.0f;
+    for (int i = 0; i < buffer.getNumSamples(); ++i)
+        peak = juce::jmax(peak, processFrame(channels, numChannels, i));
+
+    return peak;
+}
+
+} // namespace AIplayer
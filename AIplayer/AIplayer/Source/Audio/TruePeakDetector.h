@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Streaming 4x true-peak detector (ITU-R BS.1770-4 Annex 2 interpolator).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include <cmath>
+
+namespace AIplayer {
+
+/**
+ * @class TruePeakDetector
+ * @brief Estimates inter-sample peaks by 4x polyphase interpolation
+ *
+ * Each input sample produces four interpolated points from the 48-tap
+ * BS.1770-4 interpolation filter (four 12-tap phases). The reported peak
+ * also includes the original sample, so it is never below the sample peak.
+ *
+ * The filter is centred DELAY_SAMPLES behind the newest input: the peak
+ * returned for sample n describes the signal around sample n - DELAY_SAMPLES.
+ * Consumers that act on the detection (the lookahead limiter) add this to
+ * their delay. History is allocated in prepare(); processing never allocates.
+ */
+class TruePeakDetector
+{
+public:
+    /// Interpolation factor
+    static constexpr int OVERSAMPLING = 4;
+
+    /// Taps per polyphase branch
+    static constexpr int TAPS_PER_PHASE = 12;
+
+    /// Input samples between the newest sample and the detected region
+    static constexpr int DELAY_SAMPLES = 6;
+
+    /// BS.1770-4 Annex 2 interpolation filter, split into its four phases
+    static constexpr float COEFFICIENTS[OVERSAMPLING][TAPS_PER_PHASE] = {
+        {  0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f,
+          -0.0594482421875f,  0.1373291015625f,  0.9721679687500f, -0.1022949218750f,
+           0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+        { -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f,
+          -0.1665039062500f,  0.4650878906250f,  0.7797851562500f, -0.2003173828125f,
+           0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+        { -0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f,
+          -0.2003173828125f,  0.7797851562500f,  0.4650878906250f, -0.1665039062500f,
+           0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+        { -0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f,
+          -0.1022949218750f,  0.9721679687500f,  0.1373291015625f, -0.0594482421875f,
+           0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f }
+    };
+
+    /**
+     * @brief Constructor
+     */
+    TruePeakDetector() = default;
+
+    /**
+     * @brief Allocates the filter history
+     *
+     * @param numChannels Number of channels
+     */
+    void prepare(int numChannels);
+
+    /**
+     * @brief Clears the filter history
+     */
+    void reset();
+
+    /**
+     * @brief Feeds one sample of every channel
+     *
+     * @details Inline: called once per sample by the limiter.
+     *
+     * @param channels Channel pointers
+     * @param numChannels Channels to read (clamped to the prepared count)
+     * @param index Sample index within the channel arrays
+     * @return Largest absolute true-peak value across channels (linear)
+     */
+    float processFrame(const float* const* channels, int numChannels, int index)
+    {
+        numChannels = juce::jmin(numChannels, history.getNumChannels());
+
+        // History is mirrored so taps[k] is x[n - k] without wrapping
+        position = (position == 0 ? TAPS_PER_PHASE : position) - 1;
+
+        float peak = 0.0f;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float* stored = history.getWritePointer(channel);
+            const float sample = channels[channel][index];
+            stored[position] = sample;
+            stored[position + TAPS_PER_PHASE] = sample;
+
+            const float* taps = stored + position;
+            float channelPeak = std::abs(taps[DELAY_SAMPLES]);
+
+            for (const auto& phase : COEFFICIENTS)
+            {
+                float sum = 0.0f;
+                for (int k = 0; k < TAPS_PER_PHASE; ++k)
+                    sum += phase[k] * taps[k];
+
+                channelPeak = juce::jmax(channelPeak, std::abs(sum));
+            }
+
+            peak = juce::jmax(peak, channelPeak);
+        }
+
+        return peak;
+    }
+
+    /**
+     * @brief Feeds a block and returns its largest true peak
+     *
+     * @param buffer Audio to measure
+     * @return Largest true-peak value in the block (linear)
+     */
+    float processBlock(const juce::AudioBuffer<float>& buffer);
+
+private:
+    juce::AudioBuffer<float> history;   ///< 2 * TAPS_PER_PHASE per channel
+    int position{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TruePeakDetector)
+};
+
+} // namespace AIplayer
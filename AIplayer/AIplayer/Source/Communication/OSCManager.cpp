@@ -282,6 +282,240 @@ bool OSCManager::sendChatMessage(int instanceID, const juce::String& message)
     return sender.send(oscMessage);
 }
 
+bool OSCManager::sendAutoLevelStatus(const juce::String& trackID, const juce::String& mode, float targetDb,
+                                     float measuredDb, float gainDb, bool converged)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    juce::OSCMessage message(Constants::OSCAddresses::AUTO_LEVEL_STATUS);
+    message.addString(trackID);
+    message.addString(mode);
+    message.addFloat32(targetDb);
+    message.addFloat32(measuredDb);
+    message.addFloat32(gainDb);
+    message.addInt32(converged ? 1 : 0);
+    
+    return sender.send(message);
+}
+
+bool OSCManager::sendSidechainAnalysis(const juce::String& trackID, const std::array<float, 4>& keyBandsDb,
+                                       const std::array<float, 4>& maskingDb, float duckGainDb)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    juce::OSCMessage message(Constants::OSCAddresses::SIDECHAIN_ANALYSIS);
+    message.addString(trackID);
+    for (float level : keyBandsDb)
+        message.addFloat32(level);
+    for (float masking : maskingDb)
+        message.addFloat32(masking);
+    message.addFloat32(duckGainDb);
+    
+    return sender.send(message);
+}
+
+bool OSCManager::sendChannelMeters(const juce::String& trackID, float momentaryLufs,
+                                   const float* rms, const float* peak, int numChannels)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    juce::OSCMessage message(Constants::OSCAddresses::CHANNEL_METERS);
+    message.addString(trackID);
+    message.addFloat32(momentaryLufs);
+    message.addInt32(numChannels);
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        message.addFloat32(rms[channel]);
+        message.addFloat32(peak[channel]);
+    }
+    
+    return sender.send(message);
+}
+
+bool OSCManager::sendAnalysisQuality(const juce::String& trackID, const juce::String& tier, const juce::String& priority,
+                                     int fftSize, float overlap, int updateRateHz, int features,
+                                     float callbackLoad, float analysisLoad)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    juce::OSCMessage message(Constants::OSCAddresses::ANALYSIS_QUALITY);
+    message.addString(trackID);
+    message.addString(tier);
+    message.addString(priority);
+    message.addInt32(fftSize);
+    message.addFloat32(overlap);
+    message.addInt32(updateRateHz);
+    message.addInt32(features);
+    message.addFloat32(callbackLoad);
+    message.addFloat32(analysisLoad);
+    
+    return sender.send(message);
+}
+
+bool OSCManager::sendSpectrumChunk(const juce::String& trackID, int frameID, int chunkIndex, int numChunks,
+                                   int format, int totalBins, int firstBin, float lowHz, float highHz,
+                                   const void* data, int numBytes)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    juce::OSCMessage message(Constants::OSCAddresses::SPECTRUM);
+    message.addString(trackID);
+    message.addInt32(frameID);
+    message.addInt32(chunkIndex);
+    message.addInt32(numChunks);
+    message.addInt32(format);
+    message.addInt32(totalBins);
+    message.addInt32(firstBin);
+    message.addFloat32(lowHz);
+    message.addFloat32(highHz);
+    message.addBlob(juce::MemoryBlock(data, static_cast<size_t>(numBytes)));
+    
+    return sender.send(message);
+}
+
+bool OSCManager::sendLongTermSpectrum(const juce::String& trackID, const juce::String& mode, float integratedSeconds,
+                                      float minFrequency, int binsPerOctave, const float* levelsDb, int numBins,
+                                      const juce::String& referenceName, float rmsDeviationDb,
+                                      const float* bandDeviationDb, const float* deviationDb, const float* eqDb)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    juce::OSCMessage message(Constants::OSCAddresses::LTAS);
+    message.addString(trackID);
+    message.addString(mode);
+    message.addFloat32(integratedSeconds);
+    message.addFloat32(minFrequency);
+    message.addInt32(binsPerOctave);
+    message.addInt32(numBins);
+    for (int bin = 0; bin < numBins; ++bin)
+        message.addFloat32(levelsDb[bin]);
+    
+    // Comparison only when a reference was matched
+    message.addString(referenceName);
+    if (referenceName.isNotEmpty())
+    {
+        message.addFloat32(rmsDeviationDb);
+        for (int band = 0; band < 4; ++band)
+            message.addFloat32(bandDeviationDb[band]);
+        for (int bin = 0; bin < numBins; ++bin)
+            message.addFloat32(deviationDb[bin]);
+        for (int bin = 0; bin < numBins; ++bin)
+            message.addFloat32(eqDb[bin]);
+    }
+    
+    return sender.send(message);
+}
+
+bool OSCManager::sendPitch(const juce::String& trackID, bool voiced, float frequencyHz, float confidence,
+                           float midiNote, const juce::String& noteName, const float* harmonicDb, int numHarmonics)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    juce::OSCMessage message(Constants::OSCAddresses::PITCH);
+    message.addString(trackID);
+    message.addInt32(voiced ? 1 : 0);
+    message.addFloat32(frequencyHz);
+    message.addFloat32(confidence);
+    message.addFloat32(midiNote);
+    message.addString(noteName);
+    for (int harmonic = 0; harmonic < numHarmonics; ++harmonic)
+        message.addFloat32(harmonicDb[harmonic]);
+    
+    return sender.send(message);
+}
+
+bool OSCManager::sendTempo(const juce::String& trackID, const juce::String& source, float bpm, float phase, float confidence)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    juce::OSCMessage message(Constants::OSCAddresses::TEMPO);
+    message.addString(trackID);
+    message.addString(source);
+    message.addFloat32(bpm);
+    message.addFloat32(phase);
+    message.addFloat32(confidence);
+    
+    return sender.send(message);
+}
+
+bool OSCManager::sendDynamics(const juce::String& trackID, const juce::String& window, float activeSeconds,
+                              float peakDb, float rmsDb, float crestDb, float lowDb, float highDb,
+                              float loudnessLufs, float plrDb, float psrDb)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    juce::OSCMessage message(Constants::OSCAddresses::DYNAMICS);
+    message.addString(trackID);
+    message.addString(window);
+    message.addFloat32(activeSeconds);
+    message.addFloat32(peakDb);
+    message.addFloat32(rmsDb);
+    message.addFloat32(crestDb);
+    message.addFloat32(lowDb);
+    message.addFloat32(highDb);
+    message.addFloat32(loudnessLufs);
+    message.addFloat32(plrDb);
+    message.addFloat32(psrDb);
+    
+    return sender.send(message);
+}
+
+bool OSCManager::sendDrumHits(const juce::String& trackID, int hits, const float* means,
+                              const float* deviations, int numMeasures)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    // Mean and deviation interleaved per measure
+    juce::OSCMessage message(Constants::OSCAddresses::DRUM_HITS);
+    message.addString(trackID);
+    message.addInt32(hits);
+    
+    for (int i = 0; i < numMeasures; ++i)
+    {
+        message.addFloat32(means[i]);
+        message.addFloat32(deviations[i]);
+    }
+    
+    return sender.send(message);
+}
+
+bool OSCManager::sendInstances(const juce::String& queryID, const InstanceRegistry::Entry* entries, int numEntries)
+{
+    if (!senderConnected.load())
+        return false;
+    
+    juce::OSCMessage message(Constants::OSCAddresses::INSTANCES);
+    message.addString(queryID);
+    message.addInt32(numEntries);
+    
+    const auto now = juce::Time::getMillisecondCounter();
+    
+    for (int i = 0; i < numEntries; ++i)
+    {
+        const auto& entry = entries[i];
+        message.addString(juce::String::fromUTF8(entry.instanceID));
+        message.addString(juce::String::fromUTF8(entry.trackID));
+        message.addInt32(entry.port);
+        message.addString(juce::String::fromUTF8(entry.state));
+        message.addFloat32(entry.rmsDb);
+        message.addFloat32(entry.peakDb);
+        message.addFloat32(entry.loudnessLufs);
+        message.addInt32(entry.metricsTimeMs == 0 ? -1 : static_cast<int>(now - entry.metricsTimeMs));
+    }
+    
+    return sender.send(message);
+}
+
 void OSCManager::addListener(Listener* listener)
 {
     listeners.add(listener);
@@ -329,6 +563,40 @@ void OSCManager::oscMessageReceived(const juce::OSCMessage& message)
         {
             parseToneControl(message);
         }
+        else if (addressPattern == Constants::OSCAddresses::AUTO_LEVEL)
+        {
+            parseAutoLevel(message);
+        }
+        else if (addressPattern == Constants::OSCAddresses::ANALYSIS_PRIORITY)
+        {
+            parseAnalysisPriority(message);
+        }
+        else if (addressPattern == Constants::OSCAddresses::FOCUS)
+        {
+            parseFocus(message);
+        }
+        else if (addressPattern == Constants::OSCAddresses::SPECTRUM_REQUEST)
+        {
+            parseSpectrumRequest(message);
+        }
+        else if (addressPattern == Constants::OSCAddresses::LTAS_CONFIG ||
+                 addressPattern == Constants::OSCAddresses::LTAS_REFERENCE ||
+                 addressPattern == Constants::OSCAddresses::LTAS_QUERY)
+        {
+            parseLtas(message, addressPattern);
+        }
+        else if (addressPattern == Constants::OSCAddresses::PITCH_CONFIG)
+        {
+            parsePitchConfig(message);
+        }
+        else if (addressPattern == Constants::OSCAddresses::DRUM_CONFIG)
+        {
+            parseDrumConfig(message);
+        }
+        else if (addressPattern == Constants::OSCAddresses::QUERY_INSTANCES)
+        {
+            parseInstancesQuery(message);
+        }
         else if (addressPattern == Constants::OSCAddresses::CHAT_RESPONSE)
         {
             if (message.size() == 1 && message[0].isString())
@@ -443,6 +711,232 @@ void OSCManager::parseToneControl(const juce::OSCMessage& message)
     }
 }
 
+/**
+ * @brief Parses /aiplayer/auto_level
+ * 
+ * @details Format: (string mode, [float targetDb], [float toleranceDb],
+ * [float timeConstantMs]). Mode is "lufs", "rms" or "off"; omitted numeric
+ * arguments take the defaults -18 dB, 0.5 dB and 500 ms.
+ */
+void OSCManager::parseAutoLevel(const juce::OSCMessage& message)
+{
+    if (message.size() < 1 || !message[0].isString())
+    {
+        logger.log(Logger::Level::Warning, "Invalid auto_level message format");
+        return;
+    }
+    
+    float values[3] = { -18.0f, 0.5f, 500.0f };
+    for (int i = 1; i < message.size() && i <= 3; ++i)
+    {
+        if (message[i].isFloat32())
+            values[i - 1] = message[i].getFloat32();
+        else if (message[i].isInt32())
+            values[i - 1] = static_cast<float>(message[i].getInt32());
+    }
+    
+    listeners.call(&Listener::handleAutoLevelTarget, message[0].getString(), values[0], values[1], values[2]);
+}
+
+/**
+ * @brief Parses /aiplayer/analysis_priority
+ * 
+ * @details Format: (string priority) with "background", "normal" or
+ * "focused", or (int priority) with 0, 1 or 2.
+ */
+void OSCManager::parseAnalysisPriority(const juce::OSCMessage& message)
+{
+    if (message.size() >= 1 && message[0].isString())
+    {
+        listeners.call(&Listener::handleAnalysisPriority, message[0].getString());
+    }
+    else if (message.size() >= 1 && message[0].isInt32())
+    {
+        listeners.call(&Listener::handleAnalysisPriority, juce::String(message[0].getInt32()));
+    }
+    else
+    {
+        logger.log(Logger::Level::Warning, "Invalid analysis_priority message format");
+    }
+}
+
+/**
+ * @brief Parses /aiplayer/focus
+ * 
+ * @details Format: (string trackID, ...) listing the tracks the producer is
+ * focusing on; no arguments clears the focus. The same message goes to
+ * every instance, and each decides whether it is one of them.
+ */
+void OSCManager::parseFocus(const juce::OSCMessage& message)
+{
+    juce::StringArray trackIDs;
+    
+    for (const auto& argument : message)
+    {
+        if (!argument.isString())
+        {
+            logger.log(Logger::Level::Warning, "Invalid focus message format");
+            return;
+        }
+        
+        trackIDs.add(argument.getString());
+    }
+    
+    listeners.call(&Listener::handleFocus, trackIDs);
+}
+
+/**
+ * @brief Parses /aiplayer/spectrum_request
+ * 
+ * @details Format: (string resolution, [int bits], [int delta], [float rateHz]).
+ * Resolution is "log", "full" or "off"; omitted arguments take 8 bits, no
+ * delta coding and rate 0 (a single frame).
+ */
+void OSCManager::parseSpectrumRequest(const juce::OSCMessage& message)
+{
+    if (message.size() < 1 || !message[0].isString())
+    {
+        logger.log(Logger::Level::Warning, "Invalid spectrum_request message format");
+        return;
+    }
+    
+    float values[3] = { 8.0f, 0.0f, 0.0f };
+    for (int i = 1; i < message.size() && i <= 3; ++i)
+    {
+        if (message[i].isFloat32())
+            values[i - 1] = message[i].getFloat32();
+        else if (message[i].isInt32())
+            values[i - 1] = static_cast<float>(message[i].getInt32());
+    }
+    
+    listeners.call(&Listener::handleSpectrumRequest, message[0].getString(),
+                   juce::roundToInt(values[0]), values[1] != 0.0f, values[2]);
+}
+
+/**
+ * @brief Parses the /aiplayer/ltas_* messages
+ * 
+ * @details Formats:
+ * - ltas_config: (string mode, [float timeConstantSeconds]) with mode
+ *   "exponential", "infinite" or "reset"
+ * - ltas_reference: (string name, string filePath) or
+ *   (string name, float frequency, float levelDb, ...)
+ * - ltas_query: ([string referenceName])
+ */
+void OSCManager::parseLtas(const juce::OSCMessage& message, const juce::String& addressPattern)
+{
+    if (addressPattern == Constants::OSCAddresses::LTAS_QUERY)
+    {
+        const juce::String reference = message.size() >= 1 && message[0].isString() ? message[0].getString() : juce::String();
+        listeners.call(&Listener::handleLtasQuery, reference);
+        return;
+    }
+    
+    if (message.size() < 1 || !message[0].isString())
+    {
+        logger.log(Logger::Level::Warning, "Invalid " + addressPattern + " message format");
+        return;
+    }
+    
+    if (addressPattern == Constants::OSCAddresses::LTAS_CONFIG)
+    {
+        float timeConstant = 10.0f;
+        if (message.size() >= 2 && message[1].isFloat32())
+            timeConstant = message[1].getFloat32();
+        else if (message.size() >= 2 && message[1].isInt32())
+            timeConstant = static_cast<float>(message[1].getInt32());
+        
+        listeners.call(&Listener::handleLtasConfig, message[0].getString(), timeConstant);
+        return;
+    }
+    
+    juce::String filePath;
+    juce::Array<float> points;
+    
+    if (message.size() == 2 && message[1].isString())
+    {
+        filePath = message[1].getString();
+    }
+    else
+    {
+        for (int i = 1; i < message.size(); ++i)
+        {
+            if (message[i].isFloat32())
+                points.add(message[i].getFloat32());
+            else if (message[i].isInt32())
+                points.add(static_cast<float>(message[i].getInt32()));
+        }
+    }
+    
+    listeners.call(&Listener::handleLtasReference, message[0].getString(), filePath, points);
+}
+
+/**
+ * @brief Parses /aiplayer/pitch_config
+ * 
+ * @details Format: (int enable, [float minHz, float maxHz]); numbers may be
+ * int or float.
+ */
+void OSCManager::parsePitchConfig(const juce::OSCMessage& message)
+{
+    float values[3] = { 0.0f, 0.0f, 0.0f };
+    int count = 0;
+    
+    for (int i = 0; i < message.size() && i < 3; ++i)
+    {
+        if (message[i].isInt32())
+            values[count++] = static_cast<float>(message[i].getInt32());
+        else if (message[i].isFloat32())
+            values[count++] = message[i].getFloat32();
+        else
+            break;
+    }
+    
+    if (count != 1 && count != 3)
+    {
+        logger.log(Logger::Level::Warning, "Invalid pitch_config message format");
+        return;
+    }
+    
+    listeners.call(&Listener::handlePitchConfig, values[0] != 0.0f, values[1], values[2]);
+}
+
+void OSCManager::parseDrumConfig(const juce::OSCMessage& message)
+{
+    float values[2] = { 0.0f, 0.0f };
+    int count = 0;
+    
+    for (int i = 0; i < message.size() && i < 2; ++i)
+    {
+        if (message[i].isInt32())
+            values[count++] = static_cast<float>(message[i].getInt32());
+        else if (message[i].isFloat32())
+            values[count++] = message[i].getFloat32();
+        else
+            break;
+    }
+    
+    if (count == 0)
+    {
+        logger.log(Logger::Level::Warning, "Invalid drum_config message format");
+        return;
+    }
+    
+    listeners.call(&Listener::handleDrumConfig, values[0] != 0.0f, values[1]);
+}
+
+void OSCManager::parseInstancesQuery(const juce::OSCMessage& message)
+{
+    if (message.size() > 1 || (message.size() == 1 && !message[0].isString()))
+    {
+        logger.log(Logger::Level::Warning, "Invalid query_instances message format");
+        return;
+    }
+    
+    const auto queryID = message.size() == 1 ? message[0].getString() : juce::String();
+    listeners.call(&Listener::handleInstancesQuery, queryID);
+}
+
 juce::String OSCManager::getOscArgumentTypeString(const juce::OSCArgument& arg)
 {
     if (arg.isInt32()) return "i";
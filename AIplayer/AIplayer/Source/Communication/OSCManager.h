@@ -15,8 +15,10 @@
 
 #include "../../JuceLibraryCode/JuceHeader.h"
 #include "../Core/Logger.h"
+#include "../Core/InstanceRegistry.h"
 #include "../Models/TelemetryData.h"
 #include "../Models/TrackInfo.h"
+#include <array>
 
 namespace AIplayer {
 
@@ -57,6 +59,38 @@ public:
         
         /// Called when a chat response is received
         virtual void handleChatResponse(const juce::String& response) = 0;
+        
+        /// Called when an auto-level target is received
+        virtual void handleAutoLevelTarget(const juce::String& mode, float targetDb,
+                                           float toleranceDb, float timeConstantMs) = 0;
+        
+        /// Called when the controller sets this instance's analysis priority
+        virtual void handleAnalysisPriority(const juce::String& priority) = 0;
+        
+        /// Called when the controller changes which tracks the producer is focusing on
+        virtual void handleFocus(const juce::StringArray& focusedTrackIDs) = 0;
+        
+        /// Called when the controller requests the spectrum ("off" cancels a subscription)
+        virtual void handleSpectrumRequest(const juce::String& resolution, int bits, bool delta, float rateHz) = 0;
+        
+        /// Called when the long-term average spectrum is reconfigured ("exponential", "infinite" or "reset")
+        virtual void handleLtasConfig(const juce::String& mode, float timeConstantSeconds) = 0;
+        
+        /// Called when a reference curve arrives, as a file path or as frequency/level pairs
+        virtual void handleLtasReference(const juce::String& name, const juce::String& filePath,
+                                         const juce::Array<float>& points) = 0;
+        
+        /// Called when the controller asks for the long-term average spectrum
+        virtual void handleLtasQuery(const juce::String& referenceName) = 0;
+        
+        /// Called when pitch tracking is switched on or off (a range of 0 keeps the current one)
+        virtual void handlePitchConfig(bool enable, float minHz, float maxHz) = 0;
+        
+        /// Called when drum hit analysis is switched on or off (a threshold of 0 keeps the current one)
+        virtual void handleDrumConfig(bool enable, float thresholdDb) = 0;
+        
+        /// Called when the controller asks for every instance in the host
+        virtual void handleInstancesQuery(const juce::String& queryID) = 0;
     };
     
     /**
@@ -177,6 +211,180 @@ public:
      */
     bool sendChatMessage(int instanceID, const juce::String& message);
     
+    /**
+     * @brief Sends auto-level convergence status
+     * 
+     * @param trackID Track ID (or instance ID if unassigned)
+     * @param mode Active mode ("lufs", "rms" or "off")
+     * @param targetDb Target level
+     * @param measuredDb Estimated output level
+     * @param gainDb Gain currently applied by the plugin
+     * @param converged Whether the level is within tolerance
+     * @return true if sent successfully
+     */
+    bool sendAutoLevelStatus(const juce::String& trackID, const juce::String& mode, float targetDb,
+                             float measuredDb, float gainDb, bool converged);
+    
+    /**
+     * @brief Sends the sidechain key's band levels and masking against the track
+     * 
+     * @param trackID Track ID (or instance ID if unassigned)
+     * @param keyBandsDb Key level per band (dB)
+     * @param maskingDb Key-to-track ratio per band (dB, positive = track masked)
+     * @param duckGainDb Ducking cut currently applied
+     * @return true if sent successfully
+     */
+    bool sendSidechainAnalysis(const juce::String& trackID, const std::array<float, 4>& keyBandsDb,
+                               const std::array<float, 4>& maskingDb, float duckGainDb);
+    
+    /**
+     * @brief Sends per-channel meters for a multichannel bus
+     * 
+     * @param trackID Track ID (or instance ID if unassigned)
+     * @param momentaryLufs Channel-weighted momentary loudness
+     * @param rms Per-channel RMS levels (linear)
+     * @param peak Per-channel peak levels (linear)
+     * @param numChannels Number of channels
+     * @return true if sent successfully
+     */
+    bool sendChannelMeters(const juce::String& trackID, float momentaryLufs,
+                           const float* rms, const float* peak, int numChannels);
+    
+    /**
+     * @brief Sends the analysis quality chosen by the governor and the load behind it
+     * 
+     * @param trackID Track ID (or instance ID if unassigned)
+     * @param tier Quality tier ("minimal", "reduced", "standard", "high")
+     * @param priority Instance priority ("background", "normal", "focused")
+     * @param fftSize FFT size in samples
+     * @param overlap Frame overlap fraction
+     * @param updateRateHz Analysis update rate
+     * @param features Optional features running (AnalysisGovernor::Feature flags)
+     * @param callbackLoad Audio callback time as a fraction of real time
+     * @param analysisLoad Analysis time as a fraction of the message thread
+     * @return true if sent successfully
+     */
+    bool sendAnalysisQuality(const juce::String& trackID, const juce::String& tier, const juce::String& priority,
+                             int fftSize, float overlap, int updateRateHz, int features,
+                             float callbackLoad, float analysisLoad);
+    
+    /**
+     * @brief Sends one chunk of a spectrum frame
+     * 
+     * @param trackID Track ID (or instance ID if unassigned)
+     * @param frameID Frame the chunk belongs to
+     * @param chunkIndex Index of this chunk within the frame
+     * @param numChunks Number of chunks in the frame
+     * @param format SpectrumStreamer::Format flags
+     * @param totalBins Bins in the whole frame
+     * @param firstBin First bin carried by this chunk
+     * @param lowHz Lower band edge (log) or first bin frequency (full)
+     * @param highHz Upper band edge (log) or last bin frequency (full)
+     * @param data Encoded bins
+     * @param numBytes Size of data
+     * @return true if sent successfully
+     */
+    bool sendSpectrumChunk(const juce::String& trackID, int frameID, int chunkIndex, int numChunks,
+                           int format, int totalBins, int firstBin, float lowHz, float highHz,
+                           const void* data, int numBytes);
+    
+    /**
+     * @brief Sends the long-term average spectrum, optionally with a reference comparison
+     * 
+     * @param trackID Track ID (or instance ID if unassigned)
+     * @param mode Integration mode ("exponential" or "infinite")
+     * @param integratedSeconds Audio time averaged
+     * @param minFrequency Lower edge of the first bin
+     * @param binsPerOctave Bin spacing
+     * @param levelsDb Average level per bin (dB)
+     * @param numBins Number of bins
+     * @param referenceName Reference compared against, or empty
+     * @param rmsDeviationDb Overall RMS deviation (with a reference)
+     * @param bandDeviationDb Mean deviation per analysis band (with a reference, 4 values)
+     * @param deviationDb Deviation per bin (with a reference)
+     * @param eqDb Suggested EQ per bin (with a reference)
+     * @return true if sent successfully
+     */
+    bool sendLongTermSpectrum(const juce::String& trackID, const juce::String& mode, float integratedSeconds,
+                              float minFrequency, int binsPerOctave, const float* levelsDb, int numBins,
+                              const juce::String& referenceName, float rmsDeviationDb,
+                              const float* bandDeviationDb, const float* deviationDb, const float* eqDb);
+    
+    /**
+     * @brief Sends the tracked pitch and harmonic levels
+     * 
+     * @param trackID Track identifier
+     * @param voiced Whether the frame is pitched
+     * @param frequencyHz Fundamental (0 if none was found)
+     * @param confidence Clarity of the period, 0-1
+     * @param midiNote Fractional MIDI note
+     * @param noteName Nearest note name (e.g. "E1"), empty if none
+     * @param harmonicDb Level of each harmonic (dBFS)
+     * @param numHarmonics Number of harmonics
+     * @return true if sent successfully
+     */
+    bool sendPitch(const juce::String& trackID, bool voiced, float frequencyHz, float confidence,
+                   float midiNote, const juce::String& noteName, const float* harmonicDb, int numHarmonics);
+    
+    /**
+     * @brief Sends the tempo and beat phase
+     * 
+     * @param trackID Track identifier
+     * @param source Where the tempo comes from ("audio" or "host")
+     * @param bpm Tempo
+     * @param phase Position within the beat (0 at the beat, up to 1)
+     * @param confidence Confidence of the estimate, 0-1
+     * @return true if sent successfully
+     */
+    bool sendTempo(const juce::String& trackID, const juce::String& source, float bpm, float phase, float confidence);
+    
+    /**
+     * @brief Sends the dynamics statistics of one window
+     * 
+     * @param trackID Track identifier
+     * @param window Window name ("short" or "long")
+     * @param activeSeconds Audio above the gate within the window
+     * @param peakDb Highest sample peak (dBFS)
+     * @param rmsDb Mean RMS (dBFS)
+     * @param crestDb Crest factor
+     * @param lowDb 10th percentile of the RMS level (dBFS)
+     * @param highDb 95th percentile of the RMS level (dBFS)
+     * @param loudnessLufs Gated loudness
+     * @param plrDb Peak-to-loudness ratio
+     * @param psrDb Peak-to-short-term loudness ratio
+     * @return true if sent successfully
+     */
+    bool sendDynamics(const juce::String& trackID, const juce::String& window, float activeSeconds,
+                      float peakDb, float rmsDb, float crestDb, float lowDb, float highDb,
+                      float loudnessLufs, float plrDb, float psrDb);
+    
+    /**
+     * @brief Sends the drum hit statistics
+     * 
+     * @param trackID Track identifier
+     * @param hits Hits measured since analysis was switched on
+     * @param means Mean of each DrumHitAnalyzer::Measure
+     * @param deviations Standard deviation of each measure (hit-to-hit consistency)
+     * @param numMeasures Number of measures
+     * @return true if sent successfully
+     */
+    bool sendDrumHits(const juce::String& trackID, int hits, const float* means,
+                      const float* deviations, int numMeasures);
+    
+    /**
+     * @brief Sends the registry entries of all instances in one message
+     * 
+     * After the query ID and the count, each instance adds its instance ID,
+     * track ID, port, port state, RMS and peak (dBFS), momentary loudness
+     * and the age of its levels in ms (-1 if never measured).
+     * 
+     * @param queryID ID of the query being answered
+     * @param entries Registry entries
+     * @param numEntries Number of entries
+     * @return true if sent successfully
+     */
+    bool sendInstances(const juce::String& queryID, const InstanceRegistry::Entry* entries, int numEntries);
+    
     /**
      * @brief Adds a listener for OSC events
      * 
@@ -256,6 +464,46 @@ private:
      */
     void parseToneControl(const juce::OSCMessage& message);
     
+    /**
+     * @brief Parses an auto-level target message
+     */
+    void parseAutoLevel(const juce::OSCMessage& message);
+    
+    /**
+     * @brief Parses an analysis priority message
+     */
+    void parseAnalysisPriority(const juce::OSCMessage& message);
+    
+    /**
+     * @brief Parses a focus message
+     */
+    void parseFocus(const juce::OSCMessage& message);
+    
+    /**
+     * @brief Parses a spectrum request message
+     */
+    void parseSpectrumRequest(const juce::OSCMessage& message);
+    
+    /**
+     * @brief Parses the long-term average spectrum messages
+     */
+    void parseLtas(const juce::OSCMessage& message, const juce::String& addressPattern);
+    
+    /**
+     * @brief Parses the pitch tracking configuration
+     */
+    void parsePitchConfig(const juce::OSCMessage& message);
+    
+    /**
+     * @brief Parses the drum hit analysis configuration
+     */
+    void parseDrumConfig(const juce::OSCMessage& message);
+    
+    /**
+     * @brief Parses an instances query (optional query ID)
+     */
+    void parseInstancesQuery(const juce::OSCMessage& message);
+    
     /**
      * @brief Helper to get OSC argument type as string
      */
@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+    SpectrumStreamer.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the on-demand spectrum stream.
+
+  ==============================================================================
+*/
+
+#include "SpectrumStreamer.h"
+#include "../Audio/FrequencyAnalyzer.h"
+#include "../Models/AnalysisFrame.h"
+#include "OSCManager.h"
+
+namespace AIplayer {
+
+SpectrumStreamer::SpectrumStreamer(FrequencyAnalyzer& frequencyAnalyzer, OSCManager& manager, Logger& log)
+    : analyzer(frequencyAnalyzer)
+    , oscManager(manager)
+    , logger(log)
+{
+    // Room for the largest frame, so streaming never reallocates
+    levels.resize(MAX_FULL_BINS);
+    previousCodes.reserve(MAX_FULL_BINS);
+    payload.reserve(MAX_FULL_BINS * 2);
+    chunks.reserve((MAX_FULL_BINS * 2) / MAX_CHUNK_BYTES + 1);
+}
+
+SpectrumStreamer::~SpectrumStreamer()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void SpectrumStreamer::request(const Settings& newSettings)
+{
+    settings = newSettings;
+    settings.bits = newSettings.bits > 8 ? 16 : 8;
+    settings.rateHz = juce::jlimit(0.0f, static_cast<float>(MAX_RATE_HZ), newSettings.rateHz);
+
+    // Codes of the previous stream may use another scale
+    needsKeyframe = true;
+
+    // The frame already available answers a one-shot request straight away
+    lastFrameSequence = 0;
+
+    // One-shot requests poll until a frame goes out
+    startTimerHz(settings.rateHz > 0.0f ? juce::jmax(1, juce::roundToInt(settings.rateHz)) : MAX_RATE_HZ);
+
+    logger.log(Logger::Level::Info, "Spectrum " + juce::String(settings.rateHz > 0.0f ? "subscription" : "request")
+               + ": " + resolutionToString(settings.resolution) + ", " + juce::String(settings.bits) + "-bit"
+               + (settings.delta ? ", delta" : "")
+               + (settings.rateHz > 0.0f ? ", " + juce::String(settings.rateHz, 1) + " Hz" : juce::String()));
+}
+
+void SpectrumStreamer::stop()
+{
+    if (isTimerRunning())
+    {
+        stopTimer();
+        logger.log(Logger::Level::Info, "Spectrum stream stopped");
+    }
+}
+
+juce::String SpectrumStreamer::resolutionToString(Resolution resolution)
+{
+    return resolution == Resolution::Full ? "full" : "log";
+}
+
+//==============================================================================
+int SpectrumStreamer::getFrameCost(int numBins) const
+{
+    const int bytes = numBins * (settings.bits == 16 ? 2 : 1);
+    const int numChunks = (bytes + MAX_CHUNK_BYTES - 1) / MAX_CHUNK_BYTES;
+    return bytes + numChunks * CHUNK_OVERHEAD_BYTES;
+}
+
+bool SpectrumStreamer::encodeFrame(const float* levelsDb, int numBins, float lowHz, float highHz, double nowSeconds)
+{
+    numBins = juce::jlimit(0, MAX_FULL_BINS, numBins);
+    if (levelsDb == nullptr || numBins == 0)
+        return false;
+
+    // Byte bucket: refilled at the bandwidth limit, capped at half a second
+    constexpr double capacity = MAX_BYTES_PER_SECOND / 2.0;
+    budgetBytes = lastBudgetTime < 0.0
+        ? capacity
+        : juce::jmin(capacity, budgetBytes + (nowSeconds - lastBudgetTime) * MAX_BYTES_PER_SECOND);
+    lastBudgetTime = nowSeconds;
+
+    const int cost = getFrameCost(numBins);
+    if (cost > budgetBytes)
+        return false;
+
+    budgetBytes -= cost;
+
+    // Quantise; delta frames carry the difference to the last frame sent
+    const bool sixteenBit = settings.bits == 16;
+    const int bytesPerBin = sixteenBit ? 2 : 1;
+    const int maxCode = sixteenBit ? 0xffff : 0xff;
+
+    const bool keyframe = !settings.delta || needsKeyframe || numBins != previousBins
+                       || framesSinceKeyframe >= KEYFRAME_INTERVAL - 1;
+
+    previousCodes.resize(static_cast<size_t>(numBins));
+    payload.resize(static_cast<size_t>(numBins * bytesPerBin));
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        const float normalised = (juce::jlimit(MIN_DB, MAX_DB, levelsDb[bin]) - MIN_DB) / (MAX_DB - MIN_DB);
+        const int quantised = juce::roundToInt(normalised * static_cast<float>(maxCode));
+
+        auto& previous = previousCodes[static_cast<size_t>(bin)];
+        const int code = keyframe ? quantised : ((quantised - previous) & maxCode);
+        previous = static_cast<uint16_t>(quantised);
+
+        auto* destination = payload.data() + bin * bytesPerBin;
+        destination[0] = static_cast<uint8_t>(code & 0xff);
+        if (sixteenBit)
+            destination[1] = static_cast<uint8_t>(code >> 8);
+    }
+
+    framesSinceKeyframe = keyframe ? 0 : framesSinceKeyframe + 1;
+    needsKeyframe = false;
+    previousBins = numBins;
+
+    // Split into MTU-sized chunks of whole bins
+    const int format = (settings.resolution == Resolution::Full ? FullResolution : 0)
+                     | (sixteenBit ? SixteenBit : 0)
+                     | (keyframe ? 0 : Delta);
+    const int binsPerChunk = MAX_CHUNK_BYTES / bytesPerBin;
+    const int numChunks = (numBins + binsPerChunk - 1) / binsPerChunk;
+
+    chunks.clear();
+    for (int index = 0; index < numChunks; ++index)
+    {
+        Chunk chunk;
+        chunk.frameID = frameID;
+        chunk.chunkIndex = index;
+        chunk.numChunks = numChunks;
+        chunk.format = format;
+        chunk.totalBins = numBins;
+        chunk.firstBin = index * binsPerChunk;
+        chunk.lowHz = lowHz;
+        chunk.highHz = highHz;
+        chunk.data = payload.data() + chunk.firstBin * bytesPerBin;
+        chunk.numBytes = juce::jmin(binsPerChunk, numBins - chunk.firstBin) * bytesPerBin;
+        chunks.push_back(chunk);
+    }
+
+    ++frameID;
+    return true;
+}
+
+//==============================================================================
+void SpectrumStreamer::timerCallback()
+{
+    const auto& snapshot = analyzer.getFrameSnapshot();
+    const auto sequence = snapshot.getSequence();
+
+    if (sequence == 0 || sequence == lastFrameSequence)
+        return;
+
+    const double now = juce::Time::getMillisecondCounterHiRes() / 1000.0;
+    bool encoded = false;
+
+    if (settings.resolution == Resolution::Log)
+    {
+        // Frames without a display spectrum (governor) only carry bands
+        if (!analyzer.isSpectrumEnabled())
+            return;
+
+        AnalysisFrame frame;
+        lastFrameSequence = snapshot.read(frame);
+        encoded = encodeFrame(frame.spectrumDb.data(), AnalysisFrame::NUM_SPECTRUM_BINS,
+                              AnalysisFrame::MIN_FREQUENCY, AnalysisFrame::MAX_FREQUENCY, now);
+    }
+    else
+    {
+        float binWidth = 0.0f;
+        const int numBins = analyzer.getFullSpectrumDb(levels.data(), MAX_FULL_BINS, binWidth);
+        lastFrameSequence = sequence;
+        encoded = encodeFrame(levels.data(), numBins, 0.0f, static_cast<float>(numBins - 1) * binWidth, now);
+    }
+
+    if (!encoded)
+        return;
+
+    sendChunks();
+
+    if (settings.rateHz <= 0.0f)
+        stopTimer();
+}
+
+void SpectrumStreamer::sendChunks()
+{
+    for (const auto& chunk : chunks)
+    {
+        if (!oscManager.sendSpectrumChunk(currentTrackID, chunk.frameID, chunk.chunkIndex, chunk.numChunks,
+                                          chunk.format, chunk.totalBins, chunk.firstBin, chunk.lowHz, chunk.highHz,
+                                          chunk.data, chunk.numBytes))
+        {
+            logger.log(Logger::Level::Warning, "Failed to send spectrum chunk");
+            return;
+        }
+    }
+}
+
+} // namespace AIplayer
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    SpectrumStreamer.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    On-demand spectrum stream to ChattyChannels: quantised, optionally
+    delta-coded and split into MTU-sized OSC blobs.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include "../Core/Logger.h"
+#include <cstdint>
+#include <vector>
+
+namespace AIplayer {
+
+// Forward declarations
+class FrequencyAnalyzer;
+class OSCManager;
+
+/**
+ * @class SpectrumStreamer
+ * @brief Streams the analysed spectrum when the controller asks for it
+ *
+ * The regular telemetry carries four band energies. For EQ decisions at
+ * specific frequencies the controller can request the spectrum itself
+ * (/aiplayer/spectrum_request), either once or as a subscription:
+ * - resolution: the 96 log-spaced display bins (20 Hz-20 kHz) or every FFT bin
+ * - 8-bit or 16-bit dB codes over MIN_DB..MAX_DB
+ * - optional delta coding against the previous frame sent, with an
+ *   absolute keyframe every KEYFRAME_INTERVAL frames so a lost packet
+ *   only corrupts the stream until the next one
+ *
+ * A frame is split into chunks of at most MAX_CHUNK_BYTES, each sent as one
+ * /aiplayer/spectrum message carrying its frame ID, chunk index, chunk count
+ * and first bin, so the receiver can reassemble frames and drop incomplete
+ * ones. Bandwidth is bounded per instance by a byte bucket refilled at
+ * MAX_BYTES_PER_SECOND; a frame that does not fit is skipped whole (delta
+ * coding is always against the last frame actually sent).
+ *
+ * Runs on the message thread, where the analyzer computes its frames.
+ * While the analysis governor has the display spectrum switched off, log
+ * frames are not sent; full-resolution frames are always available.
+ */
+class SpectrumStreamer : private juce::Timer
+{
+public:
+    /// Spectrum source
+    enum class Resolution
+    {
+        Log,        ///< AnalysisFrame display bins
+        Full        ///< One value per FFT bin
+    };
+
+    /// Format flags sent with every chunk
+    enum Format
+    {
+        FullResolution = 1 << 0,    ///< Linear FFT bins (otherwise log-spaced)
+        SixteenBit = 1 << 1,        ///< Two bytes per bin, little-endian (otherwise one)
+        Delta = 1 << 2              ///< Codes are differences to the previous frame, modulo the code range
+    };
+
+    /// What the controller asked for
+    struct Settings
+    {
+        Resolution resolution{Resolution::Log};
+        int bits{8};                ///< 8 or 16
+        bool delta{false};
+        float rateHz{0.0f};         ///< 0 = one frame, otherwise a subscription
+    };
+
+    /// One encoded chunk, ready to send
+    struct Chunk
+    {
+        int frameID{0};
+        int chunkIndex{0};
+        int numChunks{0};
+        int format{0};              ///< Format flags
+        int totalBins{0};
+        int firstBin{0};
+        float lowHz{0.0f};          ///< Log: lower band edge; full: first bin (0 Hz)
+        float highHz{0.0f};         ///< Log: upper band edge; full: last bin
+        const uint8_t* data{nullptr};
+        int numBytes{0};
+    };
+
+    /// dB range covered by the codes
+    static constexpr float MIN_DB = -120.0f;
+    static constexpr float MAX_DB = 0.0f;
+
+    /// Payload per chunk; with the OSC header a chunk stays well inside one Ethernet MTU
+    static constexpr int MAX_CHUNK_BYTES = 1024;
+
+    /// Address, type tags and arguments of one chunk, counted against the budget
+    static constexpr int CHUNK_OVERHEAD_BYTES = 96;
+
+    /// Per-instance bandwidth limit; a burst may use half a second's worth
+    static constexpr int MAX_BYTES_PER_SECOND = 64 * 1024;
+
+    /// Largest full-resolution frame (FFT size 16384)
+    static constexpr int MAX_FULL_BINS = 8192;
+
+    /// Highest subscription rate
+    static constexpr int MAX_RATE_HZ = 30;
+
+    /// Delta-coded streams send an absolute frame this often
+    static constexpr int KEYFRAME_INTERVAL = 16;
+
+    /**
+     * @brief Constructor
+     *
+     * @param analyzer Analyzer whose frames are streamed
+     * @param oscManager Sender for the chunks
+     * @param logger Logger for requests
+     */
+    SpectrumStreamer(FrequencyAnalyzer& analyzer, OSCManager& oscManager, Logger& logger);
+
+    ~SpectrumStreamer() override;
+
+    /// Sets the track ID sent with every chunk
+    void setTrackID(const juce::String& trackID) { currentTrackID = trackID; }
+
+    /**
+     * @brief Starts a one-shot request or a subscription
+     *
+     * Replaces any running subscription; the first frame is absolute.
+     *
+     * @param settings Resolution, bits, delta coding and rate
+     */
+    void request(const Settings& settings);
+
+    /// Cancels the running request or subscription
+    void stop();
+
+    /// Whether a request or subscription is running
+    bool isStreaming() const { return isTimerRunning(); }
+
+    /// Settings of the current (or last) request
+    const Settings& getSettings() const { return settings; }
+
+    /**
+     * @brief Encodes one frame into chunks if the budget allows
+     *
+     * Called by the timer; public so tests can check the encoding without
+     * a network.
+     *
+     * @param levelsDb Levels per bin in dB
+     * @param numBins Number of bins
+     * @param lowHz Lower band edge (log) or first bin frequency (full)
+     * @param highHz Upper band edge (log) or last bin frequency (full)
+     * @param nowSeconds Monotonic time, for the bandwidth budget
+     * @return true if the frame was encoded (see getChunks()), false if skipped for bandwidth
+     */
+    bool encodeFrame(const float* levelsDb, int numBins, float lowHz, float highHz, double nowSeconds);
+
+    /// Chunks of the last encoded frame (valid until the next encodeFrame())
+    const std::vector<Chunk>& getChunks() const { return chunks; }
+
+    /// Bytes a frame of numBins costs against the budget at the current settings
+    int getFrameCost(int numBins) const;
+
+    /// Converts a resolution to its OSC name ("log", "full")
+    static juce::String resolutionToString(Resolution resolution);
+
+private:
+    void timerCallback() override;
+
+    /// Sends the chunks of the last encoded frame
+    void sendChunks();
+
+    FrequencyAnalyzer& analyzer;
+    OSCManager& oscManager;
+    Logger& logger;
+
+    juce::String currentTrackID;
+    Settings settings;
+
+    // Encoder state
+    std::vector<float> levels;              ///< Full-resolution source levels
+    std::vector<uint16_t> previousCodes;    ///< Codes of the last frame sent
+    std::vector<uint8_t> payload;
+    std::vector<Chunk> chunks;
+    int frameID{0};
+    int framesSinceKeyframe{0};
+    int previousBins{0};
+    bool needsKeyframe{true};
+
+    // Bandwidth bucket
+    double budgetBytes{0.0};
+    double lastBudgetTime{-1.0};
+
+    uint64_t lastFrameSequence{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumStreamer)
+};
+
+} // namespace AIplayer
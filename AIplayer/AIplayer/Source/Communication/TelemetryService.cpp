@@ -11,8 +11,14 @@
 */
 
 #include "TelemetryService.h"
+#include "../Core/InstanceRegistry.h"
+#include "../Audio/AnalysisGovernor.h"
 #include "../Audio/AudioMetrics.h"
 #include "../Audio/FrequencyAnalyzer.h"
+#include "../Audio/AutoLevelController.h"
+#include "../Audio/BeatTracker.h"
+#include "../Audio/DrumHitAnalyzer.h"
+#include "../Audio/SidechainProcessor.h"
 #include "OSCManager.h"
 
 namespace AIplayer {
@@ -91,12 +97,108 @@ void TelemetryService::sendTelemetryNow()
     {
         logger.log(Logger::Level::Error, "Failed to send telemetry");
     }
+    
+    if (autoLevelController != nullptr)
+    {
+        const auto status = autoLevelController->getStatus();
+        if (status.mode != AutoLevelController::Mode::Off || status.gainDb != 0.0f)
+        {
+            oscManager.sendAutoLevelStatus(data.trackID, AutoLevelController::modeToString(status.mode),
+                                           status.targetDb, status.measuredDb, status.gainDb, status.converged);
+        }
+    }
+    
+    // Stereo is covered by the main telemetry; wider buses get per-channel meters
+    const int numChannels = audioMetrics.getNumChannels();
+    if (numChannels > 2)
+    {
+        std::array<float, ChannelLayout::MAX_CHANNELS> rms, peak;
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            rms[static_cast<size_t>(channel)] = audioMetrics.getChannelRMS(channel);
+            peak[static_cast<size_t>(channel)] = audioMetrics.getChannelPeak(channel);
+        }
+        
+        oscManager.sendChannelMeters(data.trackID, audioMetrics.getMomentaryLufs(),
+                                     rms.data(), peak.data(), numChannels);
+    }
+    
+    if (sidechainProcessor != nullptr)
+    {
+        const auto report = sidechainProcessor->getReport();
+        if (report.keyPresent || report.duckGainDb != 0.0f)
+            oscManager.sendSidechainAnalysis(data.trackID, report.keyDb, report.maskingDb, report.duckGainDb);
+    }
+    
+    if (frequencyAnalyzer.isPitchTracking())
+    {
+        const auto& pitch = frequencyAnalyzer.getPitchTracker().getResult();
+        oscManager.sendPitch(data.trackID, pitch.voiced, pitch.frequencyHz, pitch.confidence, pitch.midiNote,
+                             pitch.voiced ? PitchTracker::getNoteName(pitch.midiNote) : juce::String(),
+                             pitch.harmonicDb.data(), PitchTracker::NUM_HARMONICS);
+    }
+    
+    if (beatTracker != nullptr)
+    {
+        const auto tempo = beatTracker->getStatus();
+        if (tempo.source != BeatTracker::Source::None)
+            oscManager.sendTempo(data.trackID, BeatTracker::sourceToString(tempo.source), tempo.bpm, tempo.phase, tempo.confidence);
+    }
+    
+    if (drumHitAnalyzer != nullptr && drumHitAnalyzer->isEnabled()
+        && drumHitAnalyzer->getHitCount() != reportedDrumHits)
+    {
+        DrumHitAnalyzer::Report drums;
+        drumHitAnalyzer->getReport(drums);
+        
+        std::array<float, DrumHitAnalyzer::NUM_MEASURES> means, deviations;
+        for (size_t measure = 0; measure < means.size(); ++measure)
+        {
+            means[measure] = drums.statistics[measure].mean;
+            deviations[measure] = drums.statistics[measure].standardDeviation;
+        }
+        
+        oscManager.sendDrumHits(data.trackID, drums.hits, means.data(), deviations.data(), DrumHitAnalyzer::NUM_MEASURES);
+        reportedDrumHits = drums.hits;
+    }
+    
+    DynamicsAnalyzer::Report dynamics;
+    if (audioMetrics.getDynamics().getReport(dynamics))
+    {
+        for (int window = 0; window < DynamicsAnalyzer::NUM_WINDOWS; ++window)
+        {
+            const auto& statistics = dynamics.windows[static_cast<size_t>(window)];
+            if (statistics.activeHops == 0)
+                continue;
+            
+            oscManager.sendDynamics(data.trackID, DynamicsAnalyzer::windowToString(static_cast<DynamicsAnalyzer::Window>(window)),
+                                    static_cast<float>(statistics.activeHops * HopScheduler::DEFAULT_HOP_SECONDS),
+                                    statistics.peakDb, statistics.rmsDb, statistics.crestDb, statistics.lowDb, statistics.highDb,
+                                    statistics.loudnessLufs, statistics.plrDb, dynamics.psrDb);
+        }
+    }
+    
+    if (analysisGovernor != nullptr)
+    {
+        const int change = analysisGovernor->getChangeCount();
+        if (change != reportedQualityChange || ++updatesSinceQualityReport >= LOG_FREQUENCY)
+        {
+            const auto status = analysisGovernor->getStatus();
+            oscManager.sendAnalysisQuality(data.trackID, AnalysisGovernor::getSettings(status.tier).name,
+                                           AnalysisGovernor::priorityToString(status.priority),
+                                           status.fftSize, status.overlap, status.updateRateHz, status.features,
+                                           status.callbackLoad, status.analysisLoad);
+            reportedQualityChange = change;
+            updatesSinceQualityReport = 0;
+        }
+    }
 }
 
 void TelemetryService::timerCallback()
 {
     try
     {
+        updateRegistry();
         sendTelemetryNow();
         
         // Log periodically to avoid spam
@@ -121,6 +223,18 @@ void TelemetryService::timerCallback()
     }
 }
 
+void TelemetryService::updateRegistry()
+{
+    if (registrySlot < 0)
+        return;
+    
+    constexpr float floorDb = InstanceRegistry::FLOOR_DB;
+    InstanceRegistry::getInstance().setMetrics(registrySlot,
+                                               juce::Decibels::gainToDecibels(audioMetrics.getCurrentRMS(), floorDb),
+                                               juce::Decibels::gainToDecibels(audioMetrics.getPeakLevel(), floorDb),
+                                               juce::jmax(floorDb, audioMetrics.getMomentaryLufs()));
+}
+
 TelemetryData TelemetryService::collectTelemetryData()
 {
     TelemetryData data;
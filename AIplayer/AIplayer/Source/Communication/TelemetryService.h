@@ -21,16 +21,27 @@
 namespace AIplayer {
 
 // Forward declarations
+class AnalysisGovernor;
 class AudioMetrics;
+class AutoLevelController;
+class BeatTracker;
+class DrumHitAnalyzer;
 class FrequencyAnalyzer;
 class OSCManager;
+class SidechainProcessor;
 
 /**
  * @class TelemetryService
  * @brief Collects and sends telemetry data at regular intervals
  * 
  * This service runs on a timer and periodically collects audio metrics
- * and sends them to ChattyChannels for VU meter display.
+ * and sends them to ChattyChannels for VU meter display. Buses wider than
+ * stereo also get per-channel meters and channel-weighted loudness,
+ * instances tracking pitch report f0, confidence and harmonic levels, and
+ * the tempo and beat phase go out once known, as do the dynamics
+ * statistics of each window holding audio. Drum hit statistics are sent
+ * after new hits. Every update also refreshes the levels of this
+ * instance's InstanceRegistry entry.
  */
 class TelemetryService : public juce::Timer
 {
@@ -67,6 +78,66 @@ public:
      */
     void setInstanceID(const juce::String& instanceID);
     
+    /**
+     * @brief Sets the auto-level controller whose status is reported
+     * 
+     * While it is active (or releasing its gain) a status message is sent
+     * alongside every telemetry update.
+     * 
+     * @param controller The controller, or nullptr to stop reporting
+     */
+    void setAutoLevelController(const AutoLevelController* controller) { autoLevelController = controller; }
+    
+    /**
+     * @brief Sets the sidechain processor whose masking analysis is reported
+     * 
+     * While a key is connected the analysis is sent alongside every
+     * telemetry update.
+     * 
+     * @param processor The processor, or nullptr to stop reporting
+     */
+    void setSidechainProcessor(const SidechainProcessor* processor) { sidechainProcessor = processor; }
+    
+    /**
+     * @brief Sets the analysis governor whose quality tier is reported
+     * 
+     * The status is sent on every tier or priority change and otherwise
+     * about once per second, so the controller sees the load trend.
+     * 
+     * @param governor The governor, or nullptr to stop reporting
+     */
+    void setAnalysisGovernor(const AnalysisGovernor* governor) { analysisGovernor = governor; }
+    
+    /**
+     * @brief Sets the beat tracker whose tempo is reported
+     * 
+     * Once it has a tempo (estimated, or from a playing host transport)
+     * it is sent alongside every telemetry update.
+     * 
+     * @param tracker The tracker, or nullptr to stop reporting
+     */
+    void setBeatTracker(const BeatTracker* tracker) { beatTracker = tracker; }
+    
+    /**
+     * @brief Sets the drum hit analyzer whose statistics are reported
+     * 
+     * While it is enabled, the statistics are sent with the first
+     * telemetry update after each new hit.
+     * 
+     * @param analyzer The analyzer, or nullptr to stop reporting
+     */
+    void setDrumHitAnalyzer(const DrumHitAnalyzer* analyzer) { drumHitAnalyzer = analyzer; }
+    
+    /**
+     * @brief Sets the InstanceRegistry slot whose levels are refreshed
+     * 
+     * The levels are written at every telemetry update, whether or not
+     * they can be sent.
+     * 
+     * @param slot Slot from InstanceRegistry::add(), or -1 for none
+     */
+    void setRegistrySlot(int slot) { registrySlot = slot; }
+    
     /**
      * @brief Starts sending telemetry at the specified rate
      * 
@@ -120,6 +191,29 @@ private:
     /// Reference to logger
     Logger& logger;
     
+    /// Optional auto-level controller for status reports
+    const AutoLevelController* autoLevelController{nullptr};
+    
+    /// Optional sidechain processor for masking reports
+    const SidechainProcessor* sidechainProcessor{nullptr};
+    
+    /// Optional analysis governor for quality reports
+    const AnalysisGovernor* analysisGovernor{nullptr};
+    
+    /// Optional beat tracker for tempo reports
+    const BeatTracker* beatTracker{nullptr};
+    
+    /// Optional drum hit analyzer, and the hit count last reported
+    const DrumHitAnalyzer* drumHitAnalyzer{nullptr};
+    int reportedDrumHits{0};
+    
+    /// InstanceRegistry slot of this instance (-1 for none)
+    int registrySlot{-1};
+    
+    /// Governor change count last reported, and updates since the last report
+    int reportedQualityChange{-1};
+    int updatesSinceQualityReport{0};
+    
     /// Current track ID
     juce::String currentTrackID;
     
@@ -139,6 +233,11 @@ private:
      */
     void timerCallback() override;
     
+    /**
+     * @brief Writes the current levels to the registry slot
+     */
+    void updateRegistry();
+    
     /**
      * @brief Collects current telemetry data
      * 
@@ -60,6 +60,17 @@ namespace Constants {
         constexpr const char* TONE_ERROR = "/aiplayer/tone_error";
         constexpr const char* RMS_RESPONSE = "/aiplayer/rms_response";
         constexpr const char* CHAT_REQUEST = "/aiplayer/chat/request";
+        constexpr const char* AUTO_LEVEL_STATUS = "/aiplayer/auto_level_status";
+        constexpr const char* SIDECHAIN_ANALYSIS = "/aiplayer/sidechain_analysis";
+        constexpr const char* CHANNEL_METERS = "/aiplayer/channel_meters";
+        constexpr const char* ANALYSIS_QUALITY = "/aiplayer/analysis_quality";
+        constexpr const char* SPECTRUM = "/aiplayer/spectrum";
+        constexpr const char* LTAS = "/aiplayer/ltas";
+        constexpr const char* PITCH = "/aiplayer/pitch";
+        constexpr const char* TEMPO = "/aiplayer/tempo";
+        constexpr const char* DYNAMICS = "/aiplayer/dynamics";
+        constexpr const char* DRUM_HITS = "/aiplayer/drum_hits";
+        constexpr const char* INSTANCES = "/aiplayer/instances";
         
         // Incoming messages (from ChattyChannels)
         constexpr const char* PORT_ASSIGNMENT = "/aiplayer/port_assignment";
@@ -70,6 +81,16 @@ namespace Constants {
         constexpr const char* TONE_STATUS = "/aiplayer/tone_status";
         constexpr const char* SET_PARAMETER = "/aiplayer/set_parameter";
         constexpr const char* CHAT_RESPONSE = "/aiplayer/chat/response";
+        constexpr const char* AUTO_LEVEL = "/aiplayer/auto_level";
+        constexpr const char* ANALYSIS_PRIORITY = "/aiplayer/analysis_priority";
+        constexpr const char* FOCUS = "/aiplayer/focus";
+        constexpr const char* SPECTRUM_REQUEST = "/aiplayer/spectrum_request";
+        constexpr const char* LTAS_CONFIG = "/aiplayer/ltas_config";
+        constexpr const char* LTAS_REFERENCE = "/aiplayer/ltas_reference";
+        constexpr const char* LTAS_QUERY = "/aiplayer/ltas_query";
+        constexpr const char* PITCH_CONFIG = "/aiplayer/pitch_config";
+        constexpr const char* DRUM_CONFIG = "/aiplayer/drum_config";
+        constexpr const char* QUERY_INSTANCES = "/aiplayer/query_instances";
     }
     
     // Parameter IDs
@@ -80,6 +101,66 @@ namespace Constants {
         constexpr float GAIN_MAX_DB = 0.0f;
         constexpr float GAIN_DEFAULT_DB = 0.0f;
         constexpr float GAIN_STEP = 0.1f;
+
+        // Channel strip (all version 1)
+        constexpr int CHANNEL_STRIP_VERSION = 1;
+
+        constexpr const char* HPF_ENABLED_ID = "HPF_ENABLED";
+        constexpr const char* HPF_FREQ_ID = "HPF_FREQ";
+        constexpr float HPF_FREQ_MIN_HZ = 20.0f;
+        constexpr float HPF_FREQ_MAX_HZ = 2000.0f;
+        constexpr float HPF_FREQ_DEFAULT_HZ = 80.0f;
+
+        constexpr const char* LPF_ENABLED_ID = "LPF_ENABLED";
+        constexpr const char* LPF_FREQ_ID = "LPF_FREQ";
+        constexpr float LPF_FREQ_MIN_HZ = 1000.0f;
+        constexpr float LPF_FREQ_MAX_HZ = 20000.0f;
+        constexpr float LPF_FREQ_DEFAULT_HZ = 18000.0f;
+
+        constexpr const char* EQ_FREQ_ID = "EQ_FREQ";
+        constexpr const char* EQ_GAIN_ID = "EQ_GAIN";
+        constexpr const char* EQ_Q_ID = "EQ_Q";
+        constexpr float EQ_FREQ_DEFAULT_HZ = 250.0f;
+        constexpr float EQ_GAIN_RANGE_DB = 18.0f;
+        constexpr float EQ_Q_MIN = 0.1f;
+        constexpr float EQ_Q_MAX = 10.0f;
+        constexpr float EQ_Q_DEFAULT = 2.0f;
+
+        constexpr const char* COMP_THRESHOLD_ID = "COMP_THRESHOLD";
+        constexpr const char* COMP_RATIO_ID = "COMP_RATIO";
+        constexpr const char* COMP_ATTACK_ID = "COMP_ATTACK";
+        constexpr const char* COMP_RELEASE_ID = "COMP_RELEASE";
+        constexpr const char* COMP_MAKEUP_ID = "COMP_MAKEUP";
+        constexpr const char* COMP_LOOKAHEAD_ID = "COMP_LOOKAHEAD";
+
+        // Sidechain ducking (all version 1)
+        constexpr int SIDECHAIN_VERSION = 1;
+
+        constexpr const char* DUCK_ENABLED_ID = "DUCK_ENABLED";
+        constexpr const char* DUCK_BAND_ID = "DUCK_BAND";
+        constexpr const char* DUCK_THRESHOLD_ID = "DUCK_THRESHOLD";
+        constexpr const char* DUCK_DEPTH_ID = "DUCK_DEPTH";
+        constexpr const char* DUCK_ATTACK_ID = "DUCK_ATTACK";
+        constexpr const char* DUCK_RELEASE_ID = "DUCK_RELEASE";
+        constexpr float DUCK_THRESHOLD_DEFAULT_DB = -30.0f;
+        constexpr float DUCK_DEPTH_DEFAULT_DB = 6.0f;
+
+        // Analysis (version 1)
+        constexpr int ANALYSIS_VERSION = 1;
+        constexpr const char* ANALYSIS_DOWNMIX_ID = "ANALYSIS_DOWNMIX";
+
+        // Oversampling of the nonlinear stages (version 1)
+        constexpr int OVERSAMPLING_VERSION = 1;
+        constexpr const char* OVERSAMPLING_ID = "OVERSAMPLING";
+
+        // True-peak limiter (all version 1)
+        constexpr int LIMITER_VERSION = 1;
+
+        constexpr const char* LIMITER_ENABLED_ID = "LIMITER_ENABLED";
+        constexpr const char* LIMITER_CEILING_ID = "LIMITER_CEILING";
+        constexpr const char* LIMITER_RELEASE_ID = "LIMITER_RELEASE";
+        constexpr float LIMITER_CEILING_DEFAULT_DB = -1.0f;
+        constexpr float LIMITER_RELEASE_DEFAULT_MS = 50.0f;
     }
     
     // File paths
@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    InstanceRegistry.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the process-wide instance registry.
+
+  ==============================================================================
+*/
+
+#include "InstanceRegistry.h"
+
+namespace AIplayer {
+
+InstanceRegistry& InstanceRegistry::getInstance()
+{
+    static InstanceRegistry registry;
+    return registry;
+}
+
+int InstanceRegistry::add(const juce::String& instanceID)
+{
+    for (int index = 0; index < MAX_INSTANCES; ++index)
+    {
+        auto& slot = slots[static_cast<size_t>(index)];
+        auto expected = SlotState::Free;
+        
+        if (!slot.state.compare_exchange_strong(expected, SlotState::Claimed))
+            continue;
+        
+        // Readers skip the slot until the previous owner's entry is replaced
+        Entry entry;
+        copyText(entry.instanceID, ID_CAPACITY, instanceID);
+        slot.entry.publish(entry);
+        slot.state.store(SlotState::Live);
+        return index;
+    }
+    
+    return -1;
+}
+
+void InstanceRegistry::remove(int slot)
+{
+    if (slot >= 0 && slot < MAX_INSTANCES)
+        slots[static_cast<size_t>(slot)].state.store(SlotState::Free);
+}
+
+template <typename Modify>
+void InstanceRegistry::modify(int slot, Modify&& change)
+{
+    if (slot < 0 || slot >= MAX_INSTANCES)
+        return;
+    
+    auto& target = slots[static_cast<size_t>(slot)];
+    if (target.state.load() != SlotState::Live)
+        return;
+    
+    Entry entry;
+    target.entry.read(entry);
+    change(entry);
+    target.entry.publish(entry);
+}
+
+void InstanceRegistry::setIdentity(int slot, const juce::String& instanceID, const juce::String& trackID)
+{
+    modify(slot, [&](Entry& entry)
+    {
+        copyText(entry.instanceID, ID_CAPACITY, instanceID);
+        copyText(entry.trackID, ID_CAPACITY, trackID);
+    });
+}
+
+void InstanceRegistry::setConnection(int slot, int port, const juce::String& state)
+{
+    modify(slot, [&](Entry& entry)
+    {
+        entry.port = port;
+        copyText(entry.state, STATE_CAPACITY, state);
+    });
+}
+
+void InstanceRegistry::setMetrics(int slot, float rmsDb, float peakDb, float loudnessLufs)
+{
+    modify(slot, [&](Entry& entry)
+    {
+        entry.rmsDb = rmsDb;
+        entry.peakDb = peakDb;
+        entry.loudnessLufs = loudnessLufs;
+        entry.metricsTimeMs = juce::jmax(1u, juce::Time::getMillisecondCounter());
+    });
+}
+
+int InstanceRegistry::getEntries(Entry* destination, int maxEntries) const
+{
+    if (destination == nullptr)
+        return 0;
+    
+    int count = 0;
+    
+    for (const auto& slot : slots)
+    {
+        if (count >= maxEntries)
+            break;
+        
+        if (slot.state.load() == SlotState::Live && slot.entry.read(destination[count]) != 0)
+            ++count;
+    }
+    
+    return count;
+}
+
+int InstanceRegistry::getNumInstances() const
+{
+    int count = 0;
+    
+    for (const auto& slot : slots)
+    {
+        if (slot.state.load() == SlotState::Live)
+            ++count;
+    }
+    
+    return count;
+}
+
+void InstanceRegistry::copyText(char* destination, int capacity, const juce::String& text)
+{
+    // Truncates at a character boundary and always terminates
+    text.copyToUTF8(destination, static_cast<size_t>(capacity));
+}
+
+} // namespace AIplayer
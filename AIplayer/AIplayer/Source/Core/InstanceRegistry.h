@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    InstanceRegistry.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Process-wide table of the live AIplayer instances, so one instance can
+    report on all of them.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include "Constants.h"
+#include "SnapshotBuffer.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace AIplayer {
+
+/**
+ * @class InstanceRegistry
+ * @brief Identity, connection state and latest levels of every instance in the host
+ *
+ * All instances loaded into one host process share the registry returned
+ * by getInstance(). Each instance claims a slot when it is created and
+ * frees it when it is destroyed. Only the owning instance writes its slot;
+ * identity, connection and metrics are updated separately as they change.
+ * Any instance can then copy every live entry with getEntries(), for
+ * example to answer a controller's query about the whole session in one
+ * reply instead of one per instance.
+ *
+ * Slots are a fixed array, one per ephemeral port the instances can bind.
+ * Each slot is aligned to its own cache lines, so instances updating
+ * their own slots never contend. Entries are published through a
+ * SnapshotBuffer, so readers never block writers. Nothing allocates after
+ * static initialisation.
+ */
+class InstanceRegistry
+{
+public:
+    /// One slot per port the instances can bind
+    static constexpr int MAX_INSTANCES = (Constants::OSC_EPHEMERAL_PORT_END - Constants::OSC_EPHEMERAL_PORT_START)
+                                         / Constants::OSC_EPHEMERAL_PORT_STEP;
+
+    /// Bytes kept of IDs and state names, including the terminator (UUIDs need 37)
+    static constexpr int ID_CAPACITY = 64;
+    static constexpr int STATE_CAPACITY = 16;
+
+    /// Level reported before the first metrics update
+    static constexpr float FLOOR_DB = -100.0f;
+
+    /// Everything known about one instance
+    struct Entry
+    {
+        char instanceID[ID_CAPACITY]{};
+        char trackID[ID_CAPACITY]{};             ///< Empty until the track is assigned
+        char state[STATE_CAPACITY]{};            ///< Port state ("Requesting", "Bound", ...)
+        int port{-1};                            ///< Bound receive port (-1 if none)
+        float rmsDb{FLOOR_DB};
+        float peakDb{FLOOR_DB};
+        float loudnessLufs{FLOOR_DB};            ///< Momentary loudness
+        uint32_t metricsTimeMs{0};               ///< Millisecond counter at the last metrics update (0 = never)
+    };
+
+    /// The registry shared by every instance in this process
+    static InstanceRegistry& getInstance();
+
+    /**
+     * @brief Claims a free slot
+     * @param instanceID ID of the new instance
+     * @return Slot index, or -1 if all MAX_INSTANCES slots are taken
+     */
+    int add(const juce::String& instanceID);
+
+    /**
+     * @brief Frees a slot claimed with add()
+     * @param slot Slot index (ignored if negative)
+     */
+    void remove(int slot);
+
+    /**
+     * @brief Updates the instance and track IDs of a slot (owner only)
+     * @param slot Slot index (ignored if negative)
+     * @param instanceID Instance ID
+     * @param trackID Assigned track ID, or empty
+     */
+    void setIdentity(int slot, const juce::String& instanceID, const juce::String& trackID);
+
+    /**
+     * @brief Updates the connection of a slot (owner only)
+     * @param slot Slot index (ignored if negative)
+     * @param port Bound receive port, or -1
+     * @param state Port state name
+     */
+    void setConnection(int slot, int port, const juce::String& state);
+
+    /**
+     * @brief Updates the levels of a slot and stamps the time (owner only)
+     * @param slot Slot index (ignored if negative)
+     * @param rmsDb RMS level (dBFS)
+     * @param peakDb Peak level (dBFS)
+     * @param loudnessLufs Momentary loudness (LUFS)
+     */
+    void setMetrics(int slot, float rmsDb, float peakDb, float loudnessLufs);
+
+    /**
+     * @brief Copies the entries of all live instances, in slot order (any thread)
+     * @param destination Receives the entries
+     * @param maxEntries Capacity of destination
+     * @return Number of entries copied
+     */
+    int getEntries(Entry* destination, int maxEntries) const;
+
+    /// Number of live instances (any thread)
+    int getNumInstances() const;
+
+private:
+    InstanceRegistry() = default;
+
+    enum class SlotState : int
+    {
+        Free,
+        Claimed,        // Being initialised by add()
+        Live
+    };
+
+    struct alignas(64) Slot
+    {
+        std::atomic<SlotState> state{SlotState::Free};
+        SnapshotBuffer<Entry> entry;
+    };
+
+    // Copies, modifies and republishes the entry of a live slot
+    template <typename Modify>
+    void modify(int slot, Modify&& change);
+
+    static void copyText(char* destination, int capacity, const juce::String& text);
+
+    std::array<Slot, MAX_INSTANCES> slots;
+
+    JUCE_DECLARE_NON_COPYABLE(InstanceRegistry)
+};
+
+} // namespace AIplayer
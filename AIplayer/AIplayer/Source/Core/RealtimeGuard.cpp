@@ -0,0 +1,366 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the audio-thread allocation and lock hooks.
+
+  ==============================================================================
+*/
+
+#include "RealtimeGuard.h"
+
+#ifdef TEST_BUILD
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <pthread.h>
+
+#if JUCE_MAC || JUCE_LINUX
+ #include <dlfcn.h>
+#endif
+
+#if JUCE_MAC
+ #include <mach/mach.h>
+ #include <malloc/malloc.h>
+#endif
+
+#if JUCE_LINUX
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+}
+#endif
+
+namespace AIplayer {
+namespace RealtimeGuard {
+
+namespace {
+    /**
+     * Per-thread state lives in pthread keys rather than thread_local: the
+     * first touch of a thread_local may itself allocate (macOS TLV), which
+     * would re-enter the hooks. The keys are created during static
+     * initialisation; until then `ready` is zero-initialised and the hooks
+     * do nothing.
+     */
+    struct ThreadKeys
+    {
+        ThreadKeys()
+        {
+            pthread_key_create(&audio, nullptr);
+            pthread_key_create(&suspended, nullptr);
+            ready.store(true);
+        }
+
+        pthread_key_t audio{};
+        pthread_key_t suspended{};
+        std::atomic<bool> ready{false};
+    };
+
+    ThreadKeys keys;
+
+    juce::SpinLock violationLock;
+    std::vector<Violation> violations;
+
+    std::atomic<bool> hooksInstalled{false};
+
+    intptr_t getCount(pthread_key_t key)
+    {
+        return reinterpret_cast<intptr_t>(pthread_getspecific(key));
+    }
+
+    void addCount(pthread_key_t key, intptr_t delta)
+    {
+        pthread_setspecific(key, reinterpret_cast<void*>(getCount(key) + delta));
+    }
+
+    bool isChecking()
+    {
+        return keys.ready.load(std::memory_order_relaxed)
+            && getCount(keys.audio) > 0
+            && getCount(keys.suspended) == 0;
+    }
+
+    /// Suspends checking on this thread for the lifetime of the object
+    struct Suspension
+    {
+        Suspension()  { if (keys.ready.load(std::memory_order_relaxed)) addCount(keys.suspended, 1); }
+        ~Suspension() { if (keys.ready.load(std::memory_order_relaxed)) addCount(keys.suspended, -1); }
+    };
+
+    void report(const char* kind)
+    {
+        if (! isChecking())
+            return;
+
+        // Recording allocates and locks; don't record that
+        const Suspension suspension;
+
+        Violation violation { kind, juce::SystemStats::getStackBacktrace() };
+
+        const juce::SpinLock::ScopedLockType lock(violationLock);
+        violations.push_back(std::move(violation));
+    }
+
+   #if JUCE_MAC
+    //==============================================================================
+    // macOS: every allocator entry point ends in a malloc zone, so patch the
+    // zones' function tables. The originals are saved before a zone is patched.
+    using ZoneMalloc = void* (*)(malloc_zone_t*, size_t);
+    using ZoneCalloc = void* (*)(malloc_zone_t*, size_t, size_t);
+    using ZoneRealloc = void* (*)(malloc_zone_t*, void*, size_t);
+    using ZoneMemalign = void* (*)(malloc_zone_t*, size_t, size_t);
+
+    struct ZoneFunctions
+    {
+        malloc_zone_t* zone{nullptr};
+        ZoneMalloc malloc{nullptr};
+        ZoneCalloc calloc{nullptr};
+        ZoneMalloc valloc{nullptr};
+        ZoneRealloc realloc{nullptr};
+        ZoneMemalign memalign{nullptr};
+    };
+
+    std::array<ZoneFunctions, 16> originalZones;
+
+    const ZoneFunctions& getOriginal(malloc_zone_t* zone)
+    {
+        for (const auto& original : originalZones)
+            if (original.zone == zone)
+                return original;
+
+        jassertfalse;
+        return originalZones[0];
+    }
+
+    void* hookMalloc(malloc_zone_t* zone, size_t size)
+    {
+        report("malloc");
+        return getOriginal(zone).malloc(zone, size);
+    }
+
+    void* hookCalloc(malloc_zone_t* zone, size_t count, size_t size)
+    {
+        report("calloc");
+        return getOriginal(zone).calloc(zone, count, size);
+    }
+
+    void* hookValloc(malloc_zone_t* zone, size_t size)
+    {
+        report("valloc");
+        return getOriginal(zone).valloc(zone, size);
+    }
+
+    void* hookRealloc(malloc_zone_t* zone, void* pointer, size_t size)
+    {
+        report("realloc");
+        return getOriginal(zone).realloc(zone, pointer, size);
+    }
+
+    void* hookMemalign(malloc_zone_t* zone, size_t alignment, size_t size)
+    {
+        report("memalign");
+        return getOriginal(zone).memalign(zone, alignment, size);
+    }
+
+    void installSystemHooks()
+    {
+        vm_address_t* zones = nullptr;
+        unsigned int numZones = 0;
+
+        if (malloc_get_all_zones(mach_task_self(), nullptr, &zones, &numZones) != KERN_SUCCESS)
+            return;
+
+        numZones = juce::jmin(numZones, static_cast<unsigned int>(originalZones.size()));
+
+        for (unsigned int i = 0; i < numZones; ++i)
+        {
+            auto* zone = reinterpret_cast<malloc_zone_t*>(zones[i]);
+            auto& original = originalZones[i];
+
+            original.malloc = zone->malloc;
+            original.calloc = zone->calloc;
+            original.valloc = zone->valloc;
+            original.realloc = zone->realloc;
+            original.memalign = zone->version >= 5 ? zone->memalign : nullptr;
+            original.zone = zone;
+
+            const auto address = reinterpret_cast<vm_address_t>(zone);
+            vm_protect(mach_task_self(), address, sizeof(malloc_zone_t), 0, VM_PROT_READ | VM_PROT_WRITE);
+
+            zone->malloc = hookMalloc;
+            zone->calloc = hookCalloc;
+            zone->valloc = hookValloc;
+            zone->realloc = hookRealloc;
+
+            if (original.memalign != nullptr)
+                zone->memalign = hookMemalign;
+
+            vm_protect(mach_task_self(), address, sizeof(malloc_zone_t), 0, VM_PROT_READ);
+        }
+    }
+   #else
+    // Linux wraps malloc by symbol (below); elsewhere only operator new is seen
+    void installSystemHooks() {}
+   #endif
+
+    void installHooks()
+    {
+        bool expected = false;
+
+        if (hooksInstalled.compare_exchange_strong(expected, true))
+            installSystemHooks();
+    }
+
+    void* allocate(std::size_t size, const char* kind)
+    {
+        report(kind);
+
+        // The underlying malloc is the same allocation; report it once
+        const Suspension suspension;
+        return std::malloc(size == 0 ? 1 : size);
+    }
+}
+
+//==============================================================================
+ScopedAudioThread::ScopedAudioThread()
+{
+    installHooks();
+    addCount(keys.audio, 1);
+}
+
+ScopedAudioThread::~ScopedAudioThread()
+{
+    addCount(keys.audio, -1);
+}
+
+ScopedAllowance::ScopedAllowance(const char* reason)
+{
+    juce::ignoreUnused(reason);
+    addCount(keys.suspended, 1);
+}
+
+ScopedAllowance::~ScopedAllowance()
+{
+    addCount(keys.suspended, -1);
+}
+
+std::vector<Violation> takeViolations()
+{
+    const Suspension suspension;
+    std::vector<Violation> taken;
+
+    const juce::SpinLock::ScopedLockType lock(violationLock);
+    taken.swap(violations);
+    return taken;
+}
+
+bool hasSystemHooks()
+{
+   #if JUCE_MAC || JUCE_LINUX
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+} // namespace RealtimeGuard
+} // namespace AIplayer
+
+//==============================================================================
+// Replacement global allocation functions. The aligned overloads are left to
+// the library; nothing in the processor over-aligns heap objects.
+void* operator new(std::size_t size)
+{
+    if (auto* pointer = AIplayer::RealtimeGuard::allocate(size, "operator new"))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (auto* pointer = AIplayer::RealtimeGuard::allocate(size, "operator new[]"))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return AIplayer::RealtimeGuard::allocate(size, "operator new");
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return AIplayer::RealtimeGuard::allocate(size, "operator new[]");
+}
+
+void operator delete(void* pointer) noexcept                        { std::free(pointer); }
+void operator delete[](void* pointer) noexcept                      { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept           { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept         { std::free(pointer); }
+
+//==============================================================================
+#if JUCE_LINUX
+// glibc exports its allocator under __libc_* as well, so these wrap rather
+// than replace it; free() is left alone
+extern "C" void* malloc(size_t size)
+{
+    AIplayer::RealtimeGuard::report("malloc");
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size)
+{
+    AIplayer::RealtimeGuard::report("calloc");
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, size_t size)
+{
+    AIplayer::RealtimeGuard::report("realloc");
+    return __libc_realloc(pointer, size);
+}
+
+extern "C" void* memalign(size_t alignment, size_t size)
+{
+    AIplayer::RealtimeGuard::report("memalign");
+    return __libc_memalign(alignment, size);
+}
+#endif
+
+#if JUCE_MAC || JUCE_LINUX
+namespace {
+    using MutexLock = int (*)(pthread_mutex_t*);
+
+    // Resolved lazily without a function-local static: its guard would take
+    // this very lock on the first call
+    std::atomic<MutexLock> originalMutexLock{nullptr};
+}
+
+// Defined in the test binary, so calls from code linked into it (JUCE and the
+// plugin sources) come here first and are forwarded to the system's
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+    auto lock = originalMutexLock.load(std::memory_order_acquire);
+
+    if (lock == nullptr)
+    {
+        lock = reinterpret_cast<MutexLock>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        originalMutexLock.store(lock, std::memory_order_release);
+    }
+
+    AIplayer::RealtimeGuard::report("pthread_mutex_lock");
+    return lock(mutex);
+}
+#endif
+
+#endif // TEST_BUILD
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Test-build detection of allocations and locks on the audio thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @namespace RealtimeGuard
+ * @brief Checks the real-time contract of processBlock() in TEST_BUILD
+ *
+ * While a thread is marked as the audio thread (ScopedAudioThread), every
+ * heap allocation and every mutex acquisition it makes is recorded with a
+ * stack backtrace:
+ * - operator new / new[] are replaced (all platforms)
+ * - malloc, calloc, realloc and memalign are hooked in every malloc zone
+ *   (macOS) or wrapped around glibc (Linux), which covers juce::HeapBlock
+ *   and juce::AudioBuffer
+ * - pthread_mutex_lock is wrapped for code linked into the test binary,
+ *   which covers juce::CriticalSection and anything built on it
+ *
+ * Tests mark the thread, run processBlock(), and fail on takeViolations().
+ * Outside TEST_BUILD nothing is compiled in, and AIPLAYER_REALTIME_EXEMPT
+ * expands to nothing.
+ */
+namespace RealtimeGuard
+{
+#ifdef TEST_BUILD
+    /// One allocation or lock on a marked thread
+    struct Violation
+    {
+        juce::String kind;          ///< "operator new", "malloc", "pthread_mutex_lock", ...
+        juce::String backtrace;
+    };
+
+    /**
+     * @class ScopedAudioThread
+     * @brief Marks the calling thread as the audio thread while in scope
+     *
+     * Installs the hooks on first use. Scopes may nest.
+     */
+    class ScopedAudioThread
+    {
+    public:
+        ScopedAudioThread();
+        ~ScopedAudioThread();
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudioThread)
+    };
+
+    /**
+     * @class ScopedAllowance
+     * @brief Suspends checking on the calling thread, for documented exceptions
+     *
+     * Use through AIPLAYER_REALTIME_EXEMPT so that the reason sits in the code.
+     */
+    class ScopedAllowance
+    {
+    public:
+        explicit ScopedAllowance(const char* reason);
+        ~ScopedAllowance();
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAllowance)
+    };
+
+    /// Returns and clears the violations recorded so far (any thread)
+    std::vector<Violation> takeViolations();
+
+    /// Whether malloc and mutex hooks are active on this platform (operator new always is)
+    bool hasSystemHooks();
+#endif
+}
+
+} // namespace AIplayer
+
+#ifdef TEST_BUILD
+ /** Allows allocations and locks for the rest of the scope, e.g. a host notification */
+ #define AIPLAYER_REALTIME_EXEMPT(reason) \
+    const AIplayer::RealtimeGuard::ScopedAllowance JUCE_JOIN_MACRO(realtimeExemption, __LINE__)(reason)
+#else
+ #define AIPLAYER_REALTIME_EXEMPT(reason)
+#endif
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    SnapshotBuffer.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Lock-free "latest value" exchange for passing analysis results from
+    the producing thread to any number of readers (UI, telemetry).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace AIplayer {
+
+/**
+ * @class SnapshotBuffer
+ * @brief Single-writer, multi-reader snapshot of the most recent value
+ *
+ * The writer publishes complete values into a small ring of slots and then
+ * advances a sequence counter. Readers copy the slot belonging to the latest
+ * sequence and re-check the sequence afterwards; if the writer lapped them
+ * while copying they simply retry. Neither side ever blocks or allocates,
+ * so the writer can be the audio or analysis thread and the reader can be
+ * the message thread.
+ *
+ * @tparam T Trivially copyable payload type
+ */
+template <typename T>
+class SnapshotBuffer
+{
+public:
+    static_assert (std::is_trivially_copyable<T>::value,
+                   "SnapshotBuffer requires a trivially copyable payload");
+
+    SnapshotBuffer() = default;
+
+    /**
+     * @brief Publishes a new value
+     *
+     * Must only be called from one thread at a time.
+     *
+     * @param value The value to publish
+     */
+    void publish(const T& value) noexcept
+    {
+        const auto next = sequence.load(std::memory_order_relaxed) + 1;
+        auto& slot = slots[next % numSlots];
+
+        slot.sequence.store(0, std::memory_order_relaxed);   // mark slot as being written
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value = value;
+        slot.sequence.store(next, std::memory_order_release);
+
+        sequence.store(next, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies the latest published value
+     *
+     * @param destination Receives the value
+     * @return Sequence number of the copied value, or 0 if nothing was published yet
+     */
+    uint64_t read(T& destination) const noexcept
+    {
+        for (;;)
+        {
+            const auto seq = sequence.load(std::memory_order_acquire);
+            if (seq == 0)
+                return 0;
+
+            const auto& slot = slots[seq % numSlots];
+            if (slot.sequence.load(std::memory_order_acquire) != seq)
+                continue;
+
+            T copy = slot.value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.sequence.load(std::memory_order_relaxed) == seq)
+            {
+                destination = copy;
+                return seq;
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the sequence number of the latest published value
+     *
+     * Cheap way for readers to find out whether anything changed since
+     * their last read without copying the payload.
+     *
+     * @return Latest sequence number (0 if nothing was published yet)
+     */
+    uint64_t getSequence() const noexcept { return sequence.load(std::memory_order_acquire); }
+
+private:
+    static constexpr int numSlots = 4;
+
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence{0};
+        T value{};
+    };
+
+    std::array<Slot, numSlots> slots;
+    std::atomic<uint64_t> sequence{0};
+
+    SnapshotBuffer(const SnapshotBuffer&) = delete;
+    SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+};
+
+} // namespace AIplayer
@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+    StateSerializer.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the binary plugin state format.
+
+  ==============================================================================
+*/
+
+#include "StateSerializer.h"
+
+namespace AIplayer {
+
+namespace {
+    constexpr int SECTION_HEADER_SIZE = 6;       // uint16 tag + uint32 size
+    constexpr int MAX_PARAMETERS = 65536;        // sanity limit when decoding
+}
+
+//==============================================================================
+void StateSerializer::write(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& destData)
+{
+    // Parameters: count, then (ID length, UTF-8 ID, plain float value) per parameter
+    juce::MemoryBlock parameterBlock;
+    {
+        juce::MemoryOutputStream out(parameterBlock, false);
+
+        const auto& parameters = apvts.processor.getParameters();
+        int count = 0;
+        for (auto* parameter : parameters)
+            if (dynamic_cast<juce::RangedAudioParameter*>(parameter) != nullptr)
+                ++count;
+
+        out.writeCompressedInt(count);
+
+        for (auto* parameter : parameters)
+        {
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            {
+                const auto& id = ranged->getParameterID();
+                const auto numBytes = static_cast<int>(id.getNumBytesAsUTF8());
+
+                out.writeCompressedInt(numBytes);
+                out.write(id.toRawUTF8(), static_cast<size_t>(numBytes));
+                out.writeFloat(ranged->convertFrom0to1(ranged->getValue()));
+            }
+        }
+    }
+
+    // Extra (non-parameter) state in ValueTree's compact binary encoding
+    juce::MemoryBlock extraBlock;
+    const auto extraState = apvts.state.getChildWithName(EXTRA_STATE_TYPE);
+    if (extraState.isValid())
+    {
+        juce::MemoryOutputStream out(extraBlock, false);
+        extraState.writeToStream(out);
+    }
+
+    const auto payloadSize = SECTION_HEADER_SIZE + parameterBlock.getSize()
+                           + (extraBlock.isEmpty() ? 0 : SECTION_HEADER_SIZE + extraBlock.getSize());
+
+    destData.reset();
+    destData.ensureSize(static_cast<size_t>(HEADER_SIZE) + payloadSize);
+
+    juce::MemoryOutputStream out(destData, false);
+    out.writeInt(static_cast<int>(MAGIC));
+    out.writeShort(static_cast<short>(CURRENT_VERSION));
+    out.writeShort(static_cast<short>(MIN_READER_VERSION));
+    out.writeInt(static_cast<int>(payloadSize));
+
+    writeSection(out, Parameters, parameterBlock);
+
+    if (!extraBlock.isEmpty())
+        writeSection(out, ExtraState, extraBlock);
+
+    out.flush();
+    destData.setSize(out.getDataSize());
+}
+
+void StateSerializer::writeSection(juce::MemoryOutputStream& out, SectionTag tag, const juce::MemoryBlock& payload)
+{
+    out.writeShort(static_cast<short>(tag));
+    out.writeInt(static_cast<int>(payload.getSize()));
+    out.write(payload.getData(), payload.getSize());
+}
+
+//==============================================================================
+bool StateSerializer::isBinaryState(const void* data, int sizeInBytes)
+{
+    if (data == nullptr || sizeInBytes < HEADER_SIZE)
+        return false;
+
+    return juce::ByteOrder::littleEndianInt(data) == MAGIC;
+}
+
+/**
+ * @brief Decodes the header and all known sections
+ *
+ * @details Every length read from the data is validated against the bytes
+ * actually remaining before it is used, so truncated or damaged sessions
+ * are rejected as Corrupt instead of reading out of bounds. Sections with
+ * unknown tags (written by newer versions) are skipped.
+ */
+StateSerializer::Result StateSerializer::parse(const void* data, int sizeInBytes, ParsedState& state)
+{
+    if (!isBinaryState(data, sizeInBytes))
+        return Result::NotBinary;
+
+    juce::MemoryInputStream header(data, static_cast<size_t>(HEADER_SIZE), false);
+    header.readInt(); // magic
+    const auto formatVersion = static_cast<juce::uint16>(header.readShort());
+    const auto minReaderVersion = static_cast<juce::uint16>(header.readShort());
+    const auto payloadSize = static_cast<juce::uint32>(header.readInt());
+
+    if (minReaderVersion > CURRENT_VERSION)
+        return Result::TooNew;
+
+    if (payloadSize > static_cast<juce::uint32>(sizeInBytes - HEADER_SIZE))
+        return Result::Corrupt;
+
+    const auto* payload = static_cast<const char*>(data) + HEADER_SIZE;
+    juce::MemoryInputStream in(payload, payloadSize, false);
+
+    state = {};
+    state.formatVersion = formatVersion;
+
+    while (in.getNumBytesRemaining() >= SECTION_HEADER_SIZE)
+    {
+        const auto tag = static_cast<juce::uint16>(in.readShort());
+        const auto sectionSize = static_cast<juce::uint32>(in.readInt());
+        const auto sectionStart = in.getPosition();
+
+        if (sectionSize > static_cast<juce::uint64>(in.getNumBytesRemaining()))
+            return Result::Corrupt;
+
+        const auto* sectionData = payload + sectionStart;
+
+        switch (tag)
+        {
+            case Parameters:
+            {
+                juce::MemoryInputStream section(sectionData, sectionSize, false);
+                if (!readParameters(section, state))
+                    return Result::Corrupt;
+                break;
+            }
+
+            case ExtraState:
+                state.extraState = juce::ValueTree::readFromData(sectionData, sectionSize);
+                break;
+
+            default:
+                break;  // Unknown section from a newer version - skip it
+        }
+
+        in.setPosition(sectionStart + static_cast<juce::int64>(sectionSize));
+    }
+
+    migrateState(state);
+    return Result::Ok;
+}
+
+bool StateSerializer::readParameters(juce::MemoryInputStream& in, ParsedState& state)
+{
+    const int count = in.readCompressedInt();
+    if (count < 0 || count > MAX_PARAMETERS)
+        return false;
+
+    state.parameters.reserve(static_cast<size_t>(count));
+
+    for (int i = 0; i < count; ++i)
+    {
+        const int numBytes = in.readCompressedInt();
+        if (numBytes <= 0 || numBytes + 4 > in.getNumBytesRemaining())
+            return false;
+
+        const auto* idData = static_cast<const char*>(in.getData()) + in.getPosition();
+        auto id = juce::String::fromUTF8(idData, numBytes);
+        in.skipNextBytes(numBytes);
+
+        const float value = in.readFloat();
+        state.parameters.emplace_back(std::move(id), value);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Upgrades older state to the current layout
+ *
+ * @details Steps are applied one version at a time (v1 -> v2 -> ...), so each
+ * bump of CURRENT_VERSION only needs a case describing what changed relative
+ * to the previous version (renamed parameter IDs, unit changes, restructured
+ * extra state). State written by a newer version is left as is; its unknown
+ * sections were already skipped and unknown parameters are ignored.
+ */
+void StateSerializer::migrateState(ParsedState& state)
+{
+    for (auto version = state.formatVersion; version < CURRENT_VERSION; ++version)
+    {
+        switch (version)
+        {
+            default:
+                break;
+        }
+    }
+
+    state.formatVersion = std::max(state.formatVersion, CURRENT_VERSION);
+}
+
+//==============================================================================
+StateSerializer::Result StateSerializer::read(juce::AudioProcessorValueTreeState& apvts, const void* data, int sizeInBytes)
+{
+    ParsedState state;
+    const auto result = parse(data, sizeInBytes, state);
+
+    if (result != Result::Ok)
+        return result;
+
+    // Build the complete state tree and hand it to the APVTS, as the legacy
+    // XML path does, rather than pushing every parameter to the host one by
+    // one; anything not stored goes back to its default
+    juce::HashMap<juce::String, float> storedValues(static_cast<int>(state.parameters.size()) * 2 + 1);
+    for (const auto& [id, value] : state.parameters)
+        storedValues.set(id, value);
+
+    auto restored = apvts.copyState();
+
+    for (auto* parameter : apvts.processor.getParameters())
+    {
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+        {
+            const auto& id = ranged->getParameterID();
+            const float normalised = storedValues.contains(id)
+                                   ? ranged->convertTo0to1(storedValues[id])
+                                   : ranged->getDefaultValue();
+
+            auto child = restored.getChildWithProperty("id", id);
+            if (!child.isValid())
+            {
+                child = juce::ValueTree("PARAM");
+                child.setProperty("id", id, nullptr);
+                restored.appendChild(child, nullptr);
+            }
+
+            child.setProperty("value", ranged->convertFrom0to1(juce::jlimit(0.0f, 1.0f, normalised)), nullptr);
+        }
+    }
+
+    // Replace the extra state child
+    auto existing = restored.getChildWithName(EXTRA_STATE_TYPE);
+    if (existing.isValid())
+        restored.removeChild(existing, nullptr);
+
+    if (state.extraState.isValid())
+        restored.appendChild(state.extraState.createCopy(), nullptr);
+
+    apvts.replaceState(restored);
+    return Result::Ok;
+}
+
+} // namespace AIplayer
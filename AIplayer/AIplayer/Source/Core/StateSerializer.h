@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    StateSerializer.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Compact, versioned binary format for saving and restoring plugin state.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @class StateSerializer
+ * @brief Reads and writes the AIplayer binary state format
+ *
+ * Layout (all integers little-endian):
+ * @code
+ *   uint32  magic              'AIPS'
+ *   uint16  formatVersion      version that wrote the data
+ *   uint16  minReaderVersion   oldest reader able to interpret it
+ *   uint32  payloadSize        bytes following the header
+ *   section*                   { uint16 tag, uint32 size, payload }
+ * @endcode
+ *
+ * Sections are length-prefixed, so a reader skips any tag it does not know
+ * (forward compatibility). Data written by an older formatVersion is passed
+ * through migrateState() before being applied (backward compatibility).
+ *
+ * Parameters are stored as (ID, plain value) pairs and applied straight to
+ * the APVTS parameters, avoiding the ValueTree -> XML -> text round trip of
+ * the legacy format. Non-parameter data lives in the EXTRA_STATE_TYPE child
+ * of the APVTS state and is stored with ValueTree's binary stream format.
+ *
+ * Data saved by older plugin versions (copyXmlToBinary) is not recognised by
+ * isBinaryState() and should be loaded through the legacy XML path.
+ */
+class StateSerializer
+{
+public:
+    /// 'AIPS' read as a little-endian uint32
+    static constexpr juce::uint32 MAGIC = 0x53504941;
+
+    /// Version written by this build
+    static constexpr juce::uint16 CURRENT_VERSION = 1;
+
+    /// Oldest reader version that can interpret data written by this build
+    static constexpr juce::uint16 MIN_READER_VERSION = 1;
+
+    /// Size of the fixed header in bytes
+    static constexpr int HEADER_SIZE = 12;
+
+    /// Type of the APVTS state child holding non-parameter data
+    static constexpr const char* EXTRA_STATE_TYPE = "AIplayerState";
+
+    /**
+     * @brief Section tags
+     */
+    enum SectionTag : juce::uint16
+    {
+        Parameters = 1,     ///< Parameter ID / value pairs
+        ExtraState = 2      ///< Binary ValueTree with non-parameter state
+    };
+
+    /**
+     * @brief Outcome of a read attempt
+     */
+    enum class Result
+    {
+        Ok,             ///< State applied
+        NotBinary,      ///< Data is not in this format (try legacy XML)
+        TooNew,         ///< Written by a version this reader cannot interpret
+        Corrupt         ///< Truncated or malformed data, nothing applied
+    };
+
+    /**
+     * @struct ParsedState
+     * @brief Decoded state prior to being applied
+     */
+    struct ParsedState
+    {
+        juce::uint16 formatVersion{0};
+        std::vector<std::pair<juce::String, float>> parameters;
+        juce::ValueTree extraState;
+    };
+
+    /**
+     * @brief Serialises parameters and extra state
+     *
+     * @param apvts The parameter state to save
+     * @param destData Receives the encoded state (replaces existing contents)
+     */
+    static void write(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& destData);
+
+    /**
+     * @brief Decodes and applies a saved state
+     *
+     * Parameters missing from the data are reset to their defaults so that
+     * loading is deterministic; unknown parameter IDs are ignored.
+     *
+     * @param apvts The parameter state to restore into
+     * @param data Pointer to the saved data
+     * @param sizeInBytes Size of the saved data
+     * @return Result of the attempt
+     */
+    static Result read(juce::AudioProcessorValueTreeState& apvts, const void* data, int sizeInBytes);
+
+    /**
+     * @brief Decodes saved data without applying it
+     *
+     * @param data Pointer to the saved data
+     * @param sizeInBytes Size of the saved data
+     * @param state Receives the decoded (and migrated) state
+     * @return Result of the attempt
+     */
+    static Result parse(const void* data, int sizeInBytes, ParsedState& state);
+
+    /**
+     * @brief Checks whether data starts with the binary state header
+     *
+     * @param data Pointer to the saved data
+     * @param sizeInBytes Size of the saved data
+     * @return true if the magic number matches
+     */
+    static bool isBinaryState(const void* data, int sizeInBytes);
+
+private:
+    /// Upgrades state written by an older formatVersion to CURRENT_VERSION
+    static void migrateState(ParsedState& state);
+
+    static void writeSection(juce::MemoryOutputStream& out, SectionTag tag, const juce::MemoryBlock& payload);
+    static bool readParameters(juce::MemoryInputStream& in, ParsedState& state);
+
+    StateSerializer() = delete;
+};
+
+} // namespace AIplayer
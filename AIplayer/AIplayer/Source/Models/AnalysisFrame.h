@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    AnalysisFrame.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Data structure for one completed frequency analysis result.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace AIplayer {
+
+/**
+ * @struct AnalysisFrame
+ * @brief Snapshot of the most recent frequency analysis
+ *
+ * Published by FrequencyAnalyzer after every FFT computation and read by
+ * the editor's spectrum view. Kept trivially copyable and fixed-size so it
+ * can travel through a SnapshotBuffer without locks or allocation.
+ */
+struct AnalysisFrame
+{
+    /// Number of logarithmically spaced display bins
+    static constexpr int NUM_SPECTRUM_BINS = 96;
+
+    /// Lowest frequency covered by the display bins (Hz)
+    static constexpr float MIN_FREQUENCY = 20.0f;
+
+    /// Highest frequency covered by the display bins (Hz)
+    static constexpr float MAX_FREQUENCY = 20000.0f;
+
+    /// Magnitude per log-frequency bin in dB
+    std::array<float, NUM_SPECTRUM_BINS> spectrumDb{};
+
+    /// Band energy levels in dB (4 bands)
+    std::array<float, 4> bandEnergiesDb{ -100.0f, -100.0f, -100.0f, -100.0f };
+
+    /// Sample rate the frame was computed at
+    double sampleRate{44100.0};
+
+    /// Running count of computed frames
+    uint32_t frameIndex{0};
+};
+
+} // namespace AIplayer
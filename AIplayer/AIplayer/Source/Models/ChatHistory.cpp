@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    ChatHistory.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the bounded chat message store.
+
+  ==============================================================================
+*/
+
+#include "ChatHistory.h"
+
+namespace AIplayer {
+
+ChatHistory::ChatHistory()
+    : messages(static_cast<size_t>(MAX_MESSAGES))
+{
+}
+
+void ChatHistory::addMessage(Sender sender, const juce::String& text)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto& slot = messages[static_cast<size_t>(head)];
+    slot.sender = sender;
+    slot.text = text.length() > MAX_MESSAGE_LENGTH ? text.substring(0, MAX_MESSAGE_LENGTH) + "..." : text;
+    slot.timestamp = juce::Time::getCurrentTime();
+
+    head = (head + 1) % MAX_MESSAGES;
+    count = std::min(count + 1, MAX_MESSAGES);
+    ++totalAdded;
+
+    // Coalesced: many additions before the next message loop cycle produce one callback
+    sendChangeMessage();
+}
+
+const ChatHistory::Message& ChatHistory::getMessage(int index) const
+{
+    jassert(index >= 0 && index < count);
+
+    const int oldest = (head - count + MAX_MESSAGES) % MAX_MESSAGES;
+    return messages[static_cast<size_t>((oldest + index) % MAX_MESSAGES)];
+}
+
+juce::String ChatHistory::getSenderPrefix(Sender sender)
+{
+    switch (sender)
+    {
+        case Sender::User:   return "You: ";
+        case Sender::AI:     return "AI: ";
+        case Sender::System: break;
+    }
+
+    return {};
+}
+
+} // namespace AIplayer
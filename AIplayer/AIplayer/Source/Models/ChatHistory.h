@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    ChatHistory.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Bounded store of chat messages exchanged between the plugin and the
+    AI agents.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../JuceLibraryCode/JuceHeader.h"
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @class ChatHistory
+ * @brief Fixed-capacity ring of chat messages
+ *
+ * Owned by the processor so the conversation survives closing and reopening
+ * the editor. Once MAX_MESSAGES is reached the oldest message is overwritten,
+ * so memory stays flat no matter how long a session runs.
+ *
+ * Listeners are notified through juce::ChangeBroadcaster, which coalesces
+ * any burst of additions into a single asynchronous callback on the message
+ * thread. All methods must be called on the message thread.
+ */
+class ChatHistory : public juce::ChangeBroadcaster
+{
+public:
+    /// Maximum number of messages retained
+    static constexpr int MAX_MESSAGES = 500;
+
+    /// Longer messages are truncated to this many characters
+    static constexpr int MAX_MESSAGE_LENGTH = 4000;
+
+    /**
+     * @brief Who authored a message
+     */
+    enum class Sender
+    {
+        User,       ///< Typed into this editor
+        AI,         ///< Received from ChattyChannels
+        System      ///< Informational text generated by the plugin
+    };
+
+    /**
+     * @struct Message
+     * @brief A single chat entry
+     */
+    struct Message
+    {
+        Sender sender{Sender::System};
+        juce::String text;
+        juce::Time timestamp;
+    };
+
+    /**
+     * @brief Constructor
+     */
+    ChatHistory();
+
+    /**
+     * @brief Appends a message, overwriting the oldest one when full
+     *
+     * @param sender Author of the message
+     * @param text Message text
+     */
+    void addMessage(Sender sender, const juce::String& text);
+
+    /**
+     * @brief Gets the number of messages currently retained
+     *
+     * @return Number of messages (at most MAX_MESSAGES)
+     */
+    int getNumMessages() const { return count; }
+
+    /**
+     * @brief Accesses a message in chronological order
+     *
+     * @param index 0 is the oldest retained message
+     * @return The message at the given index
+     */
+    const Message& getMessage(int index) const;
+
+    /**
+     * @brief Gets the total number of messages ever added
+     *
+     * Together with getNumMessages() this gives each message a stable
+     * absolute index: the oldest retained message has absolute index
+     * getTotalAdded() - getNumMessages().
+     *
+     * @return Total number of messages added since construction
+     */
+    juce::uint64 getTotalAdded() const { return totalAdded; }
+
+    /**
+     * @brief Gets a display prefix for a sender
+     *
+     * @param sender The sender
+     * @return Prefix such as "You: " or "AI: "
+     */
+    static juce::String getSenderPrefix(Sender sender);
+
+private:
+    std::vector<Message> messages;
+    int head{0};
+    int count{0};
+    juce::uint64 totalAdded{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChatHistory)
+};
+
+} // namespace AIplayer
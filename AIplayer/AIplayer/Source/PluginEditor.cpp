@@ -15,22 +15,22 @@ namespace AIplayer {
 /**
  * @brief Constructor for the AIplayerAudioProcessorEditor
  *
- * Initializes the editor with all UI components including chat display,
+ * Initializes the editor with all UI components including spectrum view, chat display,
  * message input, send button, and gain controls. Sets up listeners and
  * attachments for interactive components.
  *
  * @param p Reference to the audio processor that created this editor
  */
 AIplayerAudioProcessorEditor::AIplayerAudioProcessorEditor (AIplayerAudioProcessor& p)
-    : AudioProcessorEditor (p), audioProcessor (p)
+    : AudioProcessorEditor (p), audioProcessor (p),
+      spectrumView (p.getFrequencyAnalyzer(), p.getAudioMetrics()),
+      chatView (p.getChatHistory())
 {
-    // Chat Display
-    addAndMakeVisible(chatDisplay);
-    chatDisplay.setMultiLine(true);
-    chatDisplay.setReadOnly(true);
-    chatDisplay.setCaretVisible(false); // No caret needed for display
-    chatDisplay.setScrollbarsShown(true);
-    chatDisplay.setText("AIplayer Chat\n=============\n", juce::dontSendNotification); // Initial text
+    // Spectrum / Meter View
+    addAndMakeVisible(spectrumView);
+
+    // Chat Display (virtualised view of the processor's bounded history)
+    addAndMakeVisible(chatView);
 
     // Message Input
     addAndMakeVisible(messageInput);
@@ -60,8 +60,8 @@ AIplayerAudioProcessorEditor::AIplayerAudioProcessorEditor (AIplayerAudioProcess
         gainSlider          // The slider UI element
     );
 
-    // Set initial size (make slightly taller for slider)
-    setSize (400, 350);
+    // Set initial size (taller to fit the spectrum view)
+    setSize (400, 500);
 }
 
 /**
@@ -83,7 +83,7 @@ AIplayerAudioProcessorEditor::~AIplayerAudioProcessorEditor()
  * @brief Renders the editor's UI components
  *
  * Fills the background with the default window background color.
- * All components (chatDisplay, messageInput, sendButton, gainSlider)
+ * All components (spectrumView, chatView, messageInput, sendButton, gainSlider)
  * are drawn by their respective paint methods.
  *
  * @param g The graphics context to use for drawing
@@ -93,7 +93,7 @@ void AIplayerAudioProcessorEditor::paint (juce::Graphics& g)
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
 
-    // No need to draw text here anymore, the TextEditor components handle it.
+    // No need to draw text here anymore, the child components handle it.
 }
 
 /**
@@ -102,6 +102,7 @@ void AIplayerAudioProcessorEditor::paint (juce::Graphics& g)
  * This method is called when the editor is resized and
  * positions all UI components within the available space:
  * - Gain slider at the top
+ * - Spectrum and level meters below the slider
  * - Chat display in the middle
  * - Message input and send button at the bottom
  */
@@ -112,14 +113,18 @@ void AIplayerAudioProcessorEditor::resized()
 
     auto bounds = getLocalBounds().reduced(10); // Add overall margin
     auto topArea = bounds.removeFromTop(50);    // Area for gain slider
+    auto spectrumArea = bounds.removeFromTop(150); // Area for spectrum and meters
     auto bottomArea = bounds.removeFromBottom(40); // Area for input and button
     auto buttonWidth = 80;
 
     // Position Gain Slider (Label is attached automatically to the left)
     gainSlider.setBounds(topArea.reduced(0, 10)); // Reduce vertically for spacing
 
+    // Position Spectrum View
+    spectrumView.setBounds(spectrumArea.withTrimmedBottom(5));
+
     // Position Chat Display (Takes remaining middle space)
-    chatDisplay.setBounds(bounds);
+    chatView.setBounds(bounds);
 
     // Position Bottom Controls
     sendButton.setBounds(bottomArea.removeFromRight(buttonWidth).reduced(5)); // Button on the right
@@ -180,52 +185,25 @@ void AIplayerAudioProcessorEditor::sliderValueChanged (juce::Slider* slider)
     }
 }
 
-/**
- * @brief Displays a received message in the chat display
- *
- * This method is called by the processor when a new message is received
- * via OSC. It uses callAsync to ensure that UI updates happen on the
- * message thread, not the audio thread.
- *
- * @param message The message to display
- */
-void AIplayerAudioProcessorEditor::displayReceivedMessage(const juce::String& message)
-{
-    // Ensure UI updates happen on the message thread
-    juce::MessageManager::callAsync([this, message]()
-    {
-        // We add "AI: " prefix for clarity
-        chatDisplay.moveCaretToEnd(); // Ensure text is appended at the end
-        chatDisplay.insertTextAtCaret("AI: " + message + "\n");
-        chatDisplay.moveCaretToEnd(); // Scroll to bottom after adding text
-    });
-}
-
 //==============================================================================
 /**
  * @brief Sends the current message text to the processor
  *
  * This helper method handles the complete message sending process:
  * 1. Gets the message text from the input field
- * 2. Displays the message in the chat display with "You: " prefix
- * 3. Clears the input field
- * 4. Sends the message to the processor for OSC transmission
+ * 2. Clears the input field
+ * 3. Sends the message to the processor, which records it in the chat
+ *    history (shown by chatView) and transmits it via OSC
  */
 void AIplayerAudioProcessorEditor::sendMessage()
 {
     juce::String message = messageInput.getText();
     if (message.isNotEmpty())
     {
-        // 1. Append user message to display (for immediate feedback)
-        // We add "You: " prefix for clarity
-        chatDisplay.moveCaretToEnd(); // Ensure text is appended at the end
-        chatDisplay.insertTextAtCaret("You: " + message + "\n");
-        chatDisplay.moveCaretToEnd(); // Scroll to bottom after adding text
-
-        // 2. Clear the input field
+        // 1. Clear the input field
         messageInput.clear();
 
-        // 3. Send the message to the PluginProcessor
+        // 2. Send the message to the PluginProcessor (also adds it to the chat history)
         audioProcessor.sendChatMessage(message);
         // DBG("Message sent to processor: " + message); // Keep DBG for OSC sending in processor
     }
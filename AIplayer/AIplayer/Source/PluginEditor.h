@@ -10,6 +10,8 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "UI/SpectrumMeterComponent.h"
+#include "UI/ChatView.h"
 
 namespace AIplayer {
 
@@ -19,7 +21,8 @@ namespace AIplayer {
  * @brief GUI editor component for the AIplayer plugin
  *
  * This class implements the user interface for the AIplayer plugin,
- * including chat display, message input, send button, and parameter controls.
+ * including spectrum/level display, chat display, message input, send button,
+ * and parameter controls.
  * It communicates with the AIplayerAudioProcessor to handle user interactions
  * and display messages.
  */
@@ -63,16 +66,6 @@ public:
      */
     void resized() override;
 
-    /**
-     * @brief Displays a received message in the chat display
-     *
-     * This is called by the processor when a new message is received
-     * via OSC to update the chat display.
-     *
-     * @param message The message to display
-     */
-    void displayReceivedMessage(const juce::String& message);
-
 private:
     /**
      * @brief Handles button click events
@@ -120,11 +113,20 @@ private:
     AIplayerAudioProcessor& audioProcessor;
 
     /**
-     * @brief Text editor for displaying chat messages
+     * @brief Spectrum and level meter view
+     *
+     * Shows the latest analysis frame and RMS/peak levels measured by the processor.
+     */
+    SpectrumMeterComponent spectrumView;
+    
+    /**
+     * @brief View of the processor's chat history
      *
-     * This component displays sent and received chat messages.
+     * This component displays sent and received chat messages. It observes
+     * the processor's ChatHistory, so received messages never need to reach
+     * the editor directly.
      */
-    juce::TextEditor chatDisplay;
+    ChatView chatView;
     
     /**
      * @brief Text editor for entering messages
@@ -9,6 +9,7 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "Core/Constants.h"
+#include "Core/StateSerializer.h"
 
 namespace AIplayer {
 
@@ -26,6 +27,95 @@ juce::AudioProcessorValueTreeState::ParameterLayout AIplayerAudioProcessor::crea
         "dB"                                                   // Unit Suffix
     ));
 
+    // Channel strip: HPF -> bell EQ -> LPF -> compressor
+    namespace P = Constants::Parameters;
+    const auto id = [](const char* name) { return juce::ParameterID(name, P::CHANNEL_STRIP_VERSION); };
+    const auto frequencyRange = [](float min, float max)
+    {
+        juce::NormalisableRange<float> range(min, max, 0.1f);
+        range.setSkewForCentre(std::sqrt(min * max));
+        return range;
+    };
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(id(P::HPF_ENABLED_ID), "HPF On", false));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::HPF_FREQ_ID), "HPF Frequency",
+        frequencyRange(P::HPF_FREQ_MIN_HZ, P::HPF_FREQ_MAX_HZ), P::HPF_FREQ_DEFAULT_HZ, "Hz"));
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(id(P::LPF_ENABLED_ID), "LPF On", false));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::LPF_FREQ_ID), "LPF Frequency",
+        frequencyRange(P::LPF_FREQ_MIN_HZ, P::LPF_FREQ_MAX_HZ), P::LPF_FREQ_DEFAULT_HZ, "Hz"));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::EQ_FREQ_ID), "EQ Frequency", frequencyRange(20.0f, 20000.0f), P::EQ_FREQ_DEFAULT_HZ, "Hz"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::EQ_GAIN_ID), "EQ Gain",
+        juce::NormalisableRange<float>(-P::EQ_GAIN_RANGE_DB, P::EQ_GAIN_RANGE_DB, 0.1f), 0.0f, "dB"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::EQ_Q_ID), "EQ Q", frequencyRange(P::EQ_Q_MIN, P::EQ_Q_MAX), P::EQ_Q_DEFAULT));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::COMP_THRESHOLD_ID), "Comp Threshold", juce::NormalisableRange<float>(-60.0f, 0.0f, 0.1f), 0.0f, "dB"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::COMP_RATIO_ID), "Comp Ratio", frequencyRange(1.0f, 20.0f), 1.0f, ":1"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::COMP_ATTACK_ID), "Comp Attack", frequencyRange(0.1f, 100.0f), 10.0f, "ms"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::COMP_RELEASE_ID), "Comp Release", frequencyRange(10.0f, 1000.0f), 100.0f, "ms"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::COMP_MAKEUP_ID), "Comp Makeup", juce::NormalisableRange<float>(0.0f, 24.0f, 0.1f), 0.0f, "dB"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        id(P::COMP_LOOKAHEAD_ID), "Comp Lookahead",
+        juce::NormalisableRange<float>(0.0f, ChannelStrip::MAX_LOOKAHEAD_MS, 0.1f), 0.0f, "ms"));
+
+    // Sidechain ducking: dynamic-EQ cut of one band, keyed by the sidechain bus
+    const auto duckId = [](const char* name) { return juce::ParameterID(name, P::SIDECHAIN_VERSION); };
+
+    juce::StringArray bandNames;
+    for (int band = 0; band < BandEnergyAnalyzer::NUM_BANDS; ++band)
+        bandNames.add(BandEnergyAnalyzer::getBandName(band));
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(duckId(P::DUCK_ENABLED_ID), "Duck On", false));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(duckId(P::DUCK_BAND_ID), "Duck Band", bandNames, 0));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        duckId(P::DUCK_THRESHOLD_ID), "Duck Threshold",
+        juce::NormalisableRange<float>(-60.0f, 0.0f, 0.1f), P::DUCK_THRESHOLD_DEFAULT_DB, "dB"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        duckId(P::DUCK_DEPTH_ID), "Duck Depth",
+        juce::NormalisableRange<float>(0.0f, SidechainProcessor::MAX_DEPTH_DB, 0.1f), P::DUCK_DEPTH_DEFAULT_DB, "dB"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        duckId(P::DUCK_ATTACK_ID), "Duck Attack", frequencyRange(1.0f, 100.0f), 10.0f, "ms"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        duckId(P::DUCK_RELEASE_ID), "Duck Release", frequencyRange(10.0f, 1000.0f), 150.0f, "ms"));
+
+    // Oversampling around the nonlinear stages (channel strip)
+    juce::StringArray factorNames;
+    for (int factor = 0; factor < Oversampler::NUM_FACTORS; ++factor)
+        factorNames.add(Oversampler::getFactorName(factor));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(P::OVERSAMPLING_ID, P::OVERSAMPLING_VERSION), "Oversampling", factorNames, 0));
+
+    // True-peak lookahead limiter at the end of the chain (master-bus role)
+    const auto limiterId = [](const char* name) { return juce::ParameterID(name, P::LIMITER_VERSION); };
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(limiterId(P::LIMITER_ENABLED_ID), "Limiter On", false));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        limiterId(P::LIMITER_CEILING_ID), "Limiter Ceiling",
+        juce::NormalisableRange<float>(LookaheadLimiter::MIN_CEILING_DB, LookaheadLimiter::MAX_CEILING_DB, 0.1f),
+        P::LIMITER_CEILING_DEFAULT_DB, "dBTP"));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        limiterId(P::LIMITER_RELEASE_ID), "Limiter Release", frequencyRange(1.0f, 1000.0f), P::LIMITER_RELEASE_DEFAULT_MS, "ms"));
+
+    // How multichannel buses are folded to mono for the spectrum analysis
+    juce::StringArray downmixNames;
+    for (int mode = 0; mode < ChannelLayout::NUM_DOWNMIX_MODES; ++mode)
+        downmixNames.add(ChannelLayout::getDownmixName(mode));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID(P::ANALYSIS_DOWNMIX_ID, P::ANALYSIS_VERSION), "Analysis Downmix", downmixNames, 0));
+
     return { params.begin(), params.end() };
 }
 
@@ -36,6 +126,7 @@ AIplayerAudioProcessor::AIplayerAudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
@@ -56,6 +147,9 @@ AIplayerAudioProcessor::AIplayerAudioProcessor()
     
     // Setup OSC communication
     setupOSCCommunication();
+    
+    // Latency changes measured on the audio thread reach the host from here
+    latencyTimer.startTimer(LATENCY_UPDATE_MS);
 }
 
 AIplayerAudioProcessor::~AIplayerAudioProcessor()
@@ -64,14 +158,20 @@ AIplayerAudioProcessor::~AIplayerAudioProcessor()
     if (telemetryService)
         telemetryService->stopTelemetry();
     
+    InstanceRegistry::getInstance().remove(registrySlot);
+    
     // Remove listeners
     if (oscManager)
     {
         oscManager->removeListener(this);
     }
     
-    // Stop timer
+    // Stop timers
     stopTimer();
+    latencyTimer.stopTimer();
+    
+    if (analysisGovernor)
+        analysisGovernor->stop();
     
     if (logger)
         logger->log(Logger::Level::Info, "--- AIplayer Plugin Shutting Down ---");
@@ -121,6 +221,14 @@ void AIplayerAudioProcessor::initializeComponents()
     // Initialize audio processing components - order independent
     audioMetrics = std::make_unique<AudioMetrics>();
     toneGenerator = std::make_unique<CalibrationToneGenerator>();
+    oversampler = std::make_unique<Oversampler>();
+    for (auto& strip : channelStrips)
+        strip = std::make_unique<ChannelStrip>();
+    autoLevel = std::make_unique<AutoLevelController>();
+    sidechainProcessor = std::make_unique<SidechainProcessor>();
+    limiter = std::make_unique<LookaheadLimiter>();
+    beatTracker = std::make_unique<BeatTracker>();
+    drumHitAnalyzer = std::make_unique<DrumHitAnalyzer>();
     
     // Initialize frequency analyzer with optimized real-time configuration
     FrequencyAnalyzer::Config fftConfig;
@@ -128,12 +236,36 @@ void AIplayerAudioProcessor::initializeComponents()
     fftConfig.updateRateHz = 10;      // 10 Hz update rate balances accuracy vs CPU usage
     fftConfig.enableAWeighting = false; // Disabled for raw frequency analysis
     fftConfig.autoStart = true;       // Start analysis immediately
+    
+    // Same analysis for the sidechain key; idle until the bus delivers audio
+    sidechainAnalyzer = std::make_unique<FrequencyAnalyzer>(*logger, fftConfig);
+    
+    // The main analyzer holds every FFT size the governor may select
+    fftConfig.minFftOrder = AnalysisGovernor::MIN_FFT_ORDER;
+    fftConfig.maxFftOrder = AnalysisGovernor::MAX_FFT_ORDER;
     frequencyAnalyzer = std::make_unique<FrequencyAnalyzer>(*logger, fftConfig);
     
+    // Trades analysis quality against CPU load, starting at the standard settings
+    analysisGovernor = std::make_unique<AnalysisGovernor>(*frequencyAnalyzer, *sidechainAnalyzer, *audioMetrics, *logger);
+    analysisGovernor->start();
+    
     // Initialize communication components - depend on audio components for data
     oscManager = std::make_unique<OSCManager>(*logger);
     portManager = std::make_unique<PortManager>(*oscManager, *logger);
     telemetryService = std::make_unique<TelemetryService>(*audioMetrics, *frequencyAnalyzer, *oscManager, *logger);
+    telemetryService->setAutoLevelController(autoLevel.get());
+    telemetryService->setSidechainProcessor(sidechainProcessor.get());
+    telemetryService->setAnalysisGovernor(analysisGovernor.get());
+    telemetryService->setBeatTracker(beatTracker.get());
+    telemetryService->setDrumHitAnalyzer(drumHitAnalyzer.get());
+    spectrumStreamer = std::make_unique<SpectrumStreamer>(*frequencyAnalyzer, *oscManager, *logger);
+    spectrumStreamer->setTrackID(tempInstanceID);
+    
+    // Let any instance in this host report on this one
+    registrySlot = InstanceRegistry::getInstance().add(tempInstanceID);
+    if (registrySlot < 0)
+        logger->log(Logger::Level::Warning, "Instance registry full - this instance will not be listed");
+    telemetryService->setRegistrySlot(registrySlot);
     
     componentsInitialized = true;
 }
@@ -176,6 +308,8 @@ void AIplayerAudioProcessor::setupOSCCommunication()
             logger->log(Logger::Level::Error, "Failed to bind to ephemeral port");
         }
     }
+    
+    updateRegistryConnection();
 }
 
 void AIplayerAudioProcessor::setupParameters()
@@ -186,6 +320,104 @@ void AIplayerAudioProcessor::setupParameters()
         logger->log(Logger::Level::Info, "Gain parameter pointer acquired.");
     else
         logger->log(Logger::Level::Error, "Failed to acquire Gain parameter pointer.");
+    
+    namespace P = Constants::Parameters;
+    stripParameters.hpfEnabled = apvts.getRawParameterValue(P::HPF_ENABLED_ID);
+    stripParameters.hpfFrequency = apvts.getRawParameterValue(P::HPF_FREQ_ID);
+    stripParameters.lpfEnabled = apvts.getRawParameterValue(P::LPF_ENABLED_ID);
+    stripParameters.lpfFrequency = apvts.getRawParameterValue(P::LPF_FREQ_ID);
+    stripParameters.eqFrequency = apvts.getRawParameterValue(P::EQ_FREQ_ID);
+    stripParameters.eqGain = apvts.getRawParameterValue(P::EQ_GAIN_ID);
+    stripParameters.eqQ = apvts.getRawParameterValue(P::EQ_Q_ID);
+    stripParameters.compThreshold = apvts.getRawParameterValue(P::COMP_THRESHOLD_ID);
+    stripParameters.compRatio = apvts.getRawParameterValue(P::COMP_RATIO_ID);
+    stripParameters.compAttack = apvts.getRawParameterValue(P::COMP_ATTACK_ID);
+    stripParameters.compRelease = apvts.getRawParameterValue(P::COMP_RELEASE_ID);
+    stripParameters.compMakeup = apvts.getRawParameterValue(P::COMP_MAKEUP_ID);
+    stripParameters.compLookahead = apvts.getRawParameterValue(P::COMP_LOOKAHEAD_ID);
+    
+    duckParameters.enabled = apvts.getRawParameterValue(P::DUCK_ENABLED_ID);
+    duckParameters.band = apvts.getRawParameterValue(P::DUCK_BAND_ID);
+    duckParameters.threshold = apvts.getRawParameterValue(P::DUCK_THRESHOLD_ID);
+    duckParameters.depth = apvts.getRawParameterValue(P::DUCK_DEPTH_ID);
+    duckParameters.attack = apvts.getRawParameterValue(P::DUCK_ATTACK_ID);
+    duckParameters.release = apvts.getRawParameterValue(P::DUCK_RELEASE_ID);
+    
+    downmixParameter = apvts.getRawParameterValue(P::ANALYSIS_DOWNMIX_ID);
+    oversamplingParameter = apvts.getRawParameterValue(P::OVERSAMPLING_ID);
+    
+    limiterParameters.enabled = apvts.getRawParameterValue(P::LIMITER_ENABLED_ID);
+    limiterParameters.ceiling = apvts.getRawParameterValue(P::LIMITER_CEILING_ID);
+    limiterParameters.release = apvts.getRawParameterValue(P::LIMITER_RELEASE_ID);
+}
+
+ChannelStrip::Settings AIplayerAudioProcessor::getChannelStripSettings() const
+{
+    const auto& p = stripParameters;
+    ChannelStrip::Settings s;
+
+    s.hpfEnabled = p.hpfEnabled->load() >= 0.5f;
+    s.hpfFrequency = p.hpfFrequency->load();
+    s.lpfEnabled = p.lpfEnabled->load() >= 0.5f;
+    s.lpfFrequency = p.lpfFrequency->load();
+    s.eqFrequency = p.eqFrequency->load();
+    s.eqGainDb = p.eqGain->load();
+    s.eqQ = p.eqQ->load();
+    s.compThresholdDb = p.compThreshold->load();
+    s.compRatio = p.compRatio->load();
+    s.compAttackMs = p.compAttack->load();
+    s.compReleaseMs = p.compRelease->load();
+    s.compMakeupDb = p.compMakeup->load();
+    // Whole host samples, so every oversampling factor delays by the same amount
+    const double sampleRate = getSampleRate() > 0.0 ? getSampleRate() : 44100.0;
+    const int lookaheadSamples = juce::roundToInt(p.compLookahead->load() * 0.001 * sampleRate);
+    s.compLookaheadMs = static_cast<float>(lookaheadSamples * 1000.0 / sampleRate);
+
+    return s;
+}
+
+SidechainProcessor::Settings AIplayerAudioProcessor::getSidechainSettings() const
+{
+    const auto& p = duckParameters;
+    SidechainProcessor::Settings s;
+
+    s.duckEnabled = p.enabled->load() >= 0.5f;
+    s.duckBand = juce::roundToInt(p.band->load());
+    s.thresholdDb = p.threshold->load();
+    s.depthDb = p.depth->load();
+    s.attackMs = p.attack->load();
+    s.releaseMs = p.release->load();
+
+    return s;
+}
+
+LookaheadLimiter::Settings AIplayerAudioProcessor::getLimiterSettings() const
+{
+    const auto& p = limiterParameters;
+    LookaheadLimiter::Settings s;
+
+    s.enabled = p.enabled->load() >= 0.5f;
+    s.ceilingDb = p.ceiling->load();
+    s.releaseMs = p.release->load();
+
+    return s;
+}
+
+int AIplayerAudioProcessor::getProcessingLatency(int oversamplingFactor) const
+{
+    // Strip lookahead runs at the oversampled rate (whole host samples at every
+    // factor); the oversampler pads every factor to the same filter latency
+    const int stripLatency = channelStrips[static_cast<size_t>(oversamplingFactor)]->getLatencySamples();
+    return oversampler->getLatencySamples()
+         + juce::roundToInt(static_cast<double>(stripLatency) / Oversampler::getMultiplier(oversamplingFactor))
+         + limiter->getLatencySamples();
+}
+
+void AIplayerAudioProcessor::updateLatency()
+{
+    const int latency = pendingLatency.load(std::memory_order_relaxed);
+    if (latency >= 0 && latency != getLatencySamples())
+        setLatencySamples(latency);
 }
 
 //==============================================================================
@@ -197,8 +429,46 @@ void AIplayerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
     logger->log(Logger::Level::Info, "prepareToPlay called. Sample Rate: " + 
                 juce::String(sampleRate) + ", Samples Per Block: " + juce::String(samplesPerBlock));
     
+    // Main bus layout: anything from mono to 16 discrete channels
+    mainLayout = getChannelLayoutOfBus(false, 0);
+    appliedDownmix = -1;
+    
+    std::array<float, ChannelLayout::MAX_CHANNELS> loudnessWeights;
+    ChannelLayout::loudnessWeights(mainLayout, loudnessWeights.data());
+    
+    logger->log(Logger::Level::Info, "Main bus layout: " + mainLayout.getDescription()
+                + " (" + juce::String(mainLayout.size()) + " channels)");
+    
     // Prepare audio components
     toneGenerator->prepare(sampleRate, samplesPerBlock);
+    audioMetrics->prepare(sampleRate, samplesPerBlock, mainLayout);
+    analysisGovernor->prepare(sampleRate);
+    beatTracker->prepare(sampleRate);
+    drumHitAnalyzer->prepare(sampleRate);
+    
+    // Every oversampling factor is prepared up front so switching never allocates
+    const int numChannels = getTotalNumOutputChannels();
+    oversampler->prepare(numChannels, samplesPerBlock);
+    
+    for (int factor = 0; factor < Oversampler::NUM_FACTORS; ++factor)
+    {
+        const int multiplier = Oversampler::getMultiplier(factor);
+        auto& strip = *channelStrips[static_cast<size_t>(factor)];
+        strip.prepare(sampleRate * multiplier, samplesPerBlock * multiplier, numChannels);
+        strip.setSettings(getChannelStripSettings());
+    }
+    
+    autoLevel->prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    autoLevel->setChannelWeights(loudnessWeights.data(), mainLayout.size());
+    
+    sidechainProcessor->prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    
+    limiter->setSettings(getLimiterSettings());
+    limiter->prepare(sampleRate, samplesPerBlock, numChannels);
+    
+    activeOversampling = juce::jlimit(0, Oversampler::NUM_FACTORS - 1, juce::roundToInt(oversamplingParameter->load()));
+    pendingLatency.store(getProcessingLatency(activeOversampling), std::memory_order_relaxed);
+    setLatencySamples(pendingLatency.load(std::memory_order_relaxed));
     
     logger->log(Logger::Level::Info, "Audio components prepared for playback");
 }
@@ -216,16 +486,25 @@ bool AIplayerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any named or discrete layout from mono up to 16 channels (5.1, 7.1.4, ...)
+    const auto& mainOutput = layouts.getMainOutputChannelSet();
+    if (mainOutput.isDisabled() || mainOutput.size() > ChannelLayout::MAX_CHANNELS)
         return false;
 
     // This checks if the input layout matches the output layout
    #if ! JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
+
+    // Optional sidechain key: off, mono or stereo
+    if (layouts.inputBuses.size() > 1)
+    {
+        const auto& sidechain = layouts.getChannelSet(true, 1);
+        if (! sidechain.isDisabled()
+            && sidechain != juce::AudioChannelSet::mono()
+            && sidechain != juce::AudioChannelSet::stereo())
+            return false;
+    }
    #endif
 
     return true;
@@ -239,14 +518,21 @@ bool AIplayerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
  * @details This method implements the main audio processing pipeline:
  * 1. Validates component initialization and clears unused output channels
  * 2. Applies gain parameter to input audio (with dB to linear conversion)
+ *    followed by the channel strip (HPF, bell EQ, LPF, compressor; run at
+ *    2x/4x when oversampling is selected),
+ *    in-plugin auto-leveling when the agent has set a target, masking
+ *    analysis / dynamic-EQ ducking against the optional sidechain key
  * 3. Processes calibration tone generation (mixes tone into audio if active)
+ *    followed by the true-peak lookahead limiter when enabled, so the tone
+ *    is held under the ceiling too
  * 4. Updates audio metrics (RMS, peak levels) for telemetry
  * 5. Feeds processed audio to frequency analyzer for FFT and band analysis
  * 
  * The processing order ensures that all components receive the final processed
  * audio signal including gain adjustment and calibration tones.
  * 
- * @param buffer Audio buffer containing input samples, modified in-place
+ * @param buffer Audio buffer containing input samples, modified in-place;
+ *               the main bus is processed, the sidechain bus is only read
  * @param midiMessages MIDI buffer (ignored as this is an audio effect)
  * 
  * @note This method is called from the audio thread and must be real-time safe.
@@ -259,6 +545,8 @@ bool AIplayerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
  * @see initializeComponents() for initialization requirements
  * @see AudioMetrics::updateMetrics() for RMS calculation details
  * @see FrequencyAnalyzer::processBlock() for FFT processing
+ * @see BeatTracker::process() for tempo tracking
+ * @see DrumHitAnalyzer::process() for drum hit statistics
  */
 void AIplayerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
@@ -268,9 +556,17 @@ void AIplayerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
         
     juce::ignoreUnused (midiMessages);
     juce::ScopedNoDenormals noDenormals; // Prevent denormal performance issues
+    const auto callbackStart = juce::Time::getHighResolutionTicks();
     
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
+    
+    // The main bus is processed in place; the sidechain (when enabled) is only analysed
+    auto mainBuffer = getBusBuffer (buffer, true, 0);
+    const auto* sidechainBus = getBus (true, 1);
+    const bool hasSidechain = sidechainBus != nullptr && sidechainBus->isEnabled()
+                           && sidechainBus->getNumberOfChannels() > 0;
+    const auto sidechainBuffer = hasSidechain ? getBusBuffer (buffer, true, 1) : juce::AudioBuffer<float>();
 
     // Clear extra output channels that don't have corresponding inputs
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
@@ -282,21 +578,90 @@ void AIplayerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
         float currentGainDb = gainParameter->load();
         float gainFactor = juce::Decibels::decibelsToGain(currentGainDb);
 
-        // Apply gain to all input channels
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
+        // Apply gain to all main input channels
+        for (int channel = 0; channel < mainBuffer.getNumChannels(); ++channel)
         {
-            buffer.applyGain(channel, 0, buffer.getNumSamples(), gainFactor);
+            mainBuffer.applyGain(channel, 0, mainBuffer.getNumSamples(), gainFactor);
         }
     }
     
-    // Process calibration tone if enabled (mixes tone into existing audio)
-    toneGenerator->processBlock(buffer);
+    // Analysis downmix follows its parameter (gains only; no allocation)
+    const int downmix = downmixParameter != nullptr ? juce::roundToInt(downmixParameter->load()) : 0;
+    if (downmix != appliedDownmix && mainLayout.size() > 0)
+    {
+        std::array<float, ChannelLayout::MAX_CHANNELS> gains;
+        ChannelLayout::downmixGains(static_cast<ChannelLayout::Downmix>(downmix), mainLayout, gains.data());
+        frequencyAnalyzer->setDownmixGains(gains.data(), mainLayout.size());
+        appliedDownmix = downmix;
+    }
+    
+    // Channel strip - flat stages are skipped inside
+    // (oversampled when selected; the factor's strip restarts from clean state on a switch)
+    const int oversampling = juce::jlimit(0, Oversampler::NUM_FACTORS - 1, juce::roundToInt(oversamplingParameter->load()));
+    if (oversampling != activeOversampling)
+    {
+        channelStrips[static_cast<size_t>(oversampling)]->reset();
+        activeOversampling = oversampling;
+    }
+    
+    auto& channelStrip = *channelStrips[static_cast<size_t>(activeOversampling)];
+    channelStrip.setSettings(getChannelStripSettings());
+    oversampler->process(mainBuffer, activeOversampling, [&channelStrip](juce::AudioBuffer<float>& audio, int)
+    {
+        channelStrip.process(audio);
+    });
+    
+    // Closed-loop leveling to the agent's target (bypassed when off)
+    autoLevel->process(mainBuffer);
+    
+    // Masking against the key and dynamic-EQ ducking (after leveling, so the
+    // leveler does not make up the ducked level)
+    sidechainProcessor->setSettings(getSidechainSettings());
+    sidechainProcessor->process(mainBuffer, hasSidechain ? &sidechainBuffer : nullptr);
+    
+    if (hasSidechain && analysisGovernor->isEnabled(AnalysisGovernor::KeyAnalysis))
+        sidechainAnalyzer->processBlock(sidechainBuffer, getSampleRate());
+    
+    // Process calibration tone if enabled (mixes tone into existing audio);
+    // ahead of the limiter so the tone is held under the ceiling as well
+    toneGenerator->processBlock(mainBuffer);
+    
+    // True-peak ceiling on the final processed signal
+    limiter->setSettings(getLimiterSettings());
+    limiter->process(mainBuffer);
+    
+    // Only the strip lookahead changes the plugin's latency (oversampling and
+    // the limiter report the same latency whichever way they are switched).
+    // The host is told from the message thread (updateLatency()), since
+    // setLatencySamples() takes the listener lock.
+    pendingLatency.store(getProcessingLatency(activeOversampling), std::memory_order_relaxed);
     
     // Update audio metrics with the final processed signal
-    audioMetrics->updateMetrics(buffer);
+    audioMetrics->updateMetrics(mainBuffer);
     
     // Feed processed audio to frequency analyzer for spectral analysis
-    frequencyAnalyzer->processBlock(buffer, getSampleRate());
+    frequencyAnalyzer->processBlock(mainBuffer, getSampleRate());
+    
+    // Tempo from the same tap; a playing host transport takes precedence
+    double hostBpm = 0.0, hostPpq = 0.0;
+    bool hostPlaying = false;
+    if (auto* playHead = getPlayHead())
+    {
+        if (const auto position = playHead->getPosition())
+        {
+            hostBpm = position->getBpm().orFallback(0.0);
+            hostPpq = position->getPpqPosition().orFallback(0.0);
+            hostPlaying = position->getIsPlaying();
+        }
+    }
+    beatTracker->setHostTransport(hostBpm, hostPpq, hostPlaying);
+    beatTracker->process(mainBuffer);
+    
+    // Hit envelopes for kick/snare instances (returns at once unless enabled)
+    drumHitAnalyzer->process(mainBuffer);
+    
+    // Callback load for the analysis governor
+    analysisGovernor->addCallbackTime(juce::Time::getHighResolutionTicks() - callbackStart, buffer.getNumSamples());
 }
 
 //==============================================================================
@@ -315,19 +680,9 @@ void AIplayerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     try
     {
-        auto state = apvts.copyState();
-        std::unique_ptr<juce::XmlElement> xml (state.createXml());
-        if (xml != nullptr)
-        {
-            copyXmlToBinary (*xml, destData);
-            if (logger)
-                logger->log(Logger::Level::Info, "Plugin state saved.");
-        }
-        else
-        {
-            if (logger)
-                logger->log(Logger::Level::Error, "Failed to create XML from state for saving.");
-        }
+        StateSerializer::write(apvts, destData);
+        if (logger)
+            logger->log(Logger::Level::Info, "Plugin state saved (" + juce::String(destData.getSize()) + " bytes).");
     }
     catch (const std::exception& e)
     {
@@ -340,6 +695,28 @@ void AIplayerAudioProcessor::setStateInformation (const void* data, int sizeInBy
 {
     try
     {
+        switch (StateSerializer::read(apvts, data, sizeInBytes))
+        {
+            case StateSerializer::Result::Ok:
+                if (logger)
+                    logger->log(Logger::Level::Info, "Plugin state restored.");
+                return;
+
+            case StateSerializer::Result::TooNew:
+                if (logger)
+                    logger->log(Logger::Level::Error, "Failed to restore state - saved by a newer, incompatible version.");
+                return;
+
+            case StateSerializer::Result::Corrupt:
+                if (logger)
+                    logger->log(Logger::Level::Error, "Failed to restore state - binary state is corrupt.");
+                return;
+
+            case StateSerializer::Result::NotBinary:
+                break;
+        }
+
+        // Legacy sessions saved with copyXmlToBinary
         std::unique_ptr<juce::XmlElement> xmlState (getXmlFromBinary (data, sizeInBytes));
 
         if (xmlState != nullptr)
@@ -348,7 +725,7 @@ void AIplayerAudioProcessor::setStateInformation (const void* data, int sizeInBy
             {
                 apvts.replaceState (juce::ValueTree::fromXml (*xmlState));
                 if (logger)
-                    logger->log(Logger::Level::Info, "Plugin state restored.");
+                    logger->log(Logger::Level::Info, "Plugin state restored (legacy XML import).");
             }
             else
             {
@@ -439,6 +816,8 @@ void AIplayerAudioProcessor::changeProgramName (int index, const juce::String& n
 // Public interface methods
 void AIplayerAudioProcessor::sendChatMessage(const juce::String& message)
 {
+    chatHistory.addMessage(ChatHistory::Sender::User, message);
+    
     if (oscManager)
     {
         // For now, using a placeholder instance ID
@@ -455,6 +834,8 @@ void AIplayerAudioProcessor::handleTrackAssignment(const juce::String& trackID)
     logger->log(Logger::Level::Info, "Plugin " + tempInstanceID + 
                 " successfully assigned LogicTrackUUID: " + logicTrackUUID);
     
+    InstanceRegistry::getInstance().setIdentity(registrySlot, tempInstanceID, logicTrackUUID);
+    
     // Update telemetry service with the track ID
     if (telemetryService)
     {
@@ -462,16 +843,23 @@ void AIplayerAudioProcessor::handleTrackAssignment(const juce::String& trackID)
         telemetryService->setInstanceID(tempInstanceID);
     }
     
+    if (spectrumStreamer)
+        spectrumStreamer->setTrackID(trackID);
+    
     // Send confirmation back to ChattyChannels
     if (oscManager)
     {
         oscManager->sendUUIDConfirmation(tempInstanceID, logicTrackUUID);
     }
     
+    // A focus received before the assignment may name this track
+    if (!focusedTracks.isEmpty())
+        applyFocus();
+    
     // Start telemetry if we have a port
     if (portManager && portManager->isBound() && !logicTrackUUID.isEmpty())
     {
-        telemetryService->startTelemetry(Constants::TELEMETRY_RATE_HZ);
+        telemetryService->startTelemetry(AnalysisGovernor::getTelemetryRate(analysisGovernor->getPriority()));
     }
 }
 
@@ -483,11 +871,12 @@ void AIplayerAudioProcessor::handlePortAssignment(int port, const juce::String&
     if (portManager)
     {
         portManager->handlePortAssignment(port, status, tempInstanceID);
+        updateRegistryConnection();
         
         // If successfully bound and we have a track ID, start telemetry
         if (portManager->isBound() && !logicTrackUUID.isEmpty())
         {
-            telemetryService->startTelemetry(Constants::TELEMETRY_RATE_HZ);
+            telemetryService->startTelemetry(AnalysisGovernor::getTelemetryRate(analysisGovernor->getPriority()));
         }
     }
 }
@@ -561,22 +950,200 @@ void AIplayerAudioProcessor::handleChatResponse(const juce::String& response)
 {
     logger->log(Logger::Level::Info, "Received chat response via OSC: " + response);
 
-    // Safely get the active editor and update it
+    // Record in the history on the message thread; an open editor's ChatView
+    // picks it up through the history's (coalesced) change notification
     juce::WeakReference<AIplayerAudioProcessor> weakSelf = this;
     juce::MessageManager::callAsync([weakSelf, response]() {
         if (weakSelf == nullptr) return;
 
-        if (auto* editor = weakSelf->getActiveEditor())
+        weakSelf->chatHistory.addMessage(ChatHistory::Sender::AI, response);
+    });
+}
+
+
+
+void AIplayerAudioProcessor::handleAutoLevelTarget(const juce::String& mode, float targetDb,
+                                                   float toleranceDb, float timeConstantMs)
+{
+    AutoLevelController::Target target;
+    target.mode = AutoLevelController::modeFromString(mode);
+    target.levelDb = targetDb;
+    target.toleranceDb = toleranceDb;
+    target.timeConstantMs = timeConstantMs;
+    
+    autoLevel->setTarget(target);
+    
+    logger->log(Logger::Level::Info, "Auto-level target set: mode=" + AutoLevelController::modeToString(target.mode)
+                + ", target=" + juce::String(targetDb, 1) + " dB, tolerance=" + juce::String(toleranceDb, 2)
+                + " dB, time constant=" + juce::String(timeConstantMs, 0) + " ms");
+}
+
+void AIplayerAudioProcessor::handleAnalysisPriority(const juce::String& priority)
+{
+    applyAnalysisPriority(AnalysisGovernor::priorityFromString(priority));
+}
+
+void AIplayerAudioProcessor::handleFocus(const juce::StringArray& focusedTrackIDs)
+{
+    focusedTracks = focusedTrackIDs;
+    applyFocus();
+}
+
+void AIplayerAudioProcessor::handleSpectrumRequest(const juce::String& resolution, int bits, bool delta, float rateHz)
+{
+    if (resolution.equalsIgnoreCase("off"))
+    {
+        spectrumStreamer->stop();
+        return;
+    }
+    
+    SpectrumStreamer::Settings settings;
+    settings.resolution = resolution.equalsIgnoreCase("full") ? SpectrumStreamer::Resolution::Full
+                                                              : SpectrumStreamer::Resolution::Log;
+    settings.bits = bits;
+    settings.delta = delta;
+    settings.rateHz = rateHz;
+    
+    spectrumStreamer->request(settings);
+}
+
+void AIplayerAudioProcessor::handleLtasConfig(const juce::String& mode, float timeConstantSeconds)
+{
+    auto& ltas = frequencyAnalyzer->getLongTermSpectrum();
+    
+    if (mode.equalsIgnoreCase("reset"))
+    {
+        ltas.reset();
+        logger->log(Logger::Level::Info, "Long-term spectrum reset");
+        return;
+    }
+    
+    ltas.setMode(LongTermSpectrum::modeFromString(mode), timeConstantSeconds);
+    logger->log(Logger::Level::Info, "Long-term spectrum: " + LongTermSpectrum::modeToString(ltas.getMode())
+                + (ltas.getMode() == LongTermSpectrum::Mode::Exponential
+                       ? ", time constant " + juce::String(ltas.getTimeConstant(), 1) + " s" : juce::String()));
+}
+
+void AIplayerAudioProcessor::handleLtasReference(const juce::String& name, const juce::String& filePath,
+                                                 const juce::Array<float>& points)
+{
+    auto& ltas = frequencyAnalyzer->getLongTermSpectrum();
+    bool loaded = false;
+    
+    if (filePath.isNotEmpty())
+    {
+        loaded = juce::File::isAbsolutePath(filePath) && ltas.loadReference(name, juce::File(filePath));
+    }
+    else
+    {
+        // Interleaved frequency/level pairs
+        juce::Array<float> frequencies, levels;
+        for (int i = 0; i + 1 < points.size(); i += 2)
         {
-            if (auto* aiEditor = dynamic_cast<AIplayerAudioProcessorEditor*>(editor))
-            {
-                aiEditor->displayReceivedMessage(response);
-            }
+            frequencies.add(points[i]);
+            levels.add(points[i + 1]);
         }
-    });
+        
+        loaded = ltas.setReference(name, frequencies.getRawDataPointer(), levels.getRawDataPointer(), frequencies.size());
+    }
+    
+    logger->log(loaded ? Logger::Level::Info : Logger::Level::Warning,
+                (loaded ? "Loaded LTAS reference: " : "Invalid LTAS reference: ") + name);
 }
 
+void AIplayerAudioProcessor::handleLtasQuery(const juce::String& referenceName)
+{
+    const auto& ltas = frequencyAnalyzer->getLongTermSpectrum();
+    
+    std::array<float, LongTermSpectrum::NUM_BINS> levels;
+    for (int bin = 0; bin < LongTermSpectrum::NUM_BINS; ++bin)
+        levels[static_cast<size_t>(bin)] = ltas.getLevelDb(bin);
+    
+    // Unknown references (or no audio yet) answer with the average alone
+    const auto comparison = referenceName.isNotEmpty() ? ltas.compare(referenceName) : LongTermSpectrum::Comparison();
+    
+    oscManager->sendLongTermSpectrum(logicTrackUUID.isNotEmpty() ? logicTrackUUID : tempInstanceID,
+                                     LongTermSpectrum::modeToString(ltas.getMode()),
+                                     static_cast<float>(ltas.getIntegratedSeconds()),
+                                     LongTermSpectrum::MIN_FREQUENCY, LongTermSpectrum::BINS_PER_OCTAVE,
+                                     levels.data(), LongTermSpectrum::NUM_BINS,
+                                     comparison.valid ? referenceName : juce::String(), comparison.rmsDeviationDb,
+                                     comparison.bandDeviationDb.data(), comparison.deviationDb.data(),
+                                     comparison.eqDb.data());
+}
 
+void AIplayerAudioProcessor::handlePitchConfig(bool enable, float minHz, float maxHz)
+{
+    auto& tracker = frequencyAnalyzer->getPitchTracker();
+    
+    if (minHz > 0.0f && maxHz > 0.0f)
+        tracker.setRange(minHz, maxHz);
+    
+    tracker.setEnabled(enable);
+    
+    logger->log(Logger::Level::Info, enable
+                ? "Pitch tracking on: " + juce::String(tracker.getMinFrequency(), 0) + "-"
+                  + juce::String(tracker.getMaxFrequency(), 0) + " Hz"
+                : juce::String("Pitch tracking off"));
+}
+
+void AIplayerAudioProcessor::handleDrumConfig(bool enable, float thresholdDb)
+{
+    if (thresholdDb < 0.0f)
+        drumHitAnalyzer->setThreshold(thresholdDb);
+    
+    drumHitAnalyzer->setEnabled(enable);
+    
+    logger->log(Logger::Level::Info, enable
+                ? "Drum hit analysis on: onset threshold " + juce::String(drumHitAnalyzer->getThreshold(), 1) + " dBFS"
+                : juce::String("Drum hit analysis off"));
+}
+
+void AIplayerAudioProcessor::handleInstancesQuery(const juce::String& queryID)
+{
+    // Any instance answers for the whole host, so the controller needs one query
+    std::vector<InstanceRegistry::Entry> entries(static_cast<size_t>(InstanceRegistry::MAX_INSTANCES));
+    const int count = InstanceRegistry::getInstance().getEntries(entries.data(), InstanceRegistry::MAX_INSTANCES);
+    
+    if (oscManager)
+        oscManager->sendInstances(queryID, entries.data(), count);
+    
+    logger->log(Logger::Level::Debug, "Answered instances query " + queryID + " with " + juce::String(count) + " instances");
+}
+
+void AIplayerAudioProcessor::updateRegistryConnection()
+{
+    InstanceRegistry::getInstance().setConnection(registrySlot, oscManager->getReceiverPort(), portManager->getStateString());
+}
+
+void AIplayerAudioProcessor::applyFocus()
+{
+    // Focused tracks get the full analysis and a fast stream; while anything
+    // is focused the rest step back to leave it the CPU and the OSC link
+    auto priority = AnalysisGovernor::Priority::Normal;
+    
+    if (!focusedTracks.isEmpty())
+    {
+        const bool focused = focusedTracks.contains(tempInstanceID)
+                          || (logicTrackUUID.isNotEmpty() && focusedTracks.contains(logicTrackUUID));
+        priority = focused ? AnalysisGovernor::Priority::Focused : AnalysisGovernor::Priority::Background;
+    }
+    
+    applyAnalysisPriority(priority);
+}
+
+void AIplayerAudioProcessor::applyAnalysisPriority(AnalysisGovernor::Priority priority)
+{
+    // Presets only: the governor moves between preallocated FFT sizes and the
+    // telemetry timer changes rate, so nothing on the analysis path reallocates
+    if (priority == analysisGovernor->getPriority())
+        return;
+    
+    analysisGovernor->setPriority(priority);
+    
+    if (telemetryService->isActive())
+        telemetryService->startTelemetry(AnalysisGovernor::getTelemetryRate(priority));
+}
 
 //==============================================================================
 // Timer callback for initialization retry
@@ -607,6 +1174,8 @@ void AIplayerAudioProcessor::timerCallback()
             {
                 portManager->requestPort(tempInstanceID, ephemeralPort);
             }
+            
+            updateRegistryConnection();
         }
         else
         {
@@ -10,12 +10,24 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "Core/Logger.h"
+#include "Core/InstanceRegistry.h"
 #include "Audio/AudioMetrics.h"
+#include "Audio/ChannelLayout.h"
 #include "Audio/CalibrationToneGenerator.h"
+#include "Audio/ChannelStrip.h"
+#include "Audio/Oversampler.h"
+#include "Audio/AutoLevelController.h"
+#include "Audio/SidechainProcessor.h"
+#include "Audio/LookaheadLimiter.h"
 #include "Audio/FrequencyAnalyzer.h"
+#include "Audio/AnalysisGovernor.h"
+#include "Audio/BeatTracker.h"
+#include "Audio/DrumHitAnalyzer.h"
 #include "Communication/OSCManager.h"
 #include "Communication/PortManager.h"
 #include "Communication/TelemetryService.h"
+#include "Communication/SpectrumStreamer.h"
+#include "Models/ChatHistory.h"
 
 namespace AIplayer {
 
@@ -78,6 +90,13 @@ public:
     AudioMetrics& getAudioMetrics() { return *audioMetrics; }
     CalibrationToneGenerator& getToneGenerator() { return *toneGenerator; }
     FrequencyAnalyzer& getFrequencyAnalyzer() { return *frequencyAnalyzer; }
+    FrequencyAnalyzer& getSidechainAnalyzer() { return *sidechainAnalyzer; }
+    AnalysisGovernor& getAnalysisGovernor() { return *analysisGovernor; }
+    const BeatTracker& getBeatTracker() const { return *beatTracker; }
+    DrumHitAnalyzer& getDrumHitAnalyzer() { return *drumHitAnalyzer; }
+    const SidechainProcessor& getSidechainProcessor() const { return *sidechainProcessor; }
+    const LookaheadLimiter& getLimiter() const { return *limiter; }
+    ChatHistory& getChatHistory() { return chatHistory; }
     
     // Plugin state
     juce::AudioProcessorValueTreeState apvts;
@@ -85,6 +104,11 @@ public:
     // Instance identification
     const juce::String& getTempInstanceID() const { return tempInstanceID; }
     const juce::String& getLogicTrackUUID() const { return logicTrackUUID; }
+    int getRegistrySlot() const { return registrySlot; }
+    
+    // Reports the latency last measured on the audio thread to the host
+    // (message thread; run by a timer, public so tests can run it directly)
+    void updateLatency();
 
 private:
     //==============================================================================
@@ -93,6 +117,25 @@ private:
     void setupOSCCommunication();
     void setupParameters();
     
+    // Reads the channel strip parameters into a settings snapshot
+    ChannelStrip::Settings getChannelStripSettings() const;
+    
+    // Plugin latency: oversampled section (filters plus strip lookahead) and limiter lookahead, in host samples
+    int getProcessingLatency(int oversamplingFactor) const;
+    
+    // Reads the sidechain ducking parameters into a settings snapshot
+    SidechainProcessor::Settings getSidechainSettings() const;
+    
+    // Reads the limiter parameters into a settings snapshot
+    LookaheadLimiter::Settings getLimiterSettings() const;
+    
+    // Moves this instance to the priority preset its focus implies (analysis tier ceiling, telemetry rate)
+    void applyFocus();
+    void applyAnalysisPriority(AnalysisGovernor::Priority priority);
+    
+    // Copies the bound port and port state to this instance's registry entry
+    void updateRegistryConnection();
+    
     // Parameter layout creation
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     
@@ -104,6 +147,18 @@ private:
     void handleRMSQuery(const juce::String& queryID) override;
     void handleToneControl(bool start, float frequency = 0.0f, float amplitude = 0.0f) override;
     void handleChatResponse(const juce::String& response) override;
+    void handleAutoLevelTarget(const juce::String& mode, float targetDb,
+                               float toleranceDb, float timeConstantMs) override;
+    void handleAnalysisPriority(const juce::String& priority) override;
+    void handleFocus(const juce::StringArray& focusedTrackIDs) override;
+    void handleSpectrumRequest(const juce::String& resolution, int bits, bool delta, float rateHz) override;
+    void handleLtasConfig(const juce::String& mode, float timeConstantSeconds) override;
+    void handleLtasReference(const juce::String& name, const juce::String& filePath,
+                             const juce::Array<float>& points) override;
+    void handleLtasQuery(const juce::String& referenceName) override;
+    void handlePitchConfig(bool enable, float minHz, float maxHz) override;
+    void handleDrumConfig(bool enable, float thresholdDb) override;
+    void handleInstancesQuery(const juce::String& queryID) override;
     
     //==============================================================================
     // Timer callback for initialization retry
@@ -114,17 +169,83 @@ private:
     std::unique_ptr<Logger> logger;
     std::unique_ptr<AudioMetrics> audioMetrics;
     std::unique_ptr<CalibrationToneGenerator> toneGenerator;
+    std::unique_ptr<Oversampler> oversampler;
+    std::array<std::unique_ptr<ChannelStrip>, Oversampler::NUM_FACTORS> channelStrips;   // One per factor
+    std::unique_ptr<AutoLevelController> autoLevel;
+    std::unique_ptr<SidechainProcessor> sidechainProcessor;
+    std::unique_ptr<LookaheadLimiter> limiter;
     std::unique_ptr<FrequencyAnalyzer> frequencyAnalyzer;
+    std::unique_ptr<FrequencyAnalyzer> sidechainAnalyzer;
+    std::unique_ptr<AnalysisGovernor> analysisGovernor;   // Adapts analysis quality to CPU load
+    std::unique_ptr<BeatTracker> beatTracker;             // Tempo when no host transport runs
+    std::unique_ptr<DrumHitAnalyzer> drumHitAnalyzer;     // Hit envelopes, off unless requested
     
     // Communication components
     std::unique_ptr<OSCManager> oscManager;
     std::unique_ptr<PortManager> portManager;
     std::unique_ptr<TelemetryService> telemetryService;
+    std::unique_ptr<SpectrumStreamer> spectrumStreamer;   // Spectrum on request only
+    
+    // Chat conversation (bounded, survives editor close/reopen)
+    ChatHistory chatHistory;
     
     // Plugin state
     std::atomic<float>* gainParameter{nullptr};
+    
+    struct ChannelStripParameters
+    {
+        std::atomic<float>* hpfEnabled{nullptr};
+        std::atomic<float>* hpfFrequency{nullptr};
+        std::atomic<float>* lpfEnabled{nullptr};
+        std::atomic<float>* lpfFrequency{nullptr};
+        std::atomic<float>* eqFrequency{nullptr};
+        std::atomic<float>* eqGain{nullptr};
+        std::atomic<float>* eqQ{nullptr};
+        std::atomic<float>* compThreshold{nullptr};
+        std::atomic<float>* compRatio{nullptr};
+        std::atomic<float>* compAttack{nullptr};
+        std::atomic<float>* compRelease{nullptr};
+        std::atomic<float>* compMakeup{nullptr};
+        std::atomic<float>* compLookahead{nullptr};
+    } stripParameters;
+    
+    struct DuckParameters
+    {
+        std::atomic<float>* enabled{nullptr};
+        std::atomic<float>* band{nullptr};
+        std::atomic<float>* threshold{nullptr};
+        std::atomic<float>* depth{nullptr};
+        std::atomic<float>* attack{nullptr};
+        std::atomic<float>* release{nullptr};
+    } duckParameters;
+    
+    struct LimiterParameters
+    {
+        std::atomic<float>* enabled{nullptr};
+        std::atomic<float>* ceiling{nullptr};
+        std::atomic<float>* release{nullptr};
+    } limiterParameters;
+    
+    // Oversampling factor index, switched on the audio thread
+    std::atomic<float>* oversamplingParameter{nullptr};
+    int activeOversampling{0};
+    
+    // Latency measured by processBlock(), reported to the host by updateLatency() (-1 until prepared)
+    static constexpr int LATENCY_UPDATE_MS = 100;
+    std::atomic<int> pendingLatency{-1};
+    juce::TimedCallback latencyTimer{[this] { updateLatency(); }};
+    
+    // Analysis downmix, applied on the audio thread when it changes
+    std::atomic<float>* downmixParameter{nullptr};
+    int appliedDownmix{-1};
+    juce::AudioChannelSet mainLayout;
+    
     juce::String tempInstanceID;
     juce::String logicTrackUUID;
+    int registrySlot{-1};   // Entry in the process-wide InstanceRegistry (-1 if it was full)
+    
+    // Tracks the producer is focusing on (empty = no focus); kept until the next /aiplayer/focus
+    juce::StringArray focusedTracks;
     
     // Initialization state
     bool componentsInitialized{false};
@@ -0,0 +1,357 @@
+/*
+  ==============================================================================
+
+    AnalysisGovernorTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the CPU-adaptive analysis governor: tier presets, the
+    degrade/recover policy per priority, and the allocation-free FFT size
+    and overlap switches it drives.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/AnalysisGovernor.h"
+#include "../Audio/AudioMetrics.h"
+#include "../Audio/FFTProcessor.h"
+#include "../Audio/FrequencyAnalyzer.h"
+#include "../Core/Constants.h"
+#include "../Core/Logger.h"
+#include "../PluginProcessor.h"
+
+namespace AIplayer {
+
+class AnalysisGovernorTests : public juce::UnitTest
+{
+public:
+    AnalysisGovernorTests() : UnitTest("Analysis Governor Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testTierPresets();
+        testDegradeAndRecover();
+        testPriorityOrder();
+        testBackgroundCeiling();
+        testFocusPresets();
+        testFocusCommand();
+        testTierApplied();
+        testFFTOrderSwitch();
+        testOverlap();
+    }
+
+private:
+    using Tier = AnalysisGovernor::Tier;
+    using Priority = AnalysisGovernor::Priority;
+
+    /// Analyzers, metering and logger for one governed instance
+    struct Instance
+    {
+        explicit Instance(Logger& logger)
+            : analyzer(logger, makeConfig(true)),
+              keyAnalyzer(logger, makeConfig(false)),
+              governor(analyzer, keyAnalyzer, metrics, logger)
+        {
+        }
+
+        static FrequencyAnalyzer::Config makeConfig(bool governed)
+        {
+            FrequencyAnalyzer::Config config;
+            config.autoStart = false;
+
+            if (governed)
+            {
+                config.minFftOrder = AnalysisGovernor::MIN_FFT_ORDER;
+                config.maxFftOrder = AnalysisGovernor::MAX_FFT_ORDER;
+            }
+
+            return config;
+        }
+
+        FrequencyAnalyzer analyzer;
+        FrequencyAnalyzer keyAnalyzer;
+        AudioMetrics metrics;
+        AnalysisGovernor governor;
+    };
+
+    static juce::File getLogFile()
+    {
+        juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("AIplayerTest");
+        tempDir.createDirectory();
+        return tempDir.getChildFile("governor.log");
+    }
+
+    /// One audio block, so the analyzer picks up a requested FFT size
+    static void feed(FrequencyAnalyzer& analyzer)
+    {
+        juce::AudioBuffer<float> buffer(1, 64);
+        buffer.clear();
+        analyzer.processBlock(buffer, 48000.0);
+    }
+
+    /// Runs evaluations at the timer's rate for the given time
+    static void run(AnalysisGovernor& governor, float pressure, double seconds)
+    {
+        const double step = 1.0 / AnalysisGovernor::EVALUATION_RATE_HZ;
+        for (double t = 0.0; t < seconds - 1.0e-9; t += step)
+            governor.update(pressure, step);
+    }
+
+    void testTierPresets()
+    {
+        beginTest("Tier presets rise monotonically and Standard keeps the previous analysis");
+
+        for (int i = 1; i < AnalysisGovernor::NUM_TIERS; ++i)
+        {
+            const auto& lower = AnalysisGovernor::getSettings(static_cast<Tier>(i - 1));
+            const auto& upper = AnalysisGovernor::getSettings(static_cast<Tier>(i));
+
+            expect(upper.fftOrder >= lower.fftOrder);
+            expect(upper.overlap >= lower.overlap);
+            expect(upper.updateRateHz > lower.updateRateHz);
+            expectEquals(upper.features & lower.features, lower.features, "a higher tier drops a feature");
+            expect(upper.fftOrder >= AnalysisGovernor::MIN_FFT_ORDER && upper.fftOrder <= AnalysisGovernor::MAX_FFT_ORDER);
+        }
+
+        const auto& standard = AnalysisGovernor::getSettings(Tier::Standard);
+        expectEquals(standard.fftOrder, 10);
+        expectEquals(standard.updateRateHz, 10);
+        expectEquals(standard.overlap, 0.0f);
+
+        expect(AnalysisGovernor::priorityFromString("focused") == Priority::Focused);
+        expect(AnalysisGovernor::priorityFromString("0") == Priority::Background);
+        expect(AnalysisGovernor::priorityFromString("bogus") == Priority::Normal);
+        expectEquals(AnalysisGovernor::priorityToString(Priority::Background), juce::String("background"));
+    }
+
+    void testDegradeAndRecover()
+    {
+        beginTest("Sustained pressure steps down one tier per hold; calm steps back up");
+
+        Logger logger(getLogFile());
+        Instance instance(logger);
+        auto& governor = instance.governor;
+
+        expect(governor.getTier() == Tier::Standard);
+
+        // Overload: one step per second, never below Minimal
+        run(governor, 1.5f, 0.5);
+        expect(governor.getTier() == Tier::Standard, "stepped down before the hold");
+
+        run(governor, 1.5f, 0.75);
+        expect(governor.getTier() == Tier::Reduced);
+
+        run(governor, 1.5f, 1.0);
+        expect(governor.getTier() == Tier::Minimal);
+
+        run(governor, 1.5f, 5.0);
+        expect(governor.getTier() == Tier::Minimal);
+
+        // Between recovery and threshold: hold
+        run(governor, 0.7f, 20.0);
+        expect(governor.getTier() == Tier::Minimal, "recovered while pressure was near the threshold");
+
+        // Calm: one step per five seconds, up to the Normal ceiling
+        run(governor, 0.1f, 4.75);
+        expect(governor.getTier() == Tier::Minimal);
+
+        run(governor, 0.1f, 0.5);
+        expect(governor.getTier() == Tier::Reduced);
+
+        run(governor, 0.1f, 20.0);
+        expect(governor.getTier() == Tier::Standard, "normal priority went past its ceiling");
+    }
+
+    void testPriorityOrder()
+    {
+        beginTest("Lower priorities shed load before focused ones");
+
+        Logger logger(getLogFile());
+        Instance focused(logger);
+        Instance normal(logger);
+        Instance background(logger);
+
+        focused.governor.setPriority(Priority::Focused);
+        background.governor.setPriority(Priority::Background);
+
+        // Moderate pressure: everyone but the focused track gives way
+        for (auto* instance : { &focused, &normal, &background })
+            run(instance->governor, 0.9f, 3.0);
+
+        expect(focused.governor.getTier() == Tier::Standard, "focused instance degraded");
+        expect(normal.governor.getTier() < Tier::Standard, "normal instance did not degrade");
+        expect(background.governor.getTier() == Tier::Minimal, "background instance did not degrade first");
+
+        // Promotion climbs at the next calm evaluation
+        normal.governor.setPriority(Priority::Focused);
+        const auto before = normal.governor.getTier();
+        run(normal.governor, 0.1f, 0.25);
+        expect(normal.governor.getTier() > before, "promoted instance waited a full hold");
+
+        // Only a focused instance reaches High
+        run(focused.governor, 0.1f, 6.0);
+        expect(focused.governor.getTier() == Tier::High);
+        feed(focused.analyzer);
+        expectEquals(focused.analyzer.getFFTSize(), 1 << AnalysisGovernor::getSettings(Tier::High).fftOrder);
+    }
+
+    void testBackgroundCeiling()
+    {
+        beginTest("Demotion drops to the priority's ceiling at the next evaluation");
+
+        Logger logger(getLogFile());
+        Instance instance(logger);
+        auto& governor = instance.governor;
+
+        const int changes = governor.getChangeCount();
+        governor.setPriority(Priority::Background);
+        expect(governor.getChangeCount() > changes);
+
+        run(governor, 0.0f, 0.25);
+        expect(governor.getTier() == Tier::Reduced);
+
+        run(governor, 0.0f, 60.0);
+        expect(governor.getTier() == Tier::Reduced, "background instance climbed past Reduced");
+    }
+
+    void testFocusPresets()
+    {
+        beginTest("Priority presets order telemetry rate and analysis ceiling");
+
+        const auto& background = AnalysisGovernor::getPreset(Priority::Background);
+        const auto& normal = AnalysisGovernor::getPreset(Priority::Normal);
+        const auto& focused = AnalysisGovernor::getPreset(Priority::Focused);
+
+        expectEquals(normal.telemetryRateHz, Constants::TELEMETRY_RATE_HZ);
+        expect(background.telemetryRateHz < normal.telemetryRateHz);
+        expect(focused.telemetryRateHz > normal.telemetryRateHz);
+
+        expect(background.maxTier < normal.maxTier && normal.maxTier < focused.maxTier);
+        expect(background.threshold < normal.threshold && normal.threshold < focused.threshold);
+    }
+
+    void testFocusCommand()
+    {
+        beginTest("Focus raises the named instance and lowers the rest");
+
+        AIplayerAudioProcessor processor;
+        auto& listener = static_cast<OSCManager::Listener&>(processor);
+        auto& governor = processor.getAnalysisGovernor();
+
+        listener.handleFocus({ processor.getTempInstanceID() });
+        expect(governor.getPriority() == Priority::Focused);
+
+        listener.handleFocus({ "another-track" });
+        expect(governor.getPriority() == Priority::Background);
+
+        // Demotion takes the analysis down to the background ceiling
+        governor.update(0.0f, 0.25);
+        expect(governor.getTier() == AnalysisGovernor::getMaxTier(Priority::Background));
+
+        listener.handleFocus({});
+        expect(governor.getPriority() == Priority::Normal);
+    }
+
+    void testTierApplied()
+    {
+        beginTest("Tiers switch FFT size, spectrum, key analysis and loudness");
+
+        Logger logger(getLogFile());
+        Instance instance(logger);
+        auto& governor = instance.governor;
+
+        expectEquals(instance.analyzer.getFFTSize(), 1024);
+        expect(instance.analyzer.isSpectrumEnabled());
+        expect(instance.metrics.isLoudnessEnabled());
+        expect(governor.isEnabled(AnalysisGovernor::KeyAnalysis));
+
+        run(governor, 2.0f, 2.5);
+        expect(governor.getTier() == Tier::Minimal);
+
+        const auto& minimal = AnalysisGovernor::getSettings(Tier::Minimal);
+        feed(instance.analyzer);
+        expectEquals(instance.analyzer.getFFTSize(), 1 << minimal.fftOrder);
+        expectEquals(instance.analyzer.getUpdateRate(), minimal.updateRateHz);
+        expect(! instance.analyzer.isSpectrumEnabled());
+        expect(! instance.metrics.isLoudnessEnabled());
+        expect(! governor.isEnabled(AnalysisGovernor::KeyAnalysis));
+
+        const auto status = governor.getStatus();
+        expect(status.tier == Tier::Minimal);
+        expectEquals(status.fftSize, 1 << minimal.fftOrder);
+        expectEquals(status.pressure, 2.0f);
+    }
+
+    void testFFTOrderSwitch()
+    {
+        beginTest("FFT size switches at the next block and restarts the window");
+
+        Logger logger(getLogFile());
+        FrequencyAnalyzer analyzer(logger, Instance::makeConfig(true));
+
+        const double sampleRate = 48000.0;
+        juce::AudioBuffer<float> buffer(1, 256);
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(0, i, std::sin(juce::MathConstants<float>::twoPi * 1000.0f * i / static_cast<float>(sampleRate)));
+
+        for (int block = 0; block < 8; ++block)
+            analyzer.processBlock(buffer, sampleRate);
+        expect(analyzer.computeNow());
+
+        // Requested orders are clamped to the configured range
+        analyzer.setFFTOrder(20);
+        expectEquals(analyzer.getFFTSize(), 1024, "switched before the audio thread picked it up");
+
+        analyzer.processBlock(buffer, sampleRate);
+        expectEquals(analyzer.getFFTSize(), 1 << AnalysisGovernor::MAX_FFT_ORDER);
+
+        // The new window has to fill with fresh audio before a frame
+        expect(! analyzer.computeNow(), "frame computed from a partly empty window");
+
+        for (int block = 1; block < (1 << AnalysisGovernor::MAX_FFT_ORDER) / buffer.getNumSamples(); ++block)
+            analyzer.processBlock(buffer, sampleRate);
+        expect(analyzer.computeNow());
+        const auto energies = analyzer.getBandEnergies();
+        expect(*std::max_element(energies.begin(), energies.end()) > -100.0f, "no energy after the switch");
+    }
+
+    void testOverlap()
+    {
+        beginTest("Overlap sets the hop between frames");
+
+        FFTProcessor processor(9);
+        const int fftSize = processor.getFFTSize();
+        expectEquals(processor.getHopSize(), fftSize);
+
+        juce::AudioBuffer<float> buffer(1, fftSize / 4);
+        buffer.clear();
+
+        const auto countFrames = [&](int numBlocks)
+        {
+            int frames = 0;
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                processor.processAudioBlock(buffer, 48000.0);
+                if (processor.computeFFT())
+                    ++frames;
+            }
+            return frames;
+        };
+
+        // No overlap: one frame per window of new samples
+        expectEquals(countFrames(16), 4);
+
+        // Half overlap: one frame per half window
+        processor.setHopSize(fftSize / 2);
+        expectEquals(countFrames(16), 8);
+
+        processor.setHopSize(0);
+        expectEquals(processor.getHopSize(), 1);
+    }
+};
+
+static AnalysisGovernorTests analysisGovernorTests;
+
+} // namespace AIplayer
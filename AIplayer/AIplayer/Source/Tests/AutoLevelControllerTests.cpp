@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    AutoLevelControllerTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the loudness meter and in-plugin auto-leveling.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/AutoLevelController.h"
+
+namespace AIplayer {
+
+class AutoLevelControllerTests : public juce::UnitTest
+{
+public:
+    AutoLevelControllerTests() : UnitTest("Auto Level Controller Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testKWeightingCoefficients();
+        testLoudnessCalibration();
+        testConvergesToRmsTarget();
+        testConvergesToLufsTarget();
+        testSilenceIsNotBoosted();
+        testReleaseToUnity();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 480;
+
+    /// Streams a sine through the controller and returns the output RMS of the last block (dB)
+    static float runSine(AutoLevelController& controller, int numChannels, float amplitude, double seconds)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        const int numBlocks = static_cast<int>(seconds * sampleRate) / blockSize;
+        double phase = 0.0;
+        const double increment = juce::MathConstants<double>::twoPi * 997.0 / sampleRate;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const float sample = amplitude * static_cast<float>(std::sin(phase));
+                phase += increment;
+                for (int channel = 0; channel < numChannels; ++channel)
+                    buffer.setSample(channel, i, sample);
+            }
+
+            controller.process(buffer);
+        }
+
+        return juce::Decibels::gainToDecibels(buffer.getRMSLevel(0, 0, blockSize));
+    }
+
+    void testKWeightingCoefficients()
+    {
+        beginTest("K-weighting matches the BS.1770 48 kHz coefficients");
+
+        // ITU-R BS.1770-4, Tables 1 and 2
+        const auto shelf = LoudnessMeter::kWeighting(48000.0, 0);
+        expectWithinAbsoluteError(shelf.b0, 1.53512485958697f, 1.0e-5f);
+        expectWithinAbsoluteError(shelf.b1, -2.69169618940638f, 1.0e-5f);
+        expectWithinAbsoluteError(shelf.b2, 1.19839281085285f, 1.0e-5f);
+        expectWithinAbsoluteError(shelf.a1, -1.69065929318241f, 1.0e-5f);
+        expectWithinAbsoluteError(shelf.a2, 0.73248077421585f, 1.0e-5f);
+
+        const auto highPass = LoudnessMeter::kWeighting(48000.0, 1);
+        expectWithinAbsoluteError(highPass.b0, 1.0f, 1.0e-5f);
+        expectWithinAbsoluteError(highPass.b1, -2.0f, 1.0e-5f);
+        expectWithinAbsoluteError(highPass.b2, 1.0f, 1.0e-5f);
+        expectWithinAbsoluteError(highPass.a1, -1.99004745483398f, 1.0e-5f);
+        expectWithinAbsoluteError(highPass.a2, 0.99007225036621f, 1.0e-5f);
+    }
+
+    void testLoudnessCalibration()
+    {
+        beginTest("K-weighted loudness of a 997 Hz sine");
+
+        // BS.1770: a 0 dBFS 997 Hz sine in one channel reads -3.01 LUFS
+        LoudnessMeter meter;
+        meter.prepare(sampleRate, blockSize, 1);
+
+        juce::AudioBuffer<float> buffer(1, blockSize);
+        double phase = 0.0;
+        for (int block = 0; block < 100; ++block)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                buffer.setSample(0, i, 0.1f * static_cast<float>(std::sin(phase)));
+                phase += juce::MathConstants<double>::twoPi * 997.0 / sampleRate;
+            }
+            meter.process(buffer, 0, blockSize);
+        }
+
+        logMessage("-20 dBFS sine: " + juce::String(meter.getMomentaryLufs(), 3) + " LUFS, "
+                   + juce::String(meter.getMomentaryRmsDb(), 3) + " dB RMS");
+
+        expectWithinAbsoluteError(meter.getMomentaryLufs(), -23.01f, 0.1f);
+        expectWithinAbsoluteError(meter.getMomentaryRmsDb(), -23.01f, 0.05f);
+    }
+
+    void testConvergesToRmsTarget()
+    {
+        beginTest("Converges to an RMS target");
+
+        AutoLevelController controller;
+        controller.prepare(sampleRate, blockSize, 2);
+        controller.setTarget({ AutoLevelController::Mode::Rms, -18.0f, 0.5f, 300.0f });
+
+        // -30 dB RMS input needs +12 dB
+        const float outputDb = runSine(controller, 2, juce::Decibels::decibelsToGain(-27.0f), 5.0);
+        const auto status = controller.getStatus();
+
+        logMessage("Output " + juce::String(outputDb, 2) + " dB RMS, gain " + juce::String(status.gainDb, 2) + " dB");
+
+        expectWithinAbsoluteError(outputDb, -18.0f, 0.5f);
+        expect(status.converged);
+    }
+
+    void testConvergesToLufsTarget()
+    {
+        beginTest("Converges to a LUFS target");
+
+        AutoLevelController controller;
+        controller.prepare(sampleRate, blockSize, 2);
+        controller.setTarget({ AutoLevelController::Mode::Lufs, -14.0f, 0.5f, 300.0f });
+
+        runSine(controller, 2, 0.05f, 5.0);
+        const auto status = controller.getStatus();
+
+        expectWithinAbsoluteError(status.measuredDb, -14.0f, 0.5f);
+        expect(status.converged);
+    }
+
+    void testSilenceIsNotBoosted()
+    {
+        beginTest("Silence below the gate holds the gain");
+
+        AutoLevelController controller;
+        controller.prepare(sampleRate, blockSize, 1);
+        controller.setTarget({ AutoLevelController::Mode::Rms, -18.0f, 0.5f, 100.0f });
+
+        runSine(controller, 1, 0.0f, 2.0);
+        expectEquals(controller.getStatus().gainDb, 0.0f);
+    }
+
+    void testReleaseToUnity()
+    {
+        beginTest("Switching off glides back to unity and bypasses");
+
+        AutoLevelController controller;
+        controller.prepare(sampleRate, blockSize, 1);
+        controller.setTarget({ AutoLevelController::Mode::Rms, -12.0f, 0.5f, 100.0f });
+        runSine(controller, 1, 0.1f, 2.0);
+        expect(controller.getStatus().gainDb > 5.0f);
+
+        controller.setTarget({ AutoLevelController::Mode::Off, -12.0f, 0.5f, 100.0f });
+        const float outputDb = runSine(controller, 1, 0.1f, 2.0);
+
+        expectWithinAbsoluteError(outputDb, -23.01f, 0.01f);
+    }
+};
+
+static AutoLevelControllerTests autoLevelControllerTests;
+
+} // namespace AIplayer
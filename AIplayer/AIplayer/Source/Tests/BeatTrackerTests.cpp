@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    BeatTrackerTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the streaming beat tracker: tempo, phase, block-size
+    independence and the host transport override.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/BeatTracker.h"
+
+namespace AIplayer {
+
+class BeatTrackerTests : public juce::UnitTest
+{
+public:
+    BeatTrackerTests() : UnitTest("Beat Tracker Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testTempo();
+        testBlockSizeIndependence();
+        testPhase();
+        testWarmupAndNoise();
+        testHostTransport();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+
+    /// Kick-like hit: a decaying 60 Hz burst
+    static float kick(double seconds)
+    {
+        if (seconds < 0.0 || seconds > 0.05)
+            return 0.0f;
+
+        return static_cast<float>(0.8 * std::exp(-seconds * 60.0) * std::sin(juce::MathConstants<double>::twoPi * 60.0 * seconds));
+    }
+
+    /// Feeds a stereo kick pattern (first beat at offsetSeconds) and returns the audio time fed
+    static double feedBeats(BeatTracker& tracker, double bpm, double seconds, int blockSize, double offsetSeconds = 0.1)
+    {
+        const double beat = 60.0 / bpm;
+        const auto total = static_cast<juce::int64>(seconds * sampleRate);
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        juce::int64 position = 0;
+        while (position < total)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const double time = static_cast<double>(position + i) / sampleRate - offsetSeconds;
+                const float sample = time < 0.0 ? 0.0f : kick(std::fmod(time, beat));
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample);
+            }
+
+            tracker.process(buffer);
+            position += blockSize;
+        }
+
+        return static_cast<double>(position) / sampleRate;
+    }
+
+    void testTempo()
+    {
+        beginTest("Tempo of a steady beat");
+
+        for (const double bpm : { 90.0, 100.0, 120.0, 128.0, 140.0 })
+        {
+            BeatTracker tracker;
+            tracker.prepare(sampleRate);
+            feedBeats(tracker, bpm, 15.0, 512);
+
+            const auto status = tracker.getStatus();
+            expect(status.source == BeatTracker::Source::Audio);
+            expectWithinAbsoluteError(static_cast<double>(status.bpm), bpm, 0.5, juce::String(bpm) + " BPM");
+            expectGreaterThan(status.confidence, 0.6f);
+        }
+    }
+
+    void testBlockSizeIndependence()
+    {
+        beginTest("Results do not depend on the host block size");
+
+        BeatTracker small, large;
+        small.prepare(sampleRate);
+        large.prepare(sampleRate);
+
+        // Both end on the same hop boundary
+        feedBeats(small, 120.0, 12.0, 60);
+        feedBeats(large, 120.0, 12.0, 960);
+
+        expectEquals(small.getStatus().bpm, large.getStatus().bpm);
+        expectWithinAbsoluteError(small.getStatus().phase, large.getStatus().phase, 1.0e-4f);
+    }
+
+    void testPhase()
+    {
+        beginTest("Beat phase follows the beats");
+
+        for (const double bpm : { 120.0, 133.0 })
+        {
+            BeatTracker tracker;
+            tracker.prepare(sampleRate);
+
+            // Blocks of whole hops, so the last hop ends with the audio
+            const double offset = 0.123;
+            const double end = feedBeats(tracker, bpm, 20.0, 480, offset);
+
+            const double beats = (end - offset) * bpm / 60.0;
+            const double expected = beats - std::floor(beats);
+
+            double error = std::abs(tracker.getStatus().phase - expected);
+            error = juce::jmin(error, 1.0 - error);
+            expectLessThan(error, 0.04, juce::String(bpm) + " BPM");
+        }
+    }
+
+    void testWarmupAndNoise()
+    {
+        beginTest("No tempo before warm-up; little confidence in noise");
+
+        BeatTracker tracker;
+        tracker.prepare(sampleRate);
+        feedBeats(tracker, 120.0, BeatTracker::WARMUP_SECONDS * 0.5, 512);
+        expect(tracker.getStatus().source == BeatTracker::Source::None);
+        expectEquals(tracker.getStatus().bpm, 0.0f);
+
+        tracker.reset();
+        juce::Random random(3);
+        juce::AudioBuffer<float> buffer(1, 480);
+
+        for (int block = 0; block < 1500; ++block)
+        {
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(0, i, 0.4f * (random.nextFloat() - 0.5f));
+            tracker.process(buffer);
+        }
+
+        expectLessThan(tracker.getStatus().confidence, 0.3f);
+    }
+
+    void testHostTransport()
+    {
+        beginTest("A playing host transport takes over");
+
+        BeatTracker tracker;
+        tracker.prepare(sampleRate);
+        feedBeats(tracker, 100.0, 10.0, 512);
+
+        juce::AudioBuffer<float> buffer(2, 512);
+        buffer.clear();
+
+        tracker.setHostTransport(97.0, 16.25, true);
+        tracker.process(buffer);
+
+        auto status = tracker.getStatus();
+        expect(status.source == BeatTracker::Source::Host);
+        expectEquals(status.bpm, 97.0f);
+        expectWithinAbsoluteError(status.phase, 0.25f, 1.0e-6f);
+        expectEquals(BeatTracker::sourceToString(status.source), juce::String("host"));
+
+        // A stopped transport hands back to the estimate
+        tracker.setHostTransport(97.0, 16.25, false);
+        tracker.process(buffer);
+
+        status = tracker.getStatus();
+        expect(status.source == BeatTracker::Source::Audio);
+        expectWithinAbsoluteError(status.bpm, 100.0f, 0.5f);
+    }
+};
+
+static BeatTrackerTests beatTrackerTests;
+
+} // namespace AIplayer
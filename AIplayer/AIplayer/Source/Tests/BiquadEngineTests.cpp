@@ -0,0 +1,238 @@
+/*
+  ==============================================================================
+
+    BiquadEngineTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Accuracy tests and juce::dsp::IIR::Filter comparison for BiquadEngine.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/BiquadEngine.h"
+
+namespace AIplayer {
+
+class BiquadEngineTests : public juce::UnitTest
+{
+public:
+    BiquadEngineTests() : UnitTest("Biquad Engine Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testMatchesJuceFilter();
+        testCoefficientRamp();
+        testDenormalFlush();
+        testBenchmarkAgainstJuce();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+
+    /// A cascade mixing the shapes used in the plugin
+    static BiquadCoefficients sectionCoefficients(int section)
+    {
+        switch (section % 4)
+        {
+            case 0:  return BiquadDesign::highPass(sampleRate, 40.0 + 10.0 * section);
+            case 1:  return BiquadDesign::peak(sampleRate, 250.0 * (section + 1), 2.0, -4.0);
+            case 2:  return BiquadDesign::highShelf(sampleRate, 1681.97, 4.0);
+            default: return BiquadDesign::lowPass(sampleRate, 16000.0 - 500.0 * section);
+        }
+    }
+
+    static juce::dsp::IIR::Coefficients<float>::Ptr toJuce(const BiquadCoefficients& c)
+    {
+        return new juce::dsp::IIR::Coefficients<float>(c.b0, c.b1, c.b2, 1.0f, c.a1, c.a2);
+    }
+
+    static void fillNoise(juce::AudioBuffer<float>& buffer, juce::Random& random)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    void testMatchesJuceFilter()
+    {
+        beginTest("Output matches juce::dsp::IIR::Filter");
+
+        constexpr int numChannels = 6;    // Spans more than one SIMD group on SSE/NEON
+        constexpr int numSections = 4;
+
+        BiquadEngine engine;
+        engine.prepare(numChannels, numSections, blockSize);
+        engine.setNumSections(numSections);
+
+        std::vector<juce::dsp::IIR::Filter<float>> reference(numChannels * numSections);
+        for (int section = 0; section < numSections; ++section)
+        {
+            engine.setCoefficients(section, sectionCoefficients(section));
+            for (int channel = 0; channel < numChannels; ++channel)
+                reference[static_cast<size_t>(channel * numSections + section)].coefficients = toJuce(sectionCoefficients(section));
+        }
+
+        juce::Random random(1);
+        juce::AudioBuffer<float> buffer(numChannels, blockSize), expected(numChannels, blockSize);
+
+        float maxError = 0.0f;
+        for (int block = 0; block < 20; ++block)
+        {
+            fillNoise(buffer, random);
+            expected.makeCopyOf(buffer);
+
+            engine.process(buffer);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int section = 0; section < numSections; ++section)
+                {
+                    auto& filter = reference[static_cast<size_t>(channel * numSections + section)];
+                    auto* data = expected.getWritePointer(channel);
+                    for (int i = 0; i < blockSize; ++i)
+                        data[i] = filter.processSample(data[i]);
+                }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    maxError = juce::jmax(maxError, std::abs(buffer.getSample(channel, i) - expected.getSample(channel, i)));
+        }
+
+        logMessage("Max deviation from IIR::Filter: " + juce::String(maxError, 8));
+        expect(maxError < 1.0e-4f);
+    }
+
+    void testCoefficientRamp()
+    {
+        beginTest("Coefficient ramp reaches its target exactly");
+
+        BiquadEngine engine;
+        engine.prepare(2, 1, blockSize);
+        engine.setNumSections(1);
+        engine.setCoefficients(0, BiquadDesign::peak(sampleRate, 250.0, 2.0, 0.0));
+
+        // Glide to +12 dB over 1000 samples, then compare with an engine set directly
+        const auto target = BiquadDesign::peak(sampleRate, 250.0, 2.0, 12.0);
+        engine.setCoefficients(0, target, 1000);
+
+        BiquadEngine direct;
+        direct.prepare(2, 1, blockSize);
+        direct.setNumSections(1);
+        direct.setCoefficients(0, target);
+
+        juce::AudioBuffer<float> buffer(2, blockSize), check(2, blockSize);
+        buffer.clear();
+
+        // Let the ramp complete on silence, then feed the same signal to both
+        for (int block = 0; block < 3; ++block)
+            engine.process(buffer);
+
+        juce::Random random(2);
+        fillNoise(buffer, random);
+        check.makeCopyOf(buffer);
+        engine.process(buffer);
+        direct.process(check);
+
+        for (int i = 0; i < blockSize; ++i)
+            expectEquals(buffer.getSample(1, i), check.getSample(1, i));
+    }
+
+    void testDenormalFlush()
+    {
+        beginTest("State decays to exact zero");
+
+        BiquadEngine engine;
+        engine.prepare(1, 1, blockSize);
+        engine.setNumSections(1);
+        engine.setCoefficients(0, BiquadDesign::lowPass(sampleRate, 20.0));
+
+        juce::AudioBuffer<float> buffer(1, blockSize);
+        buffer.clear();
+        buffer.setSample(0, 0, 1.0f);
+        engine.process(buffer);
+
+        buffer.clear();
+        for (int block = 0; block < 2000; ++block)
+            engine.process(buffer);
+
+        expectEquals(buffer.getSample(0, blockSize - 1), 0.0f);
+    }
+
+    void testBenchmarkAgainstJuce()
+    {
+        beginTest("Benchmark vs juce::dsp::IIR::Filter (1-8 channels x 1-10 sections)");
+
+        constexpr int numBlocks = 400;    // ~4.3 s of audio at 48 kHz
+        juce::Random random(3);
+
+        logMessage("channels sections   engine ms   juce ms   speedup   max deviation");
+
+        // Timings are logged only; the assertion is that both paths agree on the benchmarked data
+        float worstError = 0.0f;
+
+        for (const int numChannels : { 1, 2, 4, 6, 8 })
+        {
+            for (const int numSections : { 1, 2, 4, 6, 10 })
+            {
+                juce::AudioBuffer<float> input(numChannels, blockSize);
+                juce::AudioBuffer<float> engineOutput(numChannels, blockSize), juceOutput(numChannels, blockSize);
+                fillNoise(input, random);
+
+                BiquadEngine engine;
+                engine.prepare(numChannels, numSections, blockSize);
+                engine.setNumSections(numSections);
+                for (int section = 0; section < numSections; ++section)
+                    engine.setCoefficients(section, sectionCoefficients(section));
+
+                auto start = juce::Time::getMillisecondCounterHiRes();
+                for (int block = 0; block < numBlocks; ++block)
+                {
+                    engineOutput.makeCopyOf(input);
+                    engine.process(engineOutput);
+                }
+                const double engineMs = juce::Time::getMillisecondCounterHiRes() - start;
+
+                std::vector<juce::dsp::IIR::Filter<float>> filters(static_cast<size_t>(numChannels * numSections));
+                for (size_t i = 0; i < filters.size(); ++i)
+                    filters[i].coefficients = toJuce(sectionCoefficients(static_cast<int>(i) % numSections));
+
+                start = juce::Time::getMillisecondCounterHiRes();
+                for (int block = 0; block < numBlocks; ++block)
+                {
+                    juceOutput.makeCopyOf(input);
+
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        float* data = juceOutput.getWritePointer(channel);
+                        juce::dsp::AudioBlock<float> channelBlock(&data, 1, static_cast<size_t>(blockSize));
+                        juce::dsp::ProcessContextReplacing<float> context(channelBlock);
+
+                        for (int section = 0; section < numSections; ++section)
+                            filters[static_cast<size_t>(channel * numSections + section)].process(context);
+                    }
+                }
+                const double juceMs = juce::Time::getMillisecondCounterHiRes() - start;
+
+                // Both filters have run the same input sequence, so their last blocks must agree
+                float maxError = 0.0f;
+                for (int channel = 0; channel < numChannels; ++channel)
+                    for (int i = 0; i < blockSize; ++i)
+                        maxError = juce::jmax(maxError, std::abs(engineOutput.getSample(channel, i) - juceOutput.getSample(channel, i)));
+                worstError = juce::jmax(worstError, maxError);
+
+                logMessage(juce::String(numChannels).paddedLeft(' ', 8) + juce::String(numSections).paddedLeft(' ', 9)
+                           + juce::String(engineMs, 2).paddedLeft(' ', 12) + juce::String(juceMs, 2).paddedLeft(' ', 10)
+                           + juce::String(juceMs / juce::jmax(0.001, engineMs), 2).paddedLeft(' ', 10) + "x"
+                           + juce::String(maxError, 8).paddedLeft(' ', 16));
+            }
+        }
+
+        expect(worstError < 1.0e-3f, "Engine deviates from IIR::Filter by " + juce::String(worstError, 8));
+    }
+};
+
+static BiquadEngineTests biquadEngineTests;
+
+} // namespace AIplayer
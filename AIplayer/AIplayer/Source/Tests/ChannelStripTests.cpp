@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+    ChannelStripTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Behaviour and per-stage performance tests for the channel strip.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/ChannelStrip.h"
+
+namespace AIplayer {
+
+class ChannelStripTests : public juce::UnitTest
+{
+public:
+    ChannelStripTests() : UnitTest("Channel Strip Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testFlatIsTransparent();
+        testHighPass();
+        testBellEQ();
+        testCompressor();
+        testLookaheadLatency();
+        testStageBenchmarks();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+
+    static void fillSine(juce::AudioBuffer<float>& buffer, float frequency, float amplitude)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(channel, i, amplitude * std::sin(juce::MathConstants<float>::twoPi
+                                                                  * frequency * static_cast<float>(i / sampleRate)));
+    }
+
+    /// Runs a sine through the strip block by block and returns the RMS of the second half
+    static float processSineRms(ChannelStrip& strip, float frequency, float amplitude)
+    {
+        juce::AudioBuffer<float> signal(2, static_cast<int>(sampleRate));
+        fillSine(signal, frequency, amplitude);
+
+        for (int start = 0; start < signal.getNumSamples(); start += blockSize)
+        {
+            const int num = juce::jmin(blockSize, signal.getNumSamples() - start);
+            juce::AudioBuffer<float> block(signal.getArrayOfWritePointers(), 2, start, num);
+            strip.process(block);
+        }
+
+        const int half = signal.getNumSamples() / 2;
+        return signal.getRMSLevel(0, half, half);
+    }
+
+    void testFlatIsTransparent()
+    {
+        beginTest("Flat settings leave audio untouched");
+
+        ChannelStrip strip;
+        strip.prepare(sampleRate, blockSize, 2);
+
+        expect(!strip.isFilterStageActive());
+        expect(!strip.isCompressorActive());
+        expectEquals(strip.getLatencySamples(), 0);
+
+        juce::AudioBuffer<float> buffer(2, blockSize), reference(2, blockSize);
+        fillSine(buffer, 1000.0f, 0.5f);
+        reference.makeCopyOf(buffer);
+
+        strip.process(buffer);
+
+        for (int i = 0; i < blockSize; ++i)
+            expectEquals(buffer.getSample(0, i), reference.getSample(0, i));
+    }
+
+    void testHighPass()
+    {
+        beginTest("HPF attenuates below cutoff");
+
+        ChannelStrip strip;
+        strip.prepare(sampleRate, blockSize, 2);
+
+        ChannelStrip::Settings settings;
+        settings.hpfEnabled = true;
+        settings.hpfFrequency = 200.0f;
+        strip.setSettings(settings);
+
+        const float lowRms = processSineRms(strip, 30.0f, 0.5f);
+        strip.reset();
+        const float highRms = processSineRms(strip, 2000.0f, 0.5f);
+
+        const float inputRms = 0.5f / std::sqrt(2.0f);
+        logMessage("HPF 200 Hz: 30 Hz at " + juce::String(juce::Decibels::gainToDecibels(lowRms / inputRms), 1)
+                   + " dB, 2 kHz at " + juce::String(juce::Decibels::gainToDecibels(highRms / inputRms), 2) + " dB");
+
+        expect(lowRms < inputRms * 0.05f, "30 Hz should be attenuated by more than 26 dB");
+        expectWithinAbsoluteError(highRms, inputRms, inputRms * 0.02f);
+    }
+
+    void testBellEQ()
+    {
+        beginTest("Bell EQ boosts at centre frequency");
+
+        ChannelStrip strip;
+        strip.prepare(sampleRate, blockSize, 2);
+
+        ChannelStrip::Settings settings;
+        settings.eqFrequency = 250.0f;
+        settings.eqQ = 2.0f;
+        settings.eqGainDb = 6.0f;
+        strip.setSettings(settings);
+
+        const float inputRms = 0.25f / std::sqrt(2.0f);
+        const float gainDb = juce::Decibels::gainToDecibels(processSineRms(strip, 250.0f, 0.25f) / inputRms);
+
+        expectWithinAbsoluteError(gainDb, 6.0f, 0.1f);
+    }
+
+    void testCompressor()
+    {
+        beginTest("Compressor applies static curve above threshold");
+
+        ChannelStrip strip;
+        strip.prepare(sampleRate, blockSize, 2);
+
+        ChannelStrip::Settings settings;
+        settings.compThresholdDb = -20.0f;
+        settings.compRatio = 4.0f;
+        settings.compAttackMs = 1.0f;
+        settings.compReleaseMs = 50.0f;
+        strip.setSettings(settings);
+
+        // 0 dBFS peak sine, 20 dB over threshold -> 15 dB reduction at 4:1
+        processSineRms(strip, 1000.0f, 1.0f);
+        const float reduction = strip.getGainReductionDb();
+
+        logMessage("Gain reduction: " + juce::String(reduction, 2) + " dB");
+        expect(reduction < -13.0f && reduction > -16.0f, "Expected about 15 dB of gain reduction");
+    }
+
+    void testLookaheadLatency()
+    {
+        beginTest("Lookahead reports and applies its latency");
+
+        ChannelStrip strip;
+        strip.prepare(sampleRate, blockSize, 1);
+
+        ChannelStrip::Settings settings;
+        settings.compLookaheadMs = 5.0f;
+        strip.setSettings(settings);
+
+        const int expectedLatency = juce::roundToInt(0.005 * sampleRate);
+        expectEquals(strip.getLatencySamples(), expectedLatency);
+
+        juce::AudioBuffer<float> buffer(1, blockSize);
+        buffer.clear();
+        buffer.setSample(0, 0, 1.0f);
+        strip.process(buffer);
+
+        expectEquals(buffer.getSample(0, expectedLatency), 1.0f);
+        expectEquals(buffer.getSample(0, 0), 0.0f);
+    }
+
+    /// Times one stage in isolation on 10 seconds of stereo noise
+    double benchmarkStage(const ChannelStrip::Settings& settings)
+    {
+        ChannelStrip strip;
+        strip.prepare(sampleRate, blockSize, 2);
+        strip.setSettings(settings);
+
+        juce::Random random(42);
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        const int numBlocks = static_cast<int>(10.0 * sampleRate) / blockSize;
+
+        double elapsed = 0.0;
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+            const auto start = juce::Time::getMillisecondCounterHiRes();
+            strip.process(buffer);
+            elapsed += juce::Time::getMillisecondCounterHiRes() - start;
+        }
+
+        return elapsed;
+    }
+
+    void testStageBenchmarks()
+    {
+        beginTest("Per-stage benchmark (10 s stereo @ 48 kHz)");
+
+        ChannelStrip::Settings flat, hpf, eq, lpf, allFilters, comp, compLookahead;
+        hpf.hpfEnabled = true;
+        eq.eqGainDb = -4.0f;
+        lpf.lpfEnabled = true;
+        allFilters.hpfEnabled = allFilters.lpfEnabled = true;
+        allFilters.eqGainDb = -4.0f;
+        comp.compThresholdDb = -18.0f;
+        comp.compRatio = 4.0f;
+        compLookahead = comp;
+        compLookahead.compLookaheadMs = 5.0f;
+
+        const std::pair<const char*, const ChannelStrip::Settings*> stages[] = {
+            { "Bypassed (flat)", &flat }, { "HPF", &hpf }, { "Bell EQ", &eq }, { "LPF", &lpf },
+            { "HPF + EQ + LPF", &allFilters }, { "Compressor", &comp }, { "Compressor + lookahead", &compLookahead }
+        };
+
+        for (const auto& [name, settings] : stages)
+        {
+            const double ms = benchmarkStage(*settings);
+            logMessage(juce::String(name).paddedRight(' ', 24) + juce::String(ms, 2) + " ms ("
+                       + juce::String(10000.0 / juce::jmax(0.001, ms), 0) + "x realtime)");
+
+            expect(ms < 1000.0, juce::String(name) + " should run faster than realtime");
+        }
+    }
+};
+
+static ChannelStripTests channelStripTests;
+
+} // namespace AIplayer
@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+    DrumHitAnalyzerTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the drum hit analysis: onsets, attack and decay times, band
+    balance, hit-to-hit statistics and the OSC switch.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/DrumHitAnalyzer.h"
+#include "../PluginProcessor.h"
+
+namespace AIplayer {
+
+class DrumHitAnalyzerTests : public juce::UnitTest
+{
+public:
+    DrumHitAnalyzerTests() : UnitTest("Drum Hit Analyzer Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testKick();
+        testAttack();
+        testBalance();
+        testConsistency();
+        testDenseHits();
+        testEnableAndSustain();
+        testDrumConfigCommand();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+
+    using Hit = std::function<float(double seconds, int hit)>;
+
+    /// Feeds stereo hits every `interval` seconds (first at 50 ms) and returns the report
+    static DrumHitAnalyzer::Report feedHits(DrumHitAnalyzer& analyzer, const Hit& hit, double interval,
+                                            double seconds, int blockSize = 512)
+    {
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        const auto total = static_cast<juce::int64>(seconds * sampleRate);
+
+        for (juce::int64 position = 0; position < total; position += blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const double time = static_cast<double>(position + i) / sampleRate - 0.05;
+                const float sample = time < 0.0 ? 0.0f : hit(std::fmod(time, interval), static_cast<int>(time / interval));
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample);
+            }
+
+            analyzer.process(buffer);
+        }
+
+        DrumHitAnalyzer::Report report;
+        analyzer.getReport(report);
+        return report;
+    }
+
+    /// Decaying sine burst; the energy time constant is half the amplitude's
+    static float burst(double seconds, double frequency, double amplitude, double timeConstant)
+    {
+        return static_cast<float>(amplitude * std::sin(juce::MathConstants<double>::twoPi * frequency * seconds)
+                                  * std::exp(-seconds / timeConstant));
+    }
+
+    /// T60 of an exponential decay with this amplitude time constant
+    static double t60(double timeConstant) { return timeConstant * std::log(1000.0) * 1000.0; }
+
+    void testKick()
+    {
+        beginTest("Kick hits: peak, decay, balance and interval");
+
+        DrumHitAnalyzer analyzer;
+        analyzer.prepare(sampleRate);
+        analyzer.setEnabled(true);
+
+        const auto report = feedHits(analyzer, [](double t, int) { return burst(t, 60.0, 0.8, 0.05); }, 0.5, 8.05);
+
+        // The last hit is still being captured
+        expectEquals(report.hits, 16);
+        expectEquals(report.counts[DrumHitAnalyzer::IntervalMs], 15);
+
+        const auto& statistics = report.statistics;
+        expectWithinAbsoluteError(statistics[DrumHitAnalyzer::IntervalMs].mean, 500.0f, 0.5f);
+        expectWithinAbsoluteError(static_cast<double>(statistics[DrumHitAnalyzer::DecayMs].mean), t60(0.05), t60(0.05) * 0.05);
+        expectGreaterThan(statistics[DrumHitAnalyzer::BalanceDb].mean, 6.0f);
+        expectLessThan(statistics[DrumHitAnalyzer::AttackMs].mean, 5.0f);
+
+        // Identical hits
+        expectLessThan(statistics[DrumHitAnalyzer::PeakDb].standardDeviation, 0.01f);
+        expectLessThan(statistics[DrumHitAnalyzer::DecayMs].standardDeviation, 1.0f);
+    }
+
+    void testAttack()
+    {
+        beginTest("Attack time is the 10-90% rise");
+
+        DrumHitAnalyzer analyzer;
+        analyzer.prepare(sampleRate);
+        analyzer.setEnabled(true);
+
+        // 5 ms linear rise (10-90% in 4 ms), then a 30 ms decay
+        const auto report = feedHits(analyzer, [](double t, int)
+        {
+            const double envelope = t < 0.005 ? t / 0.005 : std::exp(-(t - 0.005) / 0.03);
+            return static_cast<float>(0.5 * envelope * std::sin(juce::MathConstants<double>::twoPi * 2000.0 * t));
+        }, 0.4, 4.05);
+
+        expectEquals(report.hits, 10);
+        expectWithinAbsoluteError(report.lastHit[DrumHitAnalyzer::AttackMs], 4.0f, 0.25f);
+        expectWithinAbsoluteError(report.lastHit[DrumHitAnalyzer::PeakDb], -6.0f, 0.2f);
+        expectWithinAbsoluteError(static_cast<double>(report.lastHit[DrumHitAnalyzer::DecayMs]), t60(0.03), t60(0.03) * 0.05);
+    }
+
+    void testBalance()
+    {
+        beginTest("Band balance separates kicks from snares");
+
+        DrumHitAnalyzer kick, snare;
+        kick.prepare(sampleRate);
+        snare.prepare(sampleRate);
+        kick.setEnabled(true);
+        snare.setEnabled(true);
+
+        const auto low = feedHits(kick, [](double t, int) { return burst(t, 55.0, 0.8, 0.06); }, 0.5, 3.05);
+        const auto high = feedHits(snare, [](double t, int)
+        {
+            return burst(t, 200.0, 0.3, 0.04) + burst(t, 3000.0, 0.3, 0.03);
+        }, 0.5, 3.05);
+
+        expectGreaterThan(low.lastHit[DrumHitAnalyzer::BalanceDb], 6.0f);
+        expectLessThan(high.lastHit[DrumHitAnalyzer::BalanceDb], -3.0f);
+    }
+
+    void testConsistency()
+    {
+        beginTest("The spread measures hit-to-hit consistency");
+
+        DrumHitAnalyzer analyzer;
+        analyzer.prepare(sampleRate);
+
+        // Alternate hits 6 dB apart: 3 dB standard deviation about the middle;
+        // blocks that do not divide the frame give the same result
+        for (const int blockSize : { 512, 97 })
+        {
+            analyzer.setEnabled(true);
+            const auto report = feedHits(analyzer, [](double t, int hit)
+            {
+                return burst(t, 60.0, hit % 2 == 0 ? 0.5 : 0.25, 0.05);
+            }, 0.5, 8.05, blockSize);
+
+            const auto& peak = report.statistics[DrumHitAnalyzer::PeakDb];
+            expectWithinAbsoluteError(peak.standardDeviation, 3.01f, 0.05f);
+            expectWithinAbsoluteError(std::abs(peak.mean - report.lastHit[DrumHitAnalyzer::PeakDb]), 3.01f, 0.05f);
+
+            // Switching off and on starts again
+            juce::AudioBuffer<float> silence(2, 16);
+            silence.clear();
+            analyzer.setEnabled(false);
+            analyzer.process(silence);
+        }
+    }
+
+    void testDenseHits()
+    {
+        beginTest("Sixteenths at 120 BPM are separate hits");
+
+        DrumHitAnalyzer analyzer;
+        analyzer.prepare(sampleRate);
+        analyzer.setEnabled(true);
+
+        const auto report = feedHits(analyzer, [](double t, int) { return burst(t, 60.0, 0.8, 0.02); }, 0.125, 4.05);
+
+        expectEquals(report.hits, 32);
+        expectWithinAbsoluteError(report.statistics[DrumHitAnalyzer::IntervalMs].mean, 125.0f, 0.5f);
+
+        // Cut short by the next hit, the decay is extrapolated from its upper part
+        expectWithinAbsoluteError(static_cast<double>(report.statistics[DrumHitAnalyzer::DecayMs].mean), t60(0.02), t60(0.02) * 0.1);
+    }
+
+    void testEnableAndSustain()
+    {
+        beginTest("Nothing is measured while off; sustained sound is one hit");
+
+        DrumHitAnalyzer analyzer;
+        analyzer.prepare(sampleRate);
+
+        auto tone = [](double t, int) { return burst(t, 1000.0, 0.3, 1.0e9); };
+
+        expectEquals(feedHits(analyzer, tone, 100.0, 2.0).hits, 0);
+
+        analyzer.setEnabled(true);
+        expectEquals(feedHits(analyzer, tone, 100.0, 4.0).hits, 1);
+
+        // Quiet hits below the threshold are ignored
+        analyzer.setEnabled(false);
+        analyzer.setThreshold(-20.0f);
+        feedHits(analyzer, tone, 100.0, 0.1);
+        analyzer.setEnabled(true);
+        expectEquals(feedHits(analyzer, [](double t, int) { return burst(t, 60.0, 0.05, 0.05); }, 0.5, 3.05).hits, 0);
+    }
+
+    void testDrumConfigCommand()
+    {
+        beginTest("/aiplayer/drum_config switches the analysis and sets the threshold");
+
+        AIplayerAudioProcessor processor;
+        auto& listener = static_cast<OSCManager::Listener&>(processor);
+        const auto& analyzer = processor.getDrumHitAnalyzer();
+
+        expect(! analyzer.isEnabled());
+
+        listener.handleDrumConfig(true, -40.0f);
+        expect(analyzer.isEnabled());
+        expectEquals(analyzer.getThreshold(), -40.0f);
+
+        // No threshold keeps the current one
+        listener.handleDrumConfig(false, 0.0f);
+        expect(! analyzer.isEnabled());
+        expectEquals(analyzer.getThreshold(), -40.0f);
+    }
+};
+
+static DrumHitAnalyzerTests drumHitAnalyzerTests;
+
+} // namespace AIplayer
@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    DynamicsAnalyzerTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the dynamics statistics: percentiles, crest factor, rolling
+    windows, gating, PLR/PSR and the AudioMetrics integration.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/AudioMetrics.h"
+#include "../Audio/DynamicsAnalyzer.h"
+
+namespace AIplayer {
+
+class DynamicsAnalyzerTests : public juce::UnitTest
+{
+public:
+    DynamicsAnalyzerTests() : UnitTest("Dynamics Analyzer Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testSteadyLevel();
+        testPercentiles();
+        testRollingWindows();
+        testSilenceGate();
+        testPeakToLoudness();
+        testAudioMetricsIntegration();
+    }
+
+private:
+    using Window = DynamicsAnalyzer::Window;
+
+    /// Bin resolution: a level is known to within one bin
+    static constexpr float tolerance = DynamicsAnalyzer::BIN_DB;
+
+    static const DynamicsAnalyzer::Statistics& window(const DynamicsAnalyzer::Report& report, Window which)
+    {
+        return report.windows[static_cast<size_t>(which)];
+    }
+
+    static void addHops(DynamicsAnalyzer& analyzer, int hops, float rmsDb, float peakDb)
+    {
+        for (int hop = 0; hop < hops; ++hop)
+            analyzer.addLevels(juce::Decibels::decibelsToGain(rmsDb), juce::Decibels::decibelsToGain(peakDb));
+    }
+
+    void testSteadyLevel()
+    {
+        beginTest("A steady level has its crest factor and no spread");
+
+        DynamicsAnalyzer analyzer;
+        DynamicsAnalyzer::Report report;
+        expect(! analyzer.getReport(report));
+
+        addHops(analyzer, 500, -20.0f, -17.0f);
+        expect(analyzer.getReport(report));
+
+        const auto& statistics = window(report, Window::Short);
+        expectEquals(statistics.activeHops, DynamicsAnalyzer::SHORT_WINDOW_HOPS);
+        expectEquals(window(report, Window::Long).activeHops, 500);
+        expectWithinAbsoluteError(statistics.rmsDb, -20.0f, tolerance);
+        expectWithinAbsoluteError(statistics.peakDb, -17.0f, tolerance);
+        expectWithinAbsoluteError(statistics.crestDb, 3.0f, tolerance);
+        expectLessThan(statistics.rangeDb, tolerance);
+
+        // Nothing to compare the peaks against without loudness
+        expectEquals(statistics.plrDb, 0.0f);
+        expectEquals(report.psrDb, 0.0f);
+    }
+
+    void testPercentiles()
+    {
+        beginTest("Percentiles follow the level distribution");
+
+        DynamicsAnalyzer analyzer;
+
+        // Levels spread evenly over -40 to -10 dBFS
+        for (int hop = 0; hop < DynamicsAnalyzer::LONG_WINDOW_HOPS; ++hop)
+        {
+            const float levelDb = -40.0f + 30.0f * static_cast<float>(hop % 300) / 300.0f;
+            addHops(analyzer, 1, levelDb, levelDb + 3.0f);
+        }
+
+        DynamicsAnalyzer::Report report;
+        analyzer.getReport(report);
+        const auto& statistics = window(report, Window::Long);
+
+        expectWithinAbsoluteError(statistics.lowDb, -37.0f, tolerance);
+        expectWithinAbsoluteError(statistics.highDb, -11.5f, tolerance);
+        expectWithinAbsoluteError(statistics.rangeDb, 25.5f, tolerance);
+        expectWithinAbsoluteError(statistics.peakDb, -7.1f, tolerance);
+
+        // The energy mean sits near the top of the range
+        expectGreaterThan(statistics.rmsDb, statistics.lowDb + 15.0f);
+    }
+
+    void testRollingWindows()
+    {
+        beginTest("Windows forget what has left them");
+
+        DynamicsAnalyzer analyzer;
+        DynamicsAnalyzer::Report report;
+
+        addHops(analyzer, DynamicsAnalyzer::LONG_WINDOW_HOPS, -10.0f, -6.0f);
+        addHops(analyzer, DynamicsAnalyzer::SHORT_WINDOW_HOPS, -30.0f, -26.0f);
+        analyzer.getReport(report);
+
+        expectWithinAbsoluteError(window(report, Window::Short).rmsDb, -30.0f, tolerance);
+        expectWithinAbsoluteError(window(report, Window::Short).peakDb, -26.0f, tolerance);
+        expectWithinAbsoluteError(window(report, Window::Long).peakDb, -6.0f, tolerance);
+        expectGreaterThan(window(report, Window::Long).rangeDb, 15.0f);
+
+        // Any amount of audio later, the long window holds only its last 30 s
+        for (int pass = 0; pass < 10; ++pass)
+            addHops(analyzer, DynamicsAnalyzer::LONG_WINDOW_HOPS, -30.0f, -26.0f);
+
+        analyzer.getReport(report);
+        expectEquals(window(report, Window::Long).activeHops, DynamicsAnalyzer::LONG_WINDOW_HOPS);
+        expectWithinAbsoluteError(window(report, Window::Long).peakDb, -26.0f, tolerance);
+        expectLessThan(window(report, Window::Long).rangeDb, tolerance);
+    }
+
+    void testSilenceGate()
+    {
+        beginTest("Silence does not count");
+
+        DynamicsAnalyzer analyzer;
+        DynamicsAnalyzer::Report report;
+
+        for (int hop = 0; hop < 1000; ++hop)
+            analyzer.addLevels(0.0f, 0.0f);
+
+        analyzer.getReport(report);
+        expectEquals(window(report, Window::Long).activeHops, 0);
+        expectEquals(window(report, Window::Long).rmsDb, DynamicsAnalyzer::FLOOR_DB);
+
+        // Pauses between phrases leave the percentiles alone
+        for (int phrase = 0; phrase < 5; ++phrase)
+        {
+            addHops(analyzer, 200, -18.0f, -12.0f);
+            for (int hop = 0; hop < 100; ++hop)
+                analyzer.addLevels(0.0f, 0.0f);
+        }
+
+        analyzer.getReport(report);
+        expectEquals(window(report, Window::Long).activeHops, 1000);
+        expectWithinAbsoluteError(window(report, Window::Long).lowDb, -18.0f, tolerance);
+    }
+
+    void testPeakToLoudness()
+    {
+        beginTest("PLR and PSR compare peaks with the gated loudness");
+
+        DynamicsAnalyzer analyzer;
+
+        // Loud passages at -14 LUFS with quiet ones at -40 below the relative gate
+        for (int hop = 0; hop < 1000; ++hop)
+        {
+            analyzer.addLevels(juce::Decibels::decibelsToGain(-20.0f), juce::Decibels::decibelsToGain(-1.0f));
+            analyzer.addLoudness(hop % 2 == 0 ? -14.0f : -40.0f, -15.0f);
+        }
+
+        DynamicsAnalyzer::Report report;
+        analyzer.getReport(report);
+
+        expectWithinAbsoluteError(window(report, Window::Long).loudnessLufs, -14.0f, tolerance);
+        expectWithinAbsoluteError(window(report, Window::Long).plrDb, 13.0f, 2.0f * tolerance);
+        expectWithinAbsoluteError(report.psrDb, 14.0f, tolerance);
+
+        // Restarting the loudness clears only the loudness
+        analyzer.resetLoudness();
+        addHops(analyzer, DynamicsAnalyzer::STATISTICS_HOPS, -20.0f, -1.0f);
+        analyzer.getReport(report);
+
+        expectEquals(window(report, Window::Long).loudnessLufs, DynamicsAnalyzer::FLOOR_DB);
+        expectEquals(report.psrDb, 0.0f);
+        expectEquals(window(report, Window::Long).activeHops, 1000 + DynamicsAnalyzer::STATISTICS_HOPS);
+    }
+
+    void testAudioMetricsIntegration()
+    {
+        beginTest("AudioMetrics feeds the analyzer on its hop grid");
+
+        const double sampleRate = 48000.0;
+        const int totalSamples = static_cast<int>(sampleRate * 5.0);
+
+        auto measure = [&](int blockSize, DynamicsAnalyzer::Report& report)
+        {
+            AudioMetrics metrics;
+            metrics.prepare(sampleRate, blockSize, juce::AudioChannelSet::stereo());
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            for (int start = 0; start < totalSamples; start += blockSize)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    const float sample = 0.5f * std::sin(juce::MathConstants<float>::twoPi * 1000.0f
+                                                         * static_cast<float>(start + i) / static_cast<float>(sampleRate));
+                    buffer.setSample(0, i, sample);
+                    buffer.setSample(1, i, sample);
+                }
+
+                metrics.updateMetrics(buffer);
+            }
+
+            return metrics.getDynamics().getReport(report);
+        };
+
+        DynamicsAnalyzer::Report small, large;
+        expect(measure(333, small));
+        expect(measure(2000, large));
+
+        // A sine has a 3 dB crest; two channels at -9 dBFS RMS read -6 LUFS at 1 kHz
+        const auto& statistics = window(small, Window::Short);
+        expectWithinAbsoluteError(statistics.peakDb, -6.0f, tolerance);
+        expectWithinAbsoluteError(statistics.crestDb, 3.0f, tolerance);
+        expectWithinAbsoluteError(statistics.loudnessLufs, -6.0f, 2.0f * tolerance);
+        expectWithinAbsoluteError(small.psrDb, 0.0f, 2.0f * tolerance);
+
+        // The same hops whatever the block size (sizes differ, so compare bins)
+        expectEquals(window(large, Window::Long).activeHops, window(small, Window::Long).activeHops);
+        expectWithinAbsoluteError(window(large, Window::Long).rmsDb, window(small, Window::Long).rmsDb, 0.01f);
+        expectWithinAbsoluteError(window(large, Window::Long).loudnessLufs, window(small, Window::Long).loudnessLufs, 0.01f);
+    }
+};
+
+static DynamicsAnalyzerTests dynamicsAnalyzerTests;
+
+} // namespace AIplayer
@@ -32,6 +32,8 @@ public:
         testFFTComputationTiming();
         testBandEnergyAnalyzer();
         testFrequencyBandMapping();
+        testSineCalibration();
+        testFractionalBandEdges();
         testKickDrumSimulation();
         testPerformance();
     }
@@ -192,7 +194,7 @@ private:
         }
         
         // Analyze
-        analyzer.analyzeBands(magnitudes.data(), numBins, binWidth, 44100.0);
+        analyzer.analyzeBands(magnitudes.data(), numBins, binWidth, 44100.0, 1.0f);
         expect(analyzer.isAnalysisReady());
         
         // Check band energies
@@ -244,6 +246,120 @@ private:
         expect(juce::String(BandEnergyAnalyzer::getBandName(3)) == "High");
     }
     
+    /// Band energies of a sine at `level` through a 1024-point FFT with this window
+    static std::array<float, BandEnergyAnalyzer::NUM_BANDS> sineBands(FFTProcessor::Window window, float frequency,
+                                                                        float level, float& peakDb)
+    {
+        const double sampleRate = 48000.0;
+        
+        FFTProcessor processor(10);
+        processor.setWindow(window);
+        
+        juce::AudioBuffer<float> buffer(1, processor.getFFTSize());
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(0, i, level * std::sin(juce::MathConstants<float>::twoPi * frequency
+                                                    * static_cast<float>(i) / static_cast<float>(sampleRate) + 0.3f));
+        
+        processor.processAudioBlock(buffer, sampleRate);
+        processor.computeFFT();
+        
+        const float* magnitudes = processor.getMagnitudeSpectrum();
+        peakDb = juce::Decibels::gainToDecibels(*std::max_element(magnitudes, magnitudes + processor.getMagnitudeSpectrumSize()));
+        
+        BandEnergyAnalyzer analyzer;
+        analyzer.analyzeBands(magnitudes, processor.getMagnitudeSpectrumSize(), processor.getBinWidth(),
+                              sampleRate, processor.getNoiseBandwidth());
+        return analyzer.getAllBandEnergies();
+    }
+    
+    void testSineCalibration()
+    {
+        beginTest("A -20 dBFS sine reads -20 dB in its band with any window");
+        
+        const float level = juce::Decibels::decibelsToGain(-20.0f);
+        
+        for (const auto window : { FFTProcessor::Window::Rectangular, FFTProcessor::Window::Hann,
+                                   FFTProcessor::Window::Hamming, FFTProcessor::Window::BlackmanHarris,
+                                   FFTProcessor::Window::FlatTop })
+        {
+            // On a bin (bin width 46.875 Hz), between two, and anywhere
+            for (const float frequency : { 1031.25f, 1054.6875f, 997.0f })
+            {
+                float peakDb = 0.0f;
+                const auto bands = sineBands(window, frequency, level, peakDb);
+                
+                expectWithinAbsoluteError(bands[1], -20.0f, 0.05f,
+                                          FFTProcessor::windowToString(window) + " at " + juce::String(frequency) + " Hz");
+                expectLessThan(bands[0], -40.0f);
+                
+                // The flat top's peak reads the level too; the others lose up to their scalloping
+                if (window == FFTProcessor::Window::FlatTop)
+                    expectWithinAbsoluteError(peakDb, -20.0f, 0.05f);
+                else if (window == FFTProcessor::Window::Hann)
+                    expectGreaterThan(peakDb, -21.5f);
+            }
+        }
+        
+        // Noise bandwidths of the windows (bins)
+        FFTProcessor processor(10);
+        expectWithinAbsoluteError(processor.getNoiseBandwidth(), 1.5f, 0.01f);
+        
+        expect(FFTProcessor::windowFromString("flat_top") == FFTProcessor::Window::FlatTop);
+        expect(FFTProcessor::windowFromString("unknown") == FFTProcessor::Window::Hann);
+        
+        // The analyzer passes the window and the actual sample rate through
+        Logger logger(juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("fft_calibration.log"));
+        FrequencyAnalyzer::Config config;
+        config.autoStart = false;
+        config.window = FFTProcessor::Window::BlackmanHarris;
+        FrequencyAnalyzer frequencyAnalyzer(logger, config);
+        
+        juce::AudioBuffer<float> buffer(2, 1024);
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            const float sample = level * std::sin(juce::MathConstants<float>::twoPi * 5000.0f * static_cast<float>(i) / 96000.0f);
+            buffer.setSample(0, i, sample);
+            buffer.setSample(1, i, sample);
+        }
+        
+        frequencyAnalyzer.processBlock(buffer, 96000.0);
+        expect(frequencyAnalyzer.computeNow());
+        expectWithinAbsoluteError(frequencyAnalyzer.getBandEnergy(2), -20.0f, 0.05f);
+    }
+    
+    void testFractionalBandEdges()
+    {
+        beginTest("Bins at band edges are shared, not counted twice");
+        
+        // A flat spectrum: each band holds its width in bins, and together
+        // the bands hold exactly the 20 Hz - 20 kHz range
+        const int numBins = 512;
+        const float binWidth = 48000.0f / 1024.0f;
+        const std::vector<float> magnitudes(numBins, 1.0f);
+        
+        BandEnergyAnalyzer analyzer;
+        analyzer.analyzeBands(magnitudes.data(), numBins, binWidth, 48000.0, 1.0f);
+        
+        float total = 0.0f;
+        for (int band = 0; band < BandEnergyAnalyzer::NUM_BANDS; ++band)
+        {
+            float low, high;
+            analyzer.getBandFrequencyRange(band, low, high);
+            expectWithinAbsoluteError(analyzer.getBandEnergyLinear(band), (high - low) / binWidth, 0.01f);
+            total += analyzer.getBandEnergyLinear(band);
+        }
+        
+        expectWithinAbsoluteError(total, (20000.0f - 20.0f) / binWidth, 0.01f);
+        
+        // A sine on a band edge splits between the two bands without gaining energy
+        float peakDb = 0.0f;
+        const auto bands = sineBands(FFTProcessor::Window::Hann, 2000.0f, 0.1f, peakDb);
+        const float power = std::pow(10.0f, bands[1] / 10.0f) + std::pow(10.0f, bands[2] / 10.0f);
+        expectGreaterThan(bands[1], -40.0f);
+        expectGreaterThan(bands[2], -40.0f);
+        expectWithinAbsoluteError(10.0f * std::log10(power), -20.0f, 0.05f);
+    }
+    
     void testKickDrumSimulation()
     {
         beginTest("Kick Drum Frequency Analysis");
@@ -287,7 +403,8 @@ private:
         analyzer.analyzeBands(processor.getMagnitudeSpectrum(), 
                             processor.getMagnitudeSpectrumSize(),
                             processor.getBinWidth(),
-                            sampleRate);
+                            sampleRate,
+                            processor.getNoiseBandwidth());
         
         // Get band energies
         auto energies = analyzer.getAllBandEnergies();
@@ -359,7 +476,8 @@ private:
                             processors[i]->getMagnitudeSpectrum(),
                             processors[i]->getMagnitudeSpectrumSize(),
                             processors[i]->getBinWidth(),
-                            44100.0
+                            44100.0,
+                            processors[i]->getNoiseBandwidth()
                         );
                     }
                 }
@@ -0,0 +1,457 @@
+/*
+  ==============================================================================
+
+    GoldenRenderTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Render-and-compare regression tests for the whole processor: fixed
+    stimuli through AIplayerAudioProcessor at several sample rates and block
+    sizes, checked against stored references (decimated output samples,
+    level profile, metrics and latency) and against each other (block-size
+    independence).
+
+    References live in Source/Tests/Golden, one JSON file per scenario. A
+    missing or outdated reference fails the test; set
+    AIPLAYER_GOLDEN_RECORD=1 to record them after an intended change, and
+    AIPLAYER_GOLDEN_DIR to read and write them somewhere else. Render times
+    are logged, and only checked against the reference with
+    AIPLAYER_GOLDEN_TIMING=1 (on a quiet machine).
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "../Core/Constants.h"
+
+namespace AIplayer {
+
+class GoldenRenderTests : public juce::UnitTest
+{
+public:
+    GoldenRenderTests() : UnitTest("Golden Render Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        const auto folder = getReferenceFolder();
+        const bool record = juce::SystemStats::getEnvironmentVariable("AIPLAYER_GOLDEN_RECORD", {}) == "1";
+        const bool checkTiming = juce::SystemStats::getEnvironmentVariable("AIPLAYER_GOLDEN_TIMING", {}) == "1";
+
+        for (const auto& scenario : getScenarios())
+            testScenario(scenario, folder, record, checkTiming);
+    }
+
+private:
+    /// Reference format; bump when renders or stimuli change on purpose
+    static constexpr int REFERENCE_VERSION = 2;
+
+    static constexpr double STIMULUS_SECONDS = 1.0;
+    static constexpr double SEGMENT_SECONDS = 0.010;
+
+    /// Block size every other size must match sample for sample
+    static constexpr int REFERENCE_BLOCK_SIZE = 512;
+
+    /// Output difference allowed between block sizes (float rounding only)
+    static constexpr float BLOCK_TOLERANCE = 1.0e-5f;
+
+    /// Level and metric difference allowed against the stored reference
+    static constexpr float LEVEL_TOLERANCE_DB = 0.02f;
+
+    /// Every DECIMATION-th output sample of the reference block size is stored
+    static constexpr int DECIMATION = 32;
+
+    /// Sample difference allowed against the stored reference (compiler and CPU rounding)
+    static constexpr float SAMPLE_TOLERANCE = 1.0e-4f;
+
+    /// Segments below this are noise floor and only need to stay below it
+    static constexpr float FLOOR_DB = -90.0f;
+
+    /// Render time allowed against the reference (AIPLAYER_GOLDEN_TIMING=1, same build configuration)
+    static constexpr double TIMING_TOLERANCE = 2.0;
+    static constexpr double TIMING_SLACK_MS = 5.0;
+
+    struct Scenario
+    {
+        const char* name;
+        std::vector<std::pair<const char*, float>> parameters;   ///< Parameter ID, value in its own units
+    };
+
+    struct Render
+    {
+        juce::AudioBuffer<float> output;
+        int latency{0};
+        std::array<float, 2> rmsDb{};
+        std::array<float, 2> peakDb{};
+        float momentaryLufs{0.0f};
+        float shortTermLufs{0.0f};
+        float limiterReductionDb{0.0f};
+        double milliseconds{0.0};
+    };
+
+    static const char* getBuildName()
+    {
+       #if JUCE_DEBUG
+        return "Debug";
+       #else
+        return "Release";
+       #endif
+    }
+
+    static juce::File getReferenceFolder()
+    {
+        const auto custom = juce::SystemStats::getEnvironmentVariable("AIPLAYER_GOLDEN_DIR", {});
+        return custom.isNotEmpty() ? juce::File(custom) : juce::File(__FILE__).getSiblingFile("Golden");
+    }
+
+    static std::vector<Scenario> getScenarios()
+    {
+        namespace P = Constants::Parameters;
+
+        const std::vector<std::pair<const char*, float>> strip {
+            { P::HPF_ENABLED_ID, 1.0f }, { P::HPF_FREQ_ID, 80.0f },
+            { P::LPF_ENABLED_ID, 1.0f }, { P::LPF_FREQ_ID, 12000.0f },
+            { P::EQ_FREQ_ID, 2000.0f }, { P::EQ_GAIN_ID, 6.0f }, { P::EQ_Q_ID, 1.0f },
+            { P::COMP_THRESHOLD_ID, -24.0f }, { P::COMP_RATIO_ID, 4.0f },
+            { P::COMP_ATTACK_ID, 5.0f }, { P::COMP_RELEASE_ID, 80.0f },
+            { P::COMP_MAKEUP_ID, 6.0f }, { P::COMP_LOOKAHEAD_ID, 1.5f } };
+
+        auto strip4x = strip;
+        strip4x.push_back({ P::OVERSAMPLING_ID, 2.0f });
+
+        auto fullChain = strip;
+        fullChain.push_back({ P::GAIN_ID, -2.0f });
+        fullChain.push_back({ P::OVERSAMPLING_ID, 1.0f });
+        fullChain.push_back({ P::LIMITER_ENABLED_ID, 1.0f });
+        fullChain.push_back({ P::LIMITER_CEILING_ID, -3.0f });
+        fullChain.push_back({ P::LIMITER_RELEASE_ID, 50.0f });
+
+        return { { "bypass", {} },
+                 { "channel_strip", strip },
+                 { "channel_strip_4x", strip4x },
+                 { "full_chain", fullChain } };
+    }
+
+    /**
+     * Fixed stereo stimulus: log sweep 20 Hz - 20 kHz at -6 dBFS, white noise
+     * at -12 dBFS, then -1 dBFS clicks over a -30 dBFS 1 kHz tone. The right
+     * channel is the left at -3 dB so that stereo linking shows up.
+     */
+    static juce::AudioBuffer<float> makeStimulus(double sampleRate)
+    {
+        const int numSamples = juce::roundToInt(STIMULUS_SECONDS * sampleRate);
+        const int sweepEnd = numSamples * 4 / 10;
+        const int noiseEnd = numSamples * 7 / 10;
+        const int clickSpacing = juce::roundToInt(0.05 * sampleRate);
+
+        juce::AudioBuffer<float> buffer(2, numSamples);
+        juce::Random random(1234);
+
+        const double sweepSeconds = sweepEnd / sampleRate;
+        const double sweepRate = std::log(20000.0 / 20.0);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double t = i / sampleRate;
+            float sample;
+
+            if (i < sweepEnd)
+            {
+                const double phase = juce::MathConstants<double>::twoPi * 20.0 * sweepSeconds / sweepRate
+                                   * (std::exp(t / sweepSeconds * sweepRate) - 1.0);
+                sample = 0.5f * static_cast<float>(std::sin(phase));
+            }
+            else if (i < noiseEnd)
+            {
+                sample = 0.25f * (random.nextFloat() * 2.0f - 1.0f);
+            }
+            else
+            {
+                sample = 0.0316f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 1000.0 * t));
+                if ((i - noiseEnd) % clickSpacing == 0)
+                    sample = 0.891f;
+            }
+
+            buffer.setSample(0, i, sample);
+            buffer.setSample(1, i, 0.708f * sample);
+        }
+
+        return buffer;
+    }
+
+    Render render(const Scenario& scenario, double sampleRate, int blockSize)
+    {
+        Render result;
+        AIplayerAudioProcessor processor;
+
+        for (const auto& [id, value] : scenario.parameters)
+        {
+            auto* parameter = processor.apvts.getParameter(id);
+            expect(parameter != nullptr, juce::String("Unknown parameter ") + id);
+
+            if (parameter != nullptr)
+                parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        }
+
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        result.output = makeStimulus(sampleRate);
+        auto& output = result.output;
+        juce::MidiBuffer midi;
+
+        const double start = juce::Time::getMillisecondCounterHiRes();
+
+        for (int position = 0; position < output.getNumSamples(); position += blockSize)
+        {
+            const int count = juce::jmin(blockSize, output.getNumSamples() - position);
+            juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), output.getNumChannels(), position, count);
+            processor.processBlock(block, midi);
+        }
+
+        result.milliseconds = juce::Time::getMillisecondCounterHiRes() - start;
+
+        const auto& metrics = processor.getAudioMetrics();
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            result.rmsDb[static_cast<size_t>(channel)] = juce::Decibels::gainToDecibels(metrics.getChannelRMS(channel), -120.0f);
+            result.peakDb[static_cast<size_t>(channel)] = juce::Decibels::gainToDecibels(metrics.getChannelPeak(channel), -120.0f);
+        }
+
+        result.momentaryLufs = metrics.getMomentaryLufs();
+        result.shortTermLufs = metrics.getShortTermLufs();
+        result.limiterReductionDb = processor.getLimiter().getGainReductionDb();
+        result.latency = processor.getLatencySamples();
+
+        processor.releaseResources();
+        return result;
+    }
+
+    /// RMS level of every 10 ms segment, per channel
+    static juce::var levelProfile(const juce::AudioBuffer<float>& output, double sampleRate)
+    {
+        const int segment = juce::roundToInt(SEGMENT_SECONDS * sampleRate);
+        juce::Array<juce::var> channels;
+
+        for (int channel = 0; channel < output.getNumChannels(); ++channel)
+        {
+            juce::Array<juce::var> levels;
+            for (int start = 0; start + segment <= output.getNumSamples(); start += segment)
+                levels.add(juce::Decibels::gainToDecibels(output.getRMSLevel(channel, start, segment), -120.0f));
+            channels.add(levels);
+        }
+
+        return channels;
+    }
+
+    /// Every DECIMATION-th sample, per channel
+    static juce::var decimatedSamples(const juce::AudioBuffer<float>& output)
+    {
+        juce::Array<juce::var> channels;
+
+        for (int channel = 0; channel < output.getNumChannels(); ++channel)
+        {
+            juce::Array<juce::var> samples;
+            for (int i = 0; i < output.getNumSamples(); i += DECIMATION)
+                samples.add(output.getSample(channel, i));
+            channels.add(samples);
+        }
+
+        return channels;
+    }
+
+    static juce::var toVar(const Render& render, double sampleRate, int blockSize)
+    {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("rate", sampleRate);
+        object->setProperty("block", blockSize);
+        object->setProperty("latency", render.latency);
+        object->setProperty("rms_db", juce::Array<juce::var> { render.rmsDb[0], render.rmsDb[1] });
+        object->setProperty("peak_db", juce::Array<juce::var> { render.peakDb[0], render.peakDb[1] });
+        object->setProperty("momentary_lufs", render.momentaryLufs);
+        object->setProperty("short_term_lufs", render.shortTermLufs);
+        object->setProperty("limiter_gr_db", render.limiterReductionDb);
+        object->setProperty("render_ms", render.milliseconds);
+        return juce::var(object);
+    }
+
+    static juce::var findRender(const juce::var& reference, double sampleRate, int blockSize)
+    {
+        if (const auto* renders = reference["renders"].getArray())
+            for (const auto& entry : *renders)
+                if (static_cast<double>(entry["rate"]) == sampleRate && static_cast<int>(entry["block"]) == blockSize)
+                    return entry;
+
+        return {};
+    }
+
+    void expectLevel(float actual, const juce::var& expected, const juce::String& what)
+    {
+        const float reference = static_cast<float>(expected);
+        const bool bothAtFloor = actual < FLOOR_DB && reference < FLOOR_DB;
+
+        expect(bothAtFloor || std::abs(actual - reference) <= LEVEL_TOLERANCE_DB,
+               what + ": " + juce::String(actual, 3) + " dB, reference " + juce::String(reference, 3) + " dB");
+    }
+
+    void compareRender(const Render& actual, const juce::var& reference, bool checkTiming, const juce::String& label)
+    {
+        if (reference.isVoid())
+        {
+            expect(false, label + ": no reference (re-record with AIPLAYER_GOLDEN_RECORD=1)");
+            return;
+        }
+
+        expectEquals(actual.latency, static_cast<int>(reference["latency"]), label + " latency");
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            expectLevel(actual.rmsDb[static_cast<size_t>(channel)], reference["rms_db"][channel], label + " RMS ch" + juce::String(channel));
+            expectLevel(actual.peakDb[static_cast<size_t>(channel)], reference["peak_db"][channel], label + " peak ch" + juce::String(channel));
+        }
+
+        expectLevel(actual.momentaryLufs, reference["momentary_lufs"], label + " momentary");
+        expectLevel(actual.shortTermLufs, reference["short_term_lufs"], label + " short-term");
+        expectLevel(actual.limiterReductionDb, reference["limiter_gr_db"], label + " limiter GR");
+
+        // Timing is too noisy on shared machines to check by default; when
+        // asked to, it is only compared within one build configuration
+        const double referenceMs = reference["render_ms"];
+        if (checkTiming)
+            expect(actual.milliseconds <= referenceMs * TIMING_TOLERANCE + TIMING_SLACK_MS,
+                   label + " render took " + juce::String(actual.milliseconds, 1) + " ms, reference "
+                   + juce::String(referenceMs, 1) + " ms");
+    }
+
+    void compareProfile(const juce::var& actual, const juce::var& reference, const juce::String& label)
+    {
+        int mismatches = 0;
+        float worst = 0.0f;
+
+        for (int channel = 0; channel < actual.size(); ++channel)
+        {
+            for (int segment = 0; segment < actual[channel].size(); ++segment)
+            {
+                const float level = actual[channel][segment];
+                const float expected = reference[channel][segment];
+
+                if (level < FLOOR_DB && expected < FLOOR_DB)
+                    continue;
+
+                const float error = std::abs(level - expected);
+                worst = juce::jmax(worst, error);
+                mismatches += error > LEVEL_TOLERANCE_DB ? 1 : 0;
+            }
+        }
+
+        expect(actual.size() == reference.size() && mismatches == 0,
+               label + ": " + juce::String(mismatches) + " segments differ, worst " + juce::String(worst, 3) + " dB");
+    }
+
+    void compareSamples(const juce::var& actual, const juce::var& reference, const juce::String& label)
+    {
+        int mismatches = 0;
+        float worst = 0.0f;
+        bool sameLength = actual.size() == reference.size();
+
+        for (int channel = 0; sameLength && channel < actual.size(); ++channel)
+        {
+            sameLength = actual[channel].size() == reference[channel].size();
+
+            for (int i = 0; sameLength && i < actual[channel].size(); ++i)
+            {
+                const float error = std::abs(static_cast<float>(actual[channel][i]) - static_cast<float>(reference[channel][i]));
+                worst = juce::jmax(worst, error);
+                mismatches += error > SAMPLE_TOLERANCE ? 1 : 0;
+            }
+        }
+
+        expect(sameLength && mismatches == 0,
+               label + ": " + juce::String(mismatches) + " samples differ, worst " + juce::String(worst, 6));
+    }
+
+    void testScenario(const Scenario& scenario, const juce::File& folder, bool record, bool checkTiming)
+    {
+        beginTest(juce::String("Golden render: ") + scenario.name);
+
+        const auto file = folder.getChildFile(juce::String(scenario.name) + ".json");
+        const auto reference = record ? juce::var() : juce::JSON::parse(file);
+        const int referenceVersion = reference["version"];
+        const bool compare = !record && referenceVersion == REFERENCE_VERSION;
+        const bool timeReference = checkTiming && reference["build"].toString() == getBuildName();
+
+        // Block sizes are still compared with each other without a reference
+        if (!record && !file.existsAsFile())
+            expect(false, file.getFullPathName() + " missing (record with AIPLAYER_GOLDEN_RECORD=1)");
+        else if (!compare && !record)
+            expect(false, file.getFileName() + " is version " + juce::String(referenceVersion) + ", expected "
+                          + juce::String(REFERENCE_VERSION) + " (re-record with AIPLAYER_GOLDEN_RECORD=1)");
+
+        juce::Array<juce::var> renders;
+        auto* profiles = new juce::DynamicObject();
+        juce::var profilesVar(profiles);
+        auto* samples = new juce::DynamicObject();
+        juce::var samplesVar(samples);
+        double totalMs = 0.0;
+
+        for (const double sampleRate : { 44100.0, 48000.0, 96000.0 })
+        {
+            const auto rateKey = juce::String(juce::roundToInt(sampleRate));
+            const auto baseline = render(scenario, sampleRate, REFERENCE_BLOCK_SIZE);
+            const auto profile = levelProfile(baseline.output, sampleRate);
+            const auto decimated = decimatedSamples(baseline.output);
+            profiles->setProperty(rateKey, profile);
+            samples->setProperty(rateKey, decimated);
+
+            if (compare)
+            {
+                compareSamples(decimated, reference["samples"][juce::Identifier(rateKey)], rateKey + " Hz output samples");
+                compareProfile(profile, reference["profiles"][juce::Identifier(rateKey)], rateKey + " Hz level profile");
+            }
+
+            for (const int blockSize : { 1, 17, 64, REFERENCE_BLOCK_SIZE, 4097 })
+            {
+                const auto label = rateKey + " Hz / " + juce::String(blockSize);
+                const auto current = blockSize == REFERENCE_BLOCK_SIZE ? Render{} : render(scenario, sampleRate, blockSize);
+                const auto& actual = blockSize == REFERENCE_BLOCK_SIZE ? baseline : current;
+
+                // Every block size produces the same audio
+                float difference = 0.0f;
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < actual.output.getNumSamples(); ++i)
+                        difference = juce::jmax(difference, std::abs(actual.output.getSample(channel, i)
+                                                                     - baseline.output.getSample(channel, i)));
+
+                expect(difference <= BLOCK_TOLERANCE,
+                       label + " differs from block size " + juce::String(REFERENCE_BLOCK_SIZE) + " by " + juce::String(difference));
+
+                if (compare)
+                    compareRender(actual, findRender(reference, sampleRate, blockSize), timeReference, label);
+
+                renders.add(toVar(actual, sampleRate, blockSize));
+                totalMs += actual.milliseconds;
+            }
+        }
+
+        logMessage(juce::String(scenario.name) + ": 15 renders in " + juce::String(totalMs, 1) + " ms ("
+                   + getBuildName() + ")");
+
+        if (record)
+        {
+            auto* root = new juce::DynamicObject();
+            root->setProperty("version", REFERENCE_VERSION);
+            root->setProperty("build", getBuildName());
+            root->setProperty("renders", renders);
+            root->setProperty("profiles", profilesVar);
+            root->setProperty("samples", samplesVar);
+
+            folder.createDirectory();
+            expect(file.replaceWithText(juce::JSON::toString(juce::var(root))), "Cannot write " + file.getFullPathName());
+            logMessage("Recorded reference " + file.getFullPathName());
+        }
+    }
+};
+
+static GoldenRenderTests goldenRenderTests;
+
+} // namespace AIplayer
@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+    HopSchedulerTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the fixed-hop scheduler and the block-size independence of
+    the metering built on it.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/AudioMetrics.h"
+#include "../Audio/HopScheduler.h"
+
+namespace AIplayer {
+
+class HopSchedulerTests : public juce::UnitTest
+{
+public:
+    HopSchedulerTests() : UnitTest("Hop Scheduler Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testSegmentsFollowGrid();
+        testMeteringIndependentOfBlockSize();
+        testHopCount();
+        testCostPerSecond();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int maxBlockSize = 4096;
+
+    /// Block sizes a host might use, including ones that change every call
+    static const std::vector<int>& getBlockSizes()
+    {
+        static const std::vector<int> sizes { 1, 17, 64, 480, 512, 1024, 4096, -1 };
+        return sizes;
+    }
+
+    static int nextBlockSize(int setting, juce::Random& random)
+    {
+        return setting > 0 ? setting : 1 + random.nextInt(maxBlockSize);
+    }
+
+    void testSegmentsFollowGrid()
+    {
+        beginTest("Segments cover every sample and end on hop boundaries");
+
+        HopScheduler scheduler;
+        scheduler.prepare(sampleRate);
+        expectEquals(scheduler.getHopSamples(), 480);
+
+        juce::Random random(7);
+        juce::int64 position = 0;
+        juce::int64 expectedHop = 0;
+        bool contiguous = true;
+        bool withinHop = true;
+        bool hopsInOrder = true;
+
+        for (int block = 0; block < 2000; ++block)
+        {
+            const int numSamples = nextBlockSize(-1, random);
+            juce::int64 blockStart = position;
+
+            const int completed = scheduler.process(numSamples, [&](int start, int count)
+            {
+                contiguous = contiguous && blockStart + start == position && count > 0;
+                withinHop = withinHop && (position % 480) + count <= 480;
+                position += count;
+            },
+            [&](juce::int64 hop)
+            {
+                hopsInOrder = hopsInOrder && hop == expectedHop && position == (hop + 1) * 480;
+                ++expectedHop;
+            });
+
+            expect(completed >= 0);
+        }
+
+        expect(contiguous, "segments skip or repeat samples");
+        expect(withinHop, "a segment crosses a hop boundary");
+        expect(hopsInOrder, "hops complete out of order or off the grid");
+        expectEquals(scheduler.getHopsCompleted(), position / 480);
+        expectEquals(static_cast<juce::int64>(scheduler.getHopPosition()), position % 480);
+    }
+
+    /// Renders the same noise through AudioMetrics with one block-size setting
+    static std::vector<std::array<float, 4>> meter(int setting, int numHops)
+    {
+        AudioMetrics metrics;
+        metrics.prepare(sampleRate, maxBlockSize, juce::AudioChannelSet::stereo());
+
+        juce::Random noise(99);
+        juce::AudioBuffer<float> audio(2, numHops * 480);
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < audio.getNumSamples(); ++i)
+                audio.setSample(channel, i, (0.2f + 0.3f * channel) * (noise.nextFloat() * 2.0f - 1.0f) * (1.0f + std::sin(i * 0.0005f)));
+
+        juce::Random random(setting);
+        std::vector<std::array<float, 4>> perHop;
+        juce::int64 seen = 0;
+
+        for (int position = 0; position < audio.getNumSamples();)
+        {
+            const int count = juce::jmin(nextBlockSize(setting, random), audio.getNumSamples() - position);
+            juce::AudioBuffer<float> block(audio.getArrayOfWritePointers(), 2, position, count);
+            metrics.updateMetrics(block);
+            position += count;
+
+            // Blocks of several hops only expose the last one; keep that
+            if (metrics.getHopCount() != seen)
+            {
+                seen = metrics.getHopCount();
+                perHop.resize(static_cast<size_t>(seen));
+                perHop.back() = { metrics.getChannelRMS(0), metrics.getChannelRMS(1),
+                                  metrics.getPeakLevel(), metrics.getMomentaryLufs() };
+            }
+        }
+
+        return perHop;
+    }
+
+    void testMeteringIndependentOfBlockSize()
+    {
+        beginTest("RMS, peak and loudness are the same for every block size");
+
+        const int numHops = 200;
+        const auto reference = meter(480, numHops);
+        expectEquals(static_cast<int>(reference.size()), numHops);
+
+        for (const int setting : getBlockSizes())
+        {
+            const auto levels = meter(setting, numHops);
+            expectEquals(static_cast<int>(levels.size()), numHops);
+
+            int compared = 0;
+            float worst = 0.0f;
+
+            for (size_t hop = 0; hop < levels.size() && hop < reference.size(); ++hop)
+            {
+                // Hops skipped inside one large block have nothing to compare
+                if (levels[hop][0] == 0.0f && levels[hop][2] == 0.0f)
+                    continue;
+
+                ++compared;
+                for (size_t value = 0; value < 4; ++value)
+                    worst = juce::jmax(worst, std::abs(levels[hop][value] - reference[hop][value]));
+            }
+
+            expect(compared > 0);
+            expect(worst < 1.0e-4f, "block size " + juce::String(setting) + " differs by " + juce::String(worst));
+        }
+    }
+
+    void testHopCount()
+    {
+        beginTest("Hop count is a sample-accurate time stamp");
+
+        AudioMetrics unprepared;
+        juce::AudioBuffer<float> buffer(2, 1000);
+        buffer.clear();
+        unprepared.updateMetrics(buffer);
+        expectEquals(unprepared.getHopCount(), static_cast<juce::int64>(0));
+
+        AudioMetrics metrics;
+        metrics.prepare(44100.0, 1000, juce::AudioChannelSet::stereo());
+        expectEquals(metrics.getHopSamples(), 441);
+
+        // 1000 + 1000 + 205 = 2205 samples = 5 hops exactly
+        for (const int count : { 1000, 1000, 205 })
+        {
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, 0, count);
+            metrics.updateMetrics(block);
+        }
+
+        expectEquals(metrics.getHopCount(), static_cast<juce::int64>(5));
+    }
+
+    void testCostPerSecond()
+    {
+        beginTest("Metering cost per second does not grow with small blocks");
+
+        const auto secondsPerSecond = [](int blockSize)
+        {
+            AudioMetrics metrics;
+            metrics.prepare(sampleRate, 1024, juce::AudioChannelSet::stereo());
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::Random random(3);
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+
+            const int blocks = juce::roundToInt(10.0 * sampleRate / blockSize);
+            const double start = juce::Time::getMillisecondCounterHiRes();
+
+            for (int block = 0; block < blocks; ++block)
+                metrics.updateMetrics(buffer);
+
+            return (juce::Time::getMillisecondCounterHiRes() - start) / 10000.0;
+        };
+
+        const double small = secondsPerSecond(64);
+        const double large = secondsPerSecond(1024);
+
+        logMessage("Metering load: " + juce::String(small * 100.0, 3) + "% at 64 samples, "
+                   + juce::String(large * 100.0, 3) + "% at 1024 samples");
+
+        // Per-block overhead remains; per-sample work is the same
+        expect(small < large * 4.0 + 0.001, "small blocks cost disproportionately more");
+    }
+};
+
+static HopSchedulerTests hopSchedulerTests;
+
+} // namespace AIplayer
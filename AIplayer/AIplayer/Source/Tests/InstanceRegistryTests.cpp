@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    InstanceRegistryTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the process-wide instance registry: slot claiming, entry
+    updates and processor registration.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Core/InstanceRegistry.h"
+#include "../PluginProcessor.h"
+#include <vector>
+
+namespace AIplayer {
+
+class InstanceRegistryTests : public juce::UnitTest
+{
+public:
+    InstanceRegistryTests() : UnitTest("Instance Registry Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testSlots();
+        testUpdates();
+        testCapacity();
+        testProcessorRegistration();
+    }
+
+private:
+    using Entry = InstanceRegistry::Entry;
+
+    /// Finds the live entry with this instance ID
+    static bool findEntry(const juce::String& instanceID, Entry& found)
+    {
+        std::vector<Entry> entries(static_cast<size_t>(InstanceRegistry::MAX_INSTANCES));
+        const int count = InstanceRegistry::getInstance().getEntries(entries.data(), InstanceRegistry::MAX_INSTANCES);
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (instanceID == juce::String::fromUTF8(entries[static_cast<size_t>(i)].instanceID))
+            {
+                found = entries[static_cast<size_t>(i)];
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void testSlots()
+    {
+        beginTest("Instances claim and free slots");
+
+        auto& registry = InstanceRegistry::getInstance();
+        const int before = registry.getNumInstances();
+
+        const int first = registry.add("first");
+        const int second = registry.add("second");
+        expect(first >= 0 && second >= 0 && first != second);
+        expectEquals(registry.getNumInstances(), before + 2);
+
+        Entry entry;
+        expect(findEntry("first", entry));
+        expectEquals(entry.port, -1);
+        expectEquals(juce::String::fromUTF8(entry.trackID), juce::String());
+        expectEquals(entry.metricsTimeMs, static_cast<uint32_t>(0));
+
+        // A freed slot is reused, without the previous owner's entry
+        registry.setIdentity(first, "first", "TR1");
+        registry.remove(first);
+        expect(! findEntry("first", entry));
+
+        const int third = registry.add("third");
+        expectEquals(third, first);
+        expect(findEntry("third", entry));
+        expectEquals(juce::String::fromUTF8(entry.trackID), juce::String());
+
+        registry.remove(second);
+        registry.remove(third);
+        expectEquals(registry.getNumInstances(), before);
+
+        // Updating a freed or missing slot does nothing
+        registry.setMetrics(third, -6.0f, -3.0f, -8.0f);
+        registry.setConnection(-1, 50000, "Bound");
+        expectEquals(registry.getNumInstances(), before);
+    }
+
+    void testUpdates()
+    {
+        beginTest("Identity, connection and levels update separately");
+
+        auto& registry = InstanceRegistry::getInstance();
+        const int slot = registry.add("updates");
+
+        registry.setConnection(slot, 50100, "Bound");
+        registry.setMetrics(slot, -18.0f, -6.0f, -20.0f);
+        registry.setIdentity(slot, "updates", "TR7");
+
+        Entry entry;
+        expect(findEntry("updates", entry));
+        expectEquals(juce::String::fromUTF8(entry.trackID), juce::String("TR7"));
+        expectEquals(entry.port, 50100);
+        expectEquals(juce::String::fromUTF8(entry.state), juce::String("Bound"));
+        expectEquals(entry.rmsDb, -18.0f);
+        expectEquals(entry.peakDb, -6.0f);
+        expectEquals(entry.loudnessLufs, -20.0f);
+        expect(entry.metricsTimeMs != 0);
+
+        // Over-long IDs are cut to fit, still terminated
+        registry.setIdentity(slot, "updates", juce::String::repeatedString("x", 200));
+        expect(findEntry("updates", entry));
+        expectEquals(juce::String::fromUTF8(entry.trackID).length(), InstanceRegistry::ID_CAPACITY - 1);
+
+        registry.remove(slot);
+    }
+
+    void testCapacity()
+    {
+        beginTest("A full registry refuses new instances");
+
+        auto& registry = InstanceRegistry::getInstance();
+        std::vector<int> claimed;
+
+        for (int slot = registry.add("fill"); slot >= 0; slot = registry.add("fill"))
+            claimed.push_back(slot);
+
+        expectEquals(registry.getNumInstances(), InstanceRegistry::MAX_INSTANCES);
+        expectEquals(registry.add("overflow"), -1);
+
+        // A short destination gets the first entries only
+        std::vector<Entry> entries(4);
+        expectEquals(registry.getEntries(entries.data(), 4), 4);
+
+        for (const int slot : claimed)
+            registry.remove(slot);
+    }
+
+    void testProcessorRegistration()
+    {
+        beginTest("Processors register themselves and answer for all instances");
+
+        auto& registry = InstanceRegistry::getInstance();
+        const int before = registry.getNumInstances();
+        juce::String instanceID;
+
+        {
+            AIplayerAudioProcessor processor;
+            auto& listener = static_cast<OSCManager::Listener&>(processor);
+            instanceID = processor.getTempInstanceID();
+
+            expect(processor.getRegistrySlot() >= 0);
+            expectEquals(registry.getNumInstances(), before + 1);
+
+            Entry entry;
+            expect(findEntry(instanceID, entry));
+            expect(juce::String::fromUTF8(entry.state).isNotEmpty(), "port state not recorded");
+
+            listener.handleTrackAssignment("TR3");
+            expect(findEntry(instanceID, entry));
+            expectEquals(juce::String::fromUTF8(entry.trackID), juce::String("TR3"));
+
+            // Nothing to send to here, but the query is handled
+            listener.handleInstancesQuery("q1");
+        }
+
+        Entry entry;
+        expect(! findEntry(instanceID, entry));
+        expectEquals(registry.getNumInstances(), before);
+    }
+};
+
+static InstanceRegistryTests instanceRegistryTests;
+
+} // namespace AIplayer
@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+
+    LongTermSpectrumTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the long-term average spectrum: integration modes, FFT-size
+    and window independence, reference curves and the suggested EQ.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/FrequencyAnalyzer.h"
+#include "../Audio/LongTermSpectrum.h"
+#include "../Core/Logger.h"
+
+namespace AIplayer {
+
+class LongTermSpectrumTests : public juce::UnitTest
+{
+public:
+    LongTermSpectrumTests() : UnitTest("Long-Term Spectrum Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testFlatSpectrum();
+        testIntegrationModes();
+        testReferenceComparison();
+        testReferenceFile();
+        testAnalyzerFeedsAverage();
+        testNoiseAcrossFFTSizes();
+        testCostPerFrame();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+
+    /// Rectangular window: one bin of noise bandwidth
+    static constexpr float rectangular = 1.0f;
+
+    /// Magnitudes of a flat (white) spectrum at a given power density, as an
+    /// FFT with this bin width and window noise bandwidth would read it
+    static std::vector<float> whiteMagnitudes(int numBins, float densityDb, float binWidth,
+                                              float noiseBandwidth = rectangular)
+    {
+        const float magnitude = juce::Decibels::decibelsToGain(densityDb) * std::sqrt(noiseBandwidth * binWidth);
+        return std::vector<float>(static_cast<size_t>(numBins), magnitude);
+    }
+
+    /// Highest bin below Nyquist at this sample rate
+    static int lastAudibleBin()
+    {
+        int bin = 0;
+        while (bin + 1 < LongTermSpectrum::NUM_BINS
+               && LongTermSpectrum::getBinFrequency(bin + 1) < sampleRate * 0.45)
+            ++bin;
+        return bin;
+    }
+
+    void testFlatSpectrum()
+    {
+        beginTest("White spectrum averages flat, independent of FFT size and window");
+
+        // Rectangular, Hann and flat-top noise bandwidths
+        for (const float noiseBandwidth : { rectangular, 1.5f, 3.77f })
+        {
+            for (const int fftSize : { 512, 2048, 8192 })
+            {
+                LongTermSpectrum ltas;
+                const float binWidth = static_cast<float>(sampleRate / fftSize);
+                const auto magnitudes = whiteMagnitudes(fftSize / 2, -30.0f, binWidth, noiseBandwidth);
+
+                for (int frame = 0; frame < 20; ++frame)
+                    ltas.addFrame(magnitudes.data(), fftSize / 2, binWidth, noiseBandwidth, 0.1);
+
+                float worst = 0.0f;
+                for (int bin = 0; bin <= lastAudibleBin(); ++bin)
+                    worst = juce::jmax(worst, std::abs(ltas.getLevelDb(bin) + 30.0f));
+
+                expectLessOrEqual(worst, 0.01f, "FFT size " + juce::String(fftSize)
+                                  + ", ENBW " + juce::String(noiseBandwidth, 2));
+                expectWithinAbsoluteError(ltas.getIntegratedSeconds(), 2.0, 1.0e-9);
+            }
+        }
+    }
+
+    void testIntegrationModes()
+    {
+        beginTest("Infinite mode is the power mean; exponential follows changes");
+
+        const int numBins = 1024;
+        const float binWidth = static_cast<float>(sampleRate / 2048.0);
+        const auto loud = whiteMagnitudes(numBins, -20.0f, binWidth);
+        const auto quiet = whiteMagnitudes(numBins, -40.0f, binWidth);
+
+        // Equal time at two levels: the power mean is 3 dB under the louder one
+        LongTermSpectrum infinite;
+        infinite.setMode(LongTermSpectrum::Mode::Infinite);
+        for (int frame = 0; frame < 100; ++frame)
+            infinite.addFrame((frame % 2 == 0 ? loud : quiet).data(), numBins, binWidth, rectangular, 0.1);
+
+        const double expectedDb = 10.0 * std::log10((0.01 + 0.0001) / 2.0);
+        expectWithinAbsoluteError(infinite.getLevelDb(30), static_cast<float>(expectedDb), 0.01f);
+
+        // Exponential: after a step, one time constant covers 63% of the power change
+        LongTermSpectrum exponential;
+        exponential.setMode(LongTermSpectrum::Mode::Exponential, 5.0);
+
+        for (int frame = 0; frame < 1000; ++frame)
+            exponential.addFrame(quiet.data(), numBins, binWidth, rectangular, 0.1);
+        expectWithinAbsoluteError(exponential.getLevelDb(30), -40.0f, 0.01f);
+
+        for (int frame = 0; frame < 50; ++frame)
+            exponential.addFrame(loud.data(), numBins, binWidth, rectangular, 0.1);
+
+        const double expectedPower = 0.0001 + (0.01 - 0.0001) * (1.0 - std::exp(-1.0));
+        expectWithinAbsoluteError(exponential.getLevelDb(30), static_cast<float>(10.0 * std::log10(expectedPower)), 0.1f);
+
+        exponential.reset();
+        expectEquals(exponential.getLevelDb(30), LongTermSpectrum::FLOOR_DB);
+        expectEquals(exponential.getIntegratedSeconds(), 0.0);
+    }
+
+    void testReferenceComparison()
+    {
+        beginTest("Comparison aligns the reference and suggests the inverse EQ");
+
+        LongTermSpectrum ltas;
+        expect(! ltas.compare("flat").valid, "comparison without data or reference");
+
+        const int numBins = 4096;
+        const float binWidth = static_cast<float>(sampleRate / 8192.0);
+        const auto magnitudes = whiteMagnitudes(numBins, -30.0f, binWidth);
+        ltas.addFrame(magnitudes.data(), numBins, binWidth, rectangular, 1.0);
+
+        // A reference 40 dB lower and tilted by -3 dB per octave above 1 kHz
+        const float frequencies[] = { 20.0f, 1000.0f, 2000.0f, 4000.0f, 8000.0f, 16000.0f };
+        const float levels[] = { -70.0f, -70.0f, -73.0f, -76.0f, -79.0f, -82.0f };
+        expect(ltas.setReference("tilt", frequencies, levels, 6));
+        expect(ltas.hasReference("tilt"));
+        expect(! ltas.setReference("bad", frequencies, levels, 1));
+
+        const auto result = ltas.compare("tilt");
+        expect(result.valid);
+
+        // Alignment absorbs the overall level; deviations average to zero
+        float sum = 0.0f;
+        const int last = lastAudibleBin();
+        for (int bin = 0; bin <= last; ++bin)
+            sum += result.deviationDb[static_cast<size_t>(bin)];
+        expectWithinAbsoluteError(sum / static_cast<float>(last + 1), 0.0f, 0.5f);
+
+        // A flat track against a falling reference is too bright: positive deviation up top, cut suggested
+        expect(result.bandDeviationDb[3] > result.bandDeviationDb[0] + 6.0f);
+        expect(result.eqDb[static_cast<size_t>(last - 2)] < 0.0f);
+        expect(result.eqDb[5] > 0.0f);
+
+        // Inside the straight segment the smoothed EQ is the exact inverse
+        for (int bin = 0; bin <= last; ++bin)
+        {
+            const float frequency = LongTermSpectrum::getBinFrequency(bin);
+            if (frequency > 2500.0f && frequency < 14000.0f)
+                expectWithinAbsoluteError(result.eqDb[static_cast<size_t>(bin)], -result.deviationDb[static_cast<size_t>(bin)], 0.05f);
+
+            expectLessOrEqual(std::abs(result.eqDb[static_cast<size_t>(bin)]), LongTermSpectrum::MAX_EQ_DB);
+        }
+
+        expect(result.rmsDeviationDb > 0.0f);
+        expectWithinAbsoluteError(result.offsetDb, 40.0f + 6.0f, 6.0f);
+    }
+
+    void testReferenceFile()
+    {
+        beginTest("Reference curves load from text files");
+
+        const auto file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                              .getChildFile("AIplayerTest").getNonexistentChildFile("reference", ".txt");
+        file.getParentDirectory().createDirectory();
+        expect(file.replaceWithText("# genre reference\n20, -60\n1000;-62\n\n20000 -80\n"));
+
+        LongTermSpectrum ltas;
+        expect(ltas.loadReference("genre", file));
+        expect(ltas.getReferenceNames().contains("genre"));
+        expect(! ltas.loadReference("missing", file.getSiblingFile("missing.txt")));
+
+        file.deleteFile();
+    }
+
+    void testAnalyzerFeedsAverage()
+    {
+        beginTest("Every analysis frame feeds the average");
+
+        juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("AIplayerTest");
+        tempDir.createDirectory();
+        Logger logger(tempDir.getChildFile("ltas.log"));
+
+        FrequencyAnalyzer::Config config;
+        config.autoStart = false;
+        FrequencyAnalyzer analyzer(logger, config);
+
+        juce::AudioBuffer<float> buffer(1, 1024);
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(0, i, 0.5f * std::sin(juce::MathConstants<float>::twoPi * 1000.0f * i / static_cast<float>(sampleRate)));
+
+        for (int frame = 0; frame < 5; ++frame)
+        {
+            analyzer.processBlock(buffer, sampleRate);
+            expect(analyzer.computeNow());
+        }
+
+        // Without overlap each frame stands for one FFT size of audio
+        const auto& ltas = analyzer.getLongTermSpectrum();
+        expectWithinAbsoluteError(ltas.getIntegratedSeconds(), 5.0 * analyzer.getFFTSize() / sampleRate, 1.0e-9);
+
+        int loudest = 0;
+        for (int bin = 1; bin < LongTermSpectrum::NUM_BINS; ++bin)
+            if (ltas.getLevelDb(bin) > ltas.getLevelDb(loudest))
+                loudest = bin;
+
+        expectWithinAbsoluteError(std::log2(LongTermSpectrum::getBinFrequency(loudest) / 1000.0f), 0.0f, 0.2f);
+    }
+
+    void testNoiseAcrossFFTSizes()
+    {
+        beginTest("Noise reads the same level at every FFT size");
+
+        juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("AIplayerTest");
+        tempDir.createDirectory();
+        Logger logger(tempDir.getChildFile("ltas.log"));
+
+        // Mean level over the 2-8 kHz bins, after two seconds of white noise
+        const auto measure = [&](int fftOrder)
+        {
+            FrequencyAnalyzer::Config config;
+            config.autoStart = false;
+            config.fftOrder = fftOrder;
+            FrequencyAnalyzer analyzer(logger, config);
+
+            juce::AudioBuffer<float> buffer(1, 1024);
+            juce::Random random(7);
+
+            for (int block = 0; block < 94; ++block)
+            {
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample(0, i, 0.5f * (random.nextFloat() * 2.0f - 1.0f));
+
+                analyzer.processBlock(buffer, sampleRate);
+                analyzer.computeNow();
+            }
+
+            const auto& ltas = analyzer.getLongTermSpectrum();
+            float sum = 0.0f;
+            int count = 0;
+
+            for (int bin = 0; bin < LongTermSpectrum::NUM_BINS; ++bin)
+            {
+                const float frequency = LongTermSpectrum::getBinFrequency(bin);
+                if (frequency >= 2000.0f && frequency <= 8000.0f)
+                {
+                    sum += ltas.getLevelDb(bin);
+                    ++count;
+                }
+            }
+
+            return sum / static_cast<float>(juce::jmax(1, count));
+        };
+
+        const float small = measure(9);
+        const float large = measure(12);
+        logMessage("LTAS noise density: " + juce::String(small, 2) + " dB (512), "
+                   + juce::String(large, 2) + " dB (4096)");
+
+        expect(small > LongTermSpectrum::FLOOR_DB + 20.0f, "no noise in the average");
+        expectWithinAbsoluteError(large, small, 0.5f);
+    }
+
+    void testCostPerFrame()
+    {
+        beginTest("Accumulating a frame is cheap");
+
+        LongTermSpectrum ltas;
+        juce::Random random(1);
+        std::vector<float> magnitudes(2048);
+        for (auto& magnitude : magnitudes)
+            magnitude = random.nextFloat();
+
+        const int frames = 10000;
+        const double start = juce::Time::getMillisecondCounterHiRes();
+
+        for (int frame = 0; frame < frames; ++frame)
+            ltas.addFrame(magnitudes.data(), 2048, static_cast<float>(sampleRate / 4096.0), rectangular, 0.01);
+
+        const double microseconds = (juce::Time::getMillisecondCounterHiRes() - start) * 1000.0 / frames;
+        logMessage("LTAS: " + juce::String(microseconds, 2) + " us per 4096-point frame");
+        expect(microseconds < 200.0);
+    }
+};
+
+static LongTermSpectrumTests longTermSpectrumTests;
+
+} // namespace AIplayer
@@ -0,0 +1,346 @@
+/*
+  ==============================================================================
+
+    LookaheadLimiterTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the true-peak detector and the lookahead limiter: inter-sample
+    peak detection, the ceiling guarantee (also for the plugin's calibration
+    tone), latency, release and CPU cost.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/LookaheadLimiter.h"
+#include "../Audio/TruePeakDetector.h"
+#include "../Core/Constants.h"
+#include "../PluginProcessor.h"
+
+namespace AIplayer {
+
+class LookaheadLimiterTests : public juce::UnitTest
+{
+public:
+    LookaheadLimiterTests() : UnitTest("Lookahead Limiter Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testTruePeakDetection();
+        testBypass();
+        testTransparencyAndLatency();
+        testCeiling();
+        testToneUnderCeiling();
+        testRelease();
+        testPerformance();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 480;
+
+    static LookaheadLimiter::Settings enabledSettings(float ceilingDb)
+    {
+        LookaheadLimiter::Settings settings;
+        settings.enabled = true;
+        settings.ceilingDb = ceilingDb;
+        return settings;
+    }
+
+    /// Runs a whole buffer through the limiter in host-sized blocks
+    static void processInBlocks(LookaheadLimiter& limiter, juce::AudioBuffer<float>& audio)
+    {
+        for (int start = 0; start < audio.getNumSamples(); start += blockSize)
+        {
+            const int count = juce::jmin(blockSize, audio.getNumSamples() - start);
+            juce::AudioBuffer<float> block(audio.getArrayOfWritePointers(), audio.getNumChannels(), start, count);
+            limiter.process(block);
+        }
+    }
+
+    /// Largest true peak of a buffer from sample `start` on (dBTP)
+    static float measureTruePeakDb(const juce::AudioBuffer<float>& audio, int start)
+    {
+        TruePeakDetector detector;
+        detector.prepare(audio.getNumChannels());
+
+        const auto* const* channels = audio.getArrayOfReadPointers();
+        float peak = 0.0f;
+        for (int i = 0; i < audio.getNumSamples(); ++i)
+        {
+            const float framePeak = detector.processFrame(channels, audio.getNumChannels(), i);
+            if (i >= start + TruePeakDetector::DELAY_SAMPLES)
+                peak = juce::jmax(peak, framePeak);
+        }
+
+        return juce::Decibels::gainToDecibels(peak, -120.0f);
+    }
+
+    void testTruePeakDetection()
+    {
+        beginTest("Detects inter-sample peaks");
+
+        // Quarter-rate sine at 45 degrees: every sample sits 3 dB below the peak
+        juce::AudioBuffer<float> audio(1, 4800);
+        for (int i = 0; i < audio.getNumSamples(); ++i)
+            audio.setSample(0, i, 0.5f * static_cast<float>(std::sin(juce::MathConstants<double>::halfPi * i
+                                                                    + juce::MathConstants<double>::pi * 0.25)));
+
+        const float samplePeakDb = juce::Decibels::gainToDecibels(audio.getMagnitude(0, 0, audio.getNumSamples()));
+        const float truePeakDb = measureTruePeakDb(audio, 100);
+
+        logMessage("fs/4 sine, 0.5 peak: sample peak " + juce::String(samplePeakDb, 2) + " dBFS, true peak "
+                   + juce::String(truePeakDb, 2) + " dBTP");
+
+        expectWithinAbsoluteError(samplePeakDb, -9.03f, 0.05f);
+        expectWithinAbsoluteError(truePeakDb, -6.02f, 0.2f);
+    }
+
+    void testBypass()
+    {
+        beginTest("Disabled limiter keeps its latency and only delays the audio");
+
+        LookaheadLimiter limiter;
+        limiter.prepare(sampleRate, blockSize, 2);
+
+        const int latency = limiter.getLatencySamples();
+        expect(latency > 0);
+
+        // Toggling does not change the latency the host sees
+        limiter.setSettings(enabledSettings(-1.0f));
+        expectEquals(limiter.getLatencySamples(), latency);
+        limiter.setSettings({});
+
+        juce::AudioBuffer<float> audio(2, 4 * blockSize);
+        juce::Random random(7);
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < audio.getNumSamples(); ++i)
+                audio.setSample(channel, i, 4.0f * (random.nextFloat() - 0.5f));
+
+        juce::AudioBuffer<float> original(audio);
+        processInBlocks(limiter, audio);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            for (int i = 0; i < latency; ++i)
+                expectEquals(audio.getSample(channel, i), 0.0f);
+            for (int i = latency; i < audio.getNumSamples(); ++i)
+                expectEquals(audio.getSample(channel, i), original.getSample(channel, i - latency));
+        }
+
+        // Switching on mid-stream keeps the delayed audio continuous (a quiet
+        // signal passes unchanged across the switch)
+        LookaheadLimiter toggled;
+        toggled.prepare(sampleRate, blockSize, 1);
+
+        juce::AudioBuffer<float> quiet(1, 4 * blockSize);
+        for (int i = 0; i < quiet.getNumSamples(); ++i)
+            quiet.setSample(0, i, 0.1f * static_cast<float>(std::sin(0.05 * i)));
+
+        juce::AudioBuffer<float> quietOriginal(quiet);
+        for (int start = 0; start < quiet.getNumSamples(); start += blockSize)
+        {
+            toggled.setSettings(start < 2 * blockSize ? LookaheadLimiter::Settings{} : enabledSettings(-1.0f));
+            juce::AudioBuffer<float> block(quiet.getArrayOfWritePointers(), 1, start, blockSize);
+            toggled.process(block);
+        }
+
+        float maxError = 0.0f;
+        for (int i = latency; i < quiet.getNumSamples(); ++i)
+            maxError = juce::jmax(maxError, std::abs(quiet.getSample(0, i) - quietOriginal.getSample(0, i - latency)));
+        expectWithinAbsoluteError(maxError, 0.0f, 1.0e-6f);
+    }
+
+    void testTransparencyAndLatency()
+    {
+        beginTest("Below the ceiling the output is the input delayed by the reported latency");
+
+        LookaheadLimiter limiter;
+        limiter.prepare(sampleRate, blockSize, 2);
+        limiter.setSettings(enabledSettings(-1.0f));
+
+        const int latency = limiter.getLatencySamples();
+        const int expected = juce::roundToInt(LookaheadLimiter::LOOKAHEAD_MS * 0.001 * sampleRate) - 1
+                           + TruePeakDetector::DELAY_SAMPLES;
+        expectEquals(latency, expected);
+
+        juce::AudioBuffer<float> audio(2, 9600);
+        const double increment = juce::MathConstants<double>::twoPi * 997.0 / sampleRate;
+        for (int i = 0; i < audio.getNumSamples(); ++i)
+        {
+            audio.setSample(0, i, 0.25f * static_cast<float>(std::sin(increment * i)));
+            audio.setSample(1, i, 0.25f * static_cast<float>(std::cos(increment * i)));
+        }
+
+        juce::AudioBuffer<float> original(audio);
+        processInBlocks(limiter, audio);
+
+        float maxError = 0.0f;
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = latency; i < audio.getNumSamples(); ++i)
+                maxError = juce::jmax(maxError, std::abs(audio.getSample(channel, i)
+                                                         - original.getSample(channel, i - latency)));
+
+        logMessage("Latency " + juce::String(latency) + " samples, max error " + juce::String(maxError));
+        expectEquals(maxError, 0.0f);
+        expectEquals(limiter.getGainReductionDb(), 0.0f);
+    }
+
+    void testCeiling()
+    {
+        beginTest("Output true peak stays at the ceiling");
+
+        for (const float ceilingDb : { -1.0f, -3.0f, -0.1f })
+        {
+            LookaheadLimiter limiter;
+            limiter.prepare(sampleRate, blockSize, 2);
+            limiter.setSettings(enabledSettings(ceilingDb));
+
+            // Gated +6 dBFS tone with noise, a square burst and an isolated click
+            juce::AudioBuffer<float> audio(2, 48000);
+            juce::Random random(42);
+            const double increment = juce::MathConstants<double>::twoPi * 997.0 / sampleRate;
+
+            for (int i = 0; i < audio.getNumSamples(); ++i)
+            {
+                const float gate = (i / 2000) % 2 == 0 ? 1.0f : 0.3f;
+                float left = 2.0f * gate * static_cast<float>(std::sin(increment * i)) + random.nextFloat() - 0.5f;
+                float right = 2.0f * gate * static_cast<float>(std::sin(increment * i + 1.0)) + random.nextFloat() - 0.5f;
+
+                if (i >= 30000 && i < 33000)
+                    left = right = (i / 7) % 2 == 0 ? 1.8f : -1.8f;
+                else if (i >= 36000 && i < 40000)
+                    left = right = i == 38000 ? 3.0f : 0.0f;
+
+                audio.setSample(0, i, left);
+                audio.setSample(1, i, right);
+            }
+
+            processInBlocks(limiter, audio);
+
+            const float outputDb = measureTruePeakDb(audio, limiter.getLatencySamples());
+            logMessage("Ceiling " + juce::String(ceilingDb, 1) + " dBTP: output true peak "
+                       + juce::String(outputDb, 3) + " dBTP");
+
+            expect(outputDb <= ceilingDb + 0.05f, "True-peak ceiling exceeded");
+            expect(outputDb > ceilingDb - 0.5f, "Limiter reduces more than needed");
+        }
+    }
+
+    void testToneUnderCeiling()
+    {
+        beginTest("Calibration tone is held under the plugin's ceiling");
+
+        namespace P = Constants::Parameters;
+        constexpr float ceilingDb = -3.0f;
+
+        AIplayerAudioProcessor processor;
+
+        const auto setParameter = [&processor](const char* id, float value)
+        {
+            if (auto* parameter = processor.apvts.getParameter(id))
+                parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        };
+
+        setParameter(P::LIMITER_ENABLED_ID, 1.0f);
+        setParameter(P::LIMITER_CEILING_ID, ceilingDb);
+
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        // +6 dBFS tone over silence: only the tone can reach the output
+        auto& tone = processor.getToneGenerator();
+        tone.setTone(997.0f, 6.0f);
+        tone.startTone();
+
+        const int numChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+        juce::AudioBuffer<float> output(numChannels, 48000);
+        juce::AudioBuffer<float> block(numChannels, blockSize);
+        juce::MidiBuffer midi;
+
+        for (int start = 0; start < output.getNumSamples(); start += blockSize)
+        {
+            const int count = juce::jmin(blockSize, output.getNumSamples() - start);
+            block.clear();
+
+            juce::AudioBuffer<float> callback(block.getArrayOfWritePointers(), numChannels, count);
+            processor.processBlock(callback, midi);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                output.copyFrom(channel, start, callback, channel, 0, count);
+        }
+
+        processor.releaseResources();
+
+        const float outputDb = measureTruePeakDb(output, processor.getLatencySamples());
+        logMessage("Tone +6 dBFS, ceiling " + juce::String(ceilingDb, 1) + " dBTP: output true peak "
+                   + juce::String(outputDb, 3) + " dBTP");
+
+        expect(outputDb <= ceilingDb + 0.05f, "Calibration tone exceeds the true-peak ceiling");
+        expect(outputDb > ceilingDb - 1.0f, "Calibration tone missing from the output");
+    }
+
+    void testRelease()
+    {
+        beginTest("Gain recovers after the release time");
+
+        LookaheadLimiter limiter;
+        limiter.prepare(sampleRate, blockSize, 1);
+        auto settings = enabledSettings(-1.0f);
+        settings.releaseMs = 50.0f;
+        limiter.setSettings(settings);
+
+        // 100 ms at +6 dBFS, then 500 ms at -12 dBFS (10 release time constants)
+        juce::AudioBuffer<float> audio(1, 28800);
+        const double increment = juce::MathConstants<double>::twoPi * 1000.0 / sampleRate;
+        for (int i = 0; i < audio.getNumSamples(); ++i)
+            audio.setSample(0, i, (i < 4800 ? 2.0f : 0.25f) * static_cast<float>(std::sin(increment * i)));
+
+        juce::AudioBuffer<float> burst(audio.getArrayOfWritePointers(), 1, 0, 4800);
+        limiter.process(burst);
+        const float burstReductionDb = limiter.getGainReductionDb();
+
+        juce::AudioBuffer<float> tail(audio.getArrayOfWritePointers(), 1, 4800, audio.getNumSamples() - 4800);
+        processInBlocks(limiter, tail);
+
+        const float endLevel = audio.getMagnitude(0, audio.getNumSamples() - 2400, 2400);
+        const float endGainDb = juce::Decibels::gainToDecibels(endLevel / 0.25f);
+
+        logMessage("Burst reduction " + juce::String(burstReductionDb, 2) + " dB, gain after 10 tau "
+                   + juce::String(endGainDb, 3) + " dB");
+
+        expect(burstReductionDb < -6.0f, "No gain reduction on a +6 dBFS burst");
+        expectWithinAbsoluteError(endGainDb, 0.0f, 0.1f);
+    }
+
+    void testPerformance()
+    {
+        beginTest("Performance benchmark");
+
+        LookaheadLimiter limiter;
+        limiter.prepare(sampleRate, 512, 2);
+        limiter.setSettings(enabledSettings(-1.0f));
+
+        juce::AudioBuffer<float> block(2, 512);
+        juce::Random random(42);
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < 512; ++i)
+                block.setSample(channel, i, 4.0f * (random.nextFloat() - 0.5f));
+
+        const int iterations = 2000;
+        const double start = juce::Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < iterations; ++i)
+            limiter.process(block);
+
+        const double perBlockUs = 1000.0 * (juce::Time::getMillisecondCounterHiRes() - start) / iterations;
+
+        logMessage("Stereo, 512 samples: " + juce::String(perBlockUs, 2) + " us per block");
+        expect(perBlockUs < 500.0, "Limiter too slow");
+    }
+};
+
+static LookaheadLimiterTests lookaheadLimiterTests;
+
+} // namespace AIplayer
@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+    MultichannelTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for surround/discrete bus support: channel weights, per-channel
+    metering, weighted loudness and the analysis downmix.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/AudioMetrics.h"
+#include "../Audio/ChannelLayout.h"
+#include "../Audio/FFTProcessor.h"
+#include "../Audio/LoudnessMeter.h"
+
+namespace AIplayer {
+
+class MultichannelTests : public juce::UnitTest
+{
+public:
+    MultichannelTests() : UnitTest("Multichannel Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testLoudnessWeights();
+        testDownmixGains();
+        testWeightedLoudness();
+        testPerChannelMetering();
+        testAnalysisDownmix();
+        testPerformance();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 480;
+
+    /// Sine of the given amplitude in one channel, silence elsewhere
+    static void fillChannel(juce::AudioBuffer<float>& buffer, int channel, float amplitude, double& phase)
+    {
+        buffer.clear();
+        const double increment = juce::MathConstants<double>::twoPi * 997.0 / sampleRate;
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            buffer.setSample(channel, i, amplitude * static_cast<float>(std::sin(phase)));
+            phase += increment;
+        }
+    }
+
+    void testLoudnessWeights()
+    {
+        beginTest("BS.1770 channel weights");
+
+        float weights[ChannelLayout::MAX_CHANNELS];
+
+        // 5.1: L R C LFE Ls Rs
+        ChannelLayout::loudnessWeights(juce::AudioChannelSet::create5point1(), weights);
+        expectEquals(weights[0], 1.0f);
+        expectEquals(weights[2], 1.0f);
+        expectEquals(weights[3], 0.0f);
+        expectEquals(weights[4], ChannelLayout::SURROUND_WEIGHT);
+        expectEquals(weights[5], ChannelLayout::SURROUND_WEIGHT);
+        expectEquals(weights[6], 0.0f);
+
+        // 7.1.4: one LFE, two side surrounds at 1.41, everything else 1.0
+        const auto atmos = juce::AudioChannelSet::create7point1point4();
+        ChannelLayout::loudnessWeights(atmos, weights);
+
+        int lfe = 0, surround = 0, unity = 0;
+        for (int channel = 0; channel < atmos.size(); ++channel)
+        {
+            lfe += weights[channel] == 0.0f ? 1 : 0;
+            surround += weights[channel] == ChannelLayout::SURROUND_WEIGHT ? 1 : 0;
+            unity += weights[channel] == 1.0f ? 1 : 0;
+        }
+
+        expectEquals(atmos.size(), 12);
+        expectEquals(lfe, 1);
+        expectEquals(surround, 2);
+        expectEquals(unity, 9);
+
+        // Discrete channels all count
+        ChannelLayout::loudnessWeights(juce::AudioChannelSet::discreteChannels(16), weights);
+        for (int channel = 0; channel < 16; ++channel)
+            expectEquals(weights[channel], 1.0f);
+    }
+
+    void testDownmixGains()
+    {
+        beginTest("Downmix gains sum to one");
+
+        float gains[ChannelLayout::MAX_CHANNELS];
+        const auto layout = juce::AudioChannelSet::create5point1();
+
+        for (int mode = 0; mode < ChannelLayout::NUM_DOWNMIX_MODES; ++mode)
+        {
+            ChannelLayout::downmixGains(static_cast<ChannelLayout::Downmix>(mode), layout, gains);
+
+            float total = 0.0f;
+            for (int channel = 0; channel < layout.size(); ++channel)
+                total += gains[channel];
+
+            expectWithinAbsoluteError(total, 1.0f, 1.0e-5f);
+        }
+
+        ChannelLayout::downmixGains(ChannelLayout::Downmix::NoLfe, layout, gains);
+        expectEquals(gains[3], 0.0f);
+        expectWithinAbsoluteError(gains[0], 0.2f, 1.0e-6f);
+
+        ChannelLayout::downmixGains(ChannelLayout::Downmix::Front, layout, gains);
+        expectWithinAbsoluteError(gains[2], 1.0f / 3.0f, 1.0e-6f);
+        expectEquals(gains[4], 0.0f);
+
+        ChannelLayout::downmixGains(ChannelLayout::Downmix::Front, juce::AudioChannelSet::discreteChannels(8), gains);
+        expectEquals(gains[0], 0.5f);
+        expectEquals(gains[2], 0.0f);
+    }
+
+    void testWeightedLoudness()
+    {
+        beginTest("Surround channels read +1.5 dB, LFE is excluded");
+
+        const auto layout = juce::AudioChannelSet::create5point1();
+        float weights[ChannelLayout::MAX_CHANNELS];
+        ChannelLayout::loudnessWeights(layout, weights);
+
+        const auto measure = [&](int channel)
+        {
+            LoudnessMeter meter;
+            meter.prepare(sampleRate, blockSize, layout.size());
+            meter.setChannelWeights(weights, layout.size());
+
+            juce::AudioBuffer<float> buffer(layout.size(), blockSize);
+            double phase = 0.0;
+            for (int block = 0; block < 100; ++block)
+            {
+                fillChannel(buffer, channel, 0.1f, phase);
+                meter.process(buffer, 0, blockSize);
+            }
+
+            return meter.getMomentaryLufs();
+        };
+
+        const float front = measure(0);
+        const float surround = measure(4);
+        const float lfe = measure(3);
+
+        logMessage("-20 dBFS sine: front " + juce::String(front, 2) + " LUFS, surround "
+                   + juce::String(surround, 2) + " LUFS");
+
+        expectWithinAbsoluteError(front, -23.01f, 0.1f);
+        expectWithinAbsoluteError(surround - front, 1.49f, 0.02f);
+        expectEquals(lfe, LoudnessMeter::SILENCE_DB);
+    }
+
+    void testPerChannelMetering()
+    {
+        beginTest("Per-channel RMS and peak on a 16-channel bus");
+
+        AudioMetrics metrics;
+        metrics.prepare(sampleRate, blockSize, juce::AudioChannelSet::discreteChannels(16));
+
+        juce::AudioBuffer<float> buffer(16, blockSize);
+
+        // Channel n carries a constant of (n + 1) / 32
+        for (int channel = 0; channel < 16; ++channel)
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(channel),
+                                              static_cast<float>(channel + 1) / 32.0f, blockSize);
+
+        metrics.updateMetrics(buffer);
+
+        expectEquals(metrics.getNumChannels(), 16);
+        for (int channel = 0; channel < 16; ++channel)
+        {
+            const float expected = static_cast<float>(channel + 1) / 32.0f;
+            expectWithinAbsoluteError(metrics.getChannelRMS(channel), expected, 1.0e-4f);
+            expectWithinAbsoluteError(metrics.getChannelPeak(channel), expected, 1.0e-6f);
+        }
+
+        expectWithinAbsoluteError(metrics.getPeakLevel(), 0.5f, 1.0e-6f);
+        expectEquals(metrics.getChannelRMS(16), 0.0f);
+    }
+
+    void testAnalysisDownmix()
+    {
+        beginTest("Analysis downmix selects channels");
+
+        const auto layout = juce::AudioChannelSet::create5point1();
+        float gains[ChannelLayout::MAX_CHANNELS];
+
+        const auto peakMagnitude = [&](ChannelLayout::Downmix mode, int signalChannel)
+        {
+            FFTProcessor fft(10);
+            ChannelLayout::downmixGains(mode, layout, gains);
+            fft.setDownmixGains(gains, layout.size());
+
+            juce::AudioBuffer<float> buffer(layout.size(), 256);
+            double phase = 0.0;
+            for (int block = 0; block < 8; ++block)
+            {
+                fillChannel(buffer, signalChannel, 0.5f, phase);
+                fft.processAudioBlock(buffer, sampleRate);
+            }
+
+            expect(fft.computeFFT());
+
+            const float* magnitudes = fft.getMagnitudeSpectrum();
+            return *std::max_element(magnitudes, magnitudes + fft.getMagnitudeSpectrumSize());
+        };
+
+        // Signal only in the LFE channel
+        expect(peakMagnitude(ChannelLayout::Downmix::All, 3) > 0.01f);
+        expect(peakMagnitude(ChannelLayout::Downmix::NoLfe, 3) < 1.0e-6f);
+
+        // Signal only in a surround channel
+        expect(peakMagnitude(ChannelLayout::Downmix::Front, 4) < 1.0e-6f);
+        expect(peakMagnitude(ChannelLayout::Downmix::Loudness, 4) > 0.01f);
+    }
+
+    void testPerformance()
+    {
+        beginTest("Performance benchmark");
+
+        AudioMetrics metrics;
+        metrics.prepare(sampleRate, 512, juce::AudioChannelSet::create7point1point4());
+
+        FFTProcessor fft(10);
+
+        juce::AudioBuffer<float> buffer(12, 512);
+        juce::Random random(42);
+        for (int channel = 0; channel < 12; ++channel)
+            for (int i = 0; i < 512; ++i)
+                buffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        const int iterations = 2000;
+        double start = juce::Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < iterations; ++i)
+            metrics.updateMetrics(buffer);
+
+        const double meteringUs = 1000.0 * (juce::Time::getMillisecondCounterHiRes() - start) / iterations;
+
+        start = juce::Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < iterations; ++i)
+            fft.processAudioBlock(buffer, sampleRate);
+
+        const double downmixUs = 1000.0 * (juce::Time::getMillisecondCounterHiRes() - start) / iterations;
+
+        logMessage("7.1.4, 512 samples: metering + loudness " + juce::String(meteringUs, 2)
+                   + " us, analysis downmix " + juce::String(downmixUs, 2) + " us per block");
+
+        expect(meteringUs < 1000.0, "Multichannel metering too slow");
+        expect(downmixUs < 200.0, "Analysis downmix too slow");
+    }
+};
+
+static MultichannelTests multichannelTests;
+
+} // namespace AIplayer
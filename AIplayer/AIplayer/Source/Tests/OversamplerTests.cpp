@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    OversamplerTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the 2x/4x oversampler: transparency, reported latency and a
+    CPU versus alias rejection benchmark per factor.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/Oversampler.h"
+
+namespace AIplayer {
+
+class OversamplerTests : public juce::UnitTest
+{
+public:
+    OversamplerTests() : UnitTest("Oversampler Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testTransparency();
+        testLatency();
+        testAliasRejectionBenchmark();
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int blockSize = 512;
+
+    /// Streams a sine through an oversampler running `stage`; returns the output
+    template <typename Stage>
+    static juce::AudioBuffer<float> render(Oversampler& oversampler, int factor, double frequency,
+                                           float amplitude, int numSamples, Stage&& stage)
+    {
+        juce::AudioBuffer<float> output(1, numSamples), block(1, blockSize);
+        const double increment = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        double phase = 0.0;
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            const int count = juce::jmin(blockSize, numSamples - start);
+            block.setSize(1, count, false, false, true);
+
+            for (int i = 0; i < count; ++i)
+            {
+                block.setSample(0, i, amplitude * static_cast<float>(std::sin(phase)));
+                phase += increment;
+            }
+
+            oversampler.process(block, factor, stage);
+            output.copyFrom(0, start, block, 0, 0, count);
+        }
+
+        return output;
+    }
+
+    static void identity(juce::AudioBuffer<float>&, int) {}
+
+    void testTransparency()
+    {
+        beginTest("Pass-band gain is unity at every factor");
+
+        Oversampler oversampler;
+        oversampler.prepare(1, blockSize);
+
+        for (int factor = 0; factor < Oversampler::NUM_FACTORS; ++factor)
+        {
+            const auto output = render(oversampler, factor, 1000.0, 0.5f, 16384, identity);
+            const float rms = output.getRMSLevel(0, 8192, 8192);
+            const float gainDb = juce::Decibels::gainToDecibels(rms / (0.5f / std::sqrt(2.0f)));
+
+            logMessage(juce::String(Oversampler::getFactorName(factor)) + ": 1 kHz gain "
+                       + juce::String(gainDb, 3) + " dB");
+            expectWithinAbsoluteError(gainDb, 0.0f, 0.1f);
+        }
+    }
+
+    void testLatency()
+    {
+        beginTest("Every factor is delayed by the same reported latency");
+
+        Oversampler oversampler;
+        oversampler.prepare(1, blockSize);
+        expectEquals(oversampler.getFilterLatencySamples(Oversampler::None), 0);
+
+        // The highest factor has the longest filters; the others are padded to it
+        const int latency = oversampler.getLatencySamples();
+        expectEquals(latency, oversampler.getFilterLatencySamples(Oversampler::Four));
+        expect(latency > 0);
+
+        for (int factor = 0; factor < Oversampler::NUM_FACTORS; ++factor)
+        {
+            const auto output = render(oversampler, factor, 100.0, 0.5f, 16384, identity);
+
+            // Compare with the input delayed by the reported latency
+            const double increment = juce::MathConstants<double>::twoPi * 100.0 / sampleRate;
+            double errorSum = 0.0;
+            for (int i = 8192; i < 16384; ++i)
+            {
+                const double expected = 0.5 * std::sin(increment * (i - latency));
+                errorSum += juce::square(output.getSample(0, i) - expected);
+            }
+
+            const double errorRms = std::sqrt(errorSum / 8192.0);
+            logMessage(juce::String(Oversampler::getFactorName(factor)) + ": latency " + juce::String(latency)
+                       + " samples, residual " + juce::String(juce::Decibels::gainToDecibels(errorRms / 0.5), 1) + " dB");
+
+            expect(errorRms < 0.005, "Output is not aligned with the reported latency");
+        }
+    }
+
+    /// Alias energy relative to the fundamental (dB) of a bin-centred tone
+    static float measureAliasing(const juce::AudioBuffer<float>& output, int fundamentalBin)
+    {
+        constexpr int order = 14;
+        constexpr int size = 1 << order;
+
+        juce::dsp::FFT fft(order);
+        std::vector<float> data(static_cast<size_t>(size * 2), 0.0f);
+
+        // Periodic Hann: a bin-centred tone leaks only into its neighbours
+        const int start = output.getNumSamples() - size;
+        for (int i = 0; i < size; ++i)
+        {
+            const float window = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * i / size);
+            data[static_cast<size_t>(i)] = output.getSample(0, start + i) * window;
+        }
+
+        fft.performFrequencyOnlyForwardTransform(data.data());
+
+        const auto power = [&data](int bin)
+        {
+            double sum = 0.0;
+            for (int b = juce::jmax(0, bin - 1); b <= juce::jmin(size / 2, bin + 1); ++b)
+                sum += juce::square(static_cast<double>(data[static_cast<size_t>(b)]));
+            return sum;
+        };
+
+        // Harmonics above Nyquist fold back; in-band harmonics are legitimate distortion
+        double alias = 0.0;
+        for (int harmonic = 2; harmonic <= 40; ++harmonic)
+        {
+            const int bin = harmonic * fundamentalBin;
+            if (bin < size / 2)
+                continue;
+
+            int folded = bin % size;
+            if (folded > size / 2)
+                folded = size - folded;
+
+            alias += power(folded);
+        }
+
+        return static_cast<float>(10.0 * std::log10(juce::jmax(1.0e-20, alias) / power(fundamentalBin)));
+    }
+
+    void testAliasRejectionBenchmark()
+    {
+        beginTest("CPU versus alias rejection benchmark");
+
+        // ~5 kHz, exactly on an FFT bin, driven into tanh saturation
+        constexpr int fundamentalBin = 1858;
+        const double frequency = fundamentalBin * sampleRate / 16384.0;
+        const auto saturate = [](juce::AudioBuffer<float>& audio, int)
+        {
+            for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+            {
+                auto* samples = audio.getWritePointer(channel);
+                for (int i = 0; i < audio.getNumSamples(); ++i)
+                    samples[i] = std::tanh(4.0f * samples[i]);
+            }
+        };
+
+        const Oversampler::FilterType types[] = { Oversampler::FilterType::PolyphaseIIR,
+                                                   Oversampler::FilterType::FIREquiripple };
+        const char* typeNames[] = { "IIR", "FIR" };
+
+        for (int type = 0; type < 2; ++type)
+        {
+            Oversampler oversampler;
+            oversampler.prepare(2, blockSize, types[type]);
+
+            float aliasDb[Oversampler::NUM_FACTORS] = {};
+
+            for (int factor = 0; factor < Oversampler::NUM_FACTORS; ++factor)
+            {
+                Oversampler mono;
+                mono.prepare(1, blockSize, types[type]);
+                aliasDb[factor] = measureAliasing(render(mono, factor, frequency, 0.5f, 16384 + 8192, saturate),
+                                                  fundamentalBin);
+
+                // CPU: stereo, up + saturation + down
+                juce::AudioBuffer<float> block(2, blockSize);
+                juce::Random random(42);
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < blockSize; ++i)
+                        block.setSample(channel, i, random.nextFloat() - 0.5f);
+
+                const int iterations = 1000;
+                const double start = juce::Time::getMillisecondCounterHiRes();
+
+                for (int i = 0; i < iterations; ++i)
+                    oversampler.process(block, factor, saturate);
+
+                const double perBlockUs = 1000.0 * (juce::Time::getMillisecondCounterHiRes() - start) / iterations;
+
+                logMessage(juce::String(typeNames[type]) + " " + Oversampler::getFactorName(factor)
+                           + ": aliasing " + juce::String(aliasDb[factor], 1) + " dB, latency "
+                           + juce::String(oversampler.getFilterLatencySamples(factor)) + " samples, "
+                           + juce::String(perBlockUs, 2) + " us per 512-sample stereo block");
+            }
+
+            expect(aliasDb[Oversampler::Two] < aliasDb[Oversampler::None] - 6.0f, "2x does not reduce aliasing");
+            expect(aliasDb[Oversampler::Four] < aliasDb[Oversampler::Two], "4x does not improve on 2x");
+        }
+    }
+};
+
+static OversamplerTests oversamplerTests;
+
+} // namespace AIplayer
@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+    PitchTrackerTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the f0 tracker: accuracy, confidence, harmonic levels,
+    bounded cost and the analyzer/OSC integration.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/FFTProcessor.h"
+#include "../Audio/FrequencyAnalyzer.h"
+#include "../Audio/PitchTracker.h"
+#include "../Core/Logger.h"
+#include "../PluginProcessor.h"
+
+namespace AIplayer {
+
+class PitchTrackerTests : public juce::UnitTest
+{
+public:
+    PitchTrackerTests() : UnitTest("Pitch Tracker Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testSineAccuracy();
+        testHarmonics();
+        testUnpitched();
+        testWindowAndCost();
+        testRecentInput();
+        testAnalyzerIntegration();
+        testPitchConfigCommand();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+
+    static void fillSine(std::vector<float>& samples, double frequency, float amplitude)
+    {
+        for (size_t i = 0; i < samples.size(); ++i)
+            samples[i] = amplitude * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * frequency * static_cast<double>(i) / sampleRate));
+    }
+
+    /// Band-limited sawtooth: harmonic h at amplitude / h
+    static void fillSawtooth(std::vector<float>& samples, double frequency, float amplitude)
+    {
+        std::fill(samples.begin(), samples.end(), 0.0f);
+
+        for (int harmonic = 1; harmonic * frequency < sampleRate * 0.45; ++harmonic)
+            for (size_t i = 0; i < samples.size(); ++i)
+                samples[i] += amplitude / static_cast<float>(harmonic)
+                              * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * harmonic * frequency * static_cast<double>(i) / sampleRate));
+    }
+
+    void testSineAccuracy()
+    {
+        beginTest("Sines are tracked from low E on bass to vocal range");
+
+        PitchTracker tracker;
+        tracker.setEnabled(true);
+        std::vector<float> samples(PitchTracker::MAX_WINDOW_SIZE);
+
+        for (const double frequency : { 41.2, 82.4, 110.0, 261.6, 440.0, 1000.0, 1800.0 })
+        {
+            fillSine(samples, frequency, 0.5f);
+            expect(tracker.process(samples.data(), static_cast<int>(samples.size()), sampleRate));
+
+            const auto& result = tracker.getResult();
+            expect(result.voiced, juce::String(frequency) + " Hz");
+            expectWithinAbsoluteError(static_cast<double>(result.frequencyHz), frequency, frequency * 0.001);
+            expectGreaterThan(result.confidence, 0.95f);
+        }
+
+        expectWithinAbsoluteError(tracker.getResult().midiNote,
+                                  69.0f + 12.0f * std::log2(1800.0f / 440.0f), 0.02f);
+        expectEquals(PitchTracker::getNoteName(69.0f), juce::String("A4"));
+    }
+
+    void testHarmonics()
+    {
+        beginTest("Harmonic levels follow the source, missing fundamentals included");
+
+        PitchTracker tracker;
+        tracker.setEnabled(true);
+        std::vector<float> samples(PitchTracker::MAX_WINDOW_SIZE);
+
+        fillSawtooth(samples, 98.0, 0.25f);
+        tracker.process(samples.data(), static_cast<int>(samples.size()), sampleRate);
+
+        const auto& result = tracker.getResult();
+        expectWithinAbsoluteError(result.frequencyHz, 98.0f, 0.1f);
+
+        for (int harmonic = 0; harmonic < PitchTracker::NUM_HARMONICS; ++harmonic)
+        {
+            const float expected = juce::Decibels::gainToDecibels(0.25f / static_cast<float>(harmonic + 1));
+            expectWithinAbsoluteError(result.harmonicDb[static_cast<size_t>(harmonic)], expected, 0.5f,
+                                      "harmonic " + juce::String(harmonic + 1));
+        }
+
+        // Harmonics 2-6 only: the period is still the fundamental's
+        std::fill(samples.begin(), samples.end(), 0.0f);
+        for (int harmonic = 2; harmonic <= 6; ++harmonic)
+        {
+            std::vector<float> partial(samples.size());
+            fillSine(partial, 98.0 * harmonic, 0.1f);
+            for (size_t i = 0; i < samples.size(); ++i)
+                samples[i] += partial[i];
+        }
+
+        tracker.process(samples.data(), static_cast<int>(samples.size()), sampleRate);
+        expectWithinAbsoluteError(tracker.getResult().frequencyHz, 98.0f, 0.1f);
+        expectLessThan(tracker.getResult().harmonicDb[0], -60.0f);
+    }
+
+    void testUnpitched()
+    {
+        beginTest("Noise has low confidence; silence reports nothing");
+
+        PitchTracker tracker;
+        tracker.setEnabled(true);
+        std::vector<float> samples(PitchTracker::MAX_WINDOW_SIZE);
+
+        juce::Random random(7);
+        for (auto& sample : samples)
+            sample = random.nextFloat() - 0.5f;
+
+        tracker.process(samples.data(), static_cast<int>(samples.size()), sampleRate);
+        expect(! tracker.getResult().voiced);
+        expectLessThan(tracker.getResult().confidence, PitchTracker::VOICED_CLARITY);
+
+        std::fill(samples.begin(), samples.end(), 0.0f);
+        expect(tracker.process(samples.data(), static_cast<int>(samples.size()), sampleRate));
+        expectEquals(tracker.getResult().frequencyHz, 0.0f);
+        expectEquals(tracker.getResult().harmonicDb[0], PitchTracker::FLOOR_DB);
+
+        // Disabled trackers skip frames
+        tracker.setEnabled(false);
+        expect(! tracker.process(samples.data(), static_cast<int>(samples.size()), sampleRate));
+    }
+
+    void testWindowAndCost()
+    {
+        beginTest("The window follows the range and the cost per frame is bounded");
+
+        PitchTracker tracker;
+        tracker.setEnabled(true);
+        std::vector<float> samples(PitchTracker::MAX_WINDOW_SIZE);
+        fillSine(samples, 330.0, 0.5f);
+
+        // Two periods of 40 Hz need 2400 samples; of 80 Hz, 1200
+        tracker.process(samples.data(), static_cast<int>(samples.size()), sampleRate);
+        expectEquals(tracker.getWindowSize(), 4096);
+
+        tracker.setRange(80.0f, 1000.0f);
+        tracker.process(samples.data(), static_cast<int>(samples.size()), sampleRate);
+        expectEquals(tracker.getWindowSize(), 2048);
+        expectWithinAbsoluteError(tracker.getResult().frequencyHz, 330.0f, 0.33f);
+
+        // Too little input for the smallest window
+        expect(! tracker.process(samples.data(), PitchTracker::MIN_WINDOW_SIZE - 1, sampleRate));
+
+        tracker.setRange(PitchTracker::DEFAULT_MIN_FREQUENCY, PitchTracker::DEFAULT_MAX_FREQUENCY);
+        const int frames = 200;
+        const double start = juce::Time::getMillisecondCounterHiRes();
+
+        for (int frame = 0; frame < frames; ++frame)
+            tracker.process(samples.data(), static_cast<int>(samples.size()), sampleRate);
+
+        const double milliseconds = (juce::Time::getMillisecondCounterHiRes() - start) / frames;
+        logMessage("Pitch: " + juce::String(milliseconds * 1000.0, 1) + " us per frame");
+        expectLessThan(milliseconds, 2.0);
+    }
+
+    void testRecentInput()
+    {
+        beginTest("FFT processors keep enough history for the tracker");
+
+        FFTProcessor processor(9);
+        juce::AudioBuffer<float> buffer(1, 1000);
+        std::vector<float> history(2 * PitchTracker::MAX_WINDOW_SIZE);
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(0, i, static_cast<float>(i));
+
+        processor.processAudioBlock(buffer, sampleRate);
+        expectEquals(processor.copyRecentInput(history.data(), static_cast<int>(history.size())), 1000);
+        expectEquals(history[999], 999.0f);
+
+        // Once the ring has wrapped only the newest half is handed out; the
+        // rest is the audio thread's to overwrite
+        for (int block = 0; block < 12; ++block)
+            processor.processAudioBlock(buffer, sampleRate);
+
+        expectEquals(processor.copyRecentInput(history.data(), static_cast<int>(history.size())),
+                     FFTProcessor::MIN_HISTORY_SAMPLES);
+        expectEquals(history[FFTProcessor::MIN_HISTORY_SAMPLES - 1], 999.0f);
+        expectEquals(history.front(), static_cast<float>(1000 - FFTProcessor::MIN_HISTORY_SAMPLES % 1000));
+
+        processor.resetInput();
+        expectEquals(processor.copyRecentInput(history.data(), static_cast<int>(history.size())), 0);
+    }
+
+    void testAnalyzerIntegration()
+    {
+        beginTest("The analyzer tracks pitch when enabled and allowed");
+
+        juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("AIplayerTest");
+        tempDir.createDirectory();
+        Logger logger(tempDir.getChildFile("pitch.log"));
+
+        FrequencyAnalyzer::Config config;
+        config.autoStart = false;
+        FrequencyAnalyzer analyzer(logger, config);
+
+        juce::AudioBuffer<float> buffer(1, 1024);
+        std::vector<float> block(static_cast<size_t>(buffer.getNumSamples()));
+        int offset = 0;
+
+        auto feedFrames = [&](int frames)
+        {
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                for (int i = 0; i < buffer.getNumSamples(); ++i, ++offset)
+                    buffer.setSample(0, i, 0.5f * std::sin(juce::MathConstants<float>::twoPi * 146.8f * offset / static_cast<float>(sampleRate)));
+
+                analyzer.processBlock(buffer, sampleRate);
+                analyzer.computeNow();
+            }
+        };
+
+        feedFrames(4);
+        expect(! analyzer.isPitchTracking());
+        expectEquals(analyzer.getPitchTracker().getResult().frequencyHz, 0.0f);
+
+        analyzer.getPitchTracker().setEnabled(true);
+        expect(analyzer.isPitchTracking());
+        feedFrames(1);
+        expectWithinAbsoluteError(analyzer.getPitchTracker().getResult().frequencyHz, 146.8f, 0.2f);
+
+        // The governor's gate
+        analyzer.setPitchAllowed(false);
+        expect(! analyzer.isPitchTracking());
+    }
+
+    void testPitchConfigCommand()
+    {
+        beginTest("/aiplayer/pitch_config switches tracking and sets the range");
+
+        AIplayerAudioProcessor processor;
+        auto& listener = static_cast<OSCManager::Listener&>(processor);
+        const auto& tracker = processor.getFrequencyAnalyzer().getPitchTracker();
+
+        expect(! tracker.isEnabled());
+
+        listener.handlePitchConfig(true, 70.0f, 1200.0f);
+        expect(tracker.isEnabled());
+        expectEquals(tracker.getMinFrequency(), 70.0f);
+        expectEquals(tracker.getMaxFrequency(), 1200.0f);
+
+        // No range keeps the current one
+        listener.handlePitchConfig(false, 0.0f, 0.0f);
+        expect(! tracker.isEnabled());
+        expectEquals(tracker.getMinFrequency(), 70.0f);
+    }
+};
+
+static PitchTrackerTests pitchTrackerTests;
+
+} // namespace AIplayer
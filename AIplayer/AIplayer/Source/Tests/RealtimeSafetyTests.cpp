@@ -0,0 +1,439 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Checks the real-time contract of processBlock(): every processor path is
+    run with the test thread marked as the audio thread (RealtimeGuard), and
+    any allocation or lock inside a callback fails with its backtrace.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "../Core/Constants.h"
+#include "../Core/RealtimeGuard.h"
+
+#ifdef TEST_BUILD
+
+namespace AIplayer {
+
+class RealtimeSafetyTests : public juce::UnitTest
+{
+public:
+    RealtimeSafetyTests() : UnitTest("Realtime Safety Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testHarnessDetectsViolations();
+
+        for (const auto& path : getPaths())
+            testPath(path);
+
+        testLatencyReporting();
+    }
+
+private:
+    static constexpr double SAMPLE_RATE = 48000.0;
+    static constexpr int BLOCK_SIZE = 512;
+    static constexpr int NUM_BLOCKS = 400;
+
+    /// Backtraces printed per failing path; the rest are only counted
+    static constexpr int MAX_REPORTED = 3;
+
+    using Parameters = std::vector<std::pair<const char*, float>>;
+
+    struct Path
+    {
+        const char* name;
+        Parameters parameters;          ///< Parameter ID, value in its own units
+        bool tone{false};               ///< Calibration tone on, toggled during the run
+        bool autoLevel{false};          ///< Agent leveling target set
+        bool sidechain{false};          ///< Sidechain bus enabled
+        bool surround{false};           ///< 5.1 main bus
+        bool automate{false};           ///< Parameters moved between blocks
+        bool variableBlocks{false};     ///< Block sizes 1..BLOCK_SIZE
+        bool drums{false};              ///< Drum hit analysis on
+        bool beats{false};              ///< Host transport started and stopped during the run
+        bool governor{false};           ///< Analysis tier stepped down and back up during the run
+    };
+
+    /// Kick-like hits at 120 BPM, so onset, capture and tempo code all run
+    static constexpr int BEAT_SAMPLES = 24000;
+
+    /// Host transport, reached through getPlayHead() as a host's would be
+    struct TestPlayHead : juce::AudioPlayHead
+    {
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo position;
+            position.setBpm(128.0);
+            position.setPpqPosition(ppq);
+            position.setIsPlaying(playing);
+            return position;
+        }
+
+        double ppq{0.0};
+        bool playing{false};
+    };
+
+    static std::vector<Path> getPaths()
+    {
+        namespace P = Constants::Parameters;
+
+        const Parameters strip {
+            { P::HPF_ENABLED_ID, 1.0f }, { P::HPF_FREQ_ID, 80.0f },
+            { P::LPF_ENABLED_ID, 1.0f }, { P::LPF_FREQ_ID, 12000.0f },
+            { P::EQ_FREQ_ID, 2000.0f }, { P::EQ_GAIN_ID, 6.0f }, { P::EQ_Q_ID, 1.0f },
+            { P::COMP_THRESHOLD_ID, -24.0f }, { P::COMP_RATIO_ID, 4.0f },
+            { P::COMP_MAKEUP_ID, 6.0f }, { P::COMP_LOOKAHEAD_ID, 1.5f } };
+
+        auto oversampled2x = strip;
+        oversampled2x.push_back({ P::OVERSAMPLING_ID, 1.0f });
+
+        auto oversampled4x = strip;
+        oversampled4x.push_back({ P::OVERSAMPLING_ID, 2.0f });
+
+        auto limited = strip;
+        limited.push_back({ P::LIMITER_ENABLED_ID, 1.0f });
+        limited.push_back({ P::LIMITER_CEILING_ID, -6.0f });
+
+        const Parameters ducking {
+            { P::DUCK_ENABLED_ID, 1.0f }, { P::DUCK_THRESHOLD_ID, -40.0f }, { P::DUCK_DEPTH_ID, 6.0f } };
+
+        std::vector<Path> paths;
+        paths.push_back({ "default", {} });
+        paths.push_back({ "channel strip", strip });
+        paths.push_back({ "oversampled 2x", oversampled2x });
+        paths.push_back({ "oversampled 4x", oversampled4x });
+        paths.push_back({ "limiter", limited });
+
+        Path tone { "calibration tone", strip };
+        tone.tone = true;
+        paths.push_back(tone);
+
+        Path leveling { "auto level", strip };
+        leveling.autoLevel = true;
+        paths.push_back(leveling);
+
+        Path sidechain { "sidechain ducking", ducking };
+        sidechain.sidechain = true;
+        paths.push_back(sidechain);
+
+        Path surround { "5.1", limited };
+        surround.surround = true;
+        paths.push_back(surround);
+
+        Path automated { "parameter changes", limited };
+        automated.automate = true;
+        automated.tone = true;
+        automated.autoLevel = true;
+        paths.push_back(automated);
+
+        Path variable { "variable block sizes", oversampled4x };
+        variable.variableBlocks = true;
+        variable.automate = true;
+        paths.push_back(variable);
+
+        Path drums { "drum hit analysis", strip };
+        drums.drums = true;
+        paths.push_back(drums);
+
+        Path beats { "beat tracking", {} };
+        beats.beats = true;
+        beats.variableBlocks = true;
+        paths.push_back(beats);
+
+        Path governor { "analysis tier changes", strip };
+        governor.governor = true;
+        governor.drums = true;
+        paths.push_back(governor);
+
+        return paths;
+    }
+
+    //==============================================================================
+    void testHarnessDetectsViolations()
+    {
+        beginTest("Harness records allocations and locks");
+
+        RealtimeGuard::takeViolations();
+
+        {
+            const RealtimeGuard::ScopedAudioThread audioThread;
+            std::unique_ptr<int> allocated(new int(1));
+            expectEquals(*allocated, 1);
+        }
+
+        auto violations = RealtimeGuard::takeViolations();
+        expect(! violations.empty() && violations.front().kind.startsWith("operator new"), "operator new not detected");
+        expect(violations.empty() || violations.front().backtrace.isNotEmpty(), "violation without backtrace");
+
+        if (RealtimeGuard::hasSystemHooks())
+        {
+            {
+                const RealtimeGuard::ScopedAudioThread audioThread;
+                juce::HeapBlock<float> block(64);
+                block[0] = 1.0f;
+            }
+
+            violations = RealtimeGuard::takeViolations();
+            expect(! violations.empty(), "malloc not detected");
+
+            juce::CriticalSection lock;
+
+            {
+                const RealtimeGuard::ScopedAudioThread audioThread;
+                const juce::ScopedLock scopedLock(lock);
+            }
+
+            violations = RealtimeGuard::takeViolations();
+            expect(! violations.empty() && violations.front().kind == "pthread_mutex_lock", "mutex lock not detected");
+        }
+
+        // Unmarked threads and exempt scopes are not checked
+        {
+            std::unique_ptr<int> allocated(new int(2));
+
+            const RealtimeGuard::ScopedAudioThread audioThread;
+            AIPLAYER_REALTIME_EXEMPT("test");
+            std::unique_ptr<int> exempt(new int(3));
+        }
+
+        expect(RealtimeGuard::takeViolations().empty(), "unmarked or exempt allocation recorded");
+    }
+
+    //==============================================================================
+    static void setParameter(AIplayerAudioProcessor& processor, const char* id, float value)
+    {
+        if (auto* parameter = processor.apvts.getParameter(id))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    /**
+     * Host side, between callbacks: sweeps the continuous controls every
+     * block and flips the ones that change latency, filter state or the
+     * oversampling factor every few dozen.
+     */
+    static void automate(AIplayerAudioProcessor& processor, int block, juce::Random& random)
+    {
+        namespace P = Constants::Parameters;
+
+        setParameter(processor, P::GAIN_ID, -6.0f + 6.0f * random.nextFloat());
+        setParameter(processor, P::EQ_GAIN_ID, -12.0f + 24.0f * random.nextFloat());
+        setParameter(processor, P::EQ_FREQ_ID, 200.0f + 8000.0f * random.nextFloat());
+        setParameter(processor, P::HPF_FREQ_ID, 20.0f + 300.0f * random.nextFloat());
+        setParameter(processor, P::COMP_THRESHOLD_ID, -40.0f + 30.0f * random.nextFloat());
+
+        if (block % 37 == 0)
+            setParameter(processor, P::LIMITER_ENABLED_ID, (block / 37) % 2 == 0 ? 0.0f : 1.0f);
+
+        if (block % 41 == 0)
+            setParameter(processor, P::COMP_LOOKAHEAD_ID, random.nextFloat() * 5.0f);
+
+        if (block % 53 == 0)
+            setParameter(processor, P::OVERSAMPLING_ID, static_cast<float>((block / 53) % 3));
+
+        if (block % 59 == 0)
+            setParameter(processor, P::ANALYSIS_DOWNMIX_ID, static_cast<float>((block / 59) % 2));
+
+        if (block % 61 == 0)
+            setParameter(processor, P::LPF_ENABLED_ID, (block / 61) % 2 == 0 ? 1.0f : 0.0f);
+    }
+
+    void testPath(const Path& path)
+    {
+        beginTest(juce::String("Realtime contract: ") + path.name);
+
+        AIplayerAudioProcessor processor;
+
+        if (path.surround || path.sidechain)
+        {
+            auto layout = processor.getBusesLayout();
+
+            if (path.surround)
+            {
+                layout.inputBuses.getReference(0) = juce::AudioChannelSet::create5point1();
+                layout.outputBuses.getReference(0) = juce::AudioChannelSet::create5point1();
+            }
+
+            if (path.sidechain && layout.inputBuses.size() > 1)
+                layout.inputBuses.getReference(1) = juce::AudioChannelSet::stereo();
+
+            expect(processor.setBusesLayout(layout), "bus layout rejected");
+        }
+
+        for (const auto& [id, value] : path.parameters)
+            setParameter(processor, id, value);
+
+        processor.setRateAndBufferSizeDetails(SAMPLE_RATE, BLOCK_SIZE);
+        processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+
+        auto& tone = processor.getToneGenerator();
+        if (path.tone)
+        {
+            tone.setTone(1000.0f, -20.0f);
+            tone.startTone();
+        }
+
+        // The OSC callbacks, reached as OSCManager would
+        auto& osc = static_cast<OSCManager::Listener&>(processor);
+
+        if (path.autoLevel)
+            osc.handleAutoLevelTarget("lufs", -20.0f, 0.5f, 200.0f);
+
+        if (path.drums)
+            osc.handleDrumConfig(true, -40.0f);
+
+        // Focused instances may use every tier; pitch tracking follows the tier
+        auto& governor = processor.getAnalysisGovernor();
+        if (path.governor)
+        {
+            governor.setPriority(AnalysisGovernor::Priority::Focused);
+            osc.handlePitchConfig(true, 50.0f, 1000.0f);
+        }
+
+        TestPlayHead playHead;
+        if (path.beats)
+            processor.setPlayHead(&playHead);
+
+        const int numChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+        juce::AudioBuffer<float> buffer(numChannels, BLOCK_SIZE);
+        juce::MidiBuffer midi;
+        juce::Random random(4321);
+        juce::int64 position = 0;
+
+        // Preparation may allocate; only callbacks count
+        RealtimeGuard::takeViolations();
+
+        for (int block = 0; block < NUM_BLOCKS; ++block)
+        {
+            if (path.automate)
+                automate(processor, block, random);
+
+            if (path.tone && block % 100 == 50)
+            {
+                tone.setTone(200.0f + 2000.0f * random.nextFloat(), -30.0f);
+                tone.isToneEnabled() ? tone.stopTone() : tone.startTone();
+            }
+
+            // The message thread's decision steps: overloaded, then calm
+            // long enough to climb back (each step passes both hold times)
+            if (path.governor && block % 10 == 0)
+                governor.update((block / 80) % 2 == 0 ? 10.0f : 0.0f, 6.0);
+
+            if (path.beats && block % 100 == 50)
+                playHead.playing = ! playHead.playing;
+
+            const int numSamples = path.variableBlocks ? 1 + random.nextInt(BLOCK_SIZE) : BLOCK_SIZE;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    float sample = 0.5f * (random.nextFloat() * 2.0f - 1.0f);
+
+                    if (path.drums || path.beats)
+                    {
+                        const double t = static_cast<double>((position + i) % BEAT_SAMPLES) / SAMPLE_RATE;
+                        sample = 0.1f * sample + static_cast<float>(0.8 * std::exp(-t / 0.03)
+                                                                    * std::sin(juce::MathConstants<double>::twoPi * 60.0 * t));
+                    }
+
+                    buffer.setSample(channel, i, sample);
+                }
+            }
+
+            position += numSamples;
+            playHead.ppq = static_cast<double>(position) / SAMPLE_RATE * 128.0 / 60.0;
+
+            juce::AudioBuffer<float> callback(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+            {
+                const RealtimeGuard::ScopedAudioThread audioThread;
+                processor.processBlock(callback, midi);
+            }
+        }
+
+        expectNoViolations(RealtimeGuard::takeViolations(), path.name);
+
+        if (path.governor)
+            expect(governor.getChangeCount() >= 2 * AnalysisGovernor::NUM_TIERS - 2, "analysis tier did not change");
+
+        processor.setPlayHead(nullptr);
+        processor.releaseResources();
+    }
+
+    void testLatencyReporting()
+    {
+        beginTest("Latency changes reach the host from the message thread only");
+
+        namespace P = Constants::Parameters;
+
+        AIplayerAudioProcessor processor;
+        setParameter(processor, P::COMP_LOOKAHEAD_ID, 0.0f);
+        processor.setRateAndBufferSizeDetails(SAMPLE_RATE, BLOCK_SIZE);
+        processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+
+        const int numChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+        juce::AudioBuffer<float> buffer(numChannels, BLOCK_SIZE);
+        juce::MidiBuffer midi;
+
+        const auto processBlock = [&]
+        {
+            buffer.clear();
+            const RealtimeGuard::ScopedAudioThread audioThread;
+            processor.processBlock(buffer, midi);
+        };
+
+        const int baseLatency = processor.getLatencySamples();
+        RealtimeGuard::takeViolations();
+
+        // Oversampling and the limiter keep the latency whichever way they are switched
+        for (const float factor : { 1.0f, 2.0f, 0.0f })
+        {
+            setParameter(processor, P::OVERSAMPLING_ID, factor);
+            setParameter(processor, P::LIMITER_ENABLED_ID, factor > 0.0f ? 1.0f : 0.0f);
+            processBlock();
+            processor.updateLatency();
+            expectEquals(processor.getLatencySamples(), baseLatency);
+        }
+
+        // Lookahead changes it, but only once the message thread reports it
+        setParameter(processor, P::COMP_LOOKAHEAD_ID, 2.0f);
+        processBlock();
+        expectEquals(processor.getLatencySamples(), baseLatency);
+
+        processor.updateLatency();
+        expectEquals(processor.getLatencySamples(), baseLatency + juce::roundToInt(0.002 * SAMPLE_RATE));
+
+        expectNoViolations(RealtimeGuard::takeViolations(), "latency changes");
+        processor.releaseResources();
+    }
+
+    void expectNoViolations(const std::vector<RealtimeGuard::Violation>& violations, const juce::String& label)
+    {
+        if (violations.empty())
+        {
+            expect(true);
+            return;
+        }
+
+        juce::String message;
+        message << label << ": " << static_cast<int>(violations.size()) << " allocations/locks in processBlock";
+
+        for (size_t i = 0; i < violations.size() && i < static_cast<size_t>(MAX_REPORTED); ++i)
+            message << "\n\n" << violations[i].kind << " at\n" << violations[i].backtrace;
+
+        expect(false, message);
+    }
+};
+
+static RealtimeSafetyTests realtimeSafetyTests;
+
+} // namespace AIplayer
+
+#endif // TEST_BUILD
@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+    SidechainProcessorTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for sidechain masking analysis and dynamic-EQ ducking.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/SidechainProcessor.h"
+
+namespace AIplayer {
+
+class SidechainProcessorTests : public juce::UnitTest
+{
+public:
+    SidechainProcessorTests() : UnitTest("Sidechain Processor Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testTransparentWithoutKey();
+        testMaskingReport();
+        testDucking();
+        testReleaseBypasses();
+        testPerformance();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 480;
+
+    /// Fills every channel of a buffer with a continuing sine
+    static void fillSine(juce::AudioBuffer<float>& buffer, double frequency, float amplitude, double& phase)
+    {
+        const double increment = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            const float sample = amplitude * static_cast<float>(std::sin(phase));
+            phase += increment;
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                buffer.setSample(channel, i, sample);
+        }
+    }
+
+    /// Streams a track sine and a key sine; returns the output/input RMS ratio of the last block (dB)
+    static float run(SidechainProcessor& processor, double trackHz, float trackAmplitude,
+                     double keyHz, float keyAmplitude, double seconds)
+    {
+        juce::AudioBuffer<float> track(2, blockSize), key(2, blockSize);
+        double trackPhase = 0.0, keyPhase = 0.0;
+        float inputRms = 0.0f;
+
+        const int numBlocks = static_cast<int>(seconds * sampleRate) / blockSize;
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            fillSine(track, trackHz, trackAmplitude, trackPhase);
+            fillSine(key, keyHz, keyAmplitude, keyPhase);
+            inputRms = track.getRMSLevel(0, 0, blockSize);
+            processor.process(track, &key);
+        }
+
+        return juce::Decibels::gainToDecibels(track.getRMSLevel(0, 0, blockSize) / inputRms);
+    }
+
+    void testTransparentWithoutKey()
+    {
+        beginTest("No key leaves the track untouched");
+
+        SidechainProcessor processor;
+        processor.prepare(sampleRate, blockSize, 2);
+
+        SidechainProcessor::Settings settings;
+        settings.duckEnabled = true;
+        settings.thresholdDb = -60.0f;
+        processor.setSettings(settings);
+
+        juce::AudioBuffer<float> track(2, blockSize), reference(2, blockSize);
+        double phase = 0.0;
+        fillSine(track, 100.0, 0.5f, phase);
+        reference.makeCopyOf(track);
+
+        processor.process(track, nullptr);
+
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < blockSize; ++i)
+                expectEquals(track.getSample(channel, i), reference.getSample(channel, i));
+
+        expect(!processor.getReport().keyPresent);
+    }
+
+    void testMaskingReport()
+    {
+        beginTest("Masking is the key-to-track ratio per band");
+
+        SidechainProcessor processor;
+        processor.prepare(sampleRate, blockSize, 2);
+
+        // Kick-like key 6 dB over a bass-like track, both in the low band
+        run(processor, 60.0, 0.25f, 60.0, 0.5f, 1.0);
+        auto report = processor.getReport();
+
+        logMessage("Low band: track " + juce::String(report.trackDb[0], 2) + " dB, key "
+                   + juce::String(report.keyDb[0], 2) + " dB, masking " + juce::String(report.maskingDb[0], 2) + " dB");
+
+        expect(report.keyPresent);
+        expectWithinAbsoluteError(report.maskingDb[0], 6.02f, 0.2f);
+
+        // Empty bands report no masking
+        expectEquals(report.maskingDb[2], SidechainProcessor::NO_MASKING_DB);
+        expectEquals(report.maskingDb[3], SidechainProcessor::NO_MASKING_DB);
+
+        // Key moved to the high-mid band: only filter leakage remains in the low band
+        run(processor, 60.0, 0.25f, 4000.0, 0.5f, 1.0);
+        report = processor.getReport();
+        expect(report.maskingDb[0] < -30.0f);
+        expect(report.keyDb[2] > -10.0f);
+    }
+
+    void testDucking()
+    {
+        beginTest("Ducking cuts the selected band by the key overshoot");
+
+        SidechainProcessor processor;
+        processor.prepare(sampleRate, blockSize, 2);
+
+        SidechainProcessor::Settings settings;
+        settings.duckEnabled = true;
+        settings.duckBand = 0;
+        settings.thresholdDb = -20.0f;
+        settings.depthDb = 6.0f;
+        processor.setSettings(settings);
+
+        // Key well above threshold: full depth at the bell centre
+        const float lowCutDb = run(processor, 70.0, 0.25f, 60.0, 0.5f, 1.0);
+        logMessage("Cut at 70 Hz: " + juce::String(lowCutDb, 2) + " dB");
+        expectWithinAbsoluteError(lowCutDb, -6.0f, 0.3f);
+        expectWithinAbsoluteError(processor.getReport().duckGainDb, -6.0f, 0.01f);
+
+        // A track in another band is barely touched by the low bell
+        const float highCutDb = run(processor, 5000.0, 0.25f, 60.0, 0.5f, 1.0);
+        expect(highCutDb > -0.5f);
+
+        // Key 4 dB over threshold: 4 dB cut (1:1 above threshold)
+        const float partialDb = run(processor, 70.0, 0.25f, 60.0, juce::Decibels::decibelsToGain(-13.0f), 1.0);
+        expectWithinAbsoluteError(partialDb, -4.0f, 0.4f);
+    }
+
+    void testReleaseBypasses()
+    {
+        beginTest("Released ducking returns to a bit-exact bypass");
+
+        SidechainProcessor processor;
+        processor.prepare(sampleRate, blockSize, 2);
+
+        SidechainProcessor::Settings settings;
+        settings.duckEnabled = true;
+        settings.thresholdDb = -30.0f;
+        settings.releaseMs = 50.0f;
+        processor.setSettings(settings);
+
+        run(processor, 70.0, 0.25f, 60.0, 0.5f, 0.5);
+        expect(processor.getReport().duckGainDb < -5.0f);
+
+        // Silent key releases the cut
+        run(processor, 70.0, 0.25f, 60.0, 0.0f, 1.0);
+        expectEquals(processor.getReport().duckGainDb, 0.0f);
+
+        juce::AudioBuffer<float> track(2, blockSize), reference(2, blockSize), key(2, blockSize);
+        double phase = 0.0;
+        fillSine(track, 70.0, 0.25f, phase);
+        key.clear();
+        reference.makeCopyOf(track);
+
+        processor.process(track, &key);
+
+        for (int i = 0; i < blockSize; ++i)
+            expectEquals(track.getSample(0, i), reference.getSample(0, i));
+    }
+
+    void testPerformance()
+    {
+        beginTest("Performance benchmark");
+
+        SidechainProcessor processor;
+        processor.prepare(sampleRate, 512, 2);
+
+        SidechainProcessor::Settings settings;
+        settings.duckEnabled = true;
+        settings.thresholdDb = -40.0f;
+        processor.setSettings(settings);
+
+        juce::AudioBuffer<float> track(2, 512), key(2, 512);
+        juce::Random random(42);
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            for (int i = 0; i < 512; ++i)
+            {
+                track.setSample(channel, i, random.nextFloat() * 0.5f - 0.25f);
+                key.setSample(channel, i, random.nextFloat() * 0.5f - 0.25f);
+            }
+        }
+
+        const int iterations = 2000;
+        const double start = juce::Time::getMillisecondCounterHiRes();
+
+        for (int i = 0; i < iterations; ++i)
+            processor.process(track, &key);
+
+        const double elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+        const double perBlockUs = 1000.0 * elapsed / iterations;
+
+        logMessage("Analysis + ducking, 512 samples stereo: " + juce::String(perBlockUs, 2) + " us per block");
+
+        // 512 samples at 48 kHz is 10.7 ms; stay far below it
+        expect(perBlockUs < 500.0, "Sidechain processing too slow");
+    }
+};
+
+static SidechainProcessorTests sidechainProcessorTests;
+
+} // namespace AIplayer
@@ -0,0 +1,260 @@
+/*
+  ==============================================================================
+
+    SpectrumStreamerTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the spectrum stream encoding: quantisation, delta coding,
+    chunking and the per-instance bandwidth bound.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Audio/FrequencyAnalyzer.h"
+#include "../Communication/OSCManager.h"
+#include "../Communication/SpectrumStreamer.h"
+#include "../Core/Logger.h"
+
+namespace AIplayer {
+
+class SpectrumStreamerTests : public juce::UnitTest
+{
+public:
+    SpectrumStreamerTests() : UnitTest("Spectrum Streamer Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        juce::File tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("AIplayerTest");
+        tempDir.createDirectory();
+
+        Logger logger(tempDir.getChildFile("spectrum.log"));
+        OSCManager oscManager(logger);
+
+        FrequencyAnalyzer::Config config;
+        config.autoStart = false;
+        FrequencyAnalyzer analyzer(logger, config);
+
+        testQuantisation(analyzer, oscManager, logger);
+        testDeltaCoding(analyzer, oscManager, logger);
+        testChunking(analyzer, oscManager, logger);
+        testBandwidthBound(analyzer, oscManager, logger);
+        testFullResolutionSource(analyzer);
+    }
+
+private:
+    /// Receiver side: reassembles chunks into dB levels, applying deltas
+    struct Decoder
+    {
+        std::vector<int> codes;
+
+        std::vector<float> decode(const std::vector<SpectrumStreamer::Chunk>& chunks)
+        {
+            const auto& first = chunks.front();
+            const bool sixteenBit = (first.format & SpectrumStreamer::SixteenBit) != 0;
+            const bool delta = (first.format & SpectrumStreamer::Delta) != 0;
+            const int maxCode = sixteenBit ? 0xffff : 0xff;
+
+            codes.resize(static_cast<size_t>(first.totalBins), 0);
+
+            for (const auto& chunk : chunks)
+            {
+                const int bytesPerBin = sixteenBit ? 2 : 1;
+                for (int i = 0; i < chunk.numBytes / bytesPerBin; ++i)
+                {
+                    int code = chunk.data[i * bytesPerBin];
+                    if (sixteenBit)
+                        code |= chunk.data[i * bytesPerBin + 1] << 8;
+
+                    auto& value = codes[static_cast<size_t>(chunk.firstBin + i)];
+                    value = delta ? ((value + code) & maxCode) : code;
+                }
+            }
+
+            std::vector<float> levels;
+            for (const int code : codes)
+                levels.push_back(SpectrumStreamer::MIN_DB + (SpectrumStreamer::MAX_DB - SpectrumStreamer::MIN_DB)
+                                                            * static_cast<float>(code) / static_cast<float>(maxCode));
+            return levels;
+        }
+    };
+
+    static std::vector<float> makeSpectrum(int numBins, juce::Random& random)
+    {
+        std::vector<float> levels;
+        for (int bin = 0; bin < numBins; ++bin)
+            levels.push_back(-130.0f + 135.0f * random.nextFloat());   // Beyond the code range at both ends
+        return levels;
+    }
+
+    static SpectrumStreamer::Settings makeSettings(int bits, bool delta, SpectrumStreamer::Resolution resolution)
+    {
+        SpectrumStreamer::Settings settings;
+        settings.resolution = resolution;
+        settings.bits = bits;
+        settings.delta = delta;
+        settings.rateHz = 10.0f;
+        return settings;
+    }
+
+    float maxError(const std::vector<float>& decoded, const std::vector<float>& source)
+    {
+        float worst = 0.0f;
+        for (size_t bin = 0; bin < source.size(); ++bin)
+        {
+            const float expected = juce::jlimit(SpectrumStreamer::MIN_DB, SpectrumStreamer::MAX_DB, source[bin]);
+            worst = juce::jmax(worst, std::abs(decoded[bin] - expected));
+        }
+        return worst;
+    }
+
+    void testQuantisation(FrequencyAnalyzer& analyzer, OSCManager& oscManager, Logger& logger)
+    {
+        beginTest("8-bit and 16-bit codes round-trip within half a step");
+
+        juce::Random random(11);
+        const float range = SpectrumStreamer::MAX_DB - SpectrumStreamer::MIN_DB;
+
+        for (const int bits : { 8, 16 })
+        {
+            SpectrumStreamer streamer(analyzer, oscManager, logger);
+            streamer.request(makeSettings(bits, false, SpectrumStreamer::Resolution::Log));
+
+            const auto source = makeSpectrum(96, random);
+            expect(streamer.encodeFrame(source.data(), 96, 20.0f, 20000.0f, 0.0));
+
+            Decoder decoder;
+            const float step = range / static_cast<float>((1 << bits) - 1);
+            expectLessOrEqual(maxError(decoder.decode(streamer.getChunks()), source), step * 0.5f + 1.0e-4f);
+            expectEquals(streamer.getChunks().front().format, bits == 16 ? static_cast<int>(SpectrumStreamer::SixteenBit) : 0);
+        }
+    }
+
+    void testDeltaCoding(FrequencyAnalyzer& analyzer, OSCManager& oscManager, Logger& logger)
+    {
+        beginTest("Delta frames reconstruct exactly, with periodic keyframes");
+
+        SpectrumStreamer streamer(analyzer, oscManager, logger);
+        streamer.request(makeSettings(8, true, SpectrumStreamer::Resolution::Log));
+
+        juce::Random random(5);
+        auto source = makeSpectrum(96, random);
+        Decoder decoder;
+        int keyframes = 0;
+        float worst = 0.0f;
+        const int numFrames = 3 * SpectrumStreamer::KEYFRAME_INTERVAL;
+
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            // A drifting spectrum, as between analysis frames
+            for (auto& level : source)
+                level += random.nextFloat() * 6.0f - 3.0f;
+
+            expect(streamer.encodeFrame(source.data(), 96, 20.0f, 20000.0f, frame * 0.1));
+
+            const auto& chunks = streamer.getChunks();
+            if ((chunks.front().format & SpectrumStreamer::Delta) == 0)
+                ++keyframes;
+
+            expectEquals(chunks.front().frameID, frame);
+            worst = juce::jmax(worst, maxError(decoder.decode(chunks), source));
+        }
+
+        expectEquals(keyframes, numFrames / SpectrumStreamer::KEYFRAME_INTERVAL);
+        expectLessOrEqual(worst, 120.0f / 255.0f * 0.5f + 1.0e-4f);
+
+        // A new request restarts with an absolute frame
+        streamer.request(makeSettings(16, true, SpectrumStreamer::Resolution::Log));
+        expect(streamer.encodeFrame(source.data(), 96, 20.0f, 20000.0f, 100.0));
+        expectEquals(streamer.getChunks().front().format & SpectrumStreamer::Delta, 0);
+    }
+
+    void testChunking(FrequencyAnalyzer& analyzer, OSCManager& oscManager, Logger& logger)
+    {
+        beginTest("Frames split into MTU-sized chunks of whole bins");
+
+        SpectrumStreamer streamer(analyzer, oscManager, logger);
+        streamer.request(makeSettings(16, false, SpectrumStreamer::Resolution::Full));
+
+        juce::Random random(3);
+        const int numBins = 2049;
+        const auto source = makeSpectrum(numBins, random);
+        expect(streamer.encodeFrame(source.data(), numBins, 0.0f, 24000.0f, 0.0));
+
+        const auto& chunks = streamer.getChunks();
+        const int expectedChunks = (numBins * 2 + SpectrumStreamer::MAX_CHUNK_BYTES - 1) / SpectrumStreamer::MAX_CHUNK_BYTES;
+        expectEquals(static_cast<int>(chunks.size()), expectedChunks);
+
+        int nextBin = 0;
+        for (const auto& chunk : chunks)
+        {
+            expect(chunk.numBytes > 0 && chunk.numBytes <= SpectrumStreamer::MAX_CHUNK_BYTES);
+            expectEquals(chunk.numBytes % 2, 0);
+            expectEquals(chunk.firstBin, nextBin);
+            expectEquals(chunk.numChunks, expectedChunks);
+            expectEquals(chunk.totalBins, numBins);
+            expect((chunk.format & SpectrumStreamer::FullResolution) != 0);
+            nextBin += chunk.numBytes / 2;
+        }
+
+        expectEquals(nextBin, numBins);
+    }
+
+    void testBandwidthBound(FrequencyAnalyzer& analyzer, OSCManager& oscManager, Logger& logger)
+    {
+        beginTest("Bandwidth per instance stays within the limit");
+
+        SpectrumStreamer streamer(analyzer, oscManager, logger);
+        streamer.request(makeSettings(16, false, SpectrumStreamer::Resolution::Full));
+
+        juce::Random random(9);
+        const int numBins = 2048;
+        const auto source = makeSpectrum(numBins, random);
+
+        // Far more frames than the budget allows: 1000 per second for 10 seconds
+        const double seconds = 10.0;
+        int sent = 0;
+        for (int frame = 0; frame < 10000; ++frame)
+            if (streamer.encodeFrame(source.data(), numBins, 0.0f, 24000.0f, frame / 1000.0))
+                ++sent;
+
+        const double bytes = static_cast<double>(sent) * streamer.getFrameCost(numBins);
+        const double limit = SpectrumStreamer::MAX_BYTES_PER_SECOND * (seconds + 0.5);
+
+        logMessage("Sent " + juce::String(sent) + " frames, " + juce::String(bytes / seconds / 1024.0, 1) + " KB/s");
+        expect(sent > 0);
+        expectLessOrEqual(bytes, limit);
+        expectGreaterThan(bytes, SpectrumStreamer::MAX_BYTES_PER_SECOND * seconds * 0.8);
+    }
+
+    void testFullResolutionSource(FrequencyAnalyzer& analyzer)
+    {
+        beginTest("Full-resolution spectrum comes from the latest frame");
+
+        float binWidth = 0.0f;
+        std::vector<float> levels(static_cast<size_t>(SpectrumStreamer::MAX_FULL_BINS));
+        expectEquals(analyzer.getFullSpectrumDb(levels.data(), SpectrumStreamer::MAX_FULL_BINS, binWidth), 0);
+
+        const double sampleRate = 48000.0;
+        const float frequency = 3000.0f;
+        juce::AudioBuffer<float> buffer(1, 2048);
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            buffer.setSample(0, i, 0.5f * std::sin(juce::MathConstants<float>::twoPi * frequency * i / static_cast<float>(sampleRate)));
+
+        analyzer.processBlock(buffer, sampleRate);
+        expect(analyzer.computeNow());
+
+        const int numBins = analyzer.getFullSpectrumDb(levels.data(), SpectrumStreamer::MAX_FULL_BINS, binWidth);
+        expectEquals(numBins, analyzer.getFFTSize() / 2);
+        expectWithinAbsoluteError(binWidth, static_cast<float>(sampleRate / analyzer.getFFTSize()), 0.01f);
+
+        const auto peak = std::max_element(levels.begin(), levels.begin() + numBins) - levels.begin();
+        expectWithinAbsoluteError(static_cast<float>(peak) * binWidth, frequency, binWidth);
+    }
+};
+
+static SpectrumStreamerTests spectrumStreamerTests;
+
+} // namespace AIplayer
@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+    StateSerializerTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Round-trip, compatibility and size/speed tests for the binary state format.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../Core/StateSerializer.h"
+
+namespace AIplayer {
+
+/**
+ * @brief Minimal processor hosting an APVTS with a configurable parameter count
+ */
+class StateTestProcessor : public juce::AudioProcessor
+{
+public:
+    explicit StateTestProcessor(int numParameters)
+        : apvts(*this, nullptr, "Parameters", createLayout(numParameters))
+    {
+    }
+
+    static juce::AudioProcessorValueTreeState::ParameterLayout createLayout(int numParameters)
+    {
+        juce::AudioProcessorValueTreeState::ParameterLayout layout;
+        for (int i = 0; i < numParameters; ++i)
+            layout.add(std::make_unique<juce::AudioParameterFloat>(
+                juce::ParameterID{"param" + juce::String(i), 1}, "Param " + juce::String(i),
+                juce::NormalisableRange<float>(-60.0f, 12.0f), 0.0f));
+        return layout;
+    }
+
+    const juce::String getName() const override { return "StateTest"; }
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+
+    juce::AudioProcessorValueTreeState apvts;
+};
+
+class StateSerializerTests : public juce::UnitTest
+{
+public:
+    StateSerializerTests() : UnitTest("State Serializer Tests", "AIplayer") {}
+
+    void runTest() override
+    {
+        testRoundTrip();
+        testLegacyXmlDetection();
+        testCorruptAndNewerData();
+        testUnchangedParametersAreNotSent();
+        testSaveLoadBenchmark();
+    }
+
+private:
+    static void fillExtraState(juce::AudioProcessorValueTreeState& apvts, int numEntries)
+    {
+        juce::ValueTree extra(StateSerializer::EXTRA_STATE_TYPE);
+        extra.setProperty("trackID", "TR7", nullptr);
+
+        for (int i = 0; i < numEntries; ++i)
+        {
+            juce::ValueTree entry("Snapshot");
+            entry.setProperty("index", i, nullptr);
+            entry.setProperty("rmsDb", -20.0 + 0.01 * i, nullptr);
+            entry.setProperty("note", "snapshot " + juce::String(i), nullptr);
+            extra.appendChild(entry, nullptr);
+        }
+
+        apvts.state.appendChild(extra, nullptr);
+    }
+
+    static void setParameter(StateTestProcessor& processor, int index, float plainValue)
+    {
+        auto* parameter = processor.apvts.getParameter("param" + juce::String(index));
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(plainValue));
+    }
+
+    static float getParameter(StateTestProcessor& processor, int index)
+    {
+        return processor.apvts.getRawParameterValue("param" + juce::String(index))->load();
+    }
+
+    void testRoundTrip()
+    {
+        beginTest("Binary round trip restores parameters and extra state");
+
+        StateTestProcessor source(16);
+        for (int i = 0; i < 16; ++i)
+            setParameter(source, i, -3.0f * static_cast<float>(i));
+        fillExtraState(source.apvts, 10);
+
+        juce::MemoryBlock data;
+        StateSerializer::write(source.apvts, data);
+
+        expect(StateSerializer::isBinaryState(data.getData(), static_cast<int>(data.getSize())));
+
+        StateTestProcessor target(16);
+        setParameter(target, 3, 6.0f);
+        const auto result = StateSerializer::read(target.apvts, data.getData(), static_cast<int>(data.getSize()));
+
+        expect(result == StateSerializer::Result::Ok);
+        for (int i = 0; i < 16; ++i)
+            expectWithinAbsoluteError(getParameter(target, i), -3.0f * static_cast<float>(i), 0.001f);
+
+        const auto extra = target.apvts.state.getChildWithName(StateSerializer::EXTRA_STATE_TYPE);
+        expect(extra.isValid());
+        expectEquals(extra.getNumChildren(), 10);
+        expectEquals(extra.getProperty("trackID").toString(), juce::String("TR7"));
+
+        // Parameters unknown to the saving version fall back to their defaults
+        StateTestProcessor smaller(8);
+        StateSerializer::write(smaller.apvts, data);
+        StateSerializer::read(target.apvts, data.getData(), static_cast<int>(data.getSize()));
+        expectWithinAbsoluteError(getParameter(target, 12), 0.0f, 0.001f);
+    }
+
+    void testLegacyXmlDetection()
+    {
+        beginTest("Legacy XML state is not mistaken for binary state");
+
+        StateTestProcessor processor(4);
+        juce::MemoryBlock legacy;
+        if (auto xml = processor.apvts.copyState().createXml())
+            juce::AudioProcessor::copyXmlToBinary(*xml, legacy);
+
+        expect(!StateSerializer::isBinaryState(legacy.getData(), static_cast<int>(legacy.getSize())));
+        expect(StateSerializer::read(processor.apvts, legacy.getData(), static_cast<int>(legacy.getSize()))
+               == StateSerializer::Result::NotBinary);
+        expect(juce::AudioProcessor::getXmlFromBinary(legacy.getData(), static_cast<int>(legacy.getSize())) != nullptr);
+    }
+
+    void testCorruptAndNewerData()
+    {
+        beginTest("Truncated and newer data is rejected safely");
+
+        StateTestProcessor processor(8);
+        juce::MemoryBlock data;
+        StateSerializer::write(processor.apvts, data);
+
+        StateSerializer::ParsedState parsed;
+        const int truncatedSize = static_cast<int>(data.getSize()) - 3;
+        expect(StateSerializer::parse(data.getData(), truncatedSize, parsed) == StateSerializer::Result::Corrupt);
+
+        // Bump minReaderVersion beyond this build
+        auto* bytes = static_cast<juce::uint8*>(data.getData());
+        bytes[6] = 0xff;
+        expect(StateSerializer::parse(data.getData(), static_cast<int>(data.getSize()), parsed)
+               == StateSerializer::Result::TooNew);
+    }
+
+    /// Counts the parameter changes a host would be told about
+    struct HostListener : public juce::AudioProcessorListener
+    {
+        void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override { ++changes; }
+        void audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails&) override {}
+
+        int changes{0};
+    };
+
+    void testUnchangedParametersAreNotSent()
+    {
+        beginTest("Restoring state does not push every parameter to the host");
+
+        StateTestProcessor processor(16);
+        for (int i = 0; i < 16; ++i)
+            setParameter(processor, i, -2.0f * static_cast<float>(i));
+
+        juce::MemoryBlock data;
+        StateSerializer::write(processor.apvts, data);
+
+        HostListener host;
+        processor.addListener(&host);
+
+        // Same values: nothing to tell the host
+        expect(StateSerializer::read(processor.apvts, data.getData(), static_cast<int>(data.getSize()))
+               == StateSerializer::Result::Ok);
+        expectEquals(host.changes, 0);
+
+        processor.removeListener(&host);
+
+        for (int i = 0; i < 16; ++i)
+            expectWithinAbsoluteError(getParameter(processor, i), -2.0f * static_cast<float>(i), 0.001f);
+    }
+
+    void testSaveLoadBenchmark()
+    {
+        beginTest("Save/load benchmark: legacy XML vs binary");
+
+        constexpr int numParameters = 256;
+        constexpr int numSnapshots = 2000;
+        constexpr int iterations = 50;
+
+        StateTestProcessor processor(numParameters);
+        for (int i = 0; i < numParameters; ++i)
+            setParameter(processor, i, -0.1f * static_cast<float>(i));
+        fillExtraState(processor.apvts, numSnapshots);
+
+        juce::MemoryBlock xmlData, binaryData;
+
+        auto start = juce::Time::getMillisecondCounterHiRes();
+        for (int i = 0; i < iterations; ++i)
+            if (auto xml = processor.apvts.copyState().createXml())
+                juce::AudioProcessor::copyXmlToBinary(*xml, xmlData);
+        const double xmlSaveMs = (juce::Time::getMillisecondCounterHiRes() - start) / iterations;
+
+        start = juce::Time::getMillisecondCounterHiRes();
+        for (int i = 0; i < iterations; ++i)
+            if (auto xml = juce::AudioProcessor::getXmlFromBinary(xmlData.getData(), static_cast<int>(xmlData.getSize())))
+                processor.apvts.replaceState(juce::ValueTree::fromXml(*xml));
+        const double xmlLoadMs = (juce::Time::getMillisecondCounterHiRes() - start) / iterations;
+
+        start = juce::Time::getMillisecondCounterHiRes();
+        for (int i = 0; i < iterations; ++i)
+            StateSerializer::write(processor.apvts, binaryData);
+        const double binarySaveMs = (juce::Time::getMillisecondCounterHiRes() - start) / iterations;
+
+        start = juce::Time::getMillisecondCounterHiRes();
+        for (int i = 0; i < iterations; ++i)
+            StateSerializer::read(processor.apvts, binaryData.getData(), static_cast<int>(binaryData.getSize()));
+        const double binaryLoadMs = (juce::Time::getMillisecondCounterHiRes() - start) / iterations;
+
+        logMessage(juce::String(numParameters) + " parameters, " + juce::String(numSnapshots) + " extra state entries:");
+        logMessage("  XML:    " + juce::String(static_cast<int>(xmlData.getSize())) + " bytes, save "
+                   + juce::String(xmlSaveMs, 3) + " ms, load " + juce::String(xmlLoadMs, 3) + " ms");
+        logMessage("  Binary: " + juce::String(static_cast<int>(binaryData.getSize())) + " bytes, save "
+                   + juce::String(binarySaveMs, 3) + " ms, load " + juce::String(binaryLoadMs, 3) + " ms");
+
+        // Timings are logged only: they vary too much with load and build type to assert on
+        expect(binaryData.getSize() < xmlData.getSize(), "Binary state should be smaller than XML");
+
+        StateTestProcessor restored(numParameters);
+        expect(StateSerializer::read(restored.apvts, binaryData.getData(), static_cast<int>(binaryData.getSize()))
+               == StateSerializer::Result::Ok);
+        for (int i = 0; i < numParameters; ++i)
+            expectWithinAbsoluteError(getParameter(restored, i), getParameter(processor, i), 0.001f);
+
+        const auto extra = restored.apvts.state.getChildWithName(StateSerializer::EXTRA_STATE_TYPE);
+        expectEquals(extra.getNumChildren(), numSnapshots);
+    }
+};
+
+static StateSerializerTests stateSerializerTests;
+
+} // namespace AIplayer
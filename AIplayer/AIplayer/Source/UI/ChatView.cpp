@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    ChatView.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the virtualised chat display.
+
+  ==============================================================================
+*/
+
+#include "ChatView.h"
+
+namespace AIplayer {
+
+namespace {
+    constexpr int TEXT_INSET = 4;
+
+    /**
+     * Number of characters of `word` from `start` that fit on one line (at
+     * least one). Gallops up from one character, then bisects, so only
+     * O(log n) pieces no longer than about twice the line are measured; a
+     * very long token (URL, base64) wraps in O(n log n) instead of O(n^2).
+     */
+    int fittingLength(const juce::Font& font, const juce::String& word, int start, float maxWidth)
+    {
+        const auto fits = [&](int length)
+        {
+            return juce::GlyphArrangement::getStringWidth(font, word.substring(start, start + length)) <= maxWidth;
+        };
+
+        const int length = word.length() - start;
+        int low = 1;
+        int high = 2;
+
+        while (high < length && fits(high))
+        {
+            low = high;
+            high *= 2;
+        }
+
+        if (high >= length)
+        {
+            if (fits(length))
+                return length;
+
+            high = length;
+        }
+
+        while (high - low > 1)
+        {
+            const int middle = low + (high - low) / 2;
+            (fits(middle) ? low : high) = middle;
+        }
+
+        return low;
+    }
+}
+
+ChatView::ChatView(ChatHistory& history)
+    : chatHistory(history)
+{
+    listBox.setModel(this);
+    listBox.setRowHeight(juce::roundToInt(font.getHeight()) + 4);
+    listBox.setMultipleSelectionEnabled(false);
+    listBox.setClickingTogglesRowSelection(false);
+    listBox.setColour(juce::ListBox::backgroundColourId,
+                      getLookAndFeel().findColour(juce::TextEditor::backgroundColourId));
+    addAndMakeVisible(listBox);
+
+    chatHistory.addChangeListener(this);
+}
+
+ChatView::~ChatView()
+{
+    chatHistory.removeChangeListener(this);
+    listBox.setModel(nullptr);
+}
+
+//==============================================================================
+void ChatView::resized()
+{
+    listBox.setBounds(getLocalBounds());
+
+    // Only re-wrap when the usable width actually changed
+    const int width = juce::roundToInt(getTextWidth());
+    if (width != wrappedWidth)
+    {
+        wrappedWidth = width;
+        rebuildAllLines();
+    }
+}
+
+//==============================================================================
+int ChatView::getNumRows()
+{
+    return static_cast<int>(lines.size());
+}
+
+void ChatView::paintListBoxItem(int rowNumber, juce::Graphics& g, int width, int height, bool)
+{
+    if (rowNumber < 0 || rowNumber >= static_cast<int>(lines.size()))
+        return;
+
+    const auto& line = lines[static_cast<size_t>(rowNumber)];
+
+    auto colour = getLookAndFeel().findColour(juce::TextEditor::textColourId);
+    if (line.sender == ChatHistory::Sender::User)
+        colour = colour.withMultipliedAlpha(0.75f);
+    else if (line.sender == ChatHistory::Sender::System)
+        colour = colour.withMultipliedAlpha(0.5f);
+
+    g.setColour(colour);
+    g.setFont(font);
+    g.drawText(line.text, TEXT_INSET, 0, width - 2 * TEXT_INSET, height, juce::Justification::centredLeft, false);
+}
+
+void ChatView::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    syncWithHistory();
+}
+
+//==============================================================================
+/**
+ * @brief Brings the line cache up to date with the history
+ *
+ * @details Work done here is proportional to the number of messages added
+ * since the last callback, not to the length of the conversation. Lines of
+ * messages that have been overwritten in the ring are popped from the front.
+ */
+void ChatView::syncWithHistory()
+{
+    auto* viewport = listBox.getViewport();
+    const bool wasAtBottom = viewport == nullptr
+                          || viewport->getViewPositionY() + viewport->getViewHeight()
+                                 >= viewport->getViewedComponent()->getHeight() - listBox.getRowHeight();
+
+    const auto total = chatHistory.getTotalAdded();
+    const auto firstRetained = total - static_cast<juce::uint64>(chatHistory.getNumMessages());
+
+    // Drop lines whose messages no longer exist
+    while (!lines.empty() && lines.front().messageIndex < firstRetained)
+        lines.pop_front();
+
+    // Wrap only what's new
+    if (nextMessageToWrap < firstRetained)
+        nextMessageToWrap = firstRetained;
+
+    for (; nextMessageToWrap < total; ++nextMessageToWrap)
+    {
+        const int index = static_cast<int>(nextMessageToWrap - firstRetained);
+        appendWrappedLines(nextMessageToWrap, chatHistory.getMessage(index));
+    }
+
+    listBox.updateContent();
+
+    if (wasAtBottom && !lines.empty())
+        listBox.scrollToEnsureRowIsOnscreen(static_cast<int>(lines.size()) - 1);
+
+    listBox.repaint();
+}
+
+void ChatView::rebuildAllLines()
+{
+    lines.clear();
+    nextMessageToWrap = 0;
+    syncWithHistory();
+}
+
+void ChatView::appendWrappedLines(juce::uint64 messageIndex, const ChatHistory::Message& message)
+{
+    const float maxWidth = std::max(20.0f, getTextWidth());
+    const auto fullText = ChatHistory::getSenderPrefix(message.sender) + message.text;
+
+    auto pushLine = [this, messageIndex, &message](const juce::String& text)
+    {
+        lines.push_back({ messageIndex, text, message.sender });
+    };
+
+    for (const auto& paragraph : juce::StringArray::fromLines(fullText))
+    {
+        juce::String current;
+
+        for (const auto& word : juce::StringArray::fromTokens(paragraph, " ", {}))
+        {
+            const auto candidate = current.isEmpty() ? word : current + " " + word;
+
+            if (juce::GlyphArrangement::getStringWidth(font, candidate) <= maxWidth)
+            {
+                current = candidate;
+                continue;
+            }
+
+            if (current.isNotEmpty())
+                pushLine(current);
+
+            // Break words that don't fit on a line of their own
+            int start = 0;
+            int fit = fittingLength(font, word, start, maxWidth);
+            while (start + fit < word.length())
+            {
+                pushLine(word.substring(start, start + fit));
+                start += fit;
+                fit = fittingLength(font, word, start, maxWidth);
+            }
+
+            current = word.substring(start);
+        }
+
+        pushLine(current);
+    }
+}
+
+float ChatView::getTextWidth() const
+{
+    const int scrollbar = listBox.getViewport() != nullptr ? listBox.getViewport()->getScrollBarThickness() : 0;
+    return static_cast<float>(getWidth() - scrollbar - 2 * TEXT_INSET);
+}
+
+} // namespace AIplayer
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    ChatView.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Virtualised chat display backed by ChatHistory.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Models/ChatHistory.h"
+#include <deque>
+
+namespace AIplayer {
+
+/**
+ * @class ChatView
+ * @brief Read-only, virtualised view of a ChatHistory
+ *
+ * Replaces the ever-growing juce::TextEditor used previously:
+ * - Messages are word-wrapped once, when they arrive, into fixed-height lines
+ * - A juce::ListBox paints only the lines that are currently visible
+ * - Bursts of incoming messages arrive as one coalesced ChangeBroadcaster
+ *   callback, which triggers a single layout update and repaint
+ * - Lines belonging to messages that dropped out of the history are discarded,
+ *   so layout cost and memory stay bounded by ChatHistory::MAX_MESSAGES
+ *
+ * The view stays pinned to the newest message unless the user has scrolled up.
+ */
+class ChatView : public juce::Component,
+                 private juce::ListBoxModel,
+                 private juce::ChangeListener
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param history The chat history to display (must outlive this view)
+     */
+    explicit ChatView(ChatHistory& history);
+
+    /**
+     * @brief Destructor - detaches from the history
+     */
+    ~ChatView() override;
+
+    //==============================================================================
+    void resized() override;
+
+private:
+    /**
+     * @struct Line
+     * @brief One wrapped display line
+     */
+    struct Line
+    {
+        juce::uint64 messageIndex{0};     ///< Absolute index in ChatHistory
+        juce::String text;
+        ChatHistory::Sender sender{ChatHistory::Sender::System};
+    };
+
+    //==============================================================================
+    // ListBoxModel
+    int getNumRows() override;
+    void paintListBoxItem(int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected) override;
+
+    // ChangeListener
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+    /// Wraps any messages not yet laid out and drops lines of expired messages
+    void syncWithHistory();
+
+    /// Discards all lines and wraps the whole history again (width changed)
+    void rebuildAllLines();
+
+    /// Word-wraps a single message into lines
+    void appendWrappedLines(juce::uint64 messageIndex, const ChatHistory::Message& message);
+
+    /// Width available for text in a row
+    float getTextWidth() const;
+
+    ChatHistory& chatHistory;
+    juce::ListBox listBox;
+    juce::Font font{juce::FontOptions(14.0f)};
+
+    std::deque<Line> lines;
+    juce::uint64 nextMessageToWrap{0};
+    int wrappedWidth{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChatView)
+};
+
+} // namespace AIplayer
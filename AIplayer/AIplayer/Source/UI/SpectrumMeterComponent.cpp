@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+    SpectrumMeterComponent.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the spectrum and level meter view.
+
+  ==============================================================================
+*/
+
+#include "SpectrumMeterComponent.h"
+
+namespace AIplayer {
+
+namespace {
+    constexpr float SPECTRUM_MIN_DB = -100.0f;
+    constexpr float SPECTRUM_MAX_DB = 0.0f;
+    constexpr float METER_MIN_DB = -60.0f;
+    constexpr float METER_MAX_DB = 6.0f;
+    constexpr float PEAK_HOLD_DECAY = 0.92f;   // per refresh
+    constexpr int METER_STRIP_WIDTH = 28;
+
+    const juce::Colour backgroundColour { 0xff16181c };
+    const juce::Colour gridColour       { 0xff2c3038 };
+    const juce::Colour labelColour      { 0xff7a808c };
+    const juce::Colour spectrumColour   { 0xff4fc3f7 };
+    const juce::Colour rmsColour        { 0xff66bb6a };
+    const juce::Colour peakColour       { 0xffffca28 };
+}
+
+SpectrumMeterComponent::SpectrumMeterComponent(const FrequencyAnalyzer& analyzer, const AudioMetrics& metrics)
+    : frequencyAnalyzer(analyzer)
+    , audioMetrics(metrics)
+{
+    setOpaque(true);
+
+    for (auto& value : currentFrame.spectrumDb)
+        value = SPECTRUM_MIN_DB;
+}
+
+SpectrumMeterComponent::~SpectrumMeterComponent()
+{
+    vBlankAttachment.reset();
+}
+
+//==============================================================================
+void SpectrumMeterComponent::paint(juce::Graphics& g)
+{
+    if (backgroundImage.isValid())
+        g.drawImageAt(backgroundImage, 0, 0);
+    else
+        g.fillAll(backgroundColour);
+
+    // Spectrum curve (cached path, rebuilt only when a new frame arrives)
+    if (g.clipRegionIntersects(spectrumArea) && !spectrumPath.isEmpty())
+    {
+        g.saveState();
+        g.reduceClipRegion(spectrumArea);
+        g.setColour(spectrumColour.withAlpha(0.25f));
+        g.fillPath(spectrumPath);
+        g.setColour(spectrumColour);
+        g.strokePath(spectrumPath, juce::PathStrokeType(1.2f));
+        g.restoreState();
+    }
+
+    // Level meters
+    if (g.clipRegionIntersects(meterArea))
+    {
+        const auto halfWidth = meterArea.getWidth() / 2;
+        auto rmsBar = meterArea.withWidth(halfWidth - 1);
+        auto peakBar = meterArea.withTrimmedLeft(halfWidth + 1);
+
+        g.setColour(rmsColour);
+        g.fillRect(rmsBar.removeFromBottom(rmsHeight));
+
+        g.setColour(peakColour);
+        g.fillRect(peakBar.removeFromBottom(peakHeight));
+    }
+}
+
+void SpectrumMeterComponent::resized()
+{
+    auto bounds = getLocalBounds().reduced(4);
+    meterArea = bounds.removeFromRight(METER_STRIP_WIDTH);
+    bounds.removeFromRight(6);
+    spectrumArea = bounds;
+
+    renderBackground();
+    rebuildSpectrumPath();
+
+    rmsHeight = levelToMeterHeight(audioMetrics.getCurrentRMS());
+    peakHeight = levelToMeterHeight(peakHoldLevel);
+}
+
+void SpectrumMeterComponent::visibilityChanged()
+{
+    updateRefreshState();
+}
+
+void SpectrumMeterComponent::parentHierarchyChanged()
+{
+    updateRefreshState();
+}
+
+//==============================================================================
+/**
+ * @brief Starts or stops display-synchronised refreshes
+ *
+ * @details The attachment only exists while the component is actually on
+ * screen. Hiding the editor, minimising the host window or removing the
+ * component from its parent drops the attachment, which unregisters the
+ * callback from the peer entirely - no polling, no timers.
+ */
+void SpectrumMeterComponent::updateRefreshState()
+{
+    if (isShowing())
+    {
+        if (vBlankAttachment == nullptr)
+        {
+            vBlankAttachment = std::make_unique<juce::VBlankAttachment>(this, [this](double timestampSec)
+            {
+                onVBlank(timestampSec);
+            });
+        }
+    }
+    else
+    {
+        vBlankAttachment.reset();
+    }
+}
+
+/**
+ * @brief Per-refresh update, limited to MAX_REFRESH_HZ
+ *
+ * @details Compares cheap change indicators first (snapshot sequence number,
+ * meter heights in whole pixels) and only repaints the rectangles whose
+ * content actually changed. When the analysis is idle and the signal is
+ * constant this does no painting at all.
+ *
+ * @param timestampSec Timestamp of the vblank in seconds
+ */
+void SpectrumMeterComponent::onVBlank(double timestampSec)
+{
+    if (timestampSec - lastRefreshTime < 1.0 / MAX_REFRESH_HZ)
+        return;
+
+    lastRefreshTime = timestampSec;
+
+    // Spectrum: only copy and rebuild when a new frame was published
+    const auto& snapshot = frequencyAnalyzer.getFrameSnapshot();
+    if (snapshot.getSequence() != lastFrameSequence)
+    {
+        lastFrameSequence = snapshot.read(currentFrame);
+        rebuildSpectrumPath();
+        repaint(spectrumArea);
+    }
+
+    // Meters: repaint only if a bar moved by at least one pixel
+    const float rms = audioMetrics.getCurrentRMS();
+    peakHoldLevel = std::max(audioMetrics.getPeakLevel(), peakHoldLevel * PEAK_HOLD_DECAY);
+
+    const int newRmsHeight = levelToMeterHeight(rms);
+    const int newPeakHeight = levelToMeterHeight(peakHoldLevel);
+
+    if (newRmsHeight != rmsHeight || newPeakHeight != peakHeight)
+    {
+        const int top = meterArea.getBottom() - std::max({ rmsHeight, peakHeight, newRmsHeight, newPeakHeight });
+        rmsHeight = newRmsHeight;
+        peakHeight = newPeakHeight;
+        repaint(meterArea.withTop(top));
+    }
+}
+
+void SpectrumMeterComponent::renderBackground()
+{
+    if (getWidth() <= 0 || getHeight() <= 0)
+    {
+        backgroundImage = {};
+        return;
+    }
+
+    backgroundImage = juce::Image(juce::Image::RGB, getWidth(), getHeight(), true);
+    juce::Graphics g(backgroundImage);
+
+    g.fillAll(backgroundColour);
+    g.setFont(juce::FontOptions(10.0f));
+
+    // Frequency grid
+    const float logMin = std::log10(AnalysisFrame::MIN_FREQUENCY);
+    const float logRange = std::log10(AnalysisFrame::MAX_FREQUENCY) - logMin;
+
+    for (float freq : { 50.0f, 100.0f, 200.0f, 500.0f, 1000.0f, 2000.0f, 5000.0f, 10000.0f })
+    {
+        const float proportion = (std::log10(freq) - logMin) / logRange;
+        const int x = spectrumArea.getX() + juce::roundToInt(proportion * static_cast<float>(spectrumArea.getWidth()));
+
+        g.setColour(gridColour);
+        g.drawVerticalLine(x, static_cast<float>(spectrumArea.getY()), static_cast<float>(spectrumArea.getBottom()));
+
+        g.setColour(labelColour);
+        const auto label = freq >= 1000.0f ? juce::String(freq / 1000.0f, 0) + "k" : juce::String(freq, 0);
+        g.drawText(label, x + 2, spectrumArea.getBottom() - 12, 30, 12, juce::Justification::centredLeft, false);
+    }
+
+    // Level grid (shared by spectrum and meters)
+    for (float db : { -80.0f, -60.0f, -40.0f, -20.0f })
+    {
+        const float proportion = (db - SPECTRUM_MIN_DB) / (SPECTRUM_MAX_DB - SPECTRUM_MIN_DB);
+        const int y = spectrumArea.getBottom() - juce::roundToInt(proportion * static_cast<float>(spectrumArea.getHeight()));
+
+        g.setColour(gridColour);
+        g.drawHorizontalLine(y, static_cast<float>(spectrumArea.getX()), static_cast<float>(spectrumArea.getRight()));
+
+        g.setColour(labelColour);
+        g.drawText(juce::String(db, 0), spectrumArea.getX() + 2, y - 12, 30, 12, juce::Justification::centredLeft, false);
+    }
+
+    // Meter strip frame and 0 dB mark
+    g.setColour(gridColour);
+    g.drawRect(meterArea.expanded(1));
+
+    const int zeroDbY = meterArea.getBottom() - levelToMeterHeight(1.0f);
+    g.setColour(labelColour);
+    g.drawHorizontalLine(zeroDbY, static_cast<float>(meterArea.getX()), static_cast<float>(meterArea.getRight()));
+}
+
+void SpectrumMeterComponent::rebuildSpectrumPath()
+{
+    spectrumPath.clear();
+
+    if (spectrumArea.isEmpty() || lastFrameSequence == 0)
+        return;
+
+    const auto area = spectrumArea.toFloat();
+    const float xStep = area.getWidth() / static_cast<float>(AnalysisFrame::NUM_SPECTRUM_BINS - 1);
+
+    auto dbToY = [&area](float db)
+    {
+        const float proportion = (juce::jlimit(SPECTRUM_MIN_DB, SPECTRUM_MAX_DB, db) - SPECTRUM_MIN_DB)
+                                 / (SPECTRUM_MAX_DB - SPECTRUM_MIN_DB);
+        return area.getBottom() - proportion * area.getHeight();
+    };
+
+    spectrumPath.preallocateSpace(3 * (AnalysisFrame::NUM_SPECTRUM_BINS + 3));
+    spectrumPath.startNewSubPath(area.getX(), area.getBottom());
+
+    for (int i = 0; i < AnalysisFrame::NUM_SPECTRUM_BINS; ++i)
+        spectrumPath.lineTo(area.getX() + xStep * static_cast<float>(i), dbToY(currentFrame.spectrumDb[static_cast<size_t>(i)]));
+
+    spectrumPath.lineTo(area.getRight(), area.getBottom());
+    spectrumPath.closeSubPath();
+}
+
+int SpectrumMeterComponent::levelToMeterHeight(float linearLevel) const
+{
+    const float db = juce::Decibels::gainToDecibels(linearLevel, METER_MIN_DB);
+    const float proportion = (juce::jlimit(METER_MIN_DB, METER_MAX_DB, db) - METER_MIN_DB) / (METER_MAX_DB - METER_MIN_DB);
+    return juce::roundToInt(proportion * static_cast<float>(meterArea.getHeight()));
+}
+
+} // namespace AIplayer
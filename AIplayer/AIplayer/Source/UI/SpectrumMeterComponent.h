@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    SpectrumMeterComponent.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Lightweight spectrum and level meter view for the AIplayer editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Audio/AudioMetrics.h"
+#include "../Audio/FrequencyAnalyzer.h"
+#include "../Models/AnalysisFrame.h"
+#include <memory>
+
+namespace AIplayer {
+
+/**
+ * @class SpectrumMeterComponent
+ * @brief Displays the latest spectrum frame alongside RMS/peak meters
+ *
+ * Designed to cost next to nothing on the message thread, even with many
+ * editors open at once:
+ * - Reads analysis results from FrequencyAnalyzer's lock-free snapshot and
+ *   the atomics in AudioMetrics; never takes a lock
+ * - Redraws are driven by a juce::VBlankAttachment and further limited to
+ *   MAX_REFRESH_HZ, and only happen when something visibly changed
+ * - Static decoration (grid, labels) is rendered once into a cached image,
+ *   the spectrum curve is cached as a path and rebuilt only for new frames
+ * - Only the dirty area (spectrum or meter strip) is repainted
+ * - The vblank callback is detached whenever the component is not showing,
+ *   so hidden or minimised editors do no work at all
+ */
+class SpectrumMeterComponent : public juce::Component
+{
+public:
+    /// Upper bound on redraws per second, regardless of display refresh rate
+    static constexpr double MAX_REFRESH_HZ = 30.0;
+
+    /**
+     * @brief Constructor
+     *
+     * @param analyzer Frequency analyzer providing spectrum frames
+     * @param metrics Audio metrics providing RMS and peak levels
+     */
+    SpectrumMeterComponent(const FrequencyAnalyzer& analyzer, const AudioMetrics& metrics);
+
+    /**
+     * @brief Destructor
+     */
+    ~SpectrumMeterComponent() override;
+
+    //==============================================================================
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+
+private:
+    /// Attaches or detaches the vblank callback depending on isShowing()
+    void updateRefreshState();
+
+    /// Called for every display refresh while showing
+    void onVBlank(double timestampSec);
+
+    /// Renders the grid and labels into backgroundImage
+    void renderBackground();
+
+    /// Rebuilds spectrumPath from currentFrame
+    void rebuildSpectrumPath();
+
+    /// Converts a linear level to a meter height in pixels
+    int levelToMeterHeight(float linearLevel) const;
+
+    const FrequencyAnalyzer& frequencyAnalyzer;
+    const AudioMetrics& audioMetrics;
+
+    std::unique_ptr<juce::VBlankAttachment> vBlankAttachment;
+    double lastRefreshTime{0.0};
+
+    AnalysisFrame currentFrame;
+    uint64_t lastFrameSequence{0};
+
+    juce::Image backgroundImage;
+    juce::Path spectrumPath;
+
+    juce::Rectangle<int> spectrumArea;
+    juce::Rectangle<int> meterArea;
+
+    /// Meter state in pixels so that unchanged levels cause no repaint
+    int rmsHeight{0};
+    int peakHeight{0};
+    float peakHoldLevel{0.0f};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumMeterComponent)
+};
+
+} // namespace AIplayer
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    AnalysisAggregate.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the mergeable chunk measurements.
+
+  ==============================================================================
+*/
+
+#include "AnalysisAggregate.h"
+#include <cmath>
+
+namespace AIplayer {
+
+namespace {
+    constexpr float SILENCE_DB = -120.0f;
+
+    /// -0.691 dB offset from BS.1770
+    constexpr double LUFS_OFFSET = -0.691;
+
+    double lufsToEnergy(double lufs)
+    {
+        return std::pow(10.0, (lufs - LUFS_OFFSET) / 10.0);
+    }
+}
+
+//==============================================================================
+float AnalysisAggregate::powerToDb(double meanSquare)
+{
+    return meanSquare > 0.0 ? juce::jmax(SILENCE_DB, static_cast<float>(10.0 * std::log10(meanSquare))) : SILENCE_DB;
+}
+
+float AnalysisAggregate::energyToLufs(double energy)
+{
+    if (energy <= 1.0e-12)
+        return SILENCE_DB;
+
+    return juce::jmax(SILENCE_DB, static_cast<float>(LUFS_OFFSET + 10.0 * std::log10(energy)));
+}
+
+//==============================================================================
+void AnalysisAggregate::prepare(int numChannels, int numBins)
+{
+    channelEnergy.assign(static_cast<size_t>(numChannels), 0.0);
+    channelPeak.assign(static_cast<size_t>(numChannels), 0.0f);
+    spectrumPower.assign(static_cast<size_t>(numBins), 0.0);
+}
+
+void AnalysisAggregate::merge(const AnalysisAggregate& next)
+{
+    jassert(channelEnergy.size() == next.channelEnergy.size());
+    jassert(spectrumPower.size() == next.spectrumPower.size());
+
+    numSamples += next.numSamples;
+
+    for (size_t channel = 0; channel < channelEnergy.size() && channel < next.channelEnergy.size(); ++channel)
+    {
+        channelEnergy[channel] += next.channelEnergy[channel];
+        channelPeak[channel] = juce::jmax(channelPeak[channel], next.channelPeak[channel]);
+    }
+
+    for (size_t bin = 0; bin < levelHistogram.size(); ++bin)
+        levelHistogram[bin] += next.levelHistogram[bin];
+
+    hopEnergies.insert(hopEnergies.end(), next.hopEnergies.begin(), next.hopEnergies.end());
+    frameBandDb.insert(frameBandDb.end(), next.frameBandDb.begin(), next.frameBandDb.end());
+
+    for (size_t band = 0; band < bandPower.size(); ++band)
+        bandPower[band] += next.bandPower[band];
+
+    for (size_t bin = 0; bin < spectrumPower.size() && bin < next.spectrumPower.size(); ++bin)
+        spectrumPower[bin] += next.spectrumPower[bin];
+}
+
+void AnalysisAggregate::addHop(double weightedEnergy, double unweightedEnergy)
+{
+    hopEnergies.push_back(weightedEnergy);
+
+    const int bin = static_cast<int>(std::floor(powerToDb(unweightedEnergy))) - HISTOGRAM_MIN_DB;
+    ++levelHistogram[static_cast<size_t>(juce::jlimit(0, HISTOGRAM_BINS - 1, bin))];
+}
+
+//==============================================================================
+float AnalysisAggregate::getIntegratedLufs() const
+{
+    const int numHops = static_cast<int>(hopEnergies.size());
+    std::vector<double> blocks;
+
+    for (int start = 0; start + GATING_BLOCK_HOPS <= numHops; start += GATING_STEP_HOPS)
+    {
+        double sum = 0.0;
+        for (int hop = start; hop < start + GATING_BLOCK_HOPS; ++hop)
+            sum += hopEnergies[static_cast<size_t>(hop)];
+
+        blocks.push_back(sum / GATING_BLOCK_HOPS);
+    }
+
+    // Mean of the blocks above a threshold, or 0 if none pass
+    const auto gatedMean = [&blocks](double threshold, int& count)
+    {
+        double sum = 0.0;
+        count = 0;
+
+        for (const double block : blocks)
+        {
+            if (block > threshold)
+            {
+                sum += block;
+                ++count;
+            }
+        }
+
+        return count > 0 ? sum / count : 0.0;
+    };
+
+    int count = 0;
+    const double absoluteThreshold = lufsToEnergy(ABSOLUTE_GATE_LUFS);
+    const double ungated = gatedMean(absoluteThreshold, count);
+
+    if (count == 0)
+        return SILENCE_DB;
+
+    const double relativeThreshold = juce::jmax(absoluteThreshold, ungated * std::pow(10.0, RELATIVE_GATE_LU / 10.0));
+    return energyToLufs(gatedMean(relativeThreshold, count));
+}
+
+float AnalysisAggregate::getMaxWindowLufs(int windowHops) const
+{
+    const int numHops = static_cast<int>(hopEnergies.size());
+
+    if (numHops == 0)
+        return SILENCE_DB;
+
+    // Files shorter than the window count as one (partial) window
+    const int window = juce::jlimit(1, numHops, windowHops);
+
+    double sum = 0.0;
+    for (int hop = 0; hop < window; ++hop)
+        sum += hopEnergies[static_cast<size_t>(hop)];
+
+    double loudest = sum;
+
+    for (int hop = window; hop < numHops; ++hop)
+    {
+        sum += hopEnergies[static_cast<size_t>(hop)] - hopEnergies[static_cast<size_t>(hop - window)];
+        loudest = juce::jmax(loudest, sum);
+    }
+
+    return energyToLufs(loudest / window);
+}
+
+float AnalysisAggregate::getLevelPercentileDb(double fraction) const
+{
+    juce::int64 total = 0;
+    for (const auto count : levelHistogram)
+        total += count;
+
+    if (total == 0)
+        return SILENCE_DB;
+
+    const double target = juce::jlimit(0.0, 1.0, fraction) * static_cast<double>(total);
+    juce::int64 cumulative = 0;
+
+    for (int bin = 0; bin < HISTOGRAM_BINS; ++bin)
+    {
+        cumulative += levelHistogram[static_cast<size_t>(bin)];
+
+        if (cumulative > 0 && static_cast<double>(cumulative) >= target)
+            return static_cast<float>(HISTOGRAM_MIN_DB + bin);
+    }
+
+    return 0.0f;
+}
+
+} // namespace AIplayer
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    AnalysisAggregate.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Mergeable partial measurements of a section of an audio file.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../AIplayer/Source/Audio/BandEnergyAnalyzer.h"
+#include <array>
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @struct AnalysisAggregate
+ * @brief Everything the analyzer measures in one chunk of a file, in a form that merges
+ *
+ * A chunk owns the samples, 10 ms loudness hops and FFT frames that start
+ * inside it, so the chunks of a file partition every measurement exactly.
+ * merge() appends the next chunk:
+ * - sums (channel energy, band and spectrum power, counts) add
+ * - peaks take the maximum
+ * - the level histogram adds bin by bin
+ * - per-hop loudness energies and per-frame band levels concatenate, so
+ *   400 ms gating blocks and momentary windows that straddle a chunk
+ *   boundary are formed exactly as in a single pass
+ *
+ * Floating-point addition is not associative, so the grouping matters: the
+ * analyzer always folds the chunks left to right in file order, and that
+ * fixed order is what keeps the sums bit-identical however many threads
+ * produced them.
+ */
+struct AnalysisAggregate
+{
+    static constexpr int NUM_BANDS = BandEnergyAnalyzer::NUM_BANDS;
+
+    /// Level histogram range and resolution: 1 dB bins of 10 ms hop RMS
+    static constexpr int HISTOGRAM_MIN_DB = -120;
+    static constexpr int HISTOGRAM_BINS = 121;
+
+    /// BS.1770 gating: 400 ms blocks every 100 ms, in 10 ms hops
+    static constexpr int GATING_BLOCK_HOPS = 40;
+    static constexpr int GATING_STEP_HOPS = 10;
+    static constexpr double ABSOLUTE_GATE_LUFS = -70.0;
+    static constexpr double RELATIVE_GATE_LU = -10.0;
+
+    juce::int64 numSamples{0};
+    std::vector<double> channelEnergy;                  ///< Sum of squares per channel
+    std::vector<float> channelPeak;                     ///< Absolute peak per channel
+    std::array<juce::int64, HISTOGRAM_BINS> levelHistogram{};
+
+    std::vector<double> hopEnergies;                    ///< K-weighted mean square per 10 ms hop
+    std::vector<std::array<float, NUM_BANDS>> frameBandDb;  ///< Band levels per FFT frame
+
+    std::array<double, NUM_BANDS> bandPower{};          ///< Sum over frames
+    std::vector<double> spectrumPower;                  ///< Sum over frames per bin (optional)
+
+    /**
+     * @brief Sizes the per-channel and per-bin sums
+     *
+     * @param numChannels Channels measured
+     * @param numBins Spectrum bins to keep (0 for none)
+     */
+    void prepare(int numChannels, int numBins);
+
+    /**
+     * @brief Appends the aggregate of the following chunk
+     *
+     * @param next Aggregate of the chunk directly after this one
+     */
+    void merge(const AnalysisAggregate& next);
+
+    /**
+     * @brief Adds one completed hop
+     *
+     * @param weightedEnergy K-weighted mean square (LoudnessMeter)
+     * @param unweightedEnergy Plain mean square, for the level histogram
+     */
+    void addHop(double weightedEnergy, double unweightedEnergy);
+
+    /// Number of FFT frames measured
+    int getNumFrames() const { return static_cast<int>(frameBandDb.size()); }
+
+    /// Gated integrated loudness (BS.1770-4) in LUFS
+    float getIntegratedLufs() const;
+
+    /**
+     * @brief Loudest sliding window, updated every hop as LoudnessMeter does
+     *
+     * @param windowHops Window length (LoudnessMeter::MOMENTARY_HOPS or SHORT_TERM_HOPS)
+     * @return Loudness in LUFS
+     */
+    float getMaxWindowLufs(int windowHops) const;
+
+    /**
+     * @brief Level below which a fraction of the hops lie
+     *
+     * @param fraction 0-1 (0.5 = median hop level)
+     * @return Lower edge of the histogram bin, in dBFS
+     */
+    float getLevelPercentileDb(double fraction) const;
+
+    /// Converts a mean square to dB, floored at -120
+    static float powerToDb(double meanSquare);
+
+    /// Converts a K-weighted mean square to LUFS, floored at -120
+    static float energyToLufs(double energy);
+};
+
+} // namespace AIplayer
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    CrossStemMasking.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the cross-stem masking matrices.
+
+  ==============================================================================
+*/
+
+#include "CrossStemMasking.h"
+
+namespace AIplayer {
+
+namespace {
+    /// Average masking of one stem by another in every band
+    std::array<float, CrossStemMasking::NUM_BANDS> maskingOf(const CrossStemMasking::Stem& masked,
+                                                            const CrossStemMasking::Stem& masker)
+    {
+        std::array<float, CrossStemMasking::NUM_BANDS> result;
+        result.fill(CrossStemMasking::NO_MASKING_DB);
+
+        if (masked.aggregate == nullptr || masker.aggregate == nullptr || masked.sampleRate != masker.sampleRate)
+            return result;
+
+        const auto& maskedFrames = masked.aggregate->frameBandDb;
+        const auto& maskerFrames = masker.aggregate->frameBandDb;
+        const size_t numFrames = juce::jmin(maskedFrames.size(), maskerFrames.size());
+
+        for (size_t band = 0; band < result.size(); ++band)
+        {
+            double sum = 0.0;
+            int overlapping = 0;
+
+            for (size_t frame = 0; frame < numFrames; ++frame)
+            {
+                const float maskedDb = maskedFrames[frame][band];
+                const float maskerDb = maskerFrames[frame][band];
+
+                if (maskedDb > CrossStemMasking::MASKING_FLOOR_DB && maskerDb > CrossStemMasking::MASKING_FLOOR_DB)
+                {
+                    sum += juce::jlimit(CrossStemMasking::NO_MASKING_DB, -CrossStemMasking::NO_MASKING_DB, maskerDb - maskedDb);
+                    ++overlapping;
+                }
+            }
+
+            if (overlapping > 0)
+                result[band] = static_cast<float>(sum / overlapping);
+        }
+
+        return result;
+    }
+}
+
+//==============================================================================
+CrossStemMasking CrossStemMasking::compute(const std::vector<Stem>& stems, WorkStealingPool& pool)
+{
+    CrossStemMasking masking;
+    masking.numStems = static_cast<int>(stems.size());
+
+    for (auto& matrix : masking.maskingDb)
+        matrix.assign(stems.size() * stems.size(), NO_MASKING_DB);
+
+    // One task per row; rows write disjoint parts of the matrices
+    for (size_t masked = 0; masked < stems.size(); ++masked)
+    {
+        pool.submit([&masking, &stems, masked]
+        {
+            for (size_t masker = 0; masker < stems.size(); ++masker)
+            {
+                if (masker == masked)
+                    continue;
+
+                const auto row = maskingOf(stems[masked], stems[masker]);
+
+                for (size_t band = 0; band < row.size(); ++band)
+                    masking.maskingDb[band][masked * stems.size() + masker] = row[band];
+            }
+        });
+    }
+
+    pool.waitForAll();
+    return masking;
+}
+
+} // namespace AIplayer
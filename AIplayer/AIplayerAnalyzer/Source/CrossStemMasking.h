@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    CrossStemMasking.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Per-band masking between every pair of stems in a batch.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalysisAggregate.h"
+#include "WorkStealingPool.h"
+#include <array>
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @struct CrossStemMasking
+ * @brief Masking matrices of a batch, one per analysis band
+ *
+ * Masking uses the definition of the plugin's sidechain analysis (see
+ * SidechainProcessor): the masker's band level minus the masked stem's,
+ * clamped to +/-60 dB, and only while both are above -70 dB in that band.
+ * Offline it is averaged over the FFT frames in which both stems are
+ * active. Frames are aligned by index, which matches bounces that start
+ * together; pairs with different sample rates, or without a single frame of
+ * overlap, report NO_MASKING_DB.
+ *
+ * The matrix is not symmetric: entry (masked, masker) = how far the masker
+ * sits above the masked stem. Positive values are the conflicts to look at.
+ */
+struct CrossStemMasking
+{
+    static constexpr int NUM_BANDS = AnalysisAggregate::NUM_BANDS;
+
+    /// Bands quieter than this in either stem report no masking
+    static constexpr float MASKING_FLOOR_DB = -70.0f;
+
+    /// Masking value for pairs that never overlap (also the lower clamp)
+    static constexpr float NO_MASKING_DB = -60.0f;
+
+    /// One stem of the batch; a null aggregate marks a file that failed
+    struct Stem
+    {
+        const AnalysisAggregate* aggregate{nullptr};
+        double sampleRate{0.0};
+    };
+
+    int numStems{0};
+    std::array<std::vector<float>, NUM_BANDS> maskingDb;   ///< Row-major, numStems x numStems
+
+    /**
+     * @brief Masking of one stem by another
+     *
+     * @param band Analysis band (0-3)
+     * @param masked Stem being covered
+     * @param masker Stem doing the covering
+     */
+    float get(int band, int masked, int masker) const
+    {
+        return maskingDb[static_cast<size_t>(band)][static_cast<size_t>(masked * numStems + masker)];
+    }
+
+    /**
+     * @brief Computes every pair
+     *
+     * Each row is an independent task on the pool and is summed in frame
+     * order, so the matrices do not depend on the number of workers.
+     *
+     * @param stems Stems in report order
+     * @param pool Workers for the rows
+     */
+    static CrossStemMasking compute(const std::vector<Stem>& stems, WorkStealingPool& pool);
+};
+
+} // namespace AIplayer
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Command-line entry point of the offline stem analyzer.
+
+    Usage:
+      AIplayerAnalyzer [options] <files or folders...>
+
+      --format=json|csv        Report format (default json)
+      --output=<file>          Write the report to a file instead of stdout
+      --threads=<n>            Worker threads (default: one per core)
+      --fft-order=<n>          FFT size 2^n, 8-15 (default 10, as the plugin)
+      --map-threshold-mb=<n>   Memory-map WAV/AIFF files from this size (default 64)
+      --chunk-seconds=<s>      Unit of parallel work within a file (default 10)
+      --spectrum               Include the average spectrum (JSON only)
+      --run-tests              Run the analyzer's unit tests and exit
+
+    The JSON report also holds the cross-stem masking matrices and the
+    throughput. Results do not depend on --threads.
+
+    Exit code: 0 if every file was analysed, 1 if any failed, 2 on usage errors.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineAnalyzer.h"
+#include "ReportWriter.h"
+#include <iostream>
+
+namespace {
+
+int printUsage()
+{
+    std::cerr << "Usage: AIplayerAnalyzer [--format=json|csv] [--output=<file>] [--threads=<n>]" << std::endl
+              << "                        [--fft-order=<n>] [--map-threshold-mb=<n>] [--chunk-seconds=<s>]" << std::endl
+              << "                        [--spectrum]" << std::endl
+              << "                        <files or folders...>" << std::endl
+              << "       AIplayerAnalyzer --run-tests" << std::endl;
+    return 2;
+}
+
+int runTests()
+{
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory("AIplayerAnalyzer");
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        if (const auto* result = runner.getResult(i))
+            failures += result->failures;
+
+    return failures > 0 ? 1 : 0;
+}
+
+/// Expands folders (recursively) into the audio files they contain
+juce::Array<juce::File> collectFiles(const juce::StringArray& paths)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    const auto wildcard = formats.getWildcardForAllFormats();
+
+    juce::Array<juce::File> files;
+
+    for (const auto& path : paths)
+    {
+        const auto target = juce::File::getCurrentWorkingDirectory().getChildFile(path);
+
+        if (target.isDirectory())
+        {
+            auto found = target.findChildFiles(juce::File::findFiles, true, wildcard);
+            found.sort();
+            files.addArray(found);
+        }
+        else
+        {
+            files.add(target);
+        }
+    }
+
+    return files;
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (args.removeOptionIfFound("--run-tests"))
+        return runTests();
+
+    AIplayer::OfflineAnalyzer::Options options;
+
+    const auto format = args.removeValueForOption("--format").toLowerCase();
+    const auto output = args.removeValueForOption("--output");
+    const auto threads = args.removeValueForOption("--threads");
+    const auto fftOrder = args.removeValueForOption("--fft-order");
+    const auto mapThreshold = args.removeValueForOption("--map-threshold-mb");
+    const auto chunkSeconds = args.removeValueForOption("--chunk-seconds");
+    options.includeSpectrum = args.removeOptionIfFound("--spectrum");
+
+    if (threads.isNotEmpty())
+        options.numThreads = threads.getIntValue();
+    if (fftOrder.isNotEmpty())
+        options.fftOrder = fftOrder.getIntValue();
+    if (mapThreshold.isNotEmpty())
+        options.memoryMapThresholdBytes = static_cast<juce::int64>(mapThreshold.getIntValue()) << 20;
+    if (chunkSeconds.isNotEmpty())
+        options.chunkSeconds = chunkSeconds.getDoubleValue();
+
+    juce::StringArray paths;
+    for (const auto& argument : args.arguments)
+    {
+        if (argument.isOption())
+        {
+            std::cerr << "Unknown option: " << argument.text << std::endl;
+            return printUsage();
+        }
+
+        paths.add(argument.text);
+    }
+
+    if (paths.isEmpty() || (format.isNotEmpty() && format != "json" && format != "csv"))
+        return printUsage();
+
+    const auto files = collectFiles(paths);
+    AIplayer::OfflineAnalyzer analyzer(options);
+
+    const auto batch = analyzer.analyseBatch(files);
+    const auto& reports = batch.stems;
+
+    const auto text = format == "csv" ? AIplayer::ReportWriter::toCsv(reports)
+                                      : AIplayer::ReportWriter::toJson(batch);
+
+    if (output.isNotEmpty())
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(output);
+        if (!file.replaceWithText(text))
+        {
+            std::cerr << "Cannot write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << text;
+    }
+
+    int failed = 0;
+    for (const auto& report : reports)
+    {
+        failed += report.succeeded() ? 0 : 1;
+
+        if (!report.succeeded())
+            std::cerr << report.file.getFullPathName() << ": " << report.error << std::endl;
+    }
+
+    std::cerr << reports.size() << " files, " << juce::String(batch.getAudioSeconds(), 1) << " s of audio in "
+              << juce::String(batch.wallSeconds, 2) << " s on " << batch.numThreads << " threads ("
+              << juce::String(batch.getRealtimeFactor(), 1) << "x realtime, "
+              << juce::String(batch.getRealtimeFactorPerCore(), 1) << "x per core)" << std::endl;
+
+    return failed > 0 ? 1 : 0;
+}
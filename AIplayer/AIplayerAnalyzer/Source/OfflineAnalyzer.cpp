@@ -0,0 +1,372 @@
+/*
+  ==============================================================================
+
+    OfflineAnalyzer.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the offline stem analyzer.
+
+  ==============================================================================
+*/
+
+#include "OfflineAnalyzer.h"
+#include "WorkStealingPool.h"
+#include "../../AIplayer/Source/Audio/ChannelLayout.h"
+#include "../../AIplayer/Source/Audio/FFTProcessor.h"
+#include "../../AIplayer/Source/Audio/LoudnessMeter.h"
+#include <cmath>
+
+namespace AIplayer {
+
+namespace {
+    constexpr float SILENCE_DB = -120.0f;
+
+    double now()
+    {
+        return 0.001 * juce::Time::getMillisecondCounterHiRes();
+    }
+}
+
+//==============================================================================
+OfflineAnalyzer::OfflineAnalyzer(const Options& newOptions)
+    : options(newOptions)
+{
+    options.fftOrder = juce::jlimit(8, 15, options.fftOrder);
+    options.chunkSeconds = juce::jmax(0.1, options.chunkSeconds);
+}
+
+int OfflineAnalyzer::getNumThreads() const
+{
+    return options.numThreads > 0 ? options.numThreads : juce::jmax(1, juce::SystemStats::getNumCpus());
+}
+
+juce::int64 OfflineAnalyzer::getChunkLength(double sampleRate) const
+{
+    return juce::jmax<juce::int64>(1 << options.fftOrder, static_cast<juce::int64>(std::llround(options.chunkSeconds * sampleRate)));
+}
+
+int OfflineAnalyzer::getNumChunks(const StemReport& header) const
+{
+    const auto chunkLength = getChunkLength(header.sampleRate);
+    return static_cast<int>(juce::jmax<juce::int64>(1, (header.lengthInSamples + chunkLength - 1) / chunkLength));
+}
+
+std::unique_ptr<juce::AudioFormatReader> OfflineAnalyzer::openReader(juce::AudioFormatManager& formats, const juce::File& file,
+                                                                     juce::Range<juce::int64> samples, bool& memoryMapped) const
+{
+    memoryMapped = false;
+
+    // Large WAV/AIFF: map the chunk's section and let the OS page it in
+    if (file.getSize() >= options.memoryMapThresholdBytes)
+    {
+        if (auto* format = formats.findFormatForFileExtension(file.getFileExtension()))
+        {
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+
+            if (mapped != nullptr && mapped->mapSectionOfFile(samples))
+            {
+                memoryMapped = true;
+                return mapped;
+            }
+        }
+    }
+
+    return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+}
+
+//==============================================================================
+StemReport OfflineAnalyzer::readHeader(const juce::File& file) const
+{
+    StemReport report;
+    report.file = file;
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+    if (reader == nullptr)
+    {
+        report.error = file.existsAsFile() ? "Unsupported audio format" : "File not found";
+        return report;
+    }
+
+    report.sampleRate = reader->sampleRate;
+    report.numChannels = static_cast<int>(reader->numChannels);
+    report.lengthInSamples = reader->lengthInSamples;
+
+    if (report.numChannels < 1 || report.sampleRate <= 0.0)
+        report.error = "No audio";
+
+    return report;
+}
+
+OfflineAnalyzer::ChunkResult OfflineAnalyzer::analyseChunk(const StemReport& header, int chunkIndex) const
+{
+    ChunkResult result;
+    const double startTime = now();
+
+    // Channels beyond the plugin's bus limit are not analysed
+    const int numChannels = juce::jmin(header.numChannels, ChannelLayout::MAX_CHANNELS);
+    const int blockSize = 1 << options.fftOrder;
+
+    LoudnessMeter loudness;
+    loudness.prepare(header.sampleRate, blockSize, numChannels);
+
+    std::array<float, ChannelLayout::MAX_CHANNELS> weights;
+    ChannelLayout::loudnessWeights(juce::AudioChannelSet::canonicalChannelSet(numChannels), weights.data());
+    loudness.setChannelWeights(weights.data(), numChannels);
+
+    FFTProcessor fft(options.fftOrder);
+    BandEnergyAnalyzer bands;
+    const int numBins = fft.getMagnitudeSpectrumSize();
+
+    auto& aggregate = result.aggregate;
+    aggregate.prepare(numChannels, options.includeSpectrum ? numBins : 0);
+
+    // The chunk owns the samples, hops and frames that start in [start, end).
+    // Hops and frames are on grids anchored at sample 0, so reading runs a
+    // little past the end to complete the last ones, and the loudness meter
+    // starts WARMUP_HOPS early (on the hop grid) so that its filters have
+    // settled by the first owned hop.
+    const auto chunkLength = getChunkLength(header.sampleRate);
+    const juce::int64 start = chunkLength * chunkIndex;
+    const juce::int64 end = juce::jmin(header.lengthInSamples, start + chunkLength);
+
+    const int hop = loudness.getHopSamples();
+    const juce::int64 firstHop = (start + hop - 1) / hop * hop;
+    const juce::int64 meterStart = juce::jmax<juce::int64>(0, firstHop - static_cast<juce::int64>(WARMUP_HOPS) * hop);
+    const juce::int64 readStart = meterStart / blockSize * blockSize;
+    const juce::int64 readEnd = juce::jmin(header.lengthInSamples, end + juce::jmax(hop, blockSize));
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    auto reader = openReader(formats, header.file, { readStart, readEnd }, result.memoryMapped);
+    if (reader == nullptr)
+    {
+        result.error = "Cannot reopen file";
+        return result;
+    }
+
+    juce::AudioBuffer<float> block(numChannels, blockSize);
+    std::array<float, BandEnergyAnalyzer::NUM_BANDS> frameDb;
+
+    for (juce::int64 position = readStart; position < readEnd; position += blockSize)
+    {
+        const int count = static_cast<int>(juce::jmin<juce::int64>(blockSize, readEnd - position));
+        block.setSize(numChannels, count, false, false, true);
+
+        if (!reader->read(&block, 0, count, position, true, true))
+        {
+            result.error = "Read error";
+            return result;
+        }
+
+        // Levels: exactly the samples of this chunk
+        const int levelStart = static_cast<int>(juce::jlimit<juce::int64>(0, count, start - position));
+        const int levelEnd = static_cast<int>(juce::jlimit<juce::int64>(0, count, end - position));
+
+        if (levelEnd > levelStart)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                aggregate.channelEnergy[static_cast<size_t>(channel)]
+                    += ChannelLayout::sumOfSquares(block.getReadPointer(channel, levelStart), levelEnd - levelStart);
+                aggregate.channelPeak[static_cast<size_t>(channel)]
+                    = juce::jmax(aggregate.channelPeak[static_cast<size_t>(channel)],
+                                 block.getMagnitude(channel, levelStart, levelEnd - levelStart));
+            }
+
+            aggregate.numSamples += levelEnd - levelStart;
+        }
+
+        // Loudness: one hop at a time, keeping the hops that start in this chunk
+        for (int offset = static_cast<int>(juce::jlimit<juce::int64>(0, count, meterStart - position)); offset < count;)
+        {
+            const int run = juce::jmin(count - offset, loudness.getSamplesUntilHop());
+
+            if (loudness.process(block, offset, run) > 0)
+            {
+                const juce::int64 hopStart = position + offset + run - hop;
+
+                if (hopStart >= start && hopStart < end)
+                    aggregate.addHop(loudness.getLastHopWeightedEnergy(), loudness.getLastHopUnweightedEnergy());
+            }
+
+            offset += run;
+        }
+
+        // Spectrum: one non-overlapping frame per full block on the grid (the
+        // plugin's analysis thread overlaps its frames, so frame counts and
+        // per-frame statistics differ from it)
+        if (count == blockSize && position >= start && position < end)
+        {
+            fft.processAudioBlock(block, header.sampleRate);
+
+            if (fft.computeFFT())
+            {
+                const float* magnitudes = fft.getMagnitudeSpectrum();
+                bands.analyzeBands(magnitudes, numBins, fft.getBinWidth(), header.sampleRate, fft.getNoiseBandwidth());
+
+                for (int band = 0; band < BandEnergyAnalyzer::NUM_BANDS; ++band)
+                {
+                    const float power = bands.getBandEnergyLinear(band);
+                    aggregate.bandPower[static_cast<size_t>(band)] += power;
+                    frameDb[static_cast<size_t>(band)] = AnalysisAggregate::powerToDb(power);
+                }
+
+                aggregate.frameBandDb.push_back(frameDb);
+
+                for (size_t bin = 0; bin < aggregate.spectrumPower.size(); ++bin)
+                    aggregate.spectrumPower[bin] += static_cast<double>(magnitudes[bin]) * magnitudes[bin];
+            }
+        }
+    }
+
+    result.seconds = now() - startTime;
+    return result;
+}
+
+AnalysisAggregate OfflineAnalyzer::finishReport(StemReport& report, std::vector<ChunkResult>& chunks) const
+{
+    report.numChunks = static_cast<int>(chunks.size());
+
+    // Left to right in file order: the same additions for any thread count
+    AnalysisAggregate total = std::move(chunks.front().aggregate);
+
+    for (size_t index = 0; index < chunks.size(); ++index)
+    {
+        const auto& chunk = chunks[index];
+
+        if (chunk.error.isNotEmpty() && report.error.isEmpty())
+            report.error = chunk.error;
+
+        if (index > 0)
+            total.merge(chunk.aggregate);
+
+        report.memoryMapped = report.memoryMapped || chunk.memoryMapped;
+        report.processingSeconds += chunk.seconds;
+    }
+
+    if (!report.succeeded())
+        return {};
+
+    const int numChannels = static_cast<int>(total.channelEnergy.size());
+    const double length = static_cast<double>(juce::jmax<juce::int64>(1, total.numSamples));
+    double totalEnergy = 0.0;
+    float totalPeak = 0.0f;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        totalEnergy += total.channelEnergy[static_cast<size_t>(channel)];
+        totalPeak = juce::jmax(totalPeak, total.channelPeak[static_cast<size_t>(channel)]);
+
+        report.channelRmsDb.push_back(AnalysisAggregate::powerToDb(total.channelEnergy[static_cast<size_t>(channel)] / length));
+        report.channelPeakDb.push_back(juce::Decibels::gainToDecibels(total.channelPeak[static_cast<size_t>(channel)], SILENCE_DB));
+    }
+
+    report.rmsDb = AnalysisAggregate::powerToDb(totalEnergy / (length * juce::jmax(1, numChannels)));
+    report.peakDb = juce::Decibels::gainToDecibels(totalPeak, SILENCE_DB);
+
+    report.maxMomentaryLufs = total.getMaxWindowLufs(LoudnessMeter::MOMENTARY_HOPS);
+    report.maxShortTermLufs = total.getMaxWindowLufs(LoudnessMeter::SHORT_TERM_HOPS);
+    report.integratedLufs = total.getIntegratedLufs();
+    report.levelHistogram = total.levelHistogram;
+
+    const int frames = total.getNumFrames();
+    report.binWidthHz = static_cast<float>(report.sampleRate / (1 << options.fftOrder));
+
+    for (int band = 0; band < BandEnergyAnalyzer::NUM_BANDS; ++band)
+        report.bandEnergyDb[static_cast<size_t>(band)] = frames > 0 ? AnalysisAggregate::powerToDb(total.bandPower[static_cast<size_t>(band)] / frames)
+                                                                    : SILENCE_DB;
+
+    for (const double power : total.spectrumPower)
+        report.spectrumDb.push_back(frames > 0 ? AnalysisAggregate::powerToDb(power / frames) : SILENCE_DB);
+
+    return total;
+}
+
+//==============================================================================
+StemReport OfflineAnalyzer::analyseFile(const juce::File& file) const
+{
+    auto report = readHeader(file);
+
+    if (!report.succeeded())
+        return report;
+
+    std::vector<ChunkResult> chunks;
+    for (int chunk = 0; chunk < getNumChunks(report); ++chunk)
+        chunks.push_back(analyseChunk(report, chunk));
+
+    finishReport(report, chunks);
+    return report;
+}
+
+std::vector<StemReport> OfflineAnalyzer::analyseFiles(const juce::Array<juce::File>& files) const
+{
+    return analyseBatch(files).stems;
+}
+
+BatchReport OfflineAnalyzer::analyseBatch(const juce::Array<juce::File>& files) const
+{
+    const double startTime = now();
+    const size_t numFiles = static_cast<size_t>(files.size());
+
+    BatchReport batch;
+    batch.stems.resize(numFiles);
+
+    WorkStealingPool pool(getNumThreads());
+    batch.numThreads = pool.getNumWorkers();
+
+    // Headers first: the chunk count of every file is needed up front
+    for (size_t index = 0; index < numFiles; ++index)
+        pool.submit([this, &files, &batch, index] { batch.stems[index] = readHeader(files.getReference(static_cast<int>(index))); });
+
+    pool.waitForAll();
+
+    // Every chunk of every file is one task writing its own slot
+    std::vector<std::vector<ChunkResult>> chunks(numFiles);
+
+    for (size_t index = 0; index < numFiles; ++index)
+    {
+        const auto& header = batch.stems[index];
+
+        if (!header.succeeded())
+            continue;
+
+        chunks[index].resize(static_cast<size_t>(getNumChunks(header)));
+
+        for (size_t chunk = 0; chunk < chunks[index].size(); ++chunk)
+            pool.submit([this, &header, &chunks, index, chunk]
+            {
+                chunks[index][chunk] = analyseChunk(header, static_cast<int>(chunk));
+            });
+    }
+
+    pool.waitForAll();
+
+    // Merge each file's chunks in order, then compare the stems
+    std::vector<AnalysisAggregate> totals(numFiles);
+    std::vector<CrossStemMasking::Stem> stems(numFiles);
+
+    for (size_t index = 0; index < numFiles; ++index)
+    {
+        auto& report = batch.stems[index];
+
+        if (!report.succeeded())
+            continue;
+
+        totals[index] = finishReport(report, chunks[index]);
+        chunks[index].clear();
+
+        if (report.succeeded())
+            stems[index] = { &totals[index], report.sampleRate };
+    }
+
+    batch.masking = CrossStemMasking::compute(stems, pool);
+    batch.wallSeconds = now() - startTime;
+    return batch;
+}
+
+} // namespace AIplayer
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    OfflineAnalyzer.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Offline analysis of bounced stems with the plugin's own DSP classes.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalysisAggregate.h"
+#include "CrossStemMasking.h"
+#include <array>
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @struct StemReport
+ * @brief Measurements of one audio file
+ *
+ * Levels are in dBFS, loudness in LUFS. Band energies and the spectrum are
+ * power averages over every FFT frame of the file. Integrated loudness is
+ * gated as in BS.1770-4; the level histogram counts 10 ms hops per 1 dB
+ * of RMS level from -120 dBFS (see AnalysisAggregate).
+ */
+struct StemReport
+{
+    juce::File file;
+    juce::String error;                 ///< Empty on success
+
+    double sampleRate{0.0};
+    int numChannels{0};
+    juce::int64 lengthInSamples{0};
+    bool memoryMapped{false};
+
+    float rmsDb{-120.0f};
+    float peakDb{-120.0f};
+    std::vector<float> channelRmsDb;
+    std::vector<float> channelPeakDb;
+    float maxMomentaryLufs{-120.0f};
+    float maxShortTermLufs{-120.0f};
+    float integratedLufs{-120.0f};
+    std::array<juce::int64, AnalysisAggregate::HISTOGRAM_BINS> levelHistogram{};
+
+    std::array<float, BandEnergyAnalyzer::NUM_BANDS> bandEnergyDb{};
+    std::vector<float> spectrumDb;      ///< Average magnitude per FFT bin
+    float binWidthHz{0.0f};
+
+    int numChunks{0};
+    double processingSeconds{0.0};      ///< Worker time, summed over the file's chunks
+
+    bool succeeded() const { return error.isEmpty(); }
+    double getDurationSeconds() const { return sampleRate > 0.0 ? static_cast<double>(lengthInSamples) / sampleRate : 0.0; }
+
+    /// Seconds of audio analysed per second of worker time (per-core speed)
+    double getRealtimeFactor() const { return processingSeconds > 0.0 ? getDurationSeconds() / processingSeconds : 0.0; }
+};
+
+/**
+ * @struct BatchReport
+ * @brief Reports of a batch of stems, their masking matrices and the throughput
+ */
+struct BatchReport
+{
+    std::vector<StemReport> stems;      ///< In the order given
+    CrossStemMasking masking;           ///< Indexed like stems
+    int numThreads{0};
+    double wallSeconds{0.0};
+
+    /// Total duration of the stems analysed
+    double getAudioSeconds() const
+    {
+        double seconds = 0.0;
+        for (const auto& stem : stems)
+            seconds += stem.getDurationSeconds();
+        return seconds;
+    }
+
+    /// Seconds of audio per wall-clock second, all threads together
+    double getRealtimeFactor() const { return wallSeconds > 0.0 ? getAudioSeconds() / wallSeconds : 0.0; }
+
+    /// Realtime factor divided by the number of threads
+    double getRealtimeFactorPerCore() const { return numThreads > 0 ? getRealtimeFactor() / numThreads : 0.0; }
+};
+
+/**
+ * @class OfflineAnalyzer
+ * @brief Streams audio files through LoudnessMeter, FFTProcessor and BandEnergyAnalyzer
+ *
+ * The same classes the plugin runs on the audio thread measure each file,
+ * so offline reports match the plugin's telemetry. Files are read in
+ * FFT-sized blocks as fast as the disk allows; WAV and AIFF files above
+ * Options::memoryMapThresholdBytes are memory-mapped rather than streamed
+ * through a file buffer. Other formats (FLAC, Ogg, ...) use the regular
+ * reader from juce::AudioFormatManager.
+ *
+ * Every file is cut into chunks of Options::chunkSeconds. A chunk opens its
+ * own reader (mapping only its section), warms the K-weighting filters up
+ * on the 500 ms before it, and produces an AnalysisAggregate. The chunks of
+ * a batch run on a WorkStealingPool, so a folder of a hundred stems of very
+ * different lengths keeps every core busy; the aggregates are then merged
+ * in file order. Chunk boundaries depend only on the file and the options,
+ * never on the thread count, so reports are bit-identical on 1 or 64
+ * threads (apart from the timings).
+ */
+class OfflineAnalyzer
+{
+public:
+    /**
+     * @struct Options
+     * @brief Analysis settings shared by every file
+     */
+    struct Options
+    {
+        int fftOrder{10};                               ///< FFT and read block size (2^order)
+        int numThreads{0};                              ///< 0 = one per CPU core
+        juce::int64 memoryMapThresholdBytes{64 << 20};  ///< Map files at least this large
+        bool includeSpectrum{false};                    ///< Keep the average spectrum
+        double chunkSeconds{10.0};                      ///< Unit of parallel work within a file
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param options Analysis settings
+     */
+    explicit OfflineAnalyzer(const Options& options);
+
+    /**
+     * @brief Analyses one file on the calling thread
+     *
+     * Runs the same chunks as analyseBatch(), one after the other.
+     *
+     * @param file Audio file (any format registered by registerBasicFormats())
+     * @return Report; StemReport::error is set if the file cannot be read
+     */
+    StemReport analyseFile(const juce::File& file) const;
+
+    /**
+     * @brief Analyses files in parallel
+     *
+     * @param files Audio files
+     * @return One report per file, in the order given
+     */
+    std::vector<StemReport> analyseFiles(const juce::Array<juce::File>& files) const;
+
+    /**
+     * @brief Analyses files in parallel, with masking matrices and throughput
+     *
+     * @param files Audio files
+     * @return Reports in the order given, masking between them and timings
+     */
+    BatchReport analyseBatch(const juce::Array<juce::File>& files) const;
+
+    /**
+     * @brief Number of worker threads analyseFiles() uses
+     */
+    int getNumThreads() const;
+
+    /// Hops of K-weighting warm-up measured (and discarded) before a chunk
+    static constexpr int WARMUP_HOPS = 50;
+
+private:
+    /// Measurements of one chunk and what it took to get them
+    struct ChunkResult
+    {
+        AnalysisAggregate aggregate;
+        juce::String error;
+        bool memoryMapped{false};
+        double seconds{0.0};
+    };
+
+    /// Reads format, rate, channels and length; sets StemReport::error on failure
+    StemReport readHeader(const juce::File& file) const;
+
+    /// Chunk length for a sample rate
+    juce::int64 getChunkLength(double sampleRate) const;
+
+    /// Number of chunks a file is cut into
+    int getNumChunks(const StemReport& header) const;
+
+    /// Measures the samples, hops and frames starting in one chunk
+    ChunkResult analyseChunk(const StemReport& header, int chunkIndex) const;
+
+    /// Merges a file's chunks in order and fills in its report
+    AnalysisAggregate finishReport(StemReport& report, std::vector<ChunkResult>& chunks) const;
+
+    /// Opens a reader for a range of samples, memory-mapped when possible
+    std::unique_ptr<juce::AudioFormatReader> openReader(juce::AudioFormatManager& formats, const juce::File& file,
+                                                        juce::Range<juce::int64> samples, bool& memoryMapped) const;
+
+    Options options;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineAnalyzer)
+};
+
+} // namespace AIplayer
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    ReportWriter.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the report formatting.
+
+  ==============================================================================
+*/
+
+#include "ReportWriter.h"
+
+namespace AIplayer {
+
+namespace {
+    /// Band keys, in BandEnergyAnalyzer order
+    const char* const bandKeys[BandEnergyAnalyzer::NUM_BANDS] = { "low_db", "low_mid_db", "high_mid_db", "high_db" };
+    const char* const maskingKeys[BandEnergyAnalyzer::NUM_BANDS] = { "low", "low_mid", "high_mid", "high" };
+
+    juce::var toArray(const std::vector<float>& values)
+    {
+        juce::Array<juce::var> array;
+        for (const float value : values)
+            array.add(value);
+        return array;
+    }
+
+    juce::var toVar(const StemReport& report)
+    {
+        auto* object = new juce::DynamicObject();
+        juce::var result(object);
+
+        object->setProperty("file", report.file.getFullPathName());
+
+        if (!report.succeeded())
+        {
+            object->setProperty("error", report.error);
+            return result;
+        }
+
+        object->setProperty("sample_rate", report.sampleRate);
+        object->setProperty("channels", report.numChannels);
+        object->setProperty("duration_s", report.getDurationSeconds());
+        object->setProperty("memory_mapped", report.memoryMapped);
+        object->setProperty("rms_db", report.rmsDb);
+        object->setProperty("peak_db", report.peakDb);
+        object->setProperty("channel_rms_db", toArray(report.channelRmsDb));
+        object->setProperty("channel_peak_db", toArray(report.channelPeakDb));
+        object->setProperty("max_momentary_lufs", report.maxMomentaryLufs);
+        object->setProperty("max_short_term_lufs", report.maxShortTermLufs);
+        object->setProperty("integrated_lufs", report.integratedLufs);
+
+        auto* bands = new juce::DynamicObject();
+        for (int band = 0; band < BandEnergyAnalyzer::NUM_BANDS; ++band)
+            bands->setProperty(bandKeys[band], report.bandEnergyDb[static_cast<size_t>(band)]);
+        object->setProperty("bands", juce::var(bands));
+
+        auto* histogram = new juce::DynamicObject();
+        juce::Array<juce::var> counts;
+        for (const auto count : report.levelHistogram)
+            counts.add(count);
+        histogram->setProperty("min_db", AnalysisAggregate::HISTOGRAM_MIN_DB);
+        histogram->setProperty("step_db", 1);
+        histogram->setProperty("counts", counts);
+        object->setProperty("level_histogram", juce::var(histogram));
+
+        if (!report.spectrumDb.empty())
+        {
+            object->setProperty("bin_width_hz", report.binWidthHz);
+            object->setProperty("spectrum_db", toArray(report.spectrumDb));
+        }
+
+        object->setProperty("chunks", report.numChunks);
+        object->setProperty("processing_s", report.processingSeconds);
+        object->setProperty("realtime_factor", report.getRealtimeFactor());
+        return result;
+    }
+
+    juce::var toVar(const CrossStemMasking& masking, const std::vector<StemReport>& stems)
+    {
+        auto* object = new juce::DynamicObject();
+
+        juce::Array<juce::var> files;
+        for (const auto& stem : stems)
+            files.add(stem.file.getFullPathName());
+        object->setProperty("files", files);
+
+        auto* bands = new juce::DynamicObject();
+        for (int band = 0; band < CrossStemMasking::NUM_BANDS; ++band)
+        {
+            juce::Array<juce::var> rows;
+            for (int masked = 0; masked < masking.numStems; ++masked)
+            {
+                juce::Array<juce::var> row;
+                for (int masker = 0; masker < masking.numStems; ++masker)
+                    row.add(masking.get(band, masked, masker));
+                rows.add(row);
+            }
+            bands->setProperty(maskingKeys[band], rows);
+        }
+        object->setProperty("bands_db", juce::var(bands));
+
+        return juce::var(object);
+    }
+
+    juce::var toVar(const BatchReport& batch)
+    {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("threads", batch.numThreads);
+        object->setProperty("audio_s", batch.getAudioSeconds());
+        object->setProperty("wall_s", batch.wallSeconds);
+        object->setProperty("realtime_factor", batch.getRealtimeFactor());
+        object->setProperty("realtime_factor_per_core", batch.getRealtimeFactorPerCore());
+        return juce::var(object);
+    }
+
+    juce::String csvField(const juce::String& text)
+    {
+        if (!text.containsAnyOf(",\"\n"))
+            return text;
+
+        return "\"" + text.replace("\"", "\"\"") + "\"";
+    }
+}
+
+//==============================================================================
+juce::String ReportWriter::toJson(const std::vector<StemReport>& reports)
+{
+    juce::Array<juce::var> files;
+    for (const auto& report : reports)
+        files.add(toVar(report));
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("files", files);
+
+    return juce::JSON::toString(juce::var(root));
+}
+
+juce::String ReportWriter::toJson(const BatchReport& batch)
+{
+    juce::Array<juce::var> files;
+    for (const auto& report : batch.stems)
+        files.add(toVar(report));
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("files", files);
+    root->setProperty("masking", toVar(batch.masking, batch.stems));
+    root->setProperty("throughput", toVar(batch));
+
+    return juce::JSON::toString(juce::var(root));
+}
+
+juce::String ReportWriter::toCsv(const std::vector<StemReport>& reports)
+{
+    juce::StringArray lines;
+
+    juce::StringArray header { "file", "sample_rate", "channels", "duration_s", "rms_db", "peak_db",
+                               "max_momentary_lufs", "max_short_term_lufs", "integrated_lufs" };
+    for (const auto* key : bandKeys)
+        header.add(key);
+    header.addArray(juce::StringArray { "realtime_factor", "error" });
+    lines.add(header.joinIntoString(","));
+
+    for (const auto& report : reports)
+    {
+        juce::StringArray row { csvField(report.file.getFullPathName()) };
+
+        if (report.succeeded())
+        {
+            row.add(juce::String(report.sampleRate, 0));
+            row.add(juce::String(report.numChannels));
+            row.add(juce::String(report.getDurationSeconds(), 3));
+            row.add(juce::String(report.rmsDb, 2));
+            row.add(juce::String(report.peakDb, 2));
+            row.add(juce::String(report.maxMomentaryLufs, 2));
+            row.add(juce::String(report.maxShortTermLufs, 2));
+            row.add(juce::String(report.integratedLufs, 2));
+
+            for (const float energy : report.bandEnergyDb)
+                row.add(juce::String(energy, 2));
+
+            row.add(juce::String(report.getRealtimeFactor(), 1));
+            row.add({});
+        }
+        else
+        {
+            for (int column = 1; column < header.size() - 1; ++column)
+                row.add({});
+
+            row.add(csvField(report.error));
+        }
+
+        lines.add(row.joinIntoString(","));
+    }
+
+    return lines.joinIntoString("\n") + "\n";
+}
+
+} // namespace AIplayer
@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    ReportWriter.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    JSON and CSV formatting of offline analysis reports.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "OfflineAnalyzer.h"
+
+namespace AIplayer {
+
+/**
+ * @namespace ReportWriter
+ * @brief Serialises StemReports for scripts and spreadsheets
+ *
+ * JSON keys and CSV columns use the same names and units (dB, LUFS, Hz,
+ * seconds). Failed files appear with their error and no measurements.
+ * Masking matrices and throughput only exist in the batch JSON; masking
+ * rows are the masked stem and columns the masker, in file order.
+ */
+namespace ReportWriter
+{
+    /**
+     * @brief Reports as a JSON document: { "files": [ ... ] }
+     *
+     * @param reports Reports in output order
+     */
+    juce::String toJson(const std::vector<StemReport>& reports);
+
+    /**
+     * @brief Batch as JSON: { "files": [ ... ], "masking": { ... }, "throughput": { ... } }
+     *
+     * @param batch Result of OfflineAnalyzer::analyseBatch()
+     */
+    juce::String toJson(const BatchReport& batch);
+
+    /**
+     * @brief Reports as CSV, one row per file with a header row
+     *
+     * @param reports Reports in output order
+     */
+    juce::String toCsv(const std::vector<StemReport>& reports);
+}
+
+} // namespace AIplayer
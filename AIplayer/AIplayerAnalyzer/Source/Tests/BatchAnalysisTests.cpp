@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+    BatchAnalysisTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for chunked batch analysis: the work-stealing pool, results that
+    do not depend on thread count or chunking, gated loudness and the
+    cross-stem masking matrices.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../OfflineAnalyzer.h"
+#include "../ReportWriter.h"
+#include "../WorkStealingPool.h"
+#include <atomic>
+#include <cstring>
+
+namespace AIplayer {
+
+class BatchAnalysisTests : public juce::UnitTest
+{
+public:
+    BatchAnalysisTests() : UnitTest("Batch Analysis Tests", "AIplayerAnalyzer") {}
+
+    void runTest() override
+    {
+        temporaryFolder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                              .getNonexistentChildFile("AIplayerBatchTests", {});
+
+        testWorkStealingPool();
+        testThreadCountIndependence();
+        testChunkBoundaries();
+        testGatedLoudness();
+        testMaskingMatrix();
+
+        temporaryFolder.deleteRecursively();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+
+    juce::File temporaryFolder;
+
+    /// Writes a stereo 32-bit float WAV: a sine for toneSeconds, then silence
+    juce::File writeStem(const juce::String& name, double frequency, float amplitude,
+                         double toneSeconds, double silenceSeconds = 0.0, float noise = 0.0f)
+    {
+        temporaryFolder.createDirectory();
+        const auto file = temporaryFolder.getChildFile(name);
+
+        const int toneSamples = juce::roundToInt(toneSeconds * sampleRate);
+        const int numSamples = toneSamples + juce::roundToInt(silenceSeconds * sampleRate);
+        juce::AudioBuffer<float> buffer(2, numSamples);
+        buffer.clear();
+
+        const double increment = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        juce::Random random(42);
+
+        for (int i = 0; i < toneSamples; ++i)
+        {
+            const float sample = amplitude * static_cast<float>(std::sin(increment * i))
+                                 + noise * (random.nextFloat() * 2.0f - 1.0f);
+            buffer.setSample(0, i, sample);
+            buffer.setSample(1, i, sample);
+        }
+
+        std::unique_ptr<juce::OutputStream> stream(file.createOutputStream());
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 2, 32, {}, 0));
+
+        if (writer != nullptr)
+        {
+            stream.release();
+            writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+        }
+
+        return file;
+    }
+
+    template <typename Container>
+    static bool sameBits(const Container& a, const Container& b)
+    {
+        return a.size() == b.size()
+            && (a.size() == 0 || std::memcmp(a.data(), b.data(), a.size() * sizeof(a[0])) == 0);
+    }
+
+    static bool sameBits(float a, float b)
+    {
+        return std::memcmp(&a, &b, sizeof(float)) == 0;
+    }
+
+    /// Every measurement of two reports matches bit for bit
+    static bool identical(const StemReport& a, const StemReport& b)
+    {
+        return sameBits(a.rmsDb, b.rmsDb) && sameBits(a.peakDb, b.peakDb)
+            && sameBits(a.maxMomentaryLufs, b.maxMomentaryLufs) && sameBits(a.maxShortTermLufs, b.maxShortTermLufs)
+            && sameBits(a.integratedLufs, b.integratedLufs)
+            && sameBits(a.channelRmsDb, b.channelRmsDb) && sameBits(a.channelPeakDb, b.channelPeakDb)
+            && sameBits(a.bandEnergyDb, b.bandEnergyDb) && sameBits(a.spectrumDb, b.spectrumDb)
+            && a.levelHistogram == b.levelHistogram && a.numChunks == b.numChunks;
+    }
+
+    void testWorkStealingPool()
+    {
+        beginTest("Work-stealing pool runs nested and uneven tasks");
+
+        std::atomic<int> completed{0};
+        WorkStealingPool pool(4);
+
+        // Some tasks fan out from inside a worker; stealing spreads them
+        for (int i = 0; i < 64; ++i)
+        {
+            pool.submit([&pool, &completed, i]
+            {
+                if (i % 8 == 0)
+                    for (int j = 0; j < 16; ++j)
+                        pool.submit([&completed] { juce::Thread::sleep(1); ++completed; });
+
+                ++completed;
+            });
+        }
+
+        pool.waitForAll();
+        expectEquals(completed.load(), 64 + 8 * 16);
+        logMessage(juce::String(pool.getNumSteals()) + " tasks stolen");
+
+        // The pool is reusable after waiting
+        pool.submit([&completed] { ++completed; });
+        pool.waitForAll();
+        expectEquals(completed.load(), 64 + 8 * 16 + 1);
+    }
+
+    void testThreadCountIndependence()
+    {
+        beginTest("Results are bit-identical for any thread count");
+
+        juce::Array<juce::File> files { writeStem("a.wav", 1000.0, 0.5f, 3.1),
+                                        writeStem("b.wav", 100.0, 0.2f, 2.0, 0.7),
+                                        temporaryFolder.getChildFile("missing.wav"),
+                                        writeStem("c.wav", 3000.0, 0.1f, 2.5, 0.0, 0.05f) };
+
+        OfflineAnalyzer::Options options;
+        options.chunkSeconds = 0.25;
+        options.includeSpectrum = true;
+        options.numThreads = 1;
+        const auto reference = OfflineAnalyzer(options).analyseBatch(files);
+
+        expect(reference.stems[0].numChunks == 13, "3.1 s in 0.25 s chunks");
+
+        for (const int threads : { 2, 3, 8 })
+        {
+            options.numThreads = threads;
+            const OfflineAnalyzer analyzer(options);
+            const auto batch = analyzer.analyseBatch(files);
+
+            bool same = batch.stems.size() == reference.stems.size();
+            for (size_t i = 0; same && i < batch.stems.size(); ++i)
+                same = identical(batch.stems[i], reference.stems[i])
+                    && batch.stems[i].succeeded() == reference.stems[i].succeeded();
+
+            for (size_t band = 0; same && band < batch.masking.maskingDb.size(); ++band)
+                same = sameBits(batch.masking.maskingDb[band], reference.masking.maskingDb[band]);
+
+            expect(same, "Differs on " + juce::String(threads) + " threads");
+            expect(identical(analyzer.analyseFile(files[0]), reference.stems[0]), "Single-file path differs");
+
+            logMessage(juce::String(threads) + " threads: " + juce::String(batch.getRealtimeFactor(), 0)
+                       + "x realtime, " + juce::String(batch.getRealtimeFactorPerCore(), 0) + "x per core");
+        }
+
+        const auto json = juce::JSON::parse(ReportWriter::toJson(reference));
+        expect(json["masking"]["bands_db"]["low"].size() == files.size());
+        expect(json["throughput"].hasProperty("realtime_factor_per_core"));
+        expect(json["files"][0].hasProperty("integrated_lufs"));
+    }
+
+    void testChunkBoundaries()
+    {
+        beginTest("Chunking does not change the measurements");
+
+        const auto file = writeStem("long.wav", 440.0, 0.3f, 6.0, 0.0, 0.02f);
+
+        OfflineAnalyzer::Options whole;
+        whole.chunkSeconds = 100.0;
+        OfflineAnalyzer::Options chunked;
+        chunked.chunkSeconds = 0.33;
+
+        const auto a = OfflineAnalyzer(whole).analyseFile(file);
+        const auto b = OfflineAnalyzer(chunked).analyseFile(file);
+
+        expectEquals(a.numChunks, 1);
+        expect(b.numChunks > 10);
+        expectWithinAbsoluteError(b.rmsDb, a.rmsDb, 1.0e-4f);
+        expectEquals(b.peakDb, a.peakDb);
+        expectWithinAbsoluteError(b.integratedLufs, a.integratedLufs, 0.001f);
+        expectWithinAbsoluteError(b.maxMomentaryLufs, a.maxMomentaryLufs, 0.001f);
+
+        for (size_t band = 0; band < a.bandEnergyDb.size(); ++band)
+            expectWithinAbsoluteError(b.bandEnergyDb[band], a.bandEnergyDb[band], 0.001f);
+
+        juce::int64 hopsA = 0, hopsB = 0;
+        for (size_t bin = 0; bin < a.levelHistogram.size(); ++bin)
+        {
+            hopsA += a.levelHistogram[bin];
+            hopsB += b.levelHistogram[bin];
+        }
+
+        expectEquals(hopsA, static_cast<juce::int64>(600));
+        expectEquals(hopsB, hopsA);
+    }
+
+    void testGatedLoudness()
+    {
+        beginTest("Integrated loudness gates out silence");
+
+        const auto report = OfflineAnalyzer(OfflineAnalyzer::Options{}).analyseFile(writeStem("gated.wav", 1000.0, 0.5f, 3.0, 3.0));
+
+        // Stereo -6 dBFS 1 kHz sine: -6.0 LUFS. Half the file is silent, which
+        // halves the RMS power but leaves the gated loudness alone, apart from
+        // the three blocks straddling the end of the tone (-0.22 dB)
+        expectWithinAbsoluteError(report.integratedLufs, -6.24f, 0.1f);
+        expectWithinAbsoluteError(report.rmsDb, -12.04f, 0.05f);
+
+        const auto& histogram = report.levelHistogram;
+        expectEquals(histogram.front(), static_cast<juce::int64>(300), "Silent hops land in the bottom bin");
+        expectEquals(histogram[static_cast<size_t>(-10 - AnalysisAggregate::HISTOGRAM_MIN_DB)], static_cast<juce::int64>(300),
+                     "-9.03 dB hops land in the -10 dB bin");
+    }
+
+    void testMaskingMatrix()
+    {
+        beginTest("Masking matrix: a loud bass covers a quiet one");
+
+        juce::Array<juce::File> files { writeStem("loud.wav", 100.0, 0.5f, 2.0),
+                                        writeStem("quiet.wav", 100.0, 0.05f, 2.0) };
+
+        const auto batch = OfflineAnalyzer(OfflineAnalyzer::Options{}).analyseBatch(files);
+        const auto& masking = batch.masking;
+
+        expectEquals(masking.numStems, 2);
+        expectWithinAbsoluteError(masking.get(0, 1, 0), 20.0f, 0.5f);
+        expectWithinAbsoluteError(masking.get(0, 0, 1), -20.0f, 0.5f);
+        expectEquals(masking.get(0, 0, 0), CrossStemMasking::NO_MASKING_DB);
+    }
+};
+
+static BatchAnalysisTests batchAnalysisTests;
+
+} // namespace AIplayer
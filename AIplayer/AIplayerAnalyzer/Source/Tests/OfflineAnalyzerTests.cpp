@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+    OfflineAnalyzerTests.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Tests for the offline analyzer: levels and bands of a known file,
+    memory-mapped versus streamed reading, parallel ordering and reports.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../OfflineAnalyzer.h"
+#include "../ReportWriter.h"
+#include <limits>
+
+namespace AIplayer {
+
+class OfflineAnalyzerTests : public juce::UnitTest
+{
+public:
+    OfflineAnalyzerTests() : UnitTest("Offline Analyzer Tests", "AIplayerAnalyzer") {}
+
+    void runTest() override
+    {
+        temporaryFolder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                              .getNonexistentChildFile("AIplayerAnalyzerTests", {});
+
+        testLevelsAndBands();
+        testMemoryMapping();
+        testParallelOrder();
+        testReports();
+
+        temporaryFolder.deleteRecursively();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+
+    juce::File temporaryFolder;
+
+    /// Writes a stereo 32-bit float WAV of a sine
+    juce::File writeSine(const juce::String& name, double frequency, float amplitude, double seconds)
+    {
+        temporaryFolder.createDirectory();
+        const auto file = temporaryFolder.getChildFile(name);
+
+        const int numSamples = juce::roundToInt(seconds * sampleRate);
+        juce::AudioBuffer<float> buffer(2, numSamples);
+        const double increment = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float sample = amplitude * static_cast<float>(std::sin(increment * i));
+            buffer.setSample(0, i, sample);
+            buffer.setSample(1, i, sample);
+        }
+
+        std::unique_ptr<juce::OutputStream> stream(file.createOutputStream());
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 2, 32, {}, 0));
+
+        if (writer != nullptr)
+        {
+            stream.release();
+            writer->writeFromAudioSampleBuffer(buffer, 0, numSamples);
+        }
+
+        return file;
+    }
+
+    void testLevelsAndBands()
+    {
+        beginTest("Levels and bands of a 1 kHz sine");
+
+        const auto file = writeSine("sine1k.wav", 1000.0, 0.5f, 4.0);
+        OfflineAnalyzer analyzer(OfflineAnalyzer::Options{});
+        const auto report = analyzer.analyseFile(file);
+
+        expect(report.succeeded(), report.error);
+        expectEquals(report.numChannels, 2);
+        expectWithinAbsoluteError(report.getDurationSeconds(), 4.0, 1.0e-6);
+        expectWithinAbsoluteError(report.peakDb, -6.02f, 0.05f);
+        expectWithinAbsoluteError(report.rmsDb, -9.03f, 0.05f);
+        expectWithinAbsoluteError(report.maxMomentaryLufs, -6.02f, 0.3f);
+
+        // 1 kHz sits in Low-Mid at the sine's level, as the plugin reads it
+        // (window noise bandwidth corrected), well above the neighbouring bands
+        expectWithinAbsoluteError(report.bandEnergyDb[1], -6.02f, 0.1f);
+        expect(report.bandEnergyDb[1] > report.bandEnergyDb[0] + 20.0f);
+        expect(report.bandEnergyDb[1] > report.bandEnergyDb[2] + 20.0f);
+
+        logMessage("RMS " + juce::String(report.rmsDb, 2) + " dBFS, peak " + juce::String(report.peakDb, 2)
+                   + " dBFS, " + juce::String(report.getRealtimeFactor(), 0) + "x realtime");
+        expect(report.getRealtimeFactor() > 1.0, "Slower than real time");
+    }
+
+    void testMemoryMapping()
+    {
+        beginTest("Memory-mapped and streamed reads agree");
+
+        const auto file = writeSine("sine100.wav", 100.0, 0.25f, 2.0);
+
+        OfflineAnalyzer::Options mappedOptions;
+        mappedOptions.memoryMapThresholdBytes = 0;
+        mappedOptions.includeSpectrum = true;
+
+        OfflineAnalyzer::Options streamedOptions = mappedOptions;
+        streamedOptions.memoryMapThresholdBytes = std::numeric_limits<juce::int64>::max();
+
+        const auto mapped = OfflineAnalyzer(mappedOptions).analyseFile(file);
+        const auto streamed = OfflineAnalyzer(streamedOptions).analyseFile(file);
+
+        expect(mapped.memoryMapped);
+        expect(!streamed.memoryMapped);
+        expectWithinAbsoluteError(mapped.rmsDb, streamed.rmsDb, 1.0e-5f);
+        expectWithinAbsoluteError(mapped.peakDb, streamed.peakDb, 1.0e-5f);
+        expectEquals(static_cast<int>(mapped.spectrumDb.size()), 512);
+        expectEquals(static_cast<int>(streamed.spectrumDb.size()), 512);
+
+        float spectrumError = 0.0f;
+        for (size_t bin = 0; bin < mapped.spectrumDb.size() && bin < streamed.spectrumDb.size(); ++bin)
+            spectrumError = juce::jmax(spectrumError, std::abs(mapped.spectrumDb[bin] - streamed.spectrumDb[bin]));
+        expect(spectrumError < 1.0e-4f, "Spectra differ");
+    }
+
+    void testParallelOrder()
+    {
+        beginTest("Parallel analysis keeps file order and reports failures");
+
+        juce::Array<juce::File> files;
+        for (int i = 0; i < 6; ++i)
+            files.add(writeSine("order" + juce::String(i) + ".wav", 1000.0, 0.1f * static_cast<float>(i + 1), 1.0));
+        files.insert(3, temporaryFolder.getChildFile("missing.wav"));
+
+        OfflineAnalyzer::Options options;
+        options.numThreads = 4;
+        const auto reports = OfflineAnalyzer(options).analyseFiles(files);
+
+        expectEquals(static_cast<int>(reports.size()), files.size());
+        expect(!reports[3].succeeded());
+
+        for (int i = 0, stem = 0; i < files.size(); ++i)
+        {
+            if (i == 3)
+                continue;
+
+            expect(reports[static_cast<size_t>(i)].file == files[i]);
+            expectWithinAbsoluteError(reports[static_cast<size_t>(i)].peakDb,
+                                      juce::Decibels::gainToDecibels(0.1f * static_cast<float>(++stem)), 0.05f);
+        }
+    }
+
+    void testReports()
+    {
+        beginTest("JSON and CSV reports");
+
+        juce::Array<juce::File> files { writeSine("report.wav", 1000.0, 0.5f, 1.0),
+                                        temporaryFolder.getChildFile("missing, quoted.wav") };
+        const auto reports = OfflineAnalyzer(OfflineAnalyzer::Options{}).analyseFiles(files);
+
+        const auto json = juce::JSON::parse(ReportWriter::toJson(reports));
+        const auto* entries = json["files"].getArray();
+        expect(entries != nullptr && entries->size() == 2);
+
+        if (entries != nullptr && entries->size() == 2)
+        {
+            expectWithinAbsoluteError(static_cast<float>((*entries)[0]["peak_db"]), -6.02f, 0.05f);
+            expect((*entries)[0]["bands"].hasProperty("low_mid_db"));
+            expect((*entries)[1]["error"].toString().isNotEmpty());
+        }
+
+        juce::StringArray lines;
+        lines.addLines(ReportWriter::toCsv(reports).trimEnd());
+        expectEquals(lines.size(), 3);
+        expect(lines[0].startsWith("file,sample_rate,channels"));
+        expect(lines[2].startsWith("\""), "Paths with commas are quoted");
+    }
+};
+
+static OfflineAnalyzerTests offlineAnalyzerTests;
+
+} // namespace AIplayer
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    WorkStealingPool.cpp
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Implementation of the work-stealing thread pool.
+
+  ==============================================================================
+*/
+
+#include "WorkStealingPool.h"
+
+namespace AIplayer {
+
+namespace {
+    /// Pool and deque of the worker running on this thread, if any
+    thread_local const WorkStealingPool* currentPool = nullptr;
+    thread_local int currentWorker = -1;
+}
+
+//==============================================================================
+WorkStealingPool::WorkStealingPool(int numWorkers)
+{
+    numWorkers = juce::jmax(1, numWorkers);
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.push_back(std::make_unique<Worker>());
+
+    for (int i = 0; i < numWorkers; ++i)
+        threads.emplace_back([this, i] { run(i); });
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    waitForAll();
+
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+
+    workAvailable.notify_all();
+
+    for (auto& thread : threads)
+        thread.join();
+}
+
+//==============================================================================
+void WorkStealingPool::submit(Task task)
+{
+    const int numWorkers = getNumWorkers();
+    const int index = currentPool == this ? currentWorker
+                                          : static_cast<int>(static_cast<unsigned>(nextWorker++) % static_cast<unsigned>(numWorkers));
+
+    // Counted before it becomes visible, so waitForAll() cannot miss it
+    ++unfinished;
+
+    {
+        auto& worker = *workers[static_cast<size_t>(index)];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        worker.tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        ++queued;
+    }
+
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::waitForAll()
+{
+    jassert(currentPool != this); // a worker waiting for itself never returns
+
+    std::unique_lock<std::mutex> guard(stateLock);
+    allDone.wait(guard, [this] { return unfinished.load() == 0; });
+}
+
+//==============================================================================
+bool WorkStealingPool::popOwn(int index, Task& task)
+{
+    auto& worker = *workers[static_cast<size_t>(index)];
+    std::lock_guard<std::mutex> guard(worker.lock);
+
+    if (worker.tasks.empty())
+        return false;
+
+    // Newest first: its data is most likely still in this core's cache
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    --queued;
+    return true;
+}
+
+bool WorkStealingPool::steal(int thief, Task& task)
+{
+    const int numWorkers = getNumWorkers();
+
+    for (int offset = 1; offset < numWorkers; ++offset)
+    {
+        auto& victim = *workers[static_cast<size_t>((thief + offset) % numWorkers)];
+        std::lock_guard<std::mutex> guard(victim.lock);
+
+        if (victim.tasks.empty())
+            continue;
+
+        // Oldest first: the opposite end from the owner, and usually the largest remaining work
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --queued;
+        ++steals;
+        return true;
+    }
+
+    return false;
+}
+
+void WorkStealingPool::run(int index)
+{
+    currentPool = this;
+    currentWorker = index;
+
+    for (;;)
+    {
+        Task task;
+
+        if (popOwn(index, task) || steal(index, task))
+        {
+            task();
+            task = nullptr;
+
+            if (--unfinished == 0)
+            {
+                std::lock_guard<std::mutex> guard(stateLock);
+                allDone.notify_all();
+            }
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(stateLock);
+        workAvailable.wait(guard, [this] { return stopping || queued.load() > 0; });
+
+        if (stopping && queued.load() <= 0)
+            return;
+    }
+}
+
+} // namespace AIplayer
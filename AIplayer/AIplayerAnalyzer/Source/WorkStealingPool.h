@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    WorkStealingPool.h
+    Created: 17 Oct 2026
+    Author:  Nick Fox
+
+    Fixed-size thread pool with one task deque per worker.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AIplayer {
+
+/**
+ * @class WorkStealingPool
+ * @brief Runs many small tasks on all cores with little contention
+ *
+ * Every worker owns a deque. Tasks submitted from outside the pool are
+ * dealt round-robin across the deques; tasks submitted from inside a task
+ * go to the submitting worker's own deque. A worker takes its newest task
+ * first (the data it just touched is still in cache) and, once its deque is
+ * empty, steals the oldest task of another worker. A batch of uneven jobs
+ * (one 20-minute stem among a hundred short ones, split into chunks) thus
+ * keeps every core busy until the last chunk.
+ *
+ * Tasks run in no particular order; callers that need deterministic results
+ * write into per-task slots and combine them after waitForAll().
+ */
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Starts the workers
+     *
+     * @param numWorkers Number of threads (at least 1)
+     */
+    explicit WorkStealingPool(int numWorkers);
+
+    /**
+     * @brief Waits for queued tasks and stops the workers
+     */
+    ~WorkStealingPool();
+
+    /**
+     * @brief Queues a task
+     *
+     * May be called from any thread, including from inside a running task.
+     *
+     * @param task Work to run on one of the workers
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Blocks until every submitted task (and every task they submitted) has finished
+     */
+    void waitForAll();
+
+    /// Number of worker threads
+    int getNumWorkers() const { return static_cast<int>(workers.size()); }
+
+    /// Tasks taken from another worker's deque since construction
+    juce::int64 getNumSteals() const { return steals.load(); }
+
+private:
+    struct Worker
+    {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    void run(int index);
+    bool popOwn(int index, Task& task);
+    bool steal(int thief, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex stateLock;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+
+    std::atomic<int> queued{0};         ///< Tasks waiting in any deque
+    std::atomic<int> unfinished{0};     ///< Tasks submitted but not yet completed
+    std::atomic<int> nextWorker{0};
+    std::atomic<juce::int64> steals{0};
+    bool stopping{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WorkStealingPool)
+};
+
+} // namespace AIplayer